@@ -0,0 +1,181 @@
+# Offline evaluation of a converted int8 (or 16x8) .tflite KWS model over a whole .npz
+# dataset (X = spectrograms, Y = one-hot labels, like train.npz / test.npz).
+#
+# The clips are quantized with the model input scale / zero point, exactly
+# like the ESP32 feeds g_feature_buffer, and run N at a time: the model input
+# is resized to [N, 49, 40, 1], so there is one invoke per N clips.
+# How the weights are shared between the clips of a batch is up to the TFLite
+# kernels : the reference ones loop over the clips outside of the filters,
+# like one clip per invoke, and the optimized ones (--optimized-kernels) run
+# every conv and dense layer as one matrix product over the whole batch. The
+# KWS kernels of the ESP32 (main/KWS/kernels) are not used here.
+# Batches are spread over all the cores by a work-stealing pool, every worker
+# owns its interpreter and a deque of batches, and steals from the others
+# when its own deque is empty.
+#
+# The reference kernels are used by default, they use the same integer
+# arithmetic as TFLM, and --verify checks that the batched outputs are
+# bit-exact with one clip per invoke.
+#
+# The fused model (fuse_conv_max_pool.py) has a custom operator which only
+# exists on the ESP32, so evaluate converted_model.tflite.
+#
+# Usage : python batch_eval.py converted_model.tflite test.npz [--batch 64] [--threads 4] [--verify 200]
+
+import argparse
+import collections
+import os
+import random
+import threading
+import time
+
+import numpy as np
+import tensorflow as tf
+
+
+LABELS = ['go', 'stop', 'silence', 'unknown']  # Same order as kCategoryLabels
+
+
+def make_interpreter(model_path, batch, reference_kernels):
+    if reference_kernels:
+        resolver = tf.lite.experimental.OpResolverType.BUILTIN_REF
+    else:
+        resolver = tf.lite.experimental.OpResolverType.AUTO
+    interpreter = tf.lite.Interpreter(model_path=model_path, num_threads=1,
+                                      experimental_op_resolver_type=resolver)
+    input_details = interpreter.get_input_details()[0]
+    shape = list(input_details['shape'])
+    shape[0] = batch
+    interpreter.resize_tensor_input(input_details['index'], shape)
+    interpreter.allocate_tensors()
+    return interpreter
+
+
+def quantize(spectrograms, input_details):
+    scale, zero_point = input_details['quantization']
+    shape = [len(spectrograms)] + list(input_details['shape'][1:])
+    values = np.round(spectrograms.reshape(shape) / scale) + zero_point
+    # int8, or int16 for the 16x8 models
+    dtype = input_details['dtype']
+    return np.clip(values, np.iinfo(dtype).min, np.iinfo(dtype).max).astype(dtype)
+
+
+def run_batch(interpreter, clips):
+    input_details = interpreter.get_input_details()[0]
+    output_details = interpreter.get_output_details()[0]
+    # The last batch can be smaller, it is padded with copies of the first clip
+    batch = input_details['shape'][0]
+    padded = np.concatenate([clips, np.repeat(clips[:1], batch - len(clips), axis=0)])
+    interpreter.set_tensor(input_details['index'], padded)
+    interpreter.invoke()
+    return interpreter.get_tensor(output_details['index'])[:len(clips)].copy()
+
+
+class WorkStealingPool:
+    """Every worker pops batches from the front of its own deque, and steals
+    from the back of the longest other deque when its own one is empty."""
+
+    def __init__(self, worker_count):
+        self.deques = [collections.deque() for _ in range(worker_count)]
+        self.lock = threading.Lock()
+        self.steals = 0
+
+    def next_batch(self, worker):
+        with self.lock:
+            if self.deques[worker]:
+                return self.deques[worker].popleft()
+            victim = max(range(len(self.deques)), key=lambda i: len(self.deques[i]))
+            if self.deques[victim]:
+                self.steals += 1
+                return self.deques[victim].pop()
+            return None
+
+    def run(self, batches, make_worker_state, work):
+        for index, batch in enumerate(batches):
+            self.deques[index % len(self.deques)].append(batch)
+
+        def worker_loop(worker):
+            state = make_worker_state()
+            while True:
+                batch = self.next_batch(worker)
+                if batch is None:
+                    return
+                work(state, batch)
+
+        threads = [threading.Thread(target=worker_loop, args=(i,)) for i in range(len(self.deques))]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+
+def evaluate(model_path, clips, batch, threads, reference_kernels):
+    outputs = [None] * len(clips)
+    batches = [(start, min(start + batch, len(clips))) for start in range(0, len(clips), batch)]
+
+    def work(interpreter, batch_range):
+        start, end = batch_range
+        # TFLite releases the GIL during invoke, so the workers really run in parallel
+        outputs[start:end] = run_batch(interpreter, clips[start:end])
+
+    pool = WorkStealingPool(threads)
+    start_time = time.perf_counter()
+    pool.run(batches, lambda: make_interpreter(model_path, batch, reference_kernels), work)
+    elapsed = time.perf_counter() - start_time
+    return np.stack(outputs), elapsed, pool.steals
+
+
+def verify_bit_exact(model_path, clips, batched_outputs, count, reference_kernels):
+    interpreter = make_interpreter(model_path, 1, reference_kernels)
+    indices = random.sample(range(len(clips)), min(count, len(clips)))
+    mismatches = 0
+    for i in indices:
+        single = run_batch(interpreter, clips[i:i + 1])[0]
+        mismatches += int(not np.array_equal(single, batched_outputs[i]))
+    return len(indices), mismatches
+
+
+def print_report(labels, predictions):
+    class_count = len(LABELS)
+    confusion = np.zeros((class_count, class_count), dtype=np.int64)
+    for label, prediction in zip(labels, predictions):
+        confusion[label, prediction] += 1
+
+    print(f'Accuracy : {np.trace(confusion) / max(1, confusion.sum()):.4f}')
+    print('Confusion matrix (rows = true label, columns = prediction)')
+    print(' ' * 10 + ''.join(f'{name:>10}' for name in LABELS))
+    for i, name in enumerate(LABELS):
+        print(f'{name:>10}' + ''.join(f'{value:>10}' for value in confusion[i]))
+
+    print(f'{"class":>10}{"precision":>11}{"recall":>10}{"clips":>10}')
+    for i, name in enumerate(LABELS):
+        precision = confusion[i, i] / max(1, confusion[:, i].sum())
+        recall = confusion[i, i] / max(1, confusion[i, :].sum())
+        print(f'{name:>10}{precision:>11.4f}{recall:>10.4f}{confusion[i, :].sum():>10}')
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Batch evaluation of an int8 KWS .tflite model')
+    parser.add_argument('model')
+    parser.add_argument('dataset', help='.npz file with X (spectrograms) and Y (one-hot labels)')
+    parser.add_argument('--batch', type=int, default=64, help='clips per invoke')
+    parser.add_argument('--threads', type=int, default=os.cpu_count(), help='worker threads')
+    parser.add_argument('--verify', type=int, default=0, help='clips checked against one clip per invoke')
+    parser.add_argument('--optimized-kernels', action='store_true',
+                        help='use the optimized TFLite kernels instead of the reference (TFLM) arithmetic')
+    args = parser.parse_args()
+
+    dataset = np.load(args.dataset)
+    reference_kernels = not args.optimized_kernels
+    input_details = make_interpreter(args.model, 1, reference_kernels).get_input_details()[0]
+    clips = quantize(dataset['X'], input_details)
+    labels = np.argmax(dataset['Y'], axis=1)
+
+    outputs, elapsed, steals = evaluate(args.model, clips, args.batch, args.threads, reference_kernels)
+    print(f'{len(clips)} clips in {elapsed:.2f} s : {len(clips) / elapsed:.1f} clips/s '
+          f'(batch {args.batch}, {args.threads} threads, {steals} stolen batches)')
+    print_report(labels, np.argmax(outputs, axis=1))
+
+    if args.verify > 0:
+        checked, mismatches = verify_bit_exact(args.model, clips, outputs, args.verify, reference_kernels)
+        print(f'Bit-exact check : {checked - mismatches}/{checked} clips identical to batch 1')
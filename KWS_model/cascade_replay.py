@@ -0,0 +1,166 @@
+# Replays long labelled recordings through the two stages cascade of the
+# ESP32 (KWS/cascade_detector.cc, KEYWORD_SPOTTING_CASCADE_*) : how often the
+# KWS model still runs (the wake rate), and the keywords it finds when it runs
+# on every stride but misses behind stage 1.
+#
+# The recordings are the ones of sweep_thresholds.py (.wav with a .csv of
+# start_s,end_s,label). At every stride stage 1 sees the newest --rows rows of
+# the int8 spectogram, like g_feature_buffer : the energy detector with the
+# same integer arithmetic and noise floor as the ESP32, or the stage 1 model of
+# the notebook (--stage1 stage1_model.tflite). A score above --threshold makes
+# the KWS model run for --hold-strides strides. The recognizer only gets the
+# results of the strides where the KWS model ran, like on the ESP32, and the
+# detections are scored with the RECOGNIZE_* defaults.
+#
+# Usage : python cascade_replay.py converted_model.tflite recordings/ [--stage1 stage1_model.tflite]
+#             [--threshold 128] [--hold-strides 25] [--energy-gain 4]
+
+import argparse
+import glob
+import os
+
+import numpy as np
+
+from batch_eval import LABELS, make_interpreter, quantize, run_batch
+from sweep_thresholds import (BACKGROUND_LABELS, SPECTOGRAM_ROW, STRIDE_MS, Quantization, averaged_results,
+                              c_divide, detections, read_annotations, score_detections, spectrogram)
+
+
+def model_windows(features, input_details):
+    """ The int8 spectogram of every stride with 49 rows, and their time in ms """
+    windows = np.lib.stride_tricks.sliding_window_view(features, SPECTOGRAM_ROW, axis=0)
+    windows = np.ascontiguousarray(np.swapaxes(windows, 1, 2))
+    times = (np.arange(len(windows)) + SPECTOGRAM_ROW) * STRIDE_MS
+    return quantize(windows, input_details), times
+
+
+def energy_scores(newest_rows, gain, threshold):
+    """ Scores of the energy detector, like cascade_stage1_score() without a model """
+    noise_floor_q8 = -128 * 256
+    element_count = newest_rows[0].size
+    scores = []
+    for total in newest_rows.reshape(len(newest_rows), -1).astype(np.int32).sum(axis=1).tolist():
+        mean_q8 = c_divide(total * 256, element_count)
+        score = ((mean_q8 - noise_floor_q8) * gain) >> 8
+        if score < threshold:
+            noise_floor_q8 += (mean_q8 - noise_floor_q8) >> 5
+        scores.append(min(max(score, 0), 255))
+    return np.array(scores)
+
+
+def model_stage1_scores(interpreter, newest_rows, batch):
+    """ Scores of the stage 1 model, its int8 input is the rows of g_feature_buffer as they are """
+    input_details = interpreter.get_input_details()[0]
+    clips = newest_rows.reshape([len(newest_rows)] + list(input_details['shape'][1:]))
+    outputs = np.concatenate([run_batch(interpreter, clips[i:i + batch])
+                              for i in range(0, len(clips), batch)])
+    scale, zero_point = interpreter.get_output_details()[0]['quantization']
+    probability = outputs.reshape(len(outputs), -1)[:, 0].astype(np.int32) - zero_point
+    # (int32_t)(probability * scale * 255.0f)
+    scores = np.trunc(probability.astype(np.float32) * np.float32(scale) * np.float32(255.0))
+    return np.clip(scores, 0, 255).astype(np.int32)
+
+
+def stage2_strides(scores, threshold, hold_strides):
+    """ True on the strides where the KWS model runs, like cascade_should_run_stage2() """
+    runs = np.zeros(len(scores), dtype=bool)
+    hold = 0
+    for stride, score in enumerate(scores.tolist()):
+        if score >= threshold:
+            hold = hold_strides
+        if hold > 0:
+            hold -= 1
+            runs[stride] = True
+    return runs
+
+
+def detected(found, keyword, tolerance_ms):
+    """ True when a detection of the label comes during the keyword, like score_detections() """
+    start_s, end_s, label = keyword
+    return any(LABELS[index] == label and start_s * 1000 <= time_ms <= end_s * 1000 + tolerance_ms
+               for time_ms, index in found)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('model', help='converted_model.tflite (not the fused one)')
+    parser.add_argument('recordings', help='folder of .wav with their .csv annotations')
+    parser.add_argument('--stage1', help='stage1_model.tflite, the energy detector without it')
+    parser.add_argument('--rows', type=int, default=16)
+    parser.add_argument('--threshold', type=int, default=128)
+    parser.add_argument('--hold-strides', type=int, default=25)
+    parser.add_argument('--energy-gain', type=int, default=4)
+    parser.add_argument('--batch', type=int, default=64)
+    parser.add_argument('--window-ms', type=int, default=800)
+    parser.add_argument('--minimum-count', type=int, default=3)
+    parser.add_argument('--recognize-threshold', type=int, default=200)
+    parser.add_argument('--release', type=int, default=100)
+    parser.add_argument('--suppression-ms', type=int, default=1500)
+    parser.add_argument('--shift', type=int, default=5)
+    parser.add_argument('--margin', type=int, default=48)
+    parser.add_argument('--max-threshold', type=int, default=245)
+    parser.add_argument('--tolerance-ms', type=int, default=1000)
+    args = parser.parse_args()
+
+    interpreter = make_interpreter(args.model, args.batch, True)
+    input_details = interpreter.get_input_details()[0]
+    if input_details['dtype'] != np.int8:
+        raise SystemExit('g_feature_buffer is int8, the cascade only runs with the int8 models')
+    scale, zero_point = interpreter.get_output_details()[0]['quantization']
+    stage1 = make_interpreter(args.stage1, args.batch, True) if args.stage1 else None
+
+    background = [label in BACKGROUND_LABELS for label in LABELS]
+    keyword_labels = [label for label in LABELS if label not in BACKGROUND_LABELS]
+
+    def found(scores, times):
+        averages = averaged_results(scores, times, zero_point, args.window_ms, args.minimum_count)
+        return detections(averages, times.tolist(), background, Quantization(scale), args.recognize_threshold,
+                          args.release, args.suppression_ms, args.shift, args.margin, args.max_threshold)
+
+    strides = runs_total = triggers = 0
+    always = {label: [0, 0, 0] for label in LABELS}
+    gated = {label: [0, 0, 0] for label in LABELS}
+    missed = 0
+    for wav_path in sorted(glob.glob(os.path.join(args.recordings, '*.wav'))):
+        annotations = read_annotations(os.path.splitext(wav_path)[0] + '.csv')
+        clips, times = model_windows(spectrogram(wav_path), input_details)
+        newest_rows = clips[:, SPECTOGRAM_ROW - args.rows:]
+        if stage1 is None:
+            stage1_scores = energy_scores(newest_rows, args.energy_gain, args.threshold)
+        else:
+            stage1_scores = model_stage1_scores(stage1, newest_rows, args.batch)
+        runs = stage2_strides(stage1_scores, args.threshold, args.hold_strides)
+
+        scores = np.concatenate([run_batch(interpreter, clips[i:i + args.batch])
+                                 for i in range(0, len(clips), args.batch)])
+        always_found = found(scores, times)
+        gated_found = found(scores[runs], times[runs])
+        for totals, counts in ((always, score_detections(always_found, annotations, LABELS, args.tolerance_ms)),
+                               (gated, score_detections(gated_found, annotations, LABELS, args.tolerance_ms))):
+            for label in LABELS:
+                totals[label] = [a + b for a, b in zip(totals[label], counts[label])]
+        # Keywords found by the KWS model alone, with no detection of the same label behind the cascade
+        for keyword in annotations:
+            if keyword[2] in keyword_labels and detected(always_found, keyword, args.tolerance_ms) \
+                    and not detected(gated_found, keyword, args.tolerance_ms):
+                missed += 1
+
+        strides += len(runs)
+        runs_total += int(runs.sum())
+        triggers += int((stage1_scores >= args.threshold).sum())
+        print('%s : %d strides, wake rate %.1f%%' % (os.path.basename(wav_path), len(runs), 100.0 * runs.mean()))
+
+    if strides == 0:
+        raise SystemExit('No .wav in ' + args.recordings)
+    print('Stage 1 %s : %d strides, %d triggers, wake rate %.1f%%'
+          % (args.stage1 or 'energy detector', strides, triggers, 100.0 * runs_total / strides))
+    for label in keyword_labels:
+        keywords = always[label][2]
+        print('%-8s %3d keywords : recall %.3f -> %.3f, false alarms %d -> %d'
+              % (label, keywords, always[label][0] / keywords if keywords else 0.0,
+                 gated[label][0] / keywords if keywords else 0.0, always[label][1], gated[label][1]))
+    print('Missed detections (found by the KWS model alone, not behind stage 1) : %d' % missed)
+
+
+if __name__ == '__main__':
+    main()
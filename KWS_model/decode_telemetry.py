@@ -0,0 +1,76 @@
+# Prints the telemetry records written by the ESP32 when
+# KEYWORD_SPOTTING_TELEMETRY_BINARY is 1 (KWS/telemetry.h).
+#
+# Every record is 16 bytes, little endian : the magic 0x4B57, the event id,
+# the low 32 bits of esp_timer_get_time() and three int32 args. They are
+# mixed with the text of the console (boot messages, ESP_LOG), so the
+# decoder looks for the magic and only keeps a record with a known id.
+#
+# The id and the format of every event come from the TELEMETRY_EVENTS list
+# of telemetry.h, so the decoder always matches the firmware it was built
+# with.
+#
+# Usage : python decode_telemetry.py console_capture.bin [--header ../KWS_wth_ESP32_SPH0645/main/KWS/telemetry.h]
+#         idf.py monitor is text only, capture the port with a raw reader (for
+#         example : python -m serial.tools.miniterm --raw ... > capture.bin)
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+
+RECORD = struct.Struct('<HHIiii')
+MAGIC = 0x4B57
+DEFAULT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                              '..', 'KWS_wth_ESP32_SPH0645', 'main', 'KWS', 'telemetry.h')
+
+
+def read_events(header_path):
+    """ The (name, format) of every event, in the order of their ids """
+    with open(header_path) as header:
+        text = header.read()
+    events = re.findall(r'EVENT\(\s*(TELEMETRY_\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)', text)
+    if not events:
+        sys.exit('No TELEMETRY_EVENTS in ' + header_path)
+    return events
+
+
+def decode(data, events):
+    """ Yields (time_us, name, text) of every record found in data """
+    magic = struct.pack('<H', MAGIC)
+    position = data.find(magic)
+    while 0 <= position <= len(data) - RECORD.size:
+        _, event_id, time_us, arg0, arg1, arg2 = RECORD.unpack_from(data, position)
+        if event_id < len(events):
+            name, event_format = events[event_id]
+            args = (arg0, arg1, arg2)[:event_format.count('%d')]
+            yield time_us, name, event_format % args
+            position = data.find(magic, position + RECORD.size)
+        else:
+            position = data.find(magic, position + 1)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('capture', help='raw bytes of the console, - for stdin')
+    parser.add_argument('--header', default=DEFAULT_HEADER)
+    args = parser.parse_args()
+
+    events = read_events(args.header)
+    if args.capture == '-':
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.capture, 'rb') as capture:
+            data = capture.read()
+
+    previous_time = None
+    for time_us, name, text in decode(data, events):
+        delta = '' if previous_time is None else '(+%d us)' % ((time_us - previous_time) & 0xFFFFFFFF)
+        print('%10d us %-14s %-32s %s' % (time_us, delta, name, text))
+        previous_time = time_us
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,156 @@
+# Replaces every CONV_2D -> MAX_POOL_2D pair of a converted int8 (or 16x8) .tflite model
+# with one 'KwsConvMaxPool2D' custom operator, which is implemented on the
+# ESP32 side in main/KWS/kernels/conv_max_pool.cc.
+#
+# The conv activation tensor between the two operators disappears from the
+# graph, so TFLM doesn't plan it in the arena anymore, and the fused kernel
+# never writes it to memory. The fused output is bit-exact with the original
+# pair, so the model accuracy doesn't change. The ESP32 app only registers the
+# custom operator with KEYWORD_SPOTTING_FUSED_CONV_POOL 1.
+#
+# Usage : python fuse_conv_max_pool.py converted_model.tflite fused_model.tflite
+
+import sys
+
+from flatbuffers import flexbuffers
+from tensorflow.lite.python import schema_py_generated as schema_fb
+from tensorflow.lite.tools import flatbuffer_utils
+
+
+CUSTOM_OP_NAME = 'KwsConvMaxPool2D'
+
+
+def builtin_code(model, op):
+    code = model.operatorCodes[op.opcodeIndex]
+    # New converters keep small opcodes in deprecatedBuiltinCode as well
+    return max(code.builtinCode, code.deprecatedBuiltinCode)
+
+
+def custom_opcode_index(model, name=CUSTOM_OP_NAME):
+    for index, code in enumerate(model.operatorCodes):
+        if code.customCode is not None and code.customCode.decode() == name:
+            return index
+
+    code = schema_fb.OperatorCodeT()
+    code.builtinCode = schema_fb.BuiltinOperator.CUSTOM
+    code.deprecatedBuiltinCode = schema_fb.BuiltinOperator.CUSTOM
+    code.customCode = name.encode()
+    code.version = 1
+    model.operatorCodes.append(code)
+    return len(model.operatorCodes) - 1
+
+
+def tensor_users(subgraph):
+    users = {}
+    for op in subgraph.operators:
+        for tensor in op.inputs:
+            users[tensor] = users.get(tensor, 0) + 1
+    for tensor in subgraph.outputs:
+        users[tensor] = users.get(tensor, 0) + 1
+    return users
+
+
+def can_fuse(model, subgraph, users, conv, pool):
+    if builtin_code(model, conv) != schema_fb.BuiltinOperator.CONV_2D:
+        return False
+    if builtin_code(model, pool) != schema_fb.BuiltinOperator.MAX_POOL_2D:
+        return False
+
+    conv_output = conv.outputs[0]
+    if pool.inputs[0] != conv_output or users.get(conv_output, 0) != 1:
+        return False
+
+    # The kernel handles the int8 layers of our model, and the 16x8 ones
+    # (int16 activations, int8 weights)
+    activation_type = subgraph.tensors[conv.inputs[0]].type
+    if activation_type not in (schema_fb.TensorType.INT8, schema_fb.TensorType.INT16):
+        return False
+    if (subgraph.tensors[conv.inputs[1]].type != schema_fb.TensorType.INT8 or
+            subgraph.tensors[pool.outputs[0]].type != activation_type):
+        return False
+
+    conv_options = conv.builtinOptions
+    pool_options = pool.builtinOptions
+    return (conv_options.dilationWFactor == 1 and
+            conv_options.dilationHFactor == 1 and
+            pool_options.padding == schema_fb.Padding.VALID)
+
+
+def fused_operator(opcode_index, conv, pool):
+    conv_options = conv.builtinOptions
+    pool_options = pool.builtinOptions
+
+    # Keys are read by index in the kernel, flexbuffers sorts them by name
+    options = {
+        'activation': conv_options.fusedActivationFunction,
+        'padding': conv_options.padding,
+        'pool_activation': pool_options.fusedActivationFunction,
+        'pool_filter_height': pool_options.filterHeight,
+        'pool_filter_width': pool_options.filterWidth,
+        'pool_stride_height': pool_options.strideH,
+        'pool_stride_width': pool_options.strideW,
+        'stride_height': conv_options.strideH,
+        'stride_width': conv_options.strideW,
+    }
+
+    op = schema_fb.OperatorT()
+    op.opcodeIndex = opcode_index
+    op.inputs = conv.inputs
+    op.outputs = pool.outputs
+    op.builtinOptionsType = schema_fb.BuiltinOptions.NONE
+    op.customOptions = list(flexbuffers.Dumps(options))
+    op.customOptionsFormat = schema_fb.CustomOptionsFormat.FLEXBUFFERS
+    return op
+
+
+def remove_tensors(subgraph, removed):
+    # Re-index all the tensors after deleting the intermediate ones
+    new_index = {}
+    tensors = []
+    for index, tensor in enumerate(subgraph.tensors):
+        if index not in removed:
+            new_index[index] = len(tensors)
+            tensors.append(tensor)
+    subgraph.tensors = tensors
+
+    remap = lambda indices: [new_index[i] if i >= 0 else i for i in indices]
+    for op in subgraph.operators:
+        op.inputs = remap(op.inputs)
+        op.outputs = remap(op.outputs)
+    subgraph.inputs = remap(subgraph.inputs)
+    subgraph.outputs = remap(subgraph.outputs)
+
+
+def fuse_conv_max_pool(model):
+    fused_count = 0
+    for subgraph in model.subgraphs:
+        users = tensor_users(subgraph)
+        operators = []
+        removed = set()
+        i = 0
+        while i < len(subgraph.operators):
+            op = subgraph.operators[i]
+            if (i + 1 < len(subgraph.operators) and
+                    can_fuse(model, subgraph, users, op, subgraph.operators[i + 1])):
+                pool = subgraph.operators[i + 1]
+                operators.append(fused_operator(custom_opcode_index(model), op, pool))
+                removed.add(op.outputs[0])
+                fused_count += 1
+                i += 2
+            else:
+                operators.append(op)
+                i += 1
+        subgraph.operators = operators
+        remove_tensors(subgraph, removed)
+    return fused_count
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        print('Usage : python fuse_conv_max_pool.py <input.tflite> <output.tflite>')
+        sys.exit(1)
+
+    model = flatbuffer_utils.read_model(sys.argv[1])
+    count = fuse_conv_max_pool(model)
+    flatbuffer_utils.write_model(model, sys.argv[2])
+    print(f'Fused {count} Conv2D + MaxPool2D pairs into {CUSTOM_OP_NAME}')
@@ -0,0 +1,128 @@
+# Builds the streaming version of the audio preprocessor model, which is used
+# on the ESP32 side when KEYWORD_SPOTTING_STREAMING_FRONTEND is 1.
+#
+# The normal preprocessor takes a 30 ms window (480 samples) every 20 ms, so the
+# audio provider keeps the last 10 ms in a history buffer and builds every
+# window by hand. The streaming model puts a 'SignalFramer' operator in front
+# of the graph, its input is only the 20 ms of new audio (320 samples) and it
+# keeps the overlap in its own state, with 10 ms of zeros as prefill like the
+# history buffer at start up. Its output is the old [1, 480] model input, so
+# all the other operators and tensors stay the same and the features are
+# bit-exact with the normal model.
+#
+# The graph stays at one frame per invoke : the Framer can cut several frames
+# from a longer input, but the FilterBank operators after it only take one
+# frame, so catching up is done by invoking the model once per stride.
+#
+# Usage : python make_streaming_preprocessor.py audio_preprocessor_int8_model_data.h audio_preprocessor_streaming_int8_model_data.h
+
+import re
+import sys
+
+from flatbuffers import flexbuffers
+from tensorflow.lite.python import schema_py_generated as schema_fb
+from tensorflow.lite.tools import flatbuffer_utils
+
+
+FRAMER_OP_NAME = 'SignalFramer'
+FRAME_SIZE = 480         # 30 ms at 16 kHz, the input of the normal model
+FRAME_STEP = 320         # 20 ms at 16 kHz, the new audio of every stride
+ARRAY_NAME = 'g_audio_preprocessor_streaming_int8_tflite'
+
+
+def read_header(path):
+    # The model is stored as a C array in the header, with its bytes as 0x..
+    text = open(path).read()
+    array = text[text.index('{') + 1:text.index('}')]
+    return bytearray(int(byte, 16) for byte in re.findall(r'0x[0-9a-fA-F]{2}', array))
+
+
+def write_header(path, data):
+    with open(path, 'w') as header:
+        header.write('// We need to keep the data array aligned on some architectures.\n'
+                     '#ifdef __has_attribute\n'
+                     '#define HAVE_ATTRIBUTE(x) __has_attribute(x)\n'
+                     '#else\n'
+                     '#define HAVE_ATTRIBUTE(x) 0\n'
+                     '#endif\n'
+                     '#if HAVE_ATTRIBUTE(aligned) || (defined(__GNUC__) && !defined(__clang__))\n'
+                     '#define DATA_ALIGN_ATTRIBUTE __attribute__((aligned(4)))\n'
+                     '#else\n'
+                     '#define DATA_ALIGN_ATTRIBUTE\n'
+                     '#endif\n\n')
+        header.write(f'const unsigned char {ARRAY_NAME}[] DATA_ALIGN_ATTRIBUTE = {{\n')
+        lines = []
+        for i in range(0, len(data), 12):
+            lines.append('  ' + ', '.join(f'0x{byte:02x}' for byte in data[i:i + 12]))
+        header.write(',\n'.join(lines) + '\n};\n')
+        header.write(f'unsigned int {ARRAY_NAME}_len = {len(data)};\n')
+
+
+def add_tensor(model, subgraph, name, tensor_type, shape):
+    buffer = schema_fb.BufferT()
+    model.buffers.append(buffer)
+
+    tensor = schema_fb.TensorT()
+    tensor.name = name.encode()
+    tensor.type = tensor_type
+    tensor.shape = shape
+    tensor.buffer = len(model.buffers) - 1
+    subgraph.tensors.append(tensor)
+    return len(subgraph.tensors) - 1
+
+
+def framer_opcode_index(model):
+    code = schema_fb.OperatorCodeT()
+    code.builtinCode = schema_fb.BuiltinOperator.CUSTOM
+    code.deprecatedBuiltinCode = schema_fb.BuiltinOperator.CUSTOM
+    code.customCode = FRAMER_OP_NAME.encode()
+    code.version = 1
+    model.operatorCodes.append(code)
+    return len(model.operatorCodes) - 1
+
+
+def make_streaming(model):
+    subgraph = model.subgraphs[0]
+    frame = subgraph.inputs[0]
+    if list(subgraph.tensors[frame].shape) != [1, FRAME_SIZE]:
+        raise ValueError(f'The model input should be [1, {FRAME_SIZE}]')
+
+    samples = add_tensor(model, subgraph, 'audio_samples',
+                         schema_fb.TensorType.INT16, [FRAME_STEP])
+    valid = add_tensor(model, subgraph, 'frame_valid', schema_fb.TensorType.BOOL, [])
+
+    # Keys are read by index in the kernel, flexbuffers sorts them by name
+    options = {
+        'frame_size': FRAME_SIZE,
+        'frame_step': FRAME_STEP,
+        'prefill': True,
+    }
+
+    op = schema_fb.OperatorT()
+    op.opcodeIndex = framer_opcode_index(model)
+    op.inputs = [samples]
+    op.outputs = [frame, valid]
+    op.builtinOptionsType = schema_fb.BuiltinOptions.NONE
+    op.customOptions = list(flexbuffers.Dumps(options))
+    op.customOptionsFormat = schema_fb.CustomOptionsFormat.FLEXBUFFERS
+
+    # The old input becomes the Framer output, it's now planned in the arena
+    subgraph.operators.insert(0, op)
+    subgraph.inputs = [samples]
+    for signature in model.signatureDefs or []:
+        for tensor in signature.inputs:
+            if tensor.tensorIndex == frame:
+                tensor.tensorIndex = samples
+                tensor.name = b'audio_samples'
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        print('Usage : python make_streaming_preprocessor.py <input.h> <output.h>')
+        sys.exit(1)
+
+    model = flatbuffer_utils.convert_bytearray_to_object(read_header(sys.argv[1]))
+    make_streaming(model)
+    data = flatbuffer_utils.convert_object_to_bytearray(model)
+    write_header(sys.argv[2], data)
+    print(f'Wrote {ARRAY_NAME} ({len(data)} bytes)')
@@ -0,0 +1,62 @@
+# Compares the int8 model (converted_model.tflite) with the same network
+# converted with int16 activations and int8 weights (converted_model_16x8.tflite
+# of the notebook) : size, time per invoke and accuracy on a .npz dataset.
+#
+# On the ESP32 the features are int8 for both models, a 16x8 model gets them
+# through a table (keyword_spotting_bind_model()), so the spectrograms are
+# first quantized to the int8 input of converted_model.tflite, and the 16x8
+# model is run on their real values. The int16 activations only remove the
+# rounding of the layers, which is what the accuracy difference shows.
+#
+# The time per invoke of the host is only a relative cost : the 16x8 kernels of
+# TensorFlow Lite are not the ones of the ESP32 (kernels/conv_fc_16x8.h), the
+# ESP32 number is the "Inference" time of the telemetry.
+#
+# Usage : python quant_benchmark.py converted_model.tflite converted_model_16x8.tflite test.npz [--clips 2000]
+
+import argparse
+import os
+
+import numpy as np
+
+from batch_eval import LABELS, make_interpreter, quantize
+from stream_benchmark import run_cnn
+
+
+def device_features(spectrograms, model_path):
+    """ The real values of the int8 features which the ESP32 gives to the models """
+    input_details = make_interpreter(model_path, 1, False).get_input_details()[0]
+    scale, zero_point = input_details['quantization']
+    features = quantize(spectrograms, input_details).astype(np.float32)
+    return ((features - zero_point) * scale).reshape(spectrograms.shape)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('int8', help='converted_model.tflite')
+    parser.add_argument('int16', help='converted_model_16x8.tflite')
+    parser.add_argument('dataset', help='.npz file with X (spectrograms) and Y (one-hot labels)')
+    parser.add_argument('--clips', type=int, default=0, help='only the first clips, 0 for all')
+    args = parser.parse_args()
+
+    with np.load(args.dataset) as dataset:
+        spectrograms = dataset['X']
+        labels = np.argmax(dataset['Y'], axis=1)
+    if args.clips:
+        spectrograms, labels = spectrograms[:args.clips], labels[:args.clips]
+    features = device_features(spectrograms, args.int8)
+
+    print(f'{len(labels)} clips')
+    print(f'{"model":<8}{"bytes":>10}{"us / invoke":>14}{"accuracy":>10}  per label')
+    predictions = {}
+    for name, path in (('int8', args.int8), ('16x8', args.int16)):
+        predictions[name], invoke_seconds = run_cnn(path, features)
+        per_label = '  '.join(f'{label} {np.mean(predictions[name][labels == index] == index):.3f}'
+                              for index, label in enumerate(LABELS) if np.any(labels == index))
+        print(f'{name:<8}{os.path.getsize(path):>10}{invoke_seconds * 1e6:>14.1f}'
+              f'{np.mean(predictions[name] == labels):>10.4f}  {per_label}')
+    print(f'Same prediction for {np.mean(predictions["int8"] == predictions["16x8"]):.4f} of the clips')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,209 @@
+# Replaces the FULLY_CONNECTED operators of a converted int8 .tflite model whose
+# weights are pruned by blocks with one 'KwsSparseFullyConnected' custom
+# operator, which is implemented on the ESP32 side in
+# main/KWS/kernels/fully_connected_sparse.cc.
+#
+# The weights [rows, columns] are cut in blocks of 1x4 (1 output row x 4 input
+# columns) or 4x1, and only the non-zero blocks are kept, row block by row
+# block (block CSR) :
+#   values        [N, block size] int8, the quantization of the dense weights
+#   block_columns [N] int16, first column of every block / block columns
+#   row_blocks    [rows / block rows + 1] int32, first block of every row block
+# A stored block costs its 4 values and 2 bytes of column, so a layer is only
+# replaced when at least --min-sparsity of its blocks are zero. The kernel
+# never reads the zero blocks, and its outputs are bit-exact with
+# FULLY_CONNECTED on the pruned weights.
+#
+# The weights are pruned by the notebook (tfmot, block_size (4, 1) on the
+# Keras kernel [inputs, outputs] for the 1x4 blocks here). --prune zeroes the
+# blocks of smallest magnitude of the int8 weights instead, without training,
+# in the Dense layers of at least --prune-min-weights weights (the Dense after
+# the Flatten, not the classifier) : fine for a first look at the flash and
+# latency, the accuracy is the one of the model written by --pruned.
+#
+# The custom operator only exists on the ESP32, so evaluate the dense model
+# (converted_model.tflite, or --pruned) with batch_eval.py.
+#
+# Usage : python sparse_fully_connected.py fused_model.tflite sparse_model.tflite [--block 1x4]
+#         python sparse_fully_connected.py fused_model.tflite sparse_model.tflite --prune 0.75 --pruned pruned_model.tflite
+
+import argparse
+import copy
+
+import numpy as np
+from flatbuffers import flexbuffers
+from tensorflow.lite.python import schema_py_generated as schema_fb
+from tensorflow.lite.tools import flatbuffer_utils
+
+from fuse_conv_max_pool import builtin_code, custom_opcode_index, remove_tensors, tensor_users
+
+
+CUSTOM_OP_NAME = 'KwsSparseFullyConnected'
+BLOCKS = {'1x4': (1, 4), '4x1': (4, 1)}
+
+
+def constant_data(model, tensor):
+    data = model.buffers[tensor.buffer].data
+    return None if data is None or len(data) == 0 else np.asarray(data, dtype=np.uint8)
+
+
+def dense_weights(model, subgraph, op):
+    """ The int8 weights [rows, columns] of a FULLY_CONNECTED, or None when the kernel can't take them """
+    if builtin_code(model, op) != schema_fb.BuiltinOperator.FULLY_CONNECTED:
+        return None
+    options = op.builtinOptions
+    if options is not None and options.weightsFormat != schema_fb.FullyConnectedOptionsWeightsFormat.DEFAULT:
+        return None
+    input_tensor = subgraph.tensors[op.inputs[0]]
+    weights = subgraph.tensors[op.inputs[1]]
+    output = subgraph.tensors[op.outputs[0]]
+    if any(tensor.type != schema_fb.TensorType.INT8 for tensor in (input_tensor, weights, output)):
+        return None
+    data = constant_data(model, weights)
+    if data is None or len(weights.shape) != 2:
+        return None
+    return data.view(np.int8).reshape(weights.shape)
+
+
+def fits(weights, block):
+    rows, columns = weights.shape
+    block_rows, block_cols = block
+    return rows % block_rows == 0 and columns % block_cols == 0 and columns // block_cols <= 32767
+
+
+def block_norms(weights, block):
+    """ Sum of |w| of every block, [rows / block rows, columns / block columns] """
+    rows, columns = weights.shape
+    block_rows, block_cols = block
+    blocks = np.abs(weights.astype(np.int32)).reshape(rows // block_rows, block_rows, columns // block_cols, block_cols)
+    return blocks.sum(axis=(1, 3))
+
+
+def prune(weights, block, sparsity):
+    """ Zeroes the sparsity fraction of the blocks with the smallest magnitude """
+    norms = block_norms(weights, block)
+    pruned_count = int(round(sparsity * norms.size))
+    keep = np.ones(norms.size, dtype=bool)
+    keep[np.argsort(norms, axis=None, kind='stable')[:pruned_count]] = False
+    mask = np.repeat(np.repeat(keep.reshape(norms.shape), block[0], axis=0), block[1], axis=1)
+    return np.where(mask, weights, 0).astype(np.int8)
+
+
+def encode(weights, block):
+    """ values, block_columns and row_blocks of the non-zero blocks """
+    rows, columns = weights.shape
+    block_rows, block_cols = block
+    blocks = weights.reshape(rows // block_rows, block_rows, columns // block_cols, block_cols).transpose(0, 2, 1, 3)
+    non_zero = block_norms(weights, block) != 0
+    values = blocks[non_zero].reshape(-1, block_rows * block_cols)
+    block_columns = np.nonzero(non_zero)[1].astype(np.int16)
+    row_blocks = np.concatenate([[0], np.cumsum(non_zero.sum(axis=1))]).astype(np.int32)
+    return values, block_columns, row_blocks
+
+
+def add_constant(model, subgraph, name, array, tensor_type, quantization=None):
+    buffer = schema_fb.BufferT()
+    buffer.data = np.frombuffer(np.ascontiguousarray(array).tobytes(), dtype=np.uint8)
+    model.buffers.append(buffer)
+
+    tensor = schema_fb.TensorT()
+    tensor.name = name.encode()
+    tensor.shape = list(array.shape)
+    tensor.type = tensor_type
+    tensor.buffer = len(model.buffers) - 1
+    tensor.quantization = quantization
+    subgraph.tensors.append(tensor)
+    return len(subgraph.tensors) - 1
+
+
+def sparse_operator(model, subgraph, op, weights, block):
+    dense = subgraph.tensors[op.inputs[1]]
+    values, block_columns, row_blocks = encode(weights, block)
+    name = dense.name.decode() if dense.name else 'weights'
+    inputs = [op.inputs[0],
+              add_constant(model, subgraph, name + '/values', values, schema_fb.TensorType.INT8,
+                           copy.deepcopy(dense.quantization)),
+              add_constant(model, subgraph, name + '/block_columns', block_columns, schema_fb.TensorType.INT16),
+              add_constant(model, subgraph, name + '/row_blocks', row_blocks, schema_fb.TensorType.INT32)]
+    if len(op.inputs) > 2:
+        inputs.append(op.inputs[2])
+
+    # Keys are read by index in the kernel, flexbuffers sorts them by name
+    options = {
+        'activation': op.builtinOptions.fusedActivationFunction if op.builtinOptions is not None else 0,
+        'block_cols': block[1],
+        'block_rows': block[0],
+    }
+
+    sparse = schema_fb.OperatorT()
+    sparse.opcodeIndex = custom_opcode_index(model, CUSTOM_OP_NAME)
+    sparse.inputs = inputs
+    sparse.outputs = op.outputs
+    sparse.builtinOptionsType = schema_fb.BuiltinOptions.NONE
+    sparse.customOptions = list(flexbuffers.Dumps(options))
+    sparse.customOptionsFormat = schema_fb.CustomOptionsFormat.FLEXBUFFERS
+    return sparse, values.size + block_columns.nbytes + row_blocks.nbytes
+
+
+def prune_model(model, block, sparsity, min_weights):
+    """ Prunes the weights in place, the model keeps its FULLY_CONNECTED """
+    for subgraph in model.subgraphs:
+        for op in subgraph.operators:
+            weights = dense_weights(model, subgraph, op)
+            if weights is not None and weights.size >= min_weights and fits(weights, block):
+                pruned = prune(weights, block, sparsity)
+                model.buffers[subgraph.tensors[op.inputs[1]].buffer].data = pruned.reshape(-1).view(np.uint8)
+
+
+def sparse_fully_connected(model, block, min_sparsity):
+    """ Returns the number of FULLY_CONNECTED replaced, and prints every layer """
+    sparse_count = 0
+    for subgraph in model.subgraphs:
+        users = tensor_users(subgraph)
+        operators = []
+        removed = set()
+        for op in subgraph.operators:
+            weights = dense_weights(model, subgraph, op)
+            if weights is None or not fits(weights, block):
+                operators.append(op)
+                continue
+            zero_blocks = np.mean(block_norms(weights, block) == 0)
+            replace = zero_blocks >= min_sparsity and users.get(op.inputs[1], 0) == 1
+            if replace:
+                sparse, sparse_bytes = sparse_operator(model, subgraph, op, weights, block)
+                operators.append(sparse)
+                # The dense weights leave the flatbuffer
+                removed.add(op.inputs[1])
+                model.buffers[subgraph.tensors[op.inputs[1]].buffer].data = None
+                sparse_count += 1
+            else:
+                operators.append(op)
+                sparse_bytes = weights.size
+            print(f'  FULLY_CONNECTED {weights.shape[0]} x {weights.shape[1]} : {zero_blocks:.1%} zero blocks, '
+                  f'{weights.size} -> {sparse_bytes} bytes{"" if replace else " (kept dense)"}')
+        subgraph.operators = operators
+        remove_tensors(subgraph, removed)
+    return sparse_count
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('model', help='converted_model.tflite or fused_model.tflite')
+    parser.add_argument('output', help='the model with the sparse operators')
+    parser.add_argument('--block', choices=sorted(BLOCKS), default='1x4', help='rows x columns of the blocks')
+    parser.add_argument('--min-sparsity', type=float, default=0.4,
+                        help='fraction of zero blocks below which a layer stays dense')
+    parser.add_argument('--prune', type=float, help='zero this fraction of the blocks first (no training)')
+    parser.add_argument('--prune-min-weights', type=int, default=16384)
+    parser.add_argument('--pruned', help='write the pruned dense model, for batch_eval.py')
+    args = parser.parse_args()
+
+    block = BLOCKS[args.block]
+    model = flatbuffer_utils.read_model(args.model)
+    if args.prune is not None:
+        prune_model(model, block, args.prune, args.prune_min_weights)
+        if args.pruned:
+            flatbuffer_utils.write_model(model, args.pruned)
+    count = sparse_fully_connected(model, block, args.min_sparsity)
+    flatbuffer_utils.write_model(model, args.output)
+    print(f'Replaced {count} FULLY_CONNECTED with {CUSTOM_OP_NAME} ({args.block} blocks)')
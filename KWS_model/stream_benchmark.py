@@ -0,0 +1,87 @@
+# Compares the per-stride cost and the accuracy of the window CNN
+# (converted_model.tflite, the whole 49 x 40 spectogram per invoke) with a
+# streaming model (streaming_model.tflite of the notebook, one row of 40
+# features per invoke, the older rows are in its resource variables).
+#
+# On the ESP32 both run once per stride of 20 ms : the CNN on the spectogram,
+# the streaming model on the new row (KEYWORD_SPOTTING_STREAMING_ENABLE).
+# The time per invoke of the host is only a relative cost, the ESP32 number
+# is the "Inference" time of the telemetry.
+#
+# The receptive field of the streaming model is exactly 49 rows, so after the
+# 49 rows of a clip its output doesn't depend on the rows before : the clips
+# are fed one after the other without a reset, and the output of the last row
+# of a clip is its prediction.
+#
+# Usage : python stream_benchmark.py converted_model.tflite streaming_model.tflite test.npz [--clips 2000]
+
+import argparse
+import os
+import time
+
+import numpy as np
+
+from batch_eval import LABELS, make_interpreter, quantize
+
+
+def run_cnn(model_path, spectrograms):
+    interpreter = make_interpreter(model_path, 1, False)
+    input_details = interpreter.get_input_details()[0]
+    output_index = interpreter.get_output_details()[0]['index']
+    clips = quantize(spectrograms, input_details)
+    predictions = np.empty(len(clips), dtype=np.int64)
+    elapsed = 0.0
+    for i, clip in enumerate(clips):
+        interpreter.set_tensor(input_details['index'], clip[np.newaxis])
+        start_time = time.perf_counter()
+        interpreter.invoke()
+        elapsed += time.perf_counter() - start_time
+        predictions[i] = np.argmax(interpreter.get_tensor(output_index)[0])
+    return predictions, elapsed / len(clips)
+
+
+def run_streaming(model_path, spectrograms):
+    interpreter = make_interpreter(model_path, 1, False)
+    input_details = interpreter.get_input_details()[0]
+    output_index = interpreter.get_output_details()[0]['index']
+    rows_per_clip = spectrograms.shape[1]
+    rows = quantize(spectrograms.reshape(-1, spectrograms.shape[2]), input_details)
+    rows = rows.reshape((len(spectrograms), rows_per_clip) + rows.shape[1:])
+    predictions = np.empty(len(rows), dtype=np.int64)
+    elapsed = 0.0
+    for i, clip in enumerate(rows):
+        for row in clip:
+            interpreter.set_tensor(input_details['index'], row[np.newaxis])
+            start_time = time.perf_counter()
+            interpreter.invoke()
+            elapsed += time.perf_counter() - start_time
+        predictions[i] = np.argmax(interpreter.get_tensor(output_index)[0])
+    return predictions, elapsed / rows.shape[0] / rows_per_clip
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('cnn', help='converted_model.tflite')
+    parser.add_argument('streaming', help='streaming_model.tflite')
+    parser.add_argument('dataset', help='.npz file with X (spectrograms) and Y (one-hot labels)')
+    parser.add_argument('--clips', type=int, default=0, help='only the first clips, 0 for all')
+    args = parser.parse_args()
+
+    with np.load(args.dataset) as dataset:
+        spectrograms = dataset['X']
+        labels = np.argmax(dataset['Y'], axis=1)
+    if args.clips:
+        spectrograms, labels = spectrograms[:args.clips], labels[:args.clips]
+
+    print(f'{len(labels)} clips')
+    print(f'{"model":<12}{"bytes":>10}{"us / stride":>14}{"accuracy":>10}  per label')
+    for name, path, run in (('cnn', args.cnn, run_cnn), ('streaming', args.streaming, run_streaming)):
+        predictions, stride_seconds = run(path, spectrograms)
+        per_label = '  '.join(f'{label} {np.mean(predictions[labels == index] == index):.3f}'
+                              for index, label in enumerate(LABELS) if np.any(labels == index))
+        print(f'{name:<12}{os.path.getsize(path):>10}{stride_seconds * 1e6:>14.1f}'
+              f'{np.mean(predictions == labels):>10.4f}  {per_label}')
+
+
+if __name__ == '__main__':
+    main()
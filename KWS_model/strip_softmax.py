@@ -0,0 +1,135 @@
+# Removes the SOFTMAX at the end of a converted int8 .tflite model, the model
+# then gives the int8 logits (the output of the last Dense).
+#
+# The ESP32 only needs the argmax and the thresholds of the averaged scores,
+# so RecognizeCommands (main/KWS/other/recognize_commands.h) makes the
+# softmax of the logits itself, with a table of exp(-scale x d) for the 256
+# differences d to the highest logit. Without the operator, the resolver
+# doesn't need SOFTMAX (KEYWORD_SPOTTING_SOFTMAX_ELISION 2), and the arena
+# has neither its output tensor nor its scratch buffer.
+#
+# --check runs both models on a .npz dataset (like batch_eval.py) and compares
+# the softmax of the full model with the one made from the logits, with the
+# same integer arithmetic as the ESP32 : the argmax must be the same for every
+# clip, and the scores the same (the float exp of the table can round one
+# score in several thousands 1/256 away from the int8 softmax kernel).
+# batch_eval.py and sweep_thresholds.py still take the model with its softmax.
+#
+# Usage : python strip_softmax.py converted_model.tflite stripped_model.tflite [--check test.npz]
+#         python fuse_conv_max_pool.py stripped_model.tflite fused_model.tflite
+
+import argparse
+import math
+
+import numpy as np
+from tensorflow.lite.python import schema_py_generated as schema_fb
+from tensorflow.lite.tools import flatbuffer_utils
+
+from batch_eval import make_interpreter, quantize, run_batch
+from fuse_conv_max_pool import builtin_code, remove_tensors, tensor_users
+
+
+SOFTMAX_ZERO_POINT = -128
+
+
+def remove_unused_opcodes(model):
+    used = sorted({op.opcodeIndex for subgraph in model.subgraphs for op in subgraph.operators})
+    new_index = {old: new for new, old in enumerate(used)}
+    model.operatorCodes = [model.operatorCodes[old] for old in used]
+    for subgraph in model.subgraphs:
+        for op in subgraph.operators:
+            op.opcodeIndex = new_index[op.opcodeIndex]
+
+
+def strip_softmax(model):
+    """ Returns the number of SOFTMAX removed, their logits become the outputs """
+    stripped_count = 0
+    for subgraph_index, subgraph in enumerate(model.subgraphs):
+        users = tensor_users(subgraph)
+        outputs = list(subgraph.outputs)
+        removed = set()
+        operators = []
+        for op in subgraph.operators:
+            output = op.outputs[0]
+            # Only a softmax which makes an output that nothing else reads
+            if (builtin_code(model, op) == schema_fb.BuiltinOperator.SOFTMAX and
+                    output in outputs and users.get(output, 0) == 1):
+                outputs[outputs.index(output)] = op.inputs[0]
+                removed.add(output)
+                for signature in model.signatureDefs or []:
+                    if signature.subgraphIndex != subgraph_index:
+                        continue
+                    for tensor_map in signature.outputs or []:
+                        if tensor_map.tensorIndex == output:
+                            tensor_map.tensorIndex = op.inputs[0]
+                stripped_count += 1
+            else:
+                operators.append(op)
+        subgraph.operators = operators
+        subgraph.outputs = outputs
+
+        # remove_tensors() doesn't know the signatures
+        for signature in model.signatureDefs or []:
+            if signature.subgraphIndex == subgraph_index:
+                for tensor_map in signature.outputs or []:
+                    tensor_map.tensorIndex -= sum(1 for index in removed if index < tensor_map.tensorIndex)
+        remove_tensors(subgraph, removed)
+    remove_unused_opcodes(model)
+    return stripped_count
+
+
+def exp_table_q20(scale):
+    """ exp_q20_ of RecognizeCommands::SetOutputQuantization() """
+    return np.array([int(math.floor(1048576.0 * math.exp(-scale * difference) + 0.5))
+                     for difference in range(256)], dtype=np.int64)
+
+
+def softmax_of_logits(logits, scale):
+    """ RecognizeCommands::SoftmaxOfLogits() on every row """
+    exp_q20 = exp_table_q20(scale)
+    logits = logits.astype(np.int64)
+    terms = exp_q20[logits.max(axis=1, keepdims=True) - logits]
+    sums = terms.sum(axis=1, keepdims=True)
+    scores = np.minimum((terms * 256 + sums // 2) // sums, 255)
+    return (scores + SOFTMAX_ZERO_POINT).astype(np.int8)
+
+
+def check(full_path, stripped_path, dataset_path, batch):
+    with np.load(dataset_path) as dataset:
+        spectrograms = dataset['X']
+
+    outputs = {}
+    for name, path in (('full', full_path), ('stripped', stripped_path)):
+        interpreter = make_interpreter(path, batch, True)
+        clips = quantize(spectrograms, interpreter.get_input_details()[0])
+        outputs[name] = np.concatenate([run_batch(interpreter, clips[i:i + batch])
+                                        for i in range(0, len(clips), batch)])
+        quantization = interpreter.get_output_details()[0]['quantization']
+    scale, zero_point = quantization
+    print(f'Logits : scale {scale} zero point {zero_point}')
+
+    full = outputs['full']
+    rebuilt = softmax_of_logits(outputs['stripped'], scale)
+    argmax_differ = int(np.count_nonzero(np.argmax(full, axis=1) != np.argmax(outputs['stripped'], axis=1)))
+    differences = rebuilt.astype(np.int32) - full.astype(np.int32)
+    print(f'{len(full)} clips : argmax differs for {argmax_differ}')
+    for difference, count in zip(*np.unique(differences, return_counts=True)):
+        print(f'  score {difference:+d}/256 : {count}')
+    return argmax_differ == 0 and np.abs(differences).max() <= 1
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('model', help='converted_model.tflite')
+    parser.add_argument('output', help='the model without its softmax')
+    parser.add_argument('--check', metavar='DATASET', help='.npz file with X (spectrograms), like test.npz')
+    parser.add_argument('--batch', type=int, default=64)
+    args = parser.parse_args()
+
+    model = flatbuffer_utils.read_model(args.model)
+    count = strip_softmax(model)
+    flatbuffer_utils.write_model(model, args.output)
+    print(f'Removed {count} SOFTMAX')
+
+    if args.check and not check(args.model, args.output, args.check, args.batch):
+        raise SystemExit('The softmax made from the logits is not the one of the model')
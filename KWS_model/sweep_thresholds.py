@@ -0,0 +1,302 @@
+# Tunes the post-processing of the ESP32 (RecognizeCommands in
+# other/recognize_commands.h) on long labelled recordings : for every value of
+# the grid it gives the precision, the recall and the false alarms per hour of
+# every keyword.
+#
+# A recording is a 16 kHz mono 16 bits .wav with a .csv of the same name next
+# to it, one line per spoken keyword : start_s,end_s,label (the other labels
+# and the rest of the audio are background). The features are made by the
+# same microfrontend as the notebook, on the whole recording at once like the
+# ESP32 makes them stride by stride, and the model runs on the last 49 rows
+# at every stride (20 ms). The int8 scores only depend on the model, they are
+# kept in --cache so a second sweep doesn't run the model again.
+#
+# The decision (average window, per label threshold and release, suppression,
+# background adaptive threshold) is done with the same integer arithmetic as
+# recognize_commands.cc, so the values found here give the same detections on
+# the ESP32. They go to the KEYWORD_SPOTTING_RECOGNIZE_* defines, or at runtime
+# to keyword_spotting_app_set_threshold().
+#
+# A detection is right when it comes between the start of a keyword with its
+# label and --tolerance-ms after its end (the average needs some time), the
+# others and the second detection of the same keyword are false alarms.
+#
+# Usage : python sweep_thresholds.py converted_model.tflite recordings/ [--cache scores.npz]
+#             [--thresholds 120:250:10] [--releases 60,100] [--shifts 0,5] [--margins 32,48]
+#             [--max-fa-per-hour 1] [--out sweep.csv]
+
+import argparse
+import collections
+import csv
+import glob
+import math
+import os
+
+import numpy as np
+import tensorflow as tf
+from tensorflow.lite.experimental.microfrontend.python.ops import audio_microfrontend_op as frontend_op
+
+from batch_eval import LABELS, make_interpreter, quantize, run_batch
+
+
+SAMPLE_RATE = 16000
+STRIDE_MS = 20
+SPECTOGRAM_ROW = 49
+MAX_RESULTS = 50          # kMaxResults of PreviousResultsQueue
+BACKGROUND_LABELS = ('silence', 'unknown', '_silence_', '_unknown_')
+
+
+def spectrogram(wav_path):
+    """ The float features of the whole recording, one row every 20 ms """
+    audio = tf.audio.decode_wav(tf.io.read_file(wav_path), desired_channels=1)
+    if int(audio.sample_rate) != SAMPLE_RATE:
+        raise ValueError('%s is not at %d Hz' % (wav_path, SAMPLE_RATE))
+    samples = tf.cast(tf.round(audio.audio[:, 0] * 32767.0), tf.int16)
+    features = frontend_op.audio_microfrontend(
+        samples, sample_rate=SAMPLE_RATE, window_size=30, window_step=STRIDE_MS,
+        num_channels=40, lower_band_limit=125.0, upper_band_limit=7500.0,
+        smoothing_bits=10, even_smoothing=0.025, odd_smoothing=0.06,
+        min_signal_remaining=0.05, enable_pcan=True, pcan_strength=0.95,
+        pcan_offset=80.0, gain_bits=21, enable_log=True, scale_shift=6,
+        out_scale=1, out_type=tf.float32)
+    return (features * (10.0 / 256.0)).numpy()
+
+
+def model_scores(interpreter, features, batch):
+    """ int8 outputs of the model at every stride with 49 rows, and their time in ms """
+    input_details = interpreter.get_input_details()[0]
+    windows = np.lib.stride_tricks.sliding_window_view(features, SPECTOGRAM_ROW, axis=0)
+    windows = np.ascontiguousarray(np.swapaxes(windows, 1, 2))
+    clips = quantize(windows, input_details)
+    scores = np.concatenate([run_batch(interpreter, clips[i:i + batch])
+                             for i in range(0, len(clips), batch)])
+    times = (np.arange(len(clips)) + SPECTOGRAM_ROW) * STRIDE_MS
+    return scores, times
+
+
+def read_annotations(csv_path):
+    with open(csv_path) as annotations:
+        return [(float(row[0]), float(row[1]), row[2].strip())
+                for row in csv.reader(annotations) if row and not row[0].startswith('#')]
+
+
+def load_recordings(args):
+    """ {name: (scores, times, scale, zero_point, annotations, duration_s)} """
+    cached = {}
+    if args.cache and os.path.exists(args.cache):
+        with np.load(args.cache, allow_pickle=True) as cache:
+            cached = cache['recordings'].item()
+
+    interpreter = None
+    recordings = {}
+    for wav_path in sorted(glob.glob(os.path.join(args.recordings, '*.wav'))):
+        name = os.path.splitext(os.path.basename(wav_path))[0]
+        annotations = read_annotations(os.path.splitext(wav_path)[0] + '.csv')
+        if name not in cached:
+            if interpreter is None:
+                interpreter = make_interpreter(args.model, args.batch, True)
+            features = spectrogram(wav_path)
+            scores, times = model_scores(interpreter, features, args.batch)
+            scale, zero_point = interpreter.get_output_details()[0]['quantization']
+            cached[name] = (scores, times, scale, zero_point, len(features) * STRIDE_MS / 1000.0)
+            print('%s : %d strides' % (name, len(scores)))
+        scores, times, scale, zero_point, duration_s = cached[name]
+        recordings[name] = (scores, times, scale, zero_point, annotations, duration_s)
+
+    if args.cache:
+        np.savez(args.cache, recordings=np.array(cached, dtype=object))
+    return recordings
+
+
+def c_divide(numerator, denominator):
+    """ The integer division of C, towards zero """
+    quotient = abs(numerator) // abs(denominator)
+    return quotient if (numerator < 0) == (denominator < 0) else -quotient
+
+
+class Quantization:
+    """ The scores (probability x 256) in Q16 of the outputs minus their zero
+        point, like SetOutputQuantization() """
+
+    def __init__(self, scale):
+        self.q16_per_score_q8 = int(math.floor(65536.0 / scale + 0.5))
+
+    def to_q16(self, score):
+        return min((score * self.q16_per_score_q8 + 255) >> 8, 2 ** 31 - 1)
+
+
+def averaged_results(scores, times, zero_point, window_ms, minimum_count):
+    """ What doesn't depend on the thresholds : the Q16 average of every stride
+        (None when there are too few results), like ProcessLatestScores() """
+    latest = scores.astype(np.int32) - zero_point
+    queue = collections.deque()
+    averages = []
+    for time_ms, result in zip(times.tolist(), latest.tolist()):
+        if len(queue) < MAX_RESULTS:
+            queue.append((time_ms, result))
+        while queue and queue[0][0] < time_ms - window_ms:
+            queue.popleft()
+        if len(queue) < minimum_count or time_ms - queue[0][0] < window_ms // 4:
+            averages.append(None)
+            continue
+        sums = [sum(column) for column in zip(*(result for _, result in queue))]
+        averages.append([c_divide(total * 65536, len(queue)) for total in sums])
+    return averages
+
+
+def detections(averages, times, background, quantization, threshold, release, suppression_ms,
+               shift, margin_q4, max_threshold):
+    """ (time_ms, label) of the new commands, the integer decision of
+        recognize_commands.cc with every keyword at the same config """
+    label_count = len(background)
+    threshold_q16 = quantization.to_q16(threshold)
+    release_q16 = quantization.to_q16(release)
+    max_threshold_q16 = quantization.to_q16(max_threshold)
+    active = [False] * label_count
+    last_time = [None] * label_count
+    mean_q16 = [0] * label_count
+    deviation_q16 = [0] * label_count
+    background_seen = False
+    found = []
+    for time_ms, average in zip(times, averages):
+        if average is None:
+            continue
+        top = 0
+        top_score = average[0]
+        for label in range(1, label_count):
+            if average[label] > top_score:
+                top, top_score = label, average[label]
+
+        if shift > 0 and background[top]:
+            for label in range(label_count):
+                if background[label]:
+                    continue
+                if not background_seen:
+                    mean_q16[label], deviation_q16[label] = average[label], 0
+                    continue
+                mean_q16[label] += (average[label] - mean_q16[label]) >> shift
+                deviation_q16[label] += (abs(average[label] - mean_q16[label]) - deviation_q16[label]) >> shift
+            background_seen = True
+
+        for label in range(label_count):
+            if active[label] and average[label] < release_q16:
+                active[label] = False
+
+        effective = threshold_q16
+        if shift > 0 and background_seen:
+            adaptive = mean_q16[top] + ((margin_q4 * deviation_q16[top]) >> 4)
+            effective = max(threshold_q16, min(adaptive, max_threshold_q16))
+        suppressed = last_time[top] is not None and time_ms - last_time[top] <= suppression_ms
+        if not background[top] and not active[top] and top_score >= effective and not suppressed:
+            active[top] = True
+            last_time[top] = time_ms
+            found.append((time_ms, top))
+    return found
+
+
+def score_detections(found, annotations, labels, tolerance_ms):
+    """ {label: [true positives, false alarms, keywords]} """
+    counts = {label: [0, 0, 0] for label in labels}
+    for _, _, label in annotations:
+        if label in counts:
+            counts[label][2] += 1
+    hit = set()
+    for time_ms, index in found:
+        label = labels[index]
+        match = None
+        for number, (start_s, end_s, annotation_label) in enumerate(annotations):
+            if annotation_label == label and start_s * 1000 <= time_ms <= end_s * 1000 + tolerance_ms:
+                match = number
+                break
+        if match is None or match in hit:
+            counts[label][1] += 1
+        else:
+            hit.add(match)
+            counts[label][0] += 1
+    return counts
+
+
+def parse_range(text, cast=int):
+    """ 'a,b,c' or 'start:stop:step' (stop included) """
+    if ':' in text:
+        start, stop, step = (cast(value) for value in text.split(':'))
+        return list(range(start, stop + 1, step))
+    return [cast(value) for value in text.split(',')]
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('model', help='converted_model.tflite (not the fused one)')
+    parser.add_argument('recordings', help='folder of .wav with their .csv annotations')
+    parser.add_argument('--cache', help='.npz of the int8 scores, made if it does not exist')
+    parser.add_argument('--batch', type=int, default=64)
+    parser.add_argument('--window-ms', type=int, default=800)
+    parser.add_argument('--minimum-count', type=int, default=3)
+    parser.add_argument('--suppression-ms', type=int, default=1500)
+    parser.add_argument('--thresholds', default='120:250:10')
+    parser.add_argument('--releases', default='60,100')
+    parser.add_argument('--shifts', default='0,5')
+    parser.add_argument('--margins', default='32,48')
+    parser.add_argument('--max-threshold', type=int, default=245)
+    parser.add_argument('--tolerance-ms', type=int, default=1000)
+    parser.add_argument('--max-fa-per-hour', type=float, default=1.0,
+                        help='the best recall under this rate is printed for every keyword')
+    parser.add_argument('--out', default='sweep.csv')
+    args = parser.parse_args()
+
+    labels = LABELS
+    background = [label in BACKGROUND_LABELS for label in labels]
+    recordings = load_recordings(args)
+    if not recordings:
+        raise SystemExit('No .wav in ' + args.recordings)
+    hours = sum(recording[5] for recording in recordings.values()) / 3600.0
+    averaged = {name: averaged_results(scores, times, zero_point, args.window_ms, args.minimum_count)
+                for name, (scores, times, _, zero_point, _, _) in recordings.items()}
+
+    rows = []
+    for shift in parse_range(args.shifts):
+        # The margin does nothing without the adaptation
+        for margin_q4 in (parse_range(args.margins) if shift > 0 else [0]):
+            for threshold in parse_range(args.thresholds):
+                for release in parse_range(args.releases):
+                    if release > threshold:
+                        continue
+                    totals = {label: [0, 0, 0] for label in labels}
+                    for name, (_, times, scale, _, annotations, _) in recordings.items():
+                        found = detections(averaged[name], times.tolist(), background, Quantization(scale),
+                                           threshold, release, args.suppression_ms, shift, margin_q4,
+                                           args.max_threshold)
+                        for label, counts in score_detections(found, annotations, labels,
+                                                              args.tolerance_ms).items():
+                            totals[label] = [a + b for a, b in zip(totals[label], counts)]
+                    for label, (true_positives, false_alarms, keywords) in totals.items():
+                        if background[labels.index(label)]:
+                            continue
+                        detected = true_positives + false_alarms
+                        rows.append({'label': label, 'threshold': threshold, 'release': release,
+                                     'shift': shift, 'margin_q4': margin_q4,
+                                     'keywords': keywords, 'true_positives': true_positives,
+                                     'false_alarms': false_alarms,
+                                     'precision': true_positives / detected if detected else 1.0,
+                                     'recall': true_positives / keywords if keywords else 0.0,
+                                     'false_alarms_per_hour': false_alarms / hours})
+
+    with open(args.out, 'w', newline='') as out:
+        writer = csv.DictWriter(out, fieldnames=list(rows[0].keys()))
+        writer.writeheader()
+        writer.writerows(rows)
+    print('%d configs over %.2f h of audio written to %s' % (len(rows), hours, args.out))
+
+    for label in labels:
+        candidates = [row for row in rows if row['label'] == label
+                      and row['false_alarms_per_hour'] <= args.max_fa_per_hour]
+        if not candidates:
+            continue
+        best = max(candidates, key=lambda row: (row['recall'], -row['false_alarms_per_hour'], row['threshold']))
+        print('%-8s threshold %3d release %3d shift %d margin %2d : recall %.3f precision %.3f %.2f FA/h'
+              % (label, best['threshold'], best['release'], best['shift'], best['margin_q4'],
+                 best['recall'], best['precision'], best['false_alarms_per_hour']))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,191 @@
+/*
+ *  command_dispatch_stress.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+/* Host stress check of the command ring (main/KWS/command_dispatch.h) : in
+   every round one producer thread posts events as fast as it can, one
+   consumer thread takes them out with command_dispatch_run(), and while they
+   run kAdders threads add handlers at the same time until there is no room.
+   The consumer must get every posted event once and in order, posted plus
+   dropped must be the events of the producer, and every handler which was
+   added must have its own slot : after the adders, one more event has to
+   reach all of them.
+
+   From KWS_wth_ESP32_SPH0645 (add -fsanitize=thread to check the ordering) :
+     g++ -O2 -std=c++17 -pthread -Imain/KWS host_checks/command_dispatch_stress.cc \
+         main/KWS/command_dispatch.cc -o command_dispatch_stress
+     ./command_dispatch_stress */
+
+#include <stdio.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "command_dispatch.h"
+
+namespace {
+
+constexpr int kRounds = 200;
+constexpr int kEventsPerRound = 20000;
+constexpr int kAdders = 4;
+constexpr int kMaxPrinted = 10;
+
+/* Context of the handler which checks the events, only used by the consumer */
+typedef struct
+{
+  int32_t last_time_ms;
+  long received;
+  long errors;
+} order_check_t;
+
+/* Context of a handler added by an adder thread */
+typedef struct
+{
+  int32_t last_time_ms;
+  long calls;
+  long errors;
+} added_handler_t;
+
+long g_failures = 0;
+long g_handled = 0;
+long g_dropped = 0;
+
+int64_t HostClockUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void Fail(const char* message, int round, long value) {
+  if (g_failures++ < kMaxPrinted) {
+    printf("Round %d : %s (%ld)\n", round, message, value);
+  }
+}
+
+/* The producer posts time_ms = its index, label and score follow from it */
+void CheckOrder(const command_event_t* event, void* context) {
+  order_check_t* check = static_cast<order_check_t*>(context);
+  if ((event->time_ms <= check->last_time_ms) || (event->label != event->time_ms % COMMAND_DISPATCH_MAX_LABELS) ||
+      (event->score != static_cast<uint8_t>(event->time_ms)) || (event->model_id != 1)) {
+    check->errors++;
+  }
+  check->last_time_ms = event->time_ms;
+  check->received++;
+}
+
+void CountCalls(const command_event_t* event, void* context) {
+  added_handler_t* added = static_cast<added_handler_t*>(context);
+  if (event->time_ms <= added->last_time_ms) {
+    added->errors++;
+  }
+  added->last_time_ms = event->time_ms;
+  added->calls++;
+}
+
+void RunRound(int round) {
+  command_dispatch_init(HostClockUs);
+  order_check_t check = {-1, 0, 0};
+  command_dispatch_add_handler(COMMAND_DISPATCH_ALL_LABELS, CheckOrder, &check);
+
+  /* One context per slot the adders could get */
+  std::vector<added_handler_t> contexts(kAdders * COMMAND_DISPATCH_MAX_HANDLERS, added_handler_t{-1, 0, 0});
+  /* Per adder, a shared counter would order the adders */
+  int added_by[kAdders] = {};
+  std::atomic<bool> start{false};
+  std::atomic<bool> producer_done{false};
+  long dropped = 0;
+
+  std::thread consumer([&] {
+    while (!producer_done.load(std::memory_order_acquire) || (command_dispatch_pending() != 0)) {
+      if (command_dispatch_run(4) == 0) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  std::thread producer([&] {
+    while (!start.load(std::memory_order_acquire)) {
+    }
+    for (int i = 0; i < kEventsPerRound; ++i) {
+      /* A full ring gives the consumer some time, the events still have to
+         go through it on a single core host */
+      if (!command_dispatch_post(i, i % COMMAND_DISPATCH_MAX_LABELS, 1, static_cast<uint8_t>(i))) {
+        dropped++;
+        std::this_thread::yield();
+      }
+    }
+  });
+  std::vector<std::thread> adders;
+  for (int a = 0; a < kAdders; ++a) {
+    adders.emplace_back([&, a] {
+      while (!start.load(std::memory_order_acquire)) {
+      }
+      for (int i = 0; i < COMMAND_DISPATCH_MAX_HANDLERS; ++i) {
+        if (!command_dispatch_add_handler(COMMAND_DISPATCH_ALL_LABELS, CountCalls,
+                                          &contexts[a * COMMAND_DISPATCH_MAX_HANDLERS + i])) {
+          break;
+        }
+        added_by[a]++;
+        std::this_thread::yield();
+      }
+    });
+  }
+  start.store(true, std::memory_order_release);
+  for (std::thread& adder : adders) {
+    adder.join();
+  }
+  producer.join();
+  int added = 0;
+  for (const int count : added_by) {
+    added += count;
+  }
+
+  /* Every added handler is ready now : one more event for all of them */
+  while (command_dispatch_pending() != 0) {
+    std::this_thread::yield();
+  }
+  command_dispatch_post(kEventsPerRound, kEventsPerRound % COMMAND_DISPATCH_MAX_LABELS, 1,
+                        static_cast<uint8_t>(kEventsPerRound));
+  producer_done.store(true, std::memory_order_release);
+  consumer.join();
+
+  const command_dispatch_stats_t* stats = command_dispatch_get_stats();
+  if (added != COMMAND_DISPATCH_MAX_HANDLERS - 1) {
+    Fail("handlers added", round, added);
+  }
+  if ((check.errors != 0) || (check.last_time_ms != kEventsPerRound)) {
+    Fail("events out of order", round, check.errors);
+  }
+  if ((stats->posted + dropped != kEventsPerRound + 1) || (stats->dropped != dropped) ||
+      (stats->handled != stats->posted) || (check.received != static_cast<long>(stats->posted))) {
+    Fail("events lost or repeated", round, check.received);
+  }
+  g_handled += stats->handled;
+  g_dropped += stats->dropped;
+  int reached = 0;
+  for (const added_handler_t& context : contexts) {
+    if (context.errors != 0) {
+      Fail("handler called out of order", round, context.errors);
+    }
+    reached += (context.last_time_ms == kEventsPerRound);
+  }
+  if (reached != added) {
+    Fail("added handlers not called", round, reached);
+  }
+}
+
+}  // namespace
+
+int main() {
+  for (int round = 0; round < kRounds; ++round) {
+    RunRound(round);
+  }
+  printf("%d rounds of %d events, %d adders : %ld events handled, %ld dropped, %ld failures\n", kRounds,
+         kEventsPerRound, kAdders, g_handled, g_dropped, g_failures);
+  const bool pass = (g_failures == 0);
+  printf("%s\n", pass ? "PASS" : "FAIL");
+  return pass ? 0 : 1;
+}
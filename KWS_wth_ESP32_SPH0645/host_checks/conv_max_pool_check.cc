@@ -0,0 +1,432 @@
+/*
+ *  conv_max_pool_check.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+/* Host check and benchmark of the fused KwsConvMaxPool2D kernel
+   (main/KWS/kernels/conv_max_pool.h) against CONV_2D followed by MAX_POOL_2D :
+   - kLayers random int8 and 16x8 layers (SAME and VALID padding, strides 1
+     and 2, filters up to 5x5, overlapping and skipping pools), run with the
+     kernel runner. The fused output must be bit-exact.
+   - An int16 layer with a non zero input or output zero point must fail Prepare.
+   - g_model, fused like KWS_model/fuse_conv_max_pool.py does, against the
+     bundled unfused g_model on kClips variants of the yes clip : the outputs
+     must be bit-exact. It prints the arena of both models and their time per
+     invoke (best of kRepeats).
+
+   From KWS_wth_ESP32_SPH0645, with TFLM=managed_components/espressif__esp-tflite-micro,
+   ESPNN=managed_components/espressif__esp-nn, a host build of TFLM
+   (libtensorflow-microlite.a) and of the C versions of esp-nn, which the
+   CONV_2D of TFLM also uses with -DESP_NN (libesp-nn-ansi.a, from the
+   *_ansi.c files of $ESPNN/src) :
+     g++ -O2 -std=c++17 -DTF_LITE_STATIC_MEMORY -Imain/KWS -I$TFLM -I$ESPNN/include \
+         -I$TFLM/third_party/flatbuffers/include -I$TFLM/third_party/gemmlowp \
+         host_checks/conv_max_pool_check.cc main/KWS/kernels/conv_max_pool.cc \
+         main/KWS/keyword_spotting_model.cc main/KWS/other/yes_micro_features_data.cc \
+         libtensorflow-microlite.a libesp-nn-ansi.a -o conv_max_pool_check
+     ./conv_max_pool_check */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "flatbuffers/flexbuffers.h"
+#include "keyword_spotting_model.h"
+#include "kernels/conv_fc_16x8.h"
+#include "kernels/conv_max_pool.h"
+#include "other/yes_micro_features_data.h"
+#include "tensorflow/lite/micro/kernels/kernel_runner.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/micro/test_helpers.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace {
+
+constexpr int kLayers = 400;
+constexpr int kClips = 300;
+constexpr int kRepeats = 30;
+constexpr size_t kArenaSize = 64 * 1024;
+constexpr size_t kModelBufferSize = 128 * 1024;
+
+struct Layer {
+  int height;
+  int width;
+  int input_depth;
+  int output_depth;
+  int filter_height;
+  int filter_width;
+  TfLiteConvParams conv;
+  TfLitePoolParams pool;
+};
+
+/* Shape, data and quantization of one tensor of the kernel runner */
+template <typename T>
+struct TensorStorage {
+  std::vector<T> data;
+  int dims[5];
+  std::vector<float> scales;
+  std::vector<int> zero_points;
+  TfLiteAffineQuantization quantization;
+
+  TfLiteTensor Create(std::initializer_list<int> shape, TfLiteType type, std::vector<float> channel_scales,
+                      int zero_point) {
+    dims[0] = static_cast<int>(shape.size());
+    int size = 1;
+    int i = 1;
+    for (const int dim : shape) {
+      dims[i++] = dim;
+      size *= dim;
+    }
+    data.resize(size);
+    /* Stored as TfLiteFloatArray and TfLiteIntArray : the size, then the values */
+    scales.assign(1, 0.0f);
+    reinterpret_cast<int*>(scales.data())[0] = static_cast<int>(channel_scales.size());
+    scales.insert(scales.end(), channel_scales.begin(), channel_scales.end());
+    zero_points.assign(channel_scales.size() + 1, zero_point);
+    zero_points[0] = static_cast<int>(channel_scales.size());
+    quantization = {reinterpret_cast<TfLiteFloatArray*>(scales.data()),
+                    reinterpret_cast<TfLiteIntArray*>(zero_points.data()), 0};
+
+    TfLiteTensor tensor = {};
+    tensor.type = type;
+    tensor.data.raw = reinterpret_cast<char*>(data.data());
+    tensor.dims = tflite::testing::IntArrayFromInts(dims);
+    tensor.bytes = size * sizeof(T);
+    tensor.params = {channel_scales[0], zero_point};
+    tensor.quantization = {kTfLiteAffineQuantization, &quantization};
+    tensor.allocation_type = kTfLiteMemNone;
+    return tensor;
+  }
+};
+
+std::vector<uint8_t> FusedOptions(const TfLiteConvParams& conv, const TfLitePoolParams& pool) {
+  /* The kernel reads the keys by index, flexbuffers sorts them by name. The
+     padding is the schema enum : SAME 0 , VALID 1 */
+  flexbuffers::Builder fbb;
+  fbb.Map([&]() {
+    fbb.Int("activation", conv.activation);
+    fbb.Int("padding", (conv.padding == kTfLitePaddingSame) ? 0 : 1);
+    fbb.Int("pool_activation", pool.activation);
+    fbb.Int("pool_filter_height", pool.filter_height);
+    fbb.Int("pool_filter_width", pool.filter_width);
+    fbb.Int("pool_stride_height", pool.stride_height);
+    fbb.Int("pool_stride_width", pool.stride_width);
+    fbb.Int("stride_height", conv.stride_height);
+    fbb.Int("stride_width", conv.stride_width);
+  });
+  fbb.Finish();
+  return fbb.GetBuffer();
+}
+
+int ConvOutputSize(TfLitePadding padding, int size, int filter, int stride) {
+  return (padding == kTfLitePaddingSame) ? (size + stride - 1) / stride : (size - filter) / stride + 1;
+}
+
+/* The kernel runners share one arena, so they run one after the other */
+TfLiteStatus RunKernel(const TFLMRegistration& registration, TfLiteTensor* tensors, int* inputs, int* outputs,
+                       void* builtin_data, const std::vector<uint8_t>* options) {
+  tflite::micro::KernelRunner runner(registration, tensors, 6, tflite::testing::IntArrayFromInts(inputs),
+                                     tflite::testing::IntArrayFromInts(outputs), builtin_data);
+  const char* init_data = (options != nullptr) ? reinterpret_cast<const char*>(options->data()) : nullptr;
+  TF_LITE_ENSURE_STATUS(runner.InitAndPrepare(init_data, (options != nullptr) ? options->size() : 0));
+  return runner.Invoke();
+}
+
+/* Runs the layer unfused and fused, returns the outputs which differ, or -1
+   when a kernel fails */
+template <typename ActivationType, typename BiasType>
+int RunLayer(const Layer& layer, std::mt19937& rng, int input_zero_point, int output_zero_point) {
+  constexpr bool kInt16 = sizeof(ActivationType) == 2;
+  const TfLiteType activation_type = kInt16 ? kTfLiteInt16 : kTfLiteInt8;
+  const int conv_height =
+      ConvOutputSize(layer.conv.padding, layer.height, layer.filter_height, layer.conv.stride_height);
+  const int conv_width = ConvOutputSize(layer.conv.padding, layer.width, layer.filter_width, layer.conv.stride_width);
+  const int pooled_height = (conv_height - layer.pool.filter_height) / layer.pool.stride_height + 1;
+  const int pooled_width = (conv_width - layer.pool.filter_width) / layer.pool.stride_width + 1;
+
+  const float input_scale = kInt16 ? 0.0005f : 0.05f;
+  const float output_scale = kInt16 ? 0.002f : 0.2f;
+  std::vector<float> filter_scales(layer.output_depth);
+  std::vector<float> bias_scales(layer.output_depth);
+  for (int c = 0; c < layer.output_depth; ++c) {
+    filter_scales[c] = 0.002f * (1 + c % 5);
+    bias_scales[c] = input_scale * filter_scales[c];
+  }
+
+  TensorStorage<ActivationType> input;
+  TensorStorage<int8_t> filter;
+  TensorStorage<BiasType> bias;
+  TensorStorage<ActivationType> conv_output;
+  TensorStorage<ActivationType> pooled;
+  TensorStorage<ActivationType> fused;
+  TfLiteTensor tensors[6] = {
+      input.Create({1, layer.height, layer.width, layer.input_depth}, activation_type, {input_scale},
+                   input_zero_point),
+      filter.Create({layer.output_depth, layer.filter_height, layer.filter_width, layer.input_depth}, kTfLiteInt8,
+                    filter_scales, 0),
+      bias.Create({layer.output_depth}, kInt16 ? kTfLiteInt64 : kTfLiteInt32, bias_scales, 0),
+      conv_output.Create({1, conv_height, conv_width, layer.output_depth}, activation_type, {output_scale},
+                         output_zero_point),
+      pooled.Create({1, pooled_height, pooled_width, layer.output_depth}, activation_type, {output_scale},
+                    output_zero_point),
+      fused.Create({1, pooled_height, pooled_width, layer.output_depth}, activation_type, {output_scale},
+                   output_zero_point),
+  };
+  for (ActivationType& value : input.data) {
+    value = static_cast<ActivationType>(rng());
+  }
+  for (int8_t& value : filter.data) {
+    value = static_cast<int8_t>(static_cast<int>(rng() % 255) - 127);
+  }
+  for (BiasType& value : bias.data) {
+    value = static_cast<BiasType>(static_cast<int>(rng() % 40001) - 20000);
+  }
+
+  int conv_inputs[] = {3, 0, 1, 2};
+  int conv_outputs[] = {1, 3};
+  int pool_inputs[] = {1, 3};
+  int pool_outputs[] = {1, 4};
+  int fused_outputs[] = {1, 5};
+  TfLiteConvParams conv_params = layer.conv;
+  TfLitePoolParams pool_params = layer.pool;
+  const std::vector<uint8_t> options = FusedOptions(layer.conv, layer.pool);
+  if ((RunKernel(*tflite::Register_KWS_CONV_MAX_POOL_2D(), tensors, conv_inputs, fused_outputs, nullptr, &options) !=
+       kTfLiteOk) ||
+      (RunKernel(tflite::Register_CONV_2D(), tensors, conv_inputs, conv_outputs, &conv_params, nullptr) != kTfLiteOk) ||
+      (RunKernel(tflite::Register_MAX_POOL_2D(), tensors, pool_inputs, pool_outputs, &pool_params, nullptr) !=
+       kTfLiteOk)) {
+    return -1;
+  }
+  int mismatches = 0;
+  for (size_t i = 0; i < pooled.data.size(); ++i) {
+    mismatches += (pooled.data[i] != fused.data[i]);
+  }
+  return mismatches;
+}
+
+Layer RandomLayer(std::mt19937& rng) {
+  for (;;) {
+    Layer layer = {};
+    layer.height = 3 + rng() % 28;
+    layer.width = 3 + rng() % 28;
+    layer.input_depth = 1 + rng() % 8;
+    layer.output_depth = 1 + rng() % 16;
+    layer.filter_height = 1 + rng() % 5;
+    layer.filter_width = 1 + rng() % 5;
+    layer.conv.padding = (rng() & 1) ? kTfLitePaddingSame : kTfLitePaddingValid;
+    layer.conv.stride_height = 1 + rng() % 2;
+    layer.conv.stride_width = 1 + rng() % 2;
+    layer.conv.dilation_height_factor = 1;
+    layer.conv.dilation_width_factor = 1;
+    const TfLiteFusedActivation activations[] = {kTfLiteActNone, kTfLiteActRelu, kTfLiteActRelu6};
+    layer.conv.activation = activations[rng() % 3];
+    layer.pool.padding = kTfLitePaddingValid;
+    layer.pool.filter_height = 1 + rng() % 3;
+    layer.pool.filter_width = 1 + rng() % 3;
+    layer.pool.stride_height = 1 + rng() % 3;
+    layer.pool.stride_width = 1 + rng() % 3;
+    layer.pool.activation = kTfLiteActNone;
+    const int conv_height =
+        ConvOutputSize(layer.conv.padding, layer.height, layer.filter_height, layer.conv.stride_height);
+    const int conv_width =
+        ConvOutputSize(layer.conv.padding, layer.width, layer.filter_width, layer.conv.stride_width);
+    const bool fits = (layer.conv.padding == kTfLitePaddingSame) ||
+                      ((layer.height >= layer.filter_height) && (layer.width >= layer.filter_width));
+    if (fits && (conv_height >= layer.pool.filter_height) && (conv_width >= layer.pool.filter_width)) {
+      return layer;
+    }
+  }
+}
+
+/* g_model with every CONV_2D -> MAX_POOL_2D pair replaced by the fused
+   operator, and the conv output tensors removed, like fuse_conv_max_pool.py */
+size_t FuseModel(const uint8_t* model_data, uint8_t* buffer, size_t buffer_size, int* fused_count) {
+  std::unique_ptr<tflite::ModelT> model(tflite::GetModel(model_data)->UnPack());
+  auto code = std::make_unique<tflite::OperatorCodeT>();
+  code->builtin_code = tflite::BuiltinOperator_CUSTOM;
+  code->deprecated_builtin_code = tflite::BuiltinOperator_CUSTOM;
+  code->custom_code = tflite::kKwsConvMaxPool2DOpName;
+  code->version = 1;
+  const uint32_t custom_index = model->operator_codes.size();
+  model->operator_codes.push_back(std::move(code));
+
+  tflite::SubGraphT& subgraph = *model->subgraphs[0];
+  auto builtin = [&](const tflite::OperatorT& op) { return model->operator_codes[op.opcode_index]->builtin_code; };
+  *fused_count = 0;
+  std::vector<std::unique_ptr<tflite::OperatorT>> operators;
+  std::vector<int> removed;
+  for (size_t i = 0; i < subgraph.operators.size(); ++i) {
+    tflite::OperatorT& op = *subgraph.operators[i];
+    if ((i + 1 < subgraph.operators.size()) && (builtin(op) == tflite::BuiltinOperator_CONV_2D) &&
+        (builtin(*subgraph.operators[i + 1]) == tflite::BuiltinOperator_MAX_POOL_2D) &&
+        (subgraph.operators[i + 1]->inputs[0] == op.outputs[0])) {
+      tflite::OperatorT& pool_op = *subgraph.operators[i + 1];
+      const tflite::Conv2DOptionsT& conv_options = *op.builtin_options.AsConv2DOptions();
+      const tflite::Pool2DOptionsT& pool_options = *pool_op.builtin_options.AsPool2DOptions();
+      TfLiteConvParams conv = {};
+      conv.padding = (conv_options.padding == tflite::Padding_SAME) ? kTfLitePaddingSame : kTfLitePaddingValid;
+      conv.stride_height = conv_options.stride_h;
+      conv.stride_width = conv_options.stride_w;
+      conv.activation = static_cast<TfLiteFusedActivation>(conv_options.fused_activation_function);
+      TfLitePoolParams pool = {};
+      pool.filter_height = pool_options.filter_height;
+      pool.filter_width = pool_options.filter_width;
+      pool.stride_height = pool_options.stride_h;
+      pool.stride_width = pool_options.stride_w;
+      pool.activation = static_cast<TfLiteFusedActivation>(pool_options.fused_activation_function);
+
+      auto fused = std::make_unique<tflite::OperatorT>();
+      fused->opcode_index = custom_index;
+      fused->inputs = op.inputs;
+      fused->outputs = pool_op.outputs;
+      fused->custom_options = FusedOptions(conv, pool);
+      fused->custom_options_format = tflite::CustomOptionsFormat_FLEXBUFFERS;
+      removed.push_back(op.outputs[0]);
+      operators.push_back(std::move(fused));
+      ++*fused_count;
+      ++i;
+    } else {
+      operators.push_back(std::move(subgraph.operators[i]));
+    }
+  }
+  subgraph.operators = std::move(operators);
+
+  /* Remove the conv outputs, from the last one so the indices stay valid */
+  std::sort(removed.rbegin(), removed.rend());
+  for (const int tensor : removed) {
+    subgraph.tensors.erase(subgraph.tensors.begin() + tensor);
+    auto remap = [tensor](std::vector<int32_t>& indices) {
+      for (int32_t& index : indices) {
+        index -= (index > tensor);
+      }
+    };
+    for (auto& op : subgraph.operators) {
+      remap(op->inputs);
+      remap(op->outputs);
+    }
+    remap(subgraph.inputs);
+    remap(subgraph.outputs);
+  }
+
+  flatbuffers::DefaultAllocator allocator;
+  flatbuffers::FlatBufferBuilder builder(1024, &allocator);
+  tflite::FinishModelBuffer(builder, tflite::Model::Pack(builder, model.get()));
+  if (builder.GetSize() > buffer_size) {
+    return 0;
+  }
+  memcpy(buffer, builder.GetBufferPointer(), builder.GetSize());
+  return builder.GetSize();
+}
+
+using ModelOpResolver = tflite::MicroMutableOpResolver<6>;
+
+TfLiteStatus RegisterOps(ModelOpResolver& op_resolver) {
+  TF_LITE_ENSURE_STATUS(op_resolver.AddConv2D());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddMaxPool2D());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddReshape());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddFullyConnected());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddSoftmax());
+  return op_resolver.AddCustom(tflite::kKwsConvMaxPool2DOpName, tflite::Register_KWS_CONV_MAX_POOL_2D());
+}
+
+/* Mean time of one invoke over the clips */
+double InvokeMicroseconds(tflite::MicroInterpreter& interpreter, const std::vector<int8_t>& clips, int clip_size) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int clip = 0; clip < kClips; ++clip) {
+    memcpy(interpreter.input(0)->data.int8, &clips[clip * clip_size], clip_size);
+    interpreter.Invoke();
+  }
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kClips;
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(26);
+  long layer_mismatches = 0;
+  int layer_failures = 0;
+  for (int i = 0; i < kLayers; ++i) {
+    const Layer layer = RandomLayer(rng);
+    const int int8_result = RunLayer<int8_t, int32_t>(layer, rng, static_cast<int>(rng() % 256) - 128,
+                                                      static_cast<int>(rng() % 256) - 128);
+    const int int16_result =
+        (layer.filter_height * layer.filter_width * layer.input_depth <= tflite::kKws16x8MaxTaps)
+            ? RunLayer<int16_t, int64_t>(layer, rng, 0, 0)
+            : 0;
+    layer_failures += (int8_result < 0) + (int16_result < 0);
+    layer_mismatches += std::max(int8_result, 0) + std::max(int16_result, 0);
+  }
+  printf("Layers : %d random int8 and 16x8 layers, %ld outputs differ, %d kernel failures\n", kLayers,
+         layer_mismatches, layer_failures);
+
+  const Layer layer = RandomLayer(rng);
+  const bool input_rejected = (RunLayer<int16_t, int64_t>(layer, rng, 3, 0) < 0);
+  const bool output_rejected = (RunLayer<int16_t, int64_t>(layer, rng, 0, 3) < 0);
+  printf("16x8 layer with a zero point : input %s, output %s\n", input_rejected ? "rejected" : "accepted",
+         output_rejected ? "rejected" : "accepted");
+
+  alignas(16) static uint8_t fused_model[kModelBufferSize];
+  int fused_count = 0;
+  if (FuseModel(g_model, fused_model, kModelBufferSize, &fused_count) == 0) {
+    fprintf(stderr, "The fused model doesn't fit\n");
+    return 1;
+  }
+  static ModelOpResolver op_resolver;
+  if (RegisterOps(op_resolver) != kTfLiteOk) {
+    return 1;
+  }
+  alignas(16) static uint8_t unfused_arena[kArenaSize];
+  alignas(16) static uint8_t fused_arena[kArenaSize];
+  tflite::MicroInterpreter unfused(tflite::GetModel(g_model), op_resolver, unfused_arena, kArenaSize);
+  tflite::MicroInterpreter fused(tflite::GetModel(fused_model), op_resolver, fused_arena, kArenaSize);
+  if ((unfused.AllocateTensors() != kTfLiteOk) || (fused.AllocateTensors() != kTfLiteOk)) {
+    fprintf(stderr, "AllocateTensors() failed\n");
+    return 1;
+  }
+
+  /* Variants of the yes clip : noise and a level offset on its features */
+  const int clip_size = g_yes_micro_f2e59fea_nohash_1_width * g_yes_micro_f2e59fea_nohash_1_height;
+  std::vector<int8_t> clips(kClips * clip_size);
+  for (int clip = 0; clip < kClips; ++clip) {
+    const int noise = clip % 40;
+    const int offset = (clip % 7) * 8 - 24;
+    for (int i = 0; i < clip_size; ++i) {
+      const int value = g_yes_micro_f2e59fea_nohash_1_data[i] + offset +
+                        ((noise > 0) ? static_cast<int>(rng() % (2 * noise + 1)) - noise : 0);
+      clips[clip * clip_size + i] = static_cast<int8_t>(std::max(-128, std::min(127, value)));
+    }
+  }
+  long model_mismatches = 0;
+  for (int clip = 0; clip < kClips; ++clip) {
+    memcpy(unfused.input(0)->data.int8, &clips[clip * clip_size], clip_size);
+    memcpy(fused.input(0)->data.int8, &clips[clip * clip_size], clip_size);
+    if ((unfused.Invoke() != kTfLiteOk) || (fused.Invoke() != kTfLiteOk)) {
+      fprintf(stderr, "Invoke() failed\n");
+      return 1;
+    }
+    model_mismatches += (memcmp(unfused.output(0)->data.raw, fused.output(0)->data.raw, unfused.output(0)->bytes) != 0);
+  }
+  printf("g_model (%d pairs fused) : %d clips, %ld with different outputs\n", fused_count, kClips, model_mismatches);
+  printf("Arena : unfused %zu bytes, fused %zu bytes\n", unfused.arena_used_bytes(), fused.arena_used_bytes());
+  /* Both models in every repeat, so they see the same load of the host */
+  double unfused_us = 1e30;
+  double fused_us = 1e30;
+  for (int repeat = 0; repeat < kRepeats; ++repeat) {
+    unfused_us = std::min(unfused_us, InvokeMicroseconds(unfused, clips, clip_size));
+    fused_us = std::min(fused_us, InvokeMicroseconds(fused, clips, clip_size));
+  }
+  printf("Invoke : unfused %.0f us, fused %.0f us (best of %d)\n", unfused_us, fused_us, kRepeats);
+
+  const bool pass = (layer_mismatches == 0) && (layer_failures == 0) && input_rejected && output_rejected &&
+                    (fused_count > 0) && (model_mismatches == 0);
+  printf("%s\n", pass ? "PASS" : "FAIL");
+  return pass ? 0 : 1;
+}
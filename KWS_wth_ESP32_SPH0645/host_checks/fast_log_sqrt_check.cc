@@ -0,0 +1,124 @@
+/*
+ *  fast_log_sqrt_check.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+/* Exhaustive host check of KwsSqrt32 and KwsLog32 (main/KWS/kernels/fast_log_sqrt.h)
+   against tflm_signal::Sqrt32 and tflm_signal::Log32 : every one of the 2^32
+   inputs must give the same result, the log with the output scales of
+   kLogScales. KwsSqrt64 is checked against tflm_signal::Sqrt64 on random inputs
+   of every magnitude, on inputs near the squares and near the half points
+   between them, and on the edges of the 64 bits range. The 2^32 inputs are
+   split between the threads of the host, it takes 9 minutes on one core.
+
+   From KWS_wth_ESP32_SPH0645, with TFLM=managed_components/espressif__esp-tflite-micro
+   and a host build of TFLM with the signal kernels (libtensorflow-microlite.a) :
+     g++ -O2 -std=c++17 -pthread -DTF_LITE_STATIC_MEMORY -Imain/KWS -I$TFLM \
+         -I$TFLM/third_party/flatbuffers/include -I$TFLM/third_party/gemmlowp \
+         host_checks/fast_log_sqrt_check.cc main/KWS/kernels/fast_log_sqrt.cc \
+         libtensorflow-microlite.a -o fast_log_sqrt_check
+     ./fast_log_sqrt_check */
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "kernels/fast_log_sqrt.h"
+#include "signal/src/log.h"
+#include "signal/src/square_root.h"
+
+namespace {
+
+/* Output scales of the log, from 1 to above Q16 */
+constexpr uint32_t kLogScales[] = {1, 640, 1600, 65535, 100000};
+constexpr long kRandom64Inputs = 200000000;
+constexpr int kMaxPrinted = 10;
+
+std::atomic<long> g_mismatches{0};
+std::mutex g_print_mutex;
+
+void Report(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+void Report(const char* format, ...) {
+  if (g_mismatches.fetch_add(1) < kMaxPrinted) {
+    std::lock_guard<std::mutex> lock(g_print_mutex);
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+  }
+}
+
+/* Every 32 bits input in [first, last) */
+void Check32(uint64_t first, uint64_t last) {
+  for (uint64_t n = first; n < last; ++n) {
+    const uint32_t x = static_cast<uint32_t>(n);
+    if (tflite::tflm_signal::Sqrt32(x) != tflite::KwsSqrt32(x)) {
+      Report("Sqrt32(%" PRIu32 ") : %u, KwsSqrt32 %u\n", x, tflite::tflm_signal::Sqrt32(x), tflite::KwsSqrt32(x));
+    }
+    if (x == 0) {
+      continue;
+    }
+    for (const uint32_t scale : kLogScales) {
+      if (tflite::tflm_signal::Log32(x, scale) != tflite::KwsLog32(x, scale)) {
+        Report("Log32(%" PRIu32 ", %" PRIu32 ") : %" PRIu32 ", KwsLog32 %" PRIu32 "\n", x, scale,
+               tflite::tflm_signal::Log32(x, scale), tflite::KwsLog32(x, scale));
+      }
+    }
+  }
+}
+
+void Check64(uint64_t value) {
+  if (tflite::tflm_signal::Sqrt64(value) != tflite::KwsSqrt64(value)) {
+    Report("Sqrt64(%" PRIu64 ") : %" PRIu32 ", KwsSqrt64 %" PRIu32 "\n", value, tflite::tflm_signal::Sqrt64(value),
+           tflite::KwsSqrt64(value));
+  }
+}
+
+}  // namespace
+
+int main() {
+  const unsigned thread_count = std::max(1u, std::thread::hardware_concurrency());
+  const uint64_t inputs = 1ull << 32;
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < thread_count; ++t) {
+    threads.emplace_back(Check32, inputs * t / thread_count, inputs * (t + 1) / thread_count);
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  const long mismatches_32 = g_mismatches.load();
+  printf("Sqrt32 and Log32 (%zu scales) on the 2^32 inputs, %u threads : %ld mismatches\n",
+         sizeof(kLogScales) / sizeof(kLogScales[0]), thread_count, mismatches_32);
+
+  std::mt19937_64 rng(7);
+  for (long i = 0; i < kRandom64Inputs; ++i) {
+    uint64_t value = rng() >> (rng() % 64);
+    if (i % 4 == 0) {
+      /* Near a square, or near the half point after it */
+      const uint64_t root = value >> 32;
+      value = root * root + (rng() % 3) - 1 + (root * (rng() & 1));
+    }
+    Check64(value);
+  }
+  const uint64_t edges[] = {0, 1, 0xFFFFFFFFull, 0x100000000ull, 0xFFFFFFFE00000000ull, 0xFFFFFFFE00000001ull,
+                            0xFFFFFFFF7FFFFFFFull, 0xFFFFFFFF80000000ull, 0xFFFFFFFFFFFFFFFFull};
+  for (const uint64_t value : edges) {
+    Check64(value);
+  }
+  printf("Sqrt64 on %ld random inputs and %zu edges : %ld mismatches\n", kRandom64Inputs,
+         sizeof(edges) / sizeof(edges[0]), g_mismatches.load() - mismatches_32);
+
+  const bool pass = (g_mismatches.load() == 0);
+  printf("%s\n", pass ? "PASS" : "FAIL");
+  return pass ? 0 : 1;
+}
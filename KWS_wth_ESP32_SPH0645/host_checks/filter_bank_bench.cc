@@ -0,0 +1,176 @@
+/*
+ *  filter_bank_bench.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+/* Host check and benchmark of the compact SignalFilterBank kernel
+   (main/KWS/kernels/filter_bank_sparse.h) against the stock one, in the audio
+   preprocessor model : 3000 frames of tones and noise from full scale to
+   nearly silent go through two interpreters which only differ by the
+   FilterBank kernel. The FilterBank outputs and the features must be
+   bit-exact. It prints how many channel sums don't fit 32 bits and the time
+   of the FilterBank operator per frame (from the profiler) of both kernels.
+   On a host with a native 64 bits multiply accumulate the stock kernel is
+   faster, the compact one is for the ESP32-S3 (KEYWORD_SPOTTING_COMPACT_FILTER_BANK).
+
+   From KWS_wth_ESP32_SPH0645, with TFLM=managed_components/espressif__esp-tflite-micro
+   and a host build of TFLM with the signal kernels (libtensorflow-microlite.a) :
+     g++ -O2 -std=c++17 -DTF_LITE_STATIC_MEMORY -Imain/KWS -I$TFLM -I$TFLM/third_party/flatbuffers/include \
+         -I$TFLM/third_party/gemmlowp host_checks/filter_bank_bench.cc main/KWS/kernels/filter_bank_sparse.cc \
+         libtensorflow-microlite.a -o filter_bank_bench
+     ./filter_bank_bench */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "kernels/filter_bank_sparse.h"
+#include "other/audio_preprocessor_int8_model_data.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/micro/micro_profiler_interface.h"
+#include "tensorflow/lite/micro/micro_utils.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace {
+
+constexpr int kFrames = 3000;
+constexpr int kWindowSamples = 480;
+constexpr int kStrideSamples = 320;
+constexpr size_t kArenaSize = 32 * 1024;
+
+using PreprocessorOpResolver = tflite::MicroMutableOpResolver<18>;
+
+TfLiteStatus RegisterOps(PreprocessorOpResolver& op_resolver, bool compact) {
+  TF_LITE_ENSURE_STATUS(op_resolver.AddReshape());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddCast());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddStridedSlice());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddConcatenation());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddMul());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddAdd());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddDiv());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddMinimum());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddMaximum());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddWindow());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddFftAutoScale());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddRfft());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddEnergy());
+  if (compact) {
+    TF_LITE_ENSURE_STATUS(op_resolver.AddCustom("SignalFilterBank", tflite::Register_KWS_FILTER_BANK()));
+  } else {
+    TF_LITE_ENSURE_STATUS(op_resolver.AddFilterBank());
+  }
+  TF_LITE_ENSURE_STATUS(op_resolver.AddFilterBankSquareRoot());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddFilterBankSpectralSubtraction());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddPCAN());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddFilterBankLog());
+  return kTfLiteOk;
+}
+
+/* Time spent in the SignalFilterBank operator */
+class FilterBankTimer : public tflite::MicroProfilerInterface {
+ public:
+  uint32_t BeginEvent(const char* tag) override {
+    is_filter_bank_ = (strcmp(tag, "SignalFilterBank") == 0);
+    start_ = std::chrono::steady_clock::now();
+    return 0;
+  }
+  void EndEvent(uint32_t) override {
+    if (is_filter_bank_) {
+      total_us_ += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_).count();
+    }
+  }
+  double total_us() const { return total_us_; }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+  bool is_filter_bank_ = false;
+  double total_us_ = 0.0;
+};
+
+/* Index of the output tensor of SignalFilterBank */
+int FilterBankOutput(const tflite::Model* model) {
+  const tflite::SubGraph* subgraph = model->subgraphs()->Get(0);
+  for (const tflite::Operator* op : *subgraph->operators()) {
+    const tflite::OperatorCode* code = model->operator_codes()->Get(op->opcode_index());
+    if ((code->custom_code() != nullptr) && (strcmp(code->custom_code()->c_str(), "SignalFilterBank") == 0)) {
+      return op->outputs()->Get(0);
+    }
+  }
+  return -1;
+}
+
+}  // namespace
+
+int main() {
+  const tflite::Model* model = tflite::GetModel(g_audio_preprocessor_int8_tflite);
+  const int filter_bank_output = FilterBankOutput(model);
+  static PreprocessorOpResolver stock_resolver;
+  static PreprocessorOpResolver compact_resolver;
+  if ((filter_bank_output < 0) || (RegisterOps(stock_resolver, false) != kTfLiteOk) ||
+      (RegisterOps(compact_resolver, true) != kTfLiteOk)) {
+    fprintf(stderr, "No SignalFilterBank in the model\n");
+    return 1;
+  }
+
+  alignas(16) static uint8_t stock_arena[kArenaSize];
+  alignas(16) static uint8_t compact_arena[kArenaSize];
+  FilterBankTimer stock_timer;
+  FilterBankTimer compact_timer;
+  tflite::MicroInterpreter stock(model, stock_resolver, stock_arena, kArenaSize, nullptr, &stock_timer, true);
+  tflite::MicroInterpreter compact(model, compact_resolver, compact_arena, kArenaSize, nullptr, &compact_timer, true);
+  if ((stock.AllocateTensors() != kTfLiteOk) || (compact.AllocateTensors() != kTfLiteOk)) {
+    fprintf(stderr, "AllocateTensors() failed\n");
+    return 1;
+  }
+  printf("Arena : stock %zu bytes, compact %zu bytes\n", stock.arena_used_bytes(), compact.arena_used_bytes());
+
+  std::mt19937 rng(3);
+  std::vector<int16_t> audio(kFrames * kStrideSamples + kWindowSamples);
+  for (size_t i = 0; i < audio.size(); ++i) {
+    const int block = (i / kStrideSamples) / 100;
+    const double amplitude = (block % 4 == 0) ? 32000 : (block % 4 == 1) ? 500 : (block % 4 == 2) ? 5 : 8000;
+    const double value = amplitude * sin(i * 0.01 * (1 + block % 37)) +
+                         std::normal_distribution<double>(0, amplitude / 3)(rng);
+    audio[i] = static_cast<int16_t>(std::max(-32768.0, std::min(32767.0, value)));
+  }
+
+  long feature_mismatches = 0;
+  long channel_mismatches = 0;
+  long channels_above_32_bits = 0;
+  long channels = 0;
+  for (int frame = 0; frame < kFrames; ++frame) {
+    memcpy(stock.input(0)->data.i16, &audio[frame * kStrideSamples], kWindowSamples * sizeof(int16_t));
+    memcpy(compact.input(0)->data.i16, &audio[frame * kStrideSamples], kWindowSamples * sizeof(int16_t));
+    if ((stock.Invoke() != kTfLiteOk) || (compact.Invoke() != kTfLiteOk)) {
+      fprintf(stderr, "Invoke() failed\n");
+      return 1;
+    }
+    feature_mismatches += (memcmp(stock.output(0)->data.raw, compact.output(0)->data.raw, stock.output(0)->bytes) != 0);
+
+    const TfLiteEvalTensor* stock_energy = stock.GetTensor(filter_bank_output);
+    const TfLiteEvalTensor* compact_energy = compact.GetTensor(filter_bank_output);
+    const int channel_count = tflite::ElementCount(*stock_energy->dims);
+    for (int c = 0; c < channel_count; ++c) {
+      channel_mismatches += (stock_energy->data.u64[c] != compact_energy->data.u64[c]);
+      channels_above_32_bits += (stock_energy->data.u64[c] > UINT32_MAX);
+    }
+    channels += channel_count;
+  }
+
+  printf("%d frames : %ld features and %ld FilterBank channels differ, %.1f%% of the channel sums above 32 bits\n",
+         kFrames, feature_mismatches, channel_mismatches, 100.0 * channels_above_32_bits / channels);
+  printf("SignalFilterBank : stock %.2f us, compact %.2f us per frame\n", stock_timer.total_us() / kFrames,
+         compact_timer.total_us() / kFrames);
+
+  const bool pass = (feature_mismatches == 0) && (channel_mismatches == 0);
+  printf("%s\n", pass ? "PASS" : "FAIL");
+  return pass ? 0 : 1;
+}
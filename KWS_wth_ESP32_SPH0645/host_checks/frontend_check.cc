@@ -0,0 +1,157 @@
+/*
+ *  frontend_check.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+/* Host check of the fused microfrontend (main/KWS/other/lib, USE_FFT) :
+   FrontendProcessSamples() writes the window straight into the FFT input and
+   takes the energy out of the last stage of kiss_fftr. Its features must be
+   bit-exact with the unfused steps (WindowProcessSamples, FftCompute,
+   FilterbankConvertFftComplexToEnergy), which are run here on a second state.
+   Checked on tones and noise at four amplitudes with four band limits, and
+   after a FrontendReset() in the middle of the audio : the features after the
+   reset must be the ones of a new state, even when the zero padding of the
+   FFT input was overwritten before.
+
+   From KWS_wth_ESP32_SPH0645, with LIB=main/KWS/other/lib and
+   TFLM=managed_components/espressif__esp-tflite-micro :
+     gcc -O2 -DFIXED_POINT=16 -I$LIB -I$TFLM -c $(find $LIB -maxdepth 1 -name '*.c') \
+         $LIB/kissfft/kiss_fft.c $LIB/kissfft/tools/kiss_fftr.c
+     g++ -O2 -DFIXED_POINT=16 -I$LIB -I$TFLM host_checks/frontend_check.cc $LIB/fft.cpp $LIB/fft_util.cpp \
+         $(find . -maxdepth 1 -name '*.o') -o frontend_check
+     ./frontend_check */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "bits.h"
+#include "frontend.h"
+#include "frontend_util.h"
+
+namespace {
+
+constexpr int kSampleRate = 16000;
+
+/* FrontendProcessSamples() as it was before the fusion */
+FrontendOutput ProcessSamplesUnfused(FrontendState* state, const int16_t* samples, size_t num_samples,
+                                     size_t* num_samples_read) {
+  FrontendOutput output;
+  output.values = nullptr;
+  output.size = 0;
+  if (!WindowProcessSamples(&state->window, samples, num_samples, num_samples_read)) {
+    return output;
+  }
+  const int input_shift = 15 - MostSignificantBit32(state->window.max_abs_output_value);
+  FftCompute(&state->fft, state->window.output, input_shift);
+  int32_t* energy = reinterpret_cast<int32_t*>(state->fft.output);
+  FilterbankConvertFftComplexToEnergy(&state->filterbank, state->fft.output, energy);
+  FilterbankAccumulateChannels(&state->filterbank, energy);
+  uint32_t* scaled_filterbank = FilterbankSqrt(&state->filterbank, input_shift);
+  NoiseReductionApply(&state->noise_reduction, scaled_filterbank);
+  if (state->pcan_gain_control.enable_pcan) {
+    PcanGainControlApply(&state->pcan_gain_control, scaled_filterbank);
+  }
+  const int correction_bits = MostSignificantBit32(state->fft.fft_size) - 1 - (kFilterbankBits / 2);
+  output.values = LogScaleApply(&state->log_scale, scaled_filterbank, state->filterbank.num_channels,
+                                correction_bits);
+  output.size = state->filterbank.num_channels;
+  return output;
+}
+
+/* Tones plus noise, the amplitude changes every half second */
+std::vector<int16_t> MakeAudio(int seconds) {
+  std::mt19937 rng(1);
+  std::vector<int16_t> audio(kSampleRate * seconds);
+  for (size_t i = 0; i < audio.size(); ++i) {
+    const int segment = i / (kSampleRate / 2);
+    const double amplitude = (segment % 4 == 0) ? 30000 : (segment % 4 == 1) ? 300 : (segment % 4 == 2) ? 3 : 12000;
+    const double value = amplitude * sin(i * 0.05 * (1 + segment % 7)) +
+                         std::normal_distribution<double>(0, amplitude / 4)(rng);
+    audio[i] = static_cast<int16_t>(std::max(-32768.0, std::min(32767.0, value)));
+  }
+  return audio;
+}
+
+/* The features of every frame of the audio, with the fused or the unfused frontend */
+std::vector<uint16_t> Features(FrontendState* state, const int16_t* audio, size_t size, bool fused) {
+  std::vector<uint16_t> features;
+  while (size > 0) {
+    size_t read = 0;
+    const FrontendOutput output = fused ? FrontendProcessSamples(state, audio, size, &read)
+                                        : ProcessSamplesUnfused(state, audio, size, &read);
+    audio += read;
+    size -= read;
+    if (output.values != nullptr) {
+      features.insert(features.end(), output.values, output.values + output.size);
+    }
+  }
+  return features;
+}
+
+int Mismatches(const std::vector<uint16_t>& a, const std::vector<uint16_t>& b) {
+  if (a.size() != b.size()) {
+    return static_cast<int>(std::max(a.size(), b.size()));
+  }
+  int count = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    count += (a[i] != b[i]);
+  }
+  return count;
+}
+
+}  // namespace
+
+int main() {
+  const std::vector<int16_t> audio = MakeAudio(20);
+  const float band_limits[][2] = {{125.0f, 7500.0f}, {20.0f, 4000.0f}, {300.0f, 7900.0f}, {0.0f, 7000.0f}};
+  int failures = 0;
+
+  for (const auto& limits : band_limits) {
+    FrontendConfig config;
+    FrontendFillConfigWithDefaults(&config);
+    config.window.size_ms = 30;
+    config.window.step_size_ms = 20;
+    config.filterbank.num_channels = 40;
+    config.filterbank.lower_band_limit = limits[0];
+    config.filterbank.upper_band_limit = limits[1];
+
+    FrontendState fused;
+    FrontendState unfused;
+    if (!FrontendPopulateState(&config, &fused, kSampleRate) ||
+        !FrontendPopulateState(&config, &unfused, kSampleRate)) {
+      fprintf(stderr, "FrontendPopulateState failed\n");
+      return 1;
+    }
+
+    /* Fused against unfused on the whole audio */
+    const std::vector<uint16_t> fused_features = Features(&fused, audio.data(), audio.size(), true);
+    const std::vector<uint16_t> unfused_features = Features(&unfused, audio.data(), audio.size(), false);
+    const int mismatches = Mismatches(fused_features, unfused_features);
+
+    /* Reset round trip : after FrontendReset() the features are the ones of
+       a new state, even with garbage in the zero padding of the FFT input */
+    const size_t half = audio.size() / 2;
+    Features(&fused, audio.data(), half, true);
+    FrontendReset(&fused);
+    for (size_t i = fused.fft.input_size; i < fused.fft.fft_size; ++i) {
+      fused.fft.input[i] = static_cast<int16_t>(0x5a5a + i);
+    }
+    const int reset_mismatches = Mismatches(Features(&fused, audio.data(), audio.size(), true), fused_features);
+
+    printf("Band %6.0f - %4.0f Hz : %zu features, %d differ from the unfused frontend, %d after a reset\n",
+           limits[0], limits[1], fused_features.size(), mismatches, reset_mismatches);
+    failures += (mismatches != 0) + (reset_mismatches != 0);
+
+    FrontendFreeStateContents(&fused);
+    FrontendFreeStateContents(&unfused);
+  }
+
+  printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,25 @@
+/*
+ *  esp_heap_caps.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef HOST_PORT_ESP_HEAP_CAPS_H_
+#define HOST_PORT_ESP_HEAP_CAPS_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* The host has one heap, the capabilities are ignored */
+#define  MALLOC_CAP_SPIRAM     (1 << 10)
+#define  MALLOC_CAP_INTERNAL   (1 << 11)
+#define  MALLOC_CAP_8BIT       (1 << 2)
+
+static inline void *heap_caps_malloc( size_t size , uint32_t caps )
+{
+  (void)caps;
+  return malloc( size );
+}
+
+#endif /* HOST_PORT_ESP_HEAP_CAPS_H_ */
@@ -0,0 +1,19 @@
+/*
+ *  esp_log.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef HOST_PORT_ESP_LOG_H_
+#define HOST_PORT_ESP_LOG_H_
+
+#include <stdio.h>
+
+#define  ESP_LOGE(tag, format, ...)  printf( "E (%s) " format "\n" , tag , ##__VA_ARGS__ )
+#define  ESP_LOGW(tag, format, ...)  printf( "W (%s) " format "\n" , tag , ##__VA_ARGS__ )
+#define  ESP_LOGI(tag, format, ...)  printf( "I (%s) " format "\n" , tag , ##__VA_ARGS__ )
+#define  ESP_LOGD(tag, format, ...)  do { } while ( 0 )
+#define  ESP_LOGV(tag, format, ...)  do { } while ( 0 )
+
+#endif /* HOST_PORT_ESP_LOG_H_ */
@@ -0,0 +1,24 @@
+/*
+ *  esp_timer.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef HOST_PORT_ESP_TIMER_H_
+#define HOST_PORT_ESP_TIMER_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Microseconds of the steady clock of the host */
+int64_t esp_timer_get_time( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_PORT_ESP_TIMER_H_ */
@@ -0,0 +1,35 @@
+/*
+ *  FreeRTOS.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+/* Host port of the few FreeRTOS types and functions the KWS modules use, so
+   that they build in the host checks. The tasks are threads, the queues and
+   the semaphores use a mutex, see host_port.cc */
+
+#ifndef HOST_PORT_FREERTOS_H_
+#define HOST_PORT_FREERTOS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+typedef void *TaskHandle_t;
+typedef void *QueueHandle_t;
+typedef void *SemaphoreHandle_t;
+typedef void (*TaskFunction_t)( void * );
+
+#define  pdTRUE               (1)
+#define  pdFALSE              (0)
+#define  pdPASS               (1)
+#define  pdFAIL               (0)
+#define  portMAX_DELAY        (0xffffffffu)
+#define  portTICK_PERIOD_MS   (1)
+#define  pdMS_TO_TICKS(ms)    ((TickType_t)(ms))
+
+#endif /* HOST_PORT_FREERTOS_H_ */
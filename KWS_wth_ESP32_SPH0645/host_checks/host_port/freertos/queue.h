@@ -0,0 +1,26 @@
+/*
+ *  queue.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef HOST_PORT_FREERTOS_QUEUE_H_
+#define HOST_PORT_FREERTOS_QUEUE_H_
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+QueueHandle_t xQueueCreate( UBaseType_t length , UBaseType_t item_size );
+BaseType_t xQueueSend( QueueHandle_t queue , const void *item , TickType_t ticks_to_wait );
+BaseType_t xQueueReceive( QueueHandle_t queue , void *item , TickType_t ticks_to_wait );
+UBaseType_t uxQueueMessagesWaiting( QueueHandle_t queue );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_PORT_FREERTOS_QUEUE_H_ */
@@ -0,0 +1,25 @@
+/*
+ *  semphr.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef HOST_PORT_FREERTOS_SEMPHR_H_
+#define HOST_PORT_FREERTOS_SEMPHR_H_
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+SemaphoreHandle_t xSemaphoreCreateBinary( void );
+BaseType_t xSemaphoreTake( SemaphoreHandle_t semaphore , TickType_t ticks_to_wait );
+BaseType_t xSemaphoreGive( SemaphoreHandle_t semaphore );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_PORT_FREERTOS_SEMPHR_H_ */
@@ -0,0 +1,27 @@
+/*
+ *  task.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef HOST_PORT_FREERTOS_TASK_H_
+#define HOST_PORT_FREERTOS_TASK_H_
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The core and the priority are ignored, the task is a detached thread */
+BaseType_t xTaskCreatePinnedToCore( TaskFunction_t function , const char *name , uint32_t stack_size ,
+                                    void *parameter , UBaseType_t priority , TaskHandle_t *handle ,
+                                    BaseType_t core_id );
+void vTaskDelay( TickType_t ticks );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_PORT_FREERTOS_TASK_H_ */
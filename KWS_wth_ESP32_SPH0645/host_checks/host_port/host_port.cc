@@ -0,0 +1,156 @@
+/*
+ *  host_port.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+/* FreeRTOS and esp_timer on the host, for the checks which build KWS modules
+   with tasks : add -Ihost_checks/host_port and this file to their build */
+
+#include "host_port.h"
+
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+namespace {
+
+struct HostQueue {
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::deque<std::vector<uint8_t>> items;
+  size_t length;
+  size_t item_size;
+};
+
+struct HostSemaphore {
+  std::mutex mutex;
+  std::condition_variable given;
+  bool available;
+};
+
+std::atomic<void (*)(void)> g_receive_hook{nullptr};
+
+/* Waits until `ready` or the ticks are over, portMAX_DELAY waits forever */
+template <typename Predicate>
+bool WaitFor(std::condition_variable& condition, std::unique_lock<std::mutex>& lock, TickType_t ticks,
+             Predicate ready) {
+  if (ticks == portMAX_DELAY) {
+    condition.wait(lock, ready);
+    return true;
+  }
+  return condition.wait_for(lock, std::chrono::milliseconds(ticks * portTICK_PERIOD_MS), ready);
+}
+
+}  // namespace
+
+extern "C" {
+
+void host_port_set_receive_hook(void (*hook)(void)) {
+  g_receive_hook.store(hook);
+}
+
+int64_t esp_timer_get_time(void) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+  HostQueue* queue = new HostQueue;
+  queue->length = length;
+  queue->item_size = item_size;
+  return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t handle, const void* item, TickType_t ticks_to_wait) {
+  HostQueue* queue = static_cast<HostQueue*>(handle);
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  if (!WaitFor(queue->changed, lock, ticks_to_wait, [queue] { return queue->items.size() < queue->length; })) {
+    return pdFAIL;
+  }
+  const uint8_t* bytes = static_cast<const uint8_t*>(item);
+  queue->items.emplace_back(bytes, bytes + queue->item_size);
+  queue->changed.notify_all();
+  return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t handle, void* item, TickType_t ticks_to_wait) {
+  HostQueue* queue = static_cast<HostQueue*>(handle);
+  {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!WaitFor(queue->changed, lock, ticks_to_wait, [queue] { return !queue->items.empty(); })) {
+      return pdFALSE;
+    }
+    memcpy(item, queue->items.front().data(), queue->item_size);
+    queue->items.pop_front();
+    queue->changed.notify_all();
+  }
+  void (*hook)(void) = g_receive_hook.load();
+  if (hook != nullptr) {
+    hook();
+  }
+  return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t handle) {
+  HostQueue* queue = static_cast<HostQueue*>(handle);
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  return static_cast<UBaseType_t>(queue->items.size());
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+  HostSemaphore* semaphore = new HostSemaphore;
+  semaphore->available = false;
+  return semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t handle, TickType_t ticks_to_wait) {
+  HostSemaphore* semaphore = static_cast<HostSemaphore*>(handle);
+  std::unique_lock<std::mutex> lock(semaphore->mutex);
+  if (!WaitFor(semaphore->given, lock, ticks_to_wait, [semaphore] { return semaphore->available; })) {
+    return pdFALSE;
+  }
+  semaphore->available = false;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t handle) {
+  HostSemaphore* semaphore = static_cast<HostSemaphore*>(handle);
+  std::lock_guard<std::mutex> lock(semaphore->mutex);
+  /* A binary semaphore : a give while it is available is lost */
+  if (semaphore->available) {
+    return pdFALSE;
+  }
+  semaphore->available = true;
+  semaphore->given.notify_all();
+  return pdTRUE;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stack_size, void* parameter,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core_id) {
+  std::thread task(function, parameter);
+  if (handle != nullptr) {
+    *handle = reinterpret_cast<TaskHandle_t>(task.native_handle());
+  }
+  task.detach();
+  return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+}
+
+}  // extern "C"
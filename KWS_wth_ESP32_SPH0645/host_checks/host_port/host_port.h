@@ -0,0 +1,24 @@
+/*
+ *  host_port.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef HOST_PORT_HOST_PORT_H_
+#define HOST_PORT_HOST_PORT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Called by xQueueReceive() in the receiving task, after it took an item and
+   before it returns. A check uses it to make the work of that task slower,
+   for example a copy from a slow flash. nullptr removes it */
+void host_port_set_receive_hook( void (*hook)( void ) );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_PORT_HOST_PORT_H_ */
@@ -0,0 +1,209 @@
+/*
+ *  resume_check.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+/* Host check and benchmark of the resume of the preprocessor
+   (main/KWS/other/micro_features_generator.h) : the snapshot of the noise
+   estimate against the warmup (KEYWORD_SPOTTING_RESUME_SNAPSHOT).
+   - Save and restore fail before the first frame.
+   - A restored snapshot gives the same features as when it was taken, also
+     when it stops a warmup.
+   - Benchmark : the device converges in a place, is suspended, and resumes
+     in the same place or in another one. The features of every way to
+     resume are compared with a reference which converged in the place of the
+     resume : the frames until the features stay within 3 and 1 LSB of it,
+     and the mean error of the 10 first frames. The places are a quiet hum
+     and a loud fan like noise.
+   From KWS_wth_ESP32_SPH0645, with TFLM=managed_components/espressif__esp-tflite-micro
+   and a host build of TFLM with the signal kernels (libtensorflow-microlite.a) :
+     g++ -O2 -std=c++17 -pthread -DTF_LITE_STATIC_MEMORY -Ihost_checks/host_port -Imain/KWS -I$TFLM \
+         -I$TFLM/third_party/flatbuffers/include -I$TFLM/third_party/gemmlowp -I$TFLM/third_party/kissfft \
+         host_checks/resume_check.cc main/KWS/other/micro_features_generator.cc \
+         main/KWS/kernels/noise_estimate.cc main/KWS/kernels/window_auto_scale.cc \
+         main/KWS/kernels/rfft_512.cc main/KWS/kernels/filter_bank_sparse.cc \
+         main/KWS/kernels/fast_log_sqrt.cc libtensorflow-microlite.a -o resume_check
+     ./resume_check */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "other/micro_features_generator.h"
+#include "other/micro_model_settings.h"
+
+namespace {
+
+constexpr int kWindowSamples = kFeatureDurationMs * kAudioSampleFrequency / 1000;
+constexpr int kStrideSamples = kFeatureStrideMs * kAudioSampleFrequency / 1000;
+/* 30 s to converge in a place, 10 s after the resume */
+constexpr int kConvergeFrames = 1500;
+constexpr int kResumeFrames = 500;
+constexpr int kFirstFrames = 10;
+
+using FeatureRows = std::vector<std::vector<int8_t>>;
+
+enum Place { kQuietHum, kLoudFan };
+
+const char* const kPlaceNames[] = {"quiet hum", "loud fan"};
+
+/* The audio of one place, one stride at a time */
+class PlaceAudio {
+ public:
+  PlaceAudio(Place place, uint32_t seed) : place_(place), rng_(seed), window_(kWindowSamples, 0) {}
+
+  /* The next window : the last one moved by one stride */
+  const int16_t* NextWindow() {
+    memmove(window_.data(), window_.data() + kStrideSamples, (kWindowSamples - kStrideSamples) * sizeof(int16_t));
+    for (int i = kWindowSamples - kStrideSamples; i < kWindowSamples; ++i) {
+      window_[i] = NextSample();
+    }
+    return window_.data();
+  }
+
+ private:
+  int16_t NextSample() {
+    const double t = static_cast<double>(sample_++) / kAudioSampleFrequency;
+    std::normal_distribution<double> noise(0.0, 1.0);
+    double value;
+    if (place_ == kQuietHum) {
+      /* Mains hum and its third harmonic over a low hiss */
+      value = 120.0 * std::sin(2.0 * M_PI * 50.0 * t) + 40.0 * std::sin(2.0 * M_PI * 150.0 * t) + 15.0 * noise(rng_);
+    } else {
+      /* Low pass noise with the blade tone of a fan */
+      low_pass_ = 0.9 * low_pass_ + 0.1 * noise(rng_);
+      value = 9000.0 * low_pass_ + 600.0 * std::sin(2.0 * M_PI * 240.0 * t) + 300.0 * noise(rng_);
+    }
+    return static_cast<int16_t>(std::max(-32768.0, std::min(32767.0, value)));
+  }
+
+  Place place_;
+  std::mt19937 rng_;
+  std::vector<int16_t> window_;
+  long sample_ = 0;
+  double low_pass_ = 0.0;
+};
+
+bool g_pass = true;
+
+void Check(bool condition, const char* message) {
+  printf("%-58s : %s\n", message, condition ? "ok" : "FAILED");
+  g_pass = g_pass && condition;
+}
+
+FeatureRows RunFrames(PlaceAudio audio, int frames) {
+  FeatureRows rows(frames, std::vector<int8_t>(g_kFeatureSize));
+  for (std::vector<int8_t>& row : rows) {
+    if (GenerateFeature(audio.NextWindow(), kWindowSamples, row.data()) != kTfLiteOk) {
+      g_pass = false;
+    }
+  }
+  return rows;
+}
+
+MicroFeaturesState ConvergeIn(Place place) {
+  MicroFeaturesState state = {};
+  RunFrames(PlaceAudio(place, 11), kConvergeFrames);
+  SaveMicroFeaturesState(&state);
+  return state;
+}
+
+int MaxError(const std::vector<int8_t>& row, const std::vector<int8_t>& reference) {
+  int error = 0;
+  for (int i = 0; i < g_kFeatureSize; ++i) {
+    error = std::max(error, std::abs(row[i] - reference[i]));
+  }
+  return error;
+}
+
+/* First frame from which the error stays within `lsb`, in ms */
+int SettledMs(const FeatureRows& rows, const FeatureRows& reference, int lsb) {
+  int frame = static_cast<int>(rows.size());
+  while ((frame > 0) && (MaxError(rows[frame - 1], reference[frame - 1]) <= lsb)) {
+    --frame;
+  }
+  return frame * kFeatureStrideMs;
+}
+
+double MeanFirstError(const FeatureRows& rows, const FeatureRows& reference) {
+  double sum = 0.0;
+  for (int frame = 0; frame < kFirstFrames; ++frame) {
+    for (int i = 0; i < g_kFeatureSize; ++i) {
+      sum += std::abs(rows[frame][i] - reference[frame][i]);
+    }
+  }
+  return sum / (kFirstFrames * g_kFeatureSize);
+}
+
+void PrintResume(const char* name, const FeatureRows& rows, const FeatureRows& reference) {
+  printf("  %-18s %9d ms %11d ms %11.1f LSB\n", name, SettledMs(rows, reference, 3), SettledMs(rows, reference, 1),
+         MeanFirstError(rows, reference));
+}
+
+/* Suspended after converging in `suspended`, resumed in `resumed` */
+void Benchmark(Place suspended, Place resumed) {
+  const MicroFeaturesState reference_state = ConvergeIn(resumed);
+  const MicroFeaturesState suspend_state = ConvergeIn(suspended);
+  MicroFeaturesState cold_state = {};
+  cold_state.valid = true;
+  const PlaceAudio resume_audio(resumed, 23);
+
+  RestoreMicroFeaturesState(&reference_state);
+  const FeatureRows reference = RunFrames(resume_audio, kResumeFrames);
+
+  printf("Suspended in the %s, resumed in the %s :\n", kPlaceNames[suspended], kPlaceNames[resumed]);
+  printf("  %-18s %12s %14s %15s\n", "", "within 3 LSB", "within 1 LSB", "10 first frames");
+  RestoreMicroFeaturesState(&cold_state);
+  PrintResume("cold reset", RunFrames(resume_audio, kResumeFrames), reference);
+  for (const int frames : {5, 10, 20}) {
+    char name[32];
+    snprintf(name, sizeof(name), "warmup %d frames", frames);
+    RestoreMicroFeaturesState(&suspend_state);
+    WarmupMicroFeatures(frames);
+    PrintResume(name, RunFrames(resume_audio, kResumeFrames), reference);
+  }
+  /* The task is frozen over the suspend, so the snapshot is also the
+     estimate it resumes with when nothing is done */
+  RestoreMicroFeaturesState(&suspend_state);
+  PrintResume("restore snapshot", RunFrames(resume_audio, kResumeFrames), reference);
+}
+
+}  // namespace
+
+int main() {
+  if (InitializeMicroFeatures() != kTfLiteOk) {
+    printf("InitializeMicroFeatures failed\nFAIL\n");
+    return 1;
+  }
+
+  MicroFeaturesState state = {};
+  Check(SaveMicroFeaturesState(&state) != kTfLiteOk, "Save before the first frame fails");
+  state.valid = true;
+  Check(RestoreMicroFeaturesState(&state) != kTfLiteOk, "Restore before the first frame fails");
+
+  const MicroFeaturesState fan_state = ConvergeIn(kLoudFan);
+  const PlaceAudio audio(kLoudFan, 5);
+  const FeatureRows after_save = RunFrames(audio, 200);
+  Check(RestoreMicroFeaturesState(&fan_state) == kTfLiteOk, "Restore of a snapshot");
+  Check(RunFrames(audio, 200) == after_save, "Same features after the restore");
+  WarmupMicroFeatures(10);
+  RunFrames(audio, 3);
+  RestoreMicroFeaturesState(&fan_state);
+  Check(RunFrames(audio, 200) == after_save, "Same features after a restore in a warmup");
+  MicroFeaturesState invalid = fan_state;
+  invalid.valid = false;
+  Check(RestoreMicroFeaturesState(&invalid) != kTfLiteOk, "Restore of an invalid snapshot fails");
+
+  Benchmark(kLoudFan, kLoudFan);
+  Benchmark(kQuietHum, kLoudFan);
+  Benchmark(kLoudFan, kQuietHum);
+
+  printf("%s\n", g_pass ? "PASS" : "FAIL");
+  return g_pass ? 0 : 1;
+}
@@ -0,0 +1,219 @@
+/*
+ *  softmax_elided_check.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+/* Host check of the elided SOFTMAX (main/KWS/kernels/softmax_elided.h,
+   KEYWORD_SPOTTING_SOFTMAX_ELISION 1) :
+   - g_model with the elided SOFTMAX against g_model stripped of its SOFTMAX
+     (like KWS_model/strip_softmax.py) with the stock kernels, on kClips
+     variants of the yes clip : the logits must be bit-exact, and
+     KwsModelLogits() must give the quantization of the stripped output.
+   - g_model with a RESHAPE after its SOFTMAX : the stock SOFTMAX loads, the
+     elided one must fail AllocateTensors(), since the RESHAPE would get the
+     logits.
+   From KWS_wth_ESP32_SPH0645, with TFLM=managed_components/espressif__esp-tflite-micro,
+   ESPNN=managed_components/espressif__esp-nn, a host build of TFLM
+   (libtensorflow-microlite.a) and of the C versions of esp-nn (libesp-nn-ansi.a,
+   from the *_ansi.c files of $ESPNN/src) :
+     g++ -O2 -std=c++17 -DTF_LITE_STATIC_MEMORY -Imain/KWS -I$TFLM -I$ESPNN/include \
+         -I$TFLM/third_party/flatbuffers/include -I$TFLM/third_party/gemmlowp \
+         host_checks/softmax_elided_check.cc main/KWS/kernels/softmax_elided.cc \
+         main/KWS/keyword_spotting_model.cc main/KWS/other/yes_micro_features_data.cc \
+         libtensorflow-microlite.a libesp-nn-ansi.a -o softmax_elided_check
+     ./softmax_elided_check */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "keyword_spotting_model.h"
+#include "kernels/softmax_elided.h"
+#include "other/yes_micro_features_data.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace {
+
+constexpr int kClips = 300;
+constexpr size_t kArenaSize = 64 * 1024;
+
+using ModelOpResolver = tflite::MicroMutableOpResolver<5>;
+
+TfLiteStatus RegisterOps(ModelOpResolver& op_resolver, bool elided) {
+  TF_LITE_ENSURE_STATUS(op_resolver.AddConv2D());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddMaxPool2D());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddReshape());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddFullyConnected());
+  return elided ? op_resolver.AddSoftmax(*tflite::Register_KWS_SOFTMAX_ELIDED()) : op_resolver.AddSoftmax();
+}
+
+/* Index of the first operator of `subgraph` with the builtin code `code` */
+int FindOperator(const tflite::ModelT& model, const tflite::SubGraphT& subgraph, tflite::BuiltinOperator code) {
+  for (size_t i = 0; i < subgraph.operators.size(); ++i) {
+    if (model.operator_codes[subgraph.operators[i]->opcode_index]->builtin_code == code) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+/* g_model changed by `edit`, in a new flatbuffer */
+std::vector<uint8_t> EditModel(const std::function<bool(tflite::ModelT&)>& edit) {
+  std::unique_ptr<tflite::ModelT> model(tflite::GetModel(g_model)->UnPack());
+  if (!edit(*model)) {
+    return {};
+  }
+  flatbuffers::DefaultAllocator allocator;
+  flatbuffers::FlatBufferBuilder builder(1024, &allocator);
+  tflite::FinishModelBuffer(builder, tflite::Model::Pack(builder, model.get()));
+  return std::vector<uint8_t>(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize());
+}
+
+/* The SOFTMAX and its output removed, the logits are the output */
+bool StripSoftmax(tflite::ModelT& model) {
+  tflite::SubGraphT& subgraph = *model.subgraphs[0];
+  const int softmax = FindOperator(model, subgraph, tflite::BuiltinOperator_SOFTMAX);
+  if (softmax < 0) {
+    return false;
+  }
+  const int logits = subgraph.operators[softmax]->inputs[0];
+  const int removed = subgraph.operators[softmax]->outputs[0];
+  subgraph.operators.erase(subgraph.operators.begin() + softmax);
+  subgraph.outputs = {logits};
+  subgraph.tensors.erase(subgraph.tensors.begin() + removed);
+  auto remap = [removed](std::vector<int32_t>& indices) {
+    for (int32_t& index : indices) {
+      index -= (index > removed);
+    }
+  };
+  for (auto& op : subgraph.operators) {
+    remap(op->inputs);
+    remap(op->outputs);
+  }
+  remap(subgraph.inputs);
+  remap(subgraph.outputs);
+  return true;
+}
+
+/* A RESHAPE after the SOFTMAX makes the output */
+bool AddReshapeAfterSoftmax(tflite::ModelT& model) {
+  tflite::SubGraphT& subgraph = *model.subgraphs[0];
+  const int softmax = FindOperator(model, subgraph, tflite::BuiltinOperator_SOFTMAX);
+  const int reshape = FindOperator(model, subgraph, tflite::BuiltinOperator_RESHAPE);
+  if ((softmax < 0) || (reshape < 0)) {
+    return false;
+  }
+  const int probabilities = subgraph.operators[softmax]->outputs[0];
+  auto output = std::make_unique<tflite::TensorT>(*subgraph.tensors[probabilities]);
+  output->name = "reshaped_probabilities";
+  output->quantization =
+      std::make_unique<tflite::QuantizationParametersT>(*subgraph.tensors[probabilities]->quantization);
+  const int output_index = static_cast<int>(subgraph.tensors.size());
+  subgraph.tensors.push_back(std::move(output));
+
+  auto op = std::make_unique<tflite::OperatorT>();
+  op->opcode_index = subgraph.operators[reshape]->opcode_index;
+  op->inputs = {probabilities};
+  op->outputs = {output_index};
+  tflite::ReshapeOptionsT options;
+  options.new_shape = subgraph.tensors[probabilities]->shape;
+  op->builtin_options.Set(options);
+  subgraph.operators.push_back(std::move(op));
+  subgraph.outputs = {output_index};
+  return true;
+}
+
+}  // namespace
+
+int main() {
+  const std::vector<uint8_t> stripped_model = EditModel(StripSoftmax);
+  const std::vector<uint8_t> inner_softmax_model = EditModel(AddReshapeAfterSoftmax);
+  if (stripped_model.empty() || inner_softmax_model.empty()) {
+    printf("g_model has no SOFTMAX or no RESHAPE\nFAIL\n");
+    return 1;
+  }
+
+  static ModelOpResolver stock_resolver;
+  static ModelOpResolver elided_resolver;
+  if ((RegisterOps(stock_resolver, false) != kTfLiteOk) || (RegisterOps(elided_resolver, true) != kTfLiteOk)) {
+    return 1;
+  }
+  alignas(16) static uint8_t stripped_arena[kArenaSize];
+  alignas(16) static uint8_t elided_arena[kArenaSize];
+  alignas(16) static uint8_t stock_arena[kArenaSize];
+  tflite::MicroInterpreter stripped(tflite::GetModel(stripped_model.data()), stock_resolver, stripped_arena,
+                                    kArenaSize);
+  tflite::MicroInterpreter elided(tflite::GetModel(g_model), elided_resolver, elided_arena, kArenaSize);
+  tflite::MicroInterpreter stock(tflite::GetModel(g_model), stock_resolver, stock_arena, kArenaSize);
+  if ((stripped.AllocateTensors() != kTfLiteOk) || (elided.AllocateTensors() != kTfLiteOk) ||
+      (stock.AllocateTensors() != kTfLiteOk)) {
+    printf("AllocateTensors() failed\nFAIL\n");
+    return 1;
+  }
+
+  /* Variants of the yes clip : noise and a level offset on its features */
+  std::mt19937 rng(3);
+  const int clip_size = g_yes_micro_f2e59fea_nohash_1_width * g_yes_micro_f2e59fea_nohash_1_height;
+  long mismatches = 0;
+  long argmax_differs = 0;
+  for (int clip = 0; clip < kClips; ++clip) {
+    const int noise = clip % 40;
+    const int offset = (clip % 7) * 8 - 24;
+    for (int i = 0; i < clip_size; ++i) {
+      const int value = g_yes_micro_f2e59fea_nohash_1_data[i] + offset +
+                        ((noise > 0) ? static_cast<int>(rng() % (2 * noise + 1)) - noise : 0);
+      const int8_t feature = static_cast<int8_t>(std::max(-128, std::min(127, value)));
+      stripped.input(0)->data.int8[i] = feature;
+      elided.input(0)->data.int8[i] = feature;
+      stock.input(0)->data.int8[i] = feature;
+    }
+    if ((stripped.Invoke() != kTfLiteOk) || (elided.Invoke() != kTfLiteOk) || (stock.Invoke() != kTfLiteOk)) {
+      printf("Invoke() failed\nFAIL\n");
+      return 1;
+    }
+    const TfLiteTensor* logits = elided.output(0);
+    mismatches += (memcmp(stripped.output(0)->data.raw, logits->data.raw, logits->bytes) != 0);
+    const int8_t* scores = stock.output(0)->data.int8;
+    const int count = static_cast<int>(logits->bytes);
+    /* The quantized softmax can tie two scores, the logits are finer */
+    argmax_differs += (std::max_element(logits->data.int8, logits->data.int8 + count) - logits->data.int8 !=
+                       std::max_element(scores, scores + count) - scores);
+  }
+  printf("g_model : %d clips, %ld with logits different from the stripped model, %ld with another argmax than "
+         "the stock SOFTMAX\n",
+         kClips, mismatches, argmax_differs);
+
+  float scale = 0.0f;
+  int32_t zero_point = 0;
+  bool has_softmax = false;
+  const bool logits_ok = (tflite::KwsModelLogits(tflite::GetModel(g_model), &scale, &zero_point, &has_softmax) ==
+                          kTfLiteOk) &&
+                         has_softmax && (scale == stripped.output(0)->params.scale) &&
+                         (zero_point == stripped.output(0)->params.zero_point);
+  printf("KwsModelLogits : scale %g, zero point %d, %s\n", scale, static_cast<int>(zero_point),
+         logits_ok ? "the ones of the stripped output" : "WRONG");
+  printf("Arena : stock %zu bytes, elided %zu bytes\n", stock.arena_used_bytes(), elided.arena_used_bytes());
+
+  alignas(16) static uint8_t inner_arena[kArenaSize];
+  tflite::MicroInterpreter inner_stock(tflite::GetModel(inner_softmax_model.data()), stock_resolver, inner_arena,
+                                       kArenaSize);
+  const bool stock_loads = (inner_stock.AllocateTensors() == kTfLiteOk);
+  tflite::MicroInterpreter inner_elided(tflite::GetModel(inner_softmax_model.data()), elided_resolver, inner_arena,
+                                        kArenaSize);
+  const bool elided_rejected = (inner_elided.AllocateTensors() != kTfLiteOk);
+  printf("SOFTMAX before a RESHAPE : stock %s, elided %s\n", stock_loads ? "loads" : "fails",
+         elided_rejected ? "rejected" : "loads");
+
+  const bool pass = (mismatches == 0) && logits_ok && stock_loads && elided_rejected;
+  printf("%s\n", pass ? "PASS" : "FAIL");
+  return pass ? 0 : 1;
+}
@@ -0,0 +1,382 @@
+/*
+ *  weight_stream_check.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+/* Host check and benchmark of the weight streaming (main/KWS/kernels/weight_stream.h)
+   through the streamed FULLY_CONNECTED (fully_connected_streamed.h). The
+   prefetch task is a thread of host_port, and every copy it makes waits
+   first for a simulated flash of kFlashBytesPerUs, with a random jitter, so
+   the kernel finds the tiles in every state : already copied, being copied,
+   or still queued behind the first tile of another tensor.
+   - kRounds rounds on kLayers int8 and 16x8 layers taken at random, 1 to 4
+     invokes each, so the staging halves keep changing hands. Every output
+     must be bit-exact with the resident FULLY_CONNECTED of TFLM : a tile
+     used before its copy is done (a sequence counter or a wake up of the
+     semaphore taken for the wrong copy) gives other weights.
+   - The statistics of every tensor : every tile is a hit or a miss.
+   - The time of one invoke of every layer, with the weights resident in RAM
+     (Register_KWS_FULLY_CONNECTED_16X8), streamed from the slow flash, and
+     streamed from a source as fast as the RAM, with kInvokeGapUs between the
+     invokes like the audio capture gives on the board.
+   From KWS_wth_ESP32_SPH0645, with TFLM=managed_components/espressif__esp-tflite-micro,
+   ESPNN=managed_components/espressif__esp-nn, a host build of TFLM
+   (libtensorflow-microlite.a) and of the C versions of esp-nn (libesp-nn-ansi.a,
+   from the *_ansi.c files of $ESPNN/src) :
+     g++ -O2 -std=c++17 -pthread -DTF_LITE_STATIC_MEMORY -Ihost_checks/host_port -Imain/KWS -I$TFLM \
+         -I$ESPNN/include -I$TFLM/third_party/flatbuffers/include -I$TFLM/third_party/gemmlowp \
+         host_checks/weight_stream_check.cc host_checks/host_port/host_port.cc \
+         main/KWS/kernels/weight_stream.cc main/KWS/kernels/fully_connected_streamed.cc \
+         main/KWS/kernels/conv_fc_16x8.cc main/KWS/telemetry.cc \
+         libtensorflow-microlite.a libesp-nn-ansi.a -o weight_stream_check
+     ./weight_stream_check */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "keyword_spotting_config.h"
+}
+
+#include "esp_timer.h"
+#include "host_port.h"
+#include "kernels/conv_fc_16x8.h"
+#include "kernels/fully_connected_streamed.h"
+#include "kernels/weight_stream.h"
+#include "telemetry.h"
+#include "tensorflow/lite/micro/kernels/kernel_runner.h"
+#include "tensorflow/lite/micro/kernels/micro_ops.h"
+#include "tensorflow/lite/micro/test_helpers.h"
+
+namespace {
+
+constexpr int kRounds = 400;
+constexpr int kTimedInvokes = 50;
+constexpr int kInvokeGapUs = 2000;
+/* About a quad SPI flash at 80 MHz read through the cache */
+constexpr int kFlashBytesPerUs = 40;
+constexpr int kMaxPrinted = 10;
+
+struct Layer {
+  const char* name;
+  TfLiteType type; /* Of the activations, int8 or int16 */
+  int batches;
+  int accum_depth;
+  int output_depth;
+};
+
+/* All above KEYWORD_SPOTTING_WEIGHT_STREAM_MIN_TENSOR_SIZE, from one row per
+   tile to twenty, with a shorter last tile */
+constexpr Layer kLayers[] = {
+    {"int8 1x640->64", kTfLiteInt8, 1, 640, 64},
+    {"int8 4x1024->48", kTfLiteInt8, 4, 1024, 48},
+    {"16x8 1x400->100", kTfLiteInt16, 1, 400, 100},
+    {"int8 1x8192->4", kTfLiteInt8, 1, 8192, 4},
+};
+constexpr int kLayerCount = sizeof(kLayers) / sizeof(kLayers[0]);
+
+/* Delay of every copy of the prefetch task, set for the layer which runs */
+std::atomic<int> g_fetch_delay_us{0};
+
+void SlowFlash() {
+  static thread_local std::mt19937 rng(7);
+  const int delay_us = g_fetch_delay_us.load();
+  if (delay_us > 0) {
+    std::uniform_int_distribution<int> jitter(delay_us / 2, delay_us * 3 / 2);
+    std::this_thread::sleep_for(std::chrono::microseconds(jitter(rng)));
+  }
+}
+
+/* Shape, data and quantization of one tensor of the kernel runner */
+template <typename T>
+struct TensorStorage {
+  std::vector<T> data;
+  int dims[3];
+  float scale[2];
+  int zero_point[2];
+  TfLiteAffineQuantization quantization;
+
+  TfLiteTensor Create(std::initializer_list<int> shape, TfLiteType type, float tensor_scale, int tensor_zero_point) {
+    dims[0] = static_cast<int>(shape.size());
+    int size = 1;
+    int i = 1;
+    for (const int dim : shape) {
+      dims[i++] = dim;
+      size *= dim;
+    }
+    data.resize(size);
+    /* Stored as TfLiteFloatArray and TfLiteIntArray : the size, then the value */
+    const int count = 1;
+    memcpy(&scale[0], &count, sizeof(count));
+    scale[1] = tensor_scale;
+    zero_point[0] = 1;
+    zero_point[1] = tensor_zero_point;
+    quantization = {reinterpret_cast<TfLiteFloatArray*>(scale), reinterpret_cast<TfLiteIntArray*>(zero_point), 0};
+
+    TfLiteTensor tensor = {};
+    tensor.type = type;
+    tensor.data.raw = reinterpret_cast<char*>(data.data());
+    tensor.dims = tflite::testing::IntArrayFromInts(dims);
+    tensor.bytes = size * sizeof(T);
+    tensor.params = {tensor_scale, tensor_zero_point};
+    tensor.quantization = {kTfLiteAffineQuantization, &quantization};
+    tensor.allocation_type = kTfLiteMemNone;
+    return tensor;
+  }
+};
+
+/* The tensors of one layer : input, filter, bias and output. The filter is
+   constant, in the model flatbuffer on the board */
+template <typename Act, typename Bias>
+struct LayerTensors {
+  TensorStorage<Act> input;
+  TensorStorage<int8_t> filter;
+  TensorStorage<Bias> bias;
+  TensorStorage<Act> output;
+  TfLiteTensor tensors[4];
+
+  void Create(const Layer& layer, std::mt19937& rng) {
+    const bool is_16x8 = (layer.type == kTfLiteInt16);
+    const float input_scale = is_16x8 ? 0.001f : 0.05f;
+    const float filter_scale = 0.002f;
+    tensors[0] = input.Create({layer.batches, layer.accum_depth}, layer.type, input_scale, is_16x8 ? 0 : -3);
+    tensors[1] = filter.Create({layer.output_depth, layer.accum_depth}, kTfLiteInt8, filter_scale, 0);
+    tensors[1].allocation_type = kTfLiteMmapRo;
+    tensors[2] = bias.Create({layer.output_depth}, is_16x8 ? kTfLiteInt64 : kTfLiteInt32, input_scale * filter_scale,
+                             0);
+    tensors[3] = output.Create({layer.batches, layer.output_depth}, layer.type, is_16x8 ? 0.005f : 0.2f,
+                               is_16x8 ? 0 : -20);
+    std::uniform_int_distribution<int> weight(-127, 127);
+    std::uniform_int_distribution<int> bias_value(-20000, 20000);
+    for (int8_t& value : filter.data) {
+      value = static_cast<int8_t>(weight(rng));
+    }
+    for (Bias& value : bias.data) {
+      value = bias_value(rng);
+    }
+  }
+
+  void RandomInput(std::mt19937& rng) {
+    std::uniform_int_distribution<int> value(std::numeric_limits<Act>::min(), std::numeric_limits<Act>::max());
+    for (Act& element : input.data) {
+      element = static_cast<Act>(value(rng));
+    }
+  }
+};
+
+struct AllLayers {
+  LayerTensors<int8_t, int32_t> int8_layers[kLayerCount];
+  LayerTensors<int16_t, int64_t> int16_layers[kLayerCount];
+};
+
+struct LayerResult {
+  long invokes = 0;
+  long tiles = 0;
+  long mismatches = 0;
+  long failures = 0;
+};
+
+long g_failures = 0;
+
+void Fail(const char* message, const char* layer, long value) {
+  if (g_failures++ < kMaxPrinted) {
+    printf("%s : %s (%ld)\n", layer, message, value);
+  }
+}
+
+int TileCount(const Layer& layer) {
+  const int tile_rows = std::min<int>(
+      layer.output_depth, static_cast<int>(tflite::KwsWeightStreamTileCapacity() / layer.accum_depth));
+  return (layer.output_depth + tile_rows - 1) / tile_rows;
+}
+
+TfLiteFullyConnectedParams FullyConnectedParams() {
+  TfLiteFullyConnectedParams params = {};
+  params.activation = kTfLiteActNone;
+  params.weights_format = kTfLiteFullyConnectedWeightsFormatDefault;
+  return params;
+}
+
+/* The output of every invoke of `inputs` with the kernel of `registration`,
+   one kernel runner at a time since they share their arena */
+template <typename Act, typename Bias>
+TfLiteStatus RunInputs(const TFLMRegistration& registration, LayerTensors<Act, Bias>& layer,
+                       const std::vector<std::vector<Act>>& inputs, std::vector<std::vector<Act>>* outputs) {
+  int input_indices[] = {3, 0, 1, 2};
+  int output_indices[] = {1, 3};
+  TfLiteFullyConnectedParams params = FullyConnectedParams();
+  tflite::micro::KernelRunner runner(registration, layer.tensors, 4,
+                                     tflite::testing::IntArrayFromInts(input_indices),
+                                     tflite::testing::IntArrayFromInts(output_indices), &params);
+  TF_LITE_ENSURE_STATUS(runner.InitAndPrepare());
+  outputs->clear();
+  for (const std::vector<Act>& input : inputs) {
+    layer.input.data = input;
+    std::fill(layer.output.data.begin(), layer.output.data.end(), 0);
+    TF_LITE_ENSURE_STATUS(runner.Invoke());
+    outputs->push_back(layer.output.data);
+  }
+  return kTfLiteOk;
+}
+
+template <typename Act, typename Bias>
+void RunRound(const Layer& layer, LayerTensors<Act, Bias>& tensors, std::mt19937& rng, LayerResult* result) {
+  std::vector<std::vector<Act>> inputs(std::uniform_int_distribution<int>(1, 4)(rng));
+  for (std::vector<Act>& input : inputs) {
+    tensors.RandomInput(rng);
+    input = tensors.input.data;
+  }
+  std::vector<std::vector<Act>> resident;
+  std::vector<std::vector<Act>> streamed;
+  g_fetch_delay_us.store(static_cast<int>(tflite::KwsWeightStreamTileCapacity() / kFlashBytesPerUs));
+  if ((RunInputs(tflite::Register_FULLY_CONNECTED(), tensors, inputs, &resident) != kTfLiteOk) ||
+      (RunInputs(tflite::Register_KWS_FULLY_CONNECTED_STREAMED(), tensors, inputs, &streamed) != kTfLiteOk)) {
+    result->failures++;
+    Fail("kernel failed", layer.name, 0);
+    return;
+  }
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (resident[i] != streamed[i]) {
+      result->mismatches++;
+      Fail("output differs", layer.name, static_cast<long>(i));
+    }
+  }
+  result->invokes += static_cast<long>(inputs.size());
+  result->tiles += static_cast<long>(inputs.size()) * TileCount(layer);
+}
+
+/* Mean time of one invoke, with kInvokeGapUs between the invokes */
+template <typename Act, typename Bias>
+double InvokeMicroseconds(const TFLMRegistration& registration, LayerTensors<Act, Bias>& layer) {
+  int input_indices[] = {3, 0, 1, 2};
+  int output_indices[] = {1, 3};
+  TfLiteFullyConnectedParams params = FullyConnectedParams();
+  tflite::micro::KernelRunner runner(registration, layer.tensors, 4,
+                                     tflite::testing::IntArrayFromInts(input_indices),
+                                     tflite::testing::IntArrayFromInts(output_indices), &params);
+  if ((runner.InitAndPrepare() != kTfLiteOk) || (runner.Invoke() != kTfLiteOk)) {
+    return -1.0;
+  }
+  double total_us = 0.0;
+  for (int i = 0; i < kTimedInvokes; ++i) {
+    std::this_thread::sleep_for(std::chrono::microseconds(kInvokeGapUs));
+    const auto start = std::chrono::steady_clock::now();
+    runner.Invoke();
+    total_us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  }
+  return total_us / kTimedInvokes;
+}
+
+const tflite::KwsWeightStreamStats* StatsOf(const void* tensor_data) {
+  for (int slot = 0; slot < KEYWORD_SPOTTING_WEIGHT_STREAM_MAX_TENSORS; ++slot) {
+    const tflite::KwsWeightStreamStats* stats = tflite::KwsWeightStreamGetStats(slot);
+    if ((stats != nullptr) && (stats->tensor_data == tensor_data)) {
+      return stats;
+    }
+  }
+  return nullptr;
+}
+
+template <typename Act, typename Bias>
+void TimeLayer(const Layer& layer, LayerTensors<Act, Bias>& tensors) {
+  const tflite::KwsWeightStreamStats* stats = StatsOf(tensors.filter.data.data());
+  g_fetch_delay_us.store(0);
+  const double resident_us = InvokeMicroseconds(tflite::Register_KWS_FULLY_CONNECTED_16X8(), tensors);
+  const double fast_us = InvokeMicroseconds(tflite::Register_KWS_FULLY_CONNECTED_STREAMED(), tensors);
+  g_fetch_delay_us.store(static_cast<int>(tflite::KwsWeightStreamTileCapacity() / kFlashBytesPerUs));
+  const uint32_t slow_hits = (stats != nullptr) ? stats->prefetch_hits : 0;
+  const uint32_t slow_misses = (stats != nullptr) ? stats->prefetch_misses : 0;
+  const int64_t slow_stall_us = (stats != nullptr) ? stats->stall_us : 0;
+  const double slow_us = InvokeMicroseconds(tflite::Register_KWS_FULLY_CONNECTED_STREAMED(), tensors);
+  if ((resident_us < 0.0) || (fast_us < 0.0) || (slow_us < 0.0) || (stats == nullptr)) {
+    Fail("timing failed", layer.name, 0);
+    return;
+  }
+  const uint32_t timed_hits = stats->prefetch_hits - slow_hits;
+  const uint32_t timed_misses = stats->prefetch_misses - slow_misses;
+  printf("%-16s : %2d tiles, resident %7.1f us, streamed %7.1f us (fast source) %7.1f us (slow flash, "
+         "%u hits %u misses, %.1f us stalled per invoke)\n",
+         layer.name, TileCount(layer), resident_us, fast_us, slow_us, timed_hits, timed_misses,
+         static_cast<double>(stats->stall_us - slow_stall_us) / (kTimedInvokes + 1));
+}
+
+}  // namespace
+
+int main() {
+  host_port_set_receive_hook(SlowFlash);
+  if (tflite::KwsWeightStreamInit() != kTfLiteOk) {
+    printf("KwsWeightStreamInit failed\nFAIL\n");
+    return 1;
+  }
+
+  std::mt19937 rng(1);
+  static AllLayers layers;
+  for (int i = 0; i < kLayerCount; ++i) {
+    if (kLayers[i].type == kTfLiteInt16) {
+      layers.int16_layers[i].Create(kLayers[i], rng);
+    } else {
+      layers.int8_layers[i].Create(kLayers[i], rng);
+    }
+  }
+
+  LayerResult results[kLayerCount];
+  std::uniform_int_distribution<int> pick(0, kLayerCount - 1);
+  for (int round = 0; round < kRounds; ++round) {
+    const int i = pick(rng);
+    if (kLayers[i].type == kTfLiteInt16) {
+      RunRound(kLayers[i], layers.int16_layers[i], rng, &results[i]);
+    } else {
+      RunRound(kLayers[i], layers.int8_layers[i], rng, &results[i]);
+    }
+  }
+
+  for (int i = 0; i < kLayerCount; ++i) {
+    const void* filter = (kLayers[i].type == kTfLiteInt16) ? static_cast<const void*>(layers.int16_layers[i].filter.data.data())
+                                                           : static_cast<const void*>(layers.int8_layers[i].filter.data.data());
+    const tflite::KwsWeightStreamStats* stats = StatsOf(filter);
+    if (stats == nullptr) {
+      Fail("not streamed", kLayers[i].name, 0);
+      continue;
+    }
+    if ((stats->invokes != results[i].invokes) || (stats->tiles != results[i].tiles) ||
+        (stats->prefetch_hits + stats->prefetch_misses != stats->tiles)) {
+      Fail("statistics", kLayers[i].name, static_cast<long>(stats->tiles));
+    }
+    printf("%-16s : %4ld invokes, %ld outputs differ, %ld kernel failures, %u hits %u misses, %lld us stalled\n",
+           kLayers[i].name, results[i].invokes, results[i].mismatches, results[i].failures, stats->prefetch_hits,
+           stats->prefetch_misses, static_cast<long long>(stats->stall_us));
+  }
+
+  printf("Invoke with %d us between invokes, flash of %d MB/s :\n", kInvokeGapUs, kFlashBytesPerUs);
+  for (int i = 0; i < kLayerCount; ++i) {
+    if (kLayers[i].type == kTfLiteInt16) {
+      TimeLayer(kLayers[i], layers.int16_layers[i]);
+    } else {
+      TimeLayer(kLayers[i], layers.int8_layers[i]);
+    }
+  }
+
+  /* The records of the statistics go through the telemetry ring */
+  telemetry_init(esp_timer_get_time);
+  tflite::KwsWeightStreamLogStats();
+  telemetry_record_t record;
+  char line[128];
+  while (telemetry_pop(&record)) {
+    telemetry_format(&record, line, sizeof(line));
+    printf("Telemetry : %s\n", line);
+  }
+
+  const bool pass = (g_failures == 0);
+  printf("%s\n", pass ? "PASS" : "FAIL");
+  return pass ? 0 : 1;
+}
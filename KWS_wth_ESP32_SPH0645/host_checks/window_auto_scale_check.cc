@@ -0,0 +1,424 @@
+/*
+ *  window_auto_scale_check.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+/* Host check and benchmark of the vector window and FFT auto scale
+   (main/KWS/kernels/window_auto_scale.h, the SSE2 or NEON path on a host) :
+   - KwsApplyWindowMaxAbs, KwsMaxAbs16 and KwsFftAutoScale against
+     ApplyWindow + MaxAbs16 and FftAutoScale, on every size up to 600 at
+     aligned and unaligned offsets, with noise, full scale, -32768 and windows
+     which saturate. They must be bit-exact.
+   - the SignalWindow / SignalFftAutoScale kernels : the FftAutoScale takes the
+     max abs of the window only when its input is the window output tensor.
+     Another tensor of the same size, elsewhere or at the address of the
+     window output written again (a buffer reused by the planner), must be
+     measured.
+   - the preprocessor model with both kernels against the stock ones, the
+     features must be bit-exact. In the model a Reshape copies the window
+     output (2D) to the 1D input of the FftAutoScale, so the check also runs a
+     model of a 1D Window and a FftAutoScale of its output, which takes the
+     max abs of the window.
+   It prints the time of one call of the window and auto scale of 480 samples,
+   scalar and vector, and the time of both operators in the two models.
+
+   From KWS_wth_ESP32_SPH0645, with TFLM=managed_components/espressif__esp-tflite-micro
+   and a host build of TFLM with the signal kernels and the kernel test helpers
+   (libtensorflow-microlite.a) :
+     g++ -O2 -std=c++17 -DTF_LITE_STATIC_MEMORY -Imain/KWS -I$TFLM -I$TFLM/third_party/flatbuffers/include \
+         -I$TFLM/third_party/gemmlowp host_checks/window_auto_scale_check.cc \
+         main/KWS/kernels/window_auto_scale.cc libtensorflow-microlite.a -o window_auto_scale_check
+     ./window_auto_scale_check */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "flatbuffers/flexbuffers.h"
+#include "kernels/window_auto_scale.h"
+#include "other/audio_preprocessor_int8_model_data.h"
+#include "signal/src/fft_auto_scale.h"
+#include "signal/src/max_abs.h"
+#include "signal/src/window.h"
+#include "tensorflow/lite/micro/kernels/kernel_runner.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/micro/micro_profiler_interface.h"
+#include "tensorflow/lite/micro/test_helpers.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace {
+
+constexpr int kMaxSize = 600;
+constexpr int kFrameSize = 480;
+constexpr int kWindowShift = 12;
+constexpr int kFrames = 2000;
+constexpr size_t kArenaSize = 32 * 1024;
+
+using PreprocessorOpResolver = tflite::MicroMutableOpResolver<18>;
+
+/* Hann window in Q12, like the preprocessor graph */
+std::vector<int16_t> HannWindow(int size) {
+  std::vector<int16_t> window(size);
+  for (int i = 0; i < size; ++i) {
+    window[i] = static_cast<int16_t>(lround((0.5 - 0.5 * cos(2.0 * M_PI * i / size)) * (1 << kWindowShift)));
+  }
+  return window;
+}
+
+int16_t RandomSample(std::mt19937& rng, int kind) {
+  switch (kind) {
+    case 0:
+      return static_cast<int16_t>(std::uniform_int_distribution<int>(-300, 300)(rng));
+    case 1:
+      return static_cast<int16_t>(std::uniform_int_distribution<int>(-32768, 32767)(rng));
+    case 2:
+      return (rng() & 1) ? -32768 : 32767;
+    default:
+      return static_cast<int16_t>(std::uniform_int_distribution<int>(-3, 3)(rng));
+  }
+}
+
+/* The functions against the scalar ones, returns the number of mismatches */
+long CheckFunctions() {
+  std::mt19937 rng(5);
+  alignas(16) int16_t input[kMaxSize + 8];
+  alignas(16) int16_t window[kMaxSize + 8];
+  alignas(16) int16_t output[kMaxSize + 8];
+  alignas(16) int16_t expected[kMaxSize + 8];
+  long mismatches = 0;
+  long cases = 0;
+  for (int size = 1; size <= kMaxSize; ++size) {
+    for (int offset : {0, 1, 3}) {
+      for (int kind = 0; kind < 4; ++kind) {
+        /* Hann window in Q12, and a window of any value which saturates */
+        for (int shift : {kWindowShift, 3}) {
+          for (int i = 0; i < size; ++i) {
+            input[offset + i] = RandomSample(rng, kind);
+            window[offset + i] = (shift == kWindowShift)
+                                     ? static_cast<int16_t>(rng() % (1 << kWindowShift) + 1)
+                                     : RandomSample(rng, 1);
+          }
+          if (kind == 2) {
+            input[offset + rng() % size] = -32768;
+          }
+          const int16_t* in = input + offset;
+          const int16_t* win = window + offset;
+          const bool fits = tflite::KwsWindowFitsInt16(win, size, shift);
+
+          tflm_signal::ApplyWindow(in, win, size, shift, expected + offset);
+          const int16_t expected_max = tflite::tflm_signal::MaxAbs16(expected + offset, size);
+          const int16_t max = tflite::KwsApplyWindowMaxAbs(in, win, size, shift, fits, output + offset);
+          mismatches += (max != expected_max) ||
+                        (memcmp(output + offset, expected + offset, size * sizeof(int16_t)) != 0);
+
+          mismatches += (tflite::KwsMaxAbs16(in, size) != tflite::tflm_signal::MaxAbs16(in, size));
+
+          const int expected_bits = tflite::tflm_signal::FftAutoScale(in, size, expected + offset);
+          const int bits = tflite::KwsFftAutoScale(in, size, output + offset);
+          mismatches += (bits != expected_bits) ||
+                        (memcmp(output + offset, expected + offset, size * sizeof(int16_t)) != 0);
+          cases += 3;
+        }
+      }
+    }
+  }
+  printf("Functions : %ld cases, %ld mismatches\n", cases, mismatches);
+  return mismatches;
+}
+
+/* SignalWindow of 480 samples, then SignalFftAutoScale on another tensor,
+   through the kernel runner of TFLM */
+class KernelPair {
+ public:
+  KernelPair() {
+    flexbuffers::Builder builder;
+    builder.Map([&]() { builder.Int("shift", kWindowShift); });
+    builder.Finish();
+    init_data_ = builder.GetBuffer();
+
+    const std::vector<int16_t> window = HannWindow(kFrameSize);
+    std::copy(window.begin(), window.end(), weights_);
+    window_tensors_[0] = tflite::testing::CreateTensor(input_, dims_);
+    window_tensors_[1] = tflite::testing::CreateTensor(weights_, dims_);
+    /* Constant weights, like in the model, for the vector path */
+    window_tensors_[1].allocation_type = kTfLiteMmapRo;
+    window_tensors_[2] = tflite::testing::CreateTensor(window_output_, dims_);
+  }
+
+  /* The input of the FftAutoScale is at the address of the window output,
+     written again after the window, or elsewhere */
+  bool Run(std::mt19937& rng, bool same_address) {
+    for (int16_t& sample : input_) {
+      sample = RandomSample(rng, rng() % 4);
+    }
+    for (int16_t& sample : other_) {
+      sample = RandomSample(rng, rng() % 4);
+    }
+
+    tflite::micro::KernelRunner window(*tflite::Register_KWS_WINDOW(), window_tensors_, 3, window_inputs_,
+                                       window_outputs_, nullptr);
+    if ((window.InitAndPrepare(reinterpret_cast<const char*>(init_data_.data()), init_data_.size()) != kTfLiteOk) ||
+        (window.Invoke() != kTfLiteOk)) {
+      return false;
+    }
+    if (same_address) {
+      for (int16_t& sample : window_output_) {
+        sample = static_cast<int16_t>(sample / 64);
+      }
+    }
+
+    int16_t* scale_input = same_address ? window_output_ : other_;
+    TfLiteTensor scale_tensors[3] = {tflite::testing::CreateTensor(scale_input, dims_),
+                                     tflite::testing::CreateTensor(scale_output_, dims_),
+                                     tflite::testing::CreateTensor(&scale_bits_, scalar_dims_)};
+    tflite::micro::KernelRunner scale(*tflite::Register_KWS_FFT_AUTO_SCALE(), scale_tensors, 3, scale_inputs_,
+                                      scale_outputs_, nullptr);
+    if ((scale.InitAndPrepare() != kTfLiteOk) || (scale.Invoke() != kTfLiteOk)) {
+      return false;
+    }
+
+    int16_t expected[kFrameSize];
+    const int expected_bits = tflite::tflm_signal::FftAutoScale(scale_input, kFrameSize, expected);
+    return (scale_bits_ == expected_bits) && (memcmp(scale_output_, expected, sizeof(expected)) == 0);
+  }
+
+ private:
+  int dims_data_[2] = {1, kFrameSize};
+  int scalar_dims_data_[1] = {0};
+  int window_inputs_data_[3] = {2, 0, 1};
+  int window_outputs_data_[2] = {1, 2};
+  int scale_inputs_data_[2] = {1, 0};
+  int scale_outputs_data_[3] = {2, 1, 2};
+  TfLiteIntArray* dims_ = tflite::testing::IntArrayFromInts(dims_data_);
+  TfLiteIntArray* scalar_dims_ = tflite::testing::IntArrayFromInts(scalar_dims_data_);
+  TfLiteIntArray* window_inputs_ = tflite::testing::IntArrayFromInts(window_inputs_data_);
+  TfLiteIntArray* window_outputs_ = tflite::testing::IntArrayFromInts(window_outputs_data_);
+  TfLiteIntArray* scale_inputs_ = tflite::testing::IntArrayFromInts(scale_inputs_data_);
+  TfLiteIntArray* scale_outputs_ = tflite::testing::IntArrayFromInts(scale_outputs_data_);
+  std::vector<uint8_t> init_data_;
+  TfLiteTensor window_tensors_[3];
+  alignas(16) int16_t input_[kFrameSize];
+  alignas(16) int16_t weights_[kFrameSize];
+  alignas(16) int16_t window_output_[kFrameSize];
+  alignas(16) int16_t other_[kFrameSize];
+  alignas(16) int16_t scale_output_[kFrameSize];
+  int32_t scale_bits_ = 0;
+};
+
+long CheckKernels() {
+  std::mt19937 rng(9);
+  KernelPair pair;
+  long failures = 0;
+  for (int i = 0; i < 500; ++i) {
+    failures += !pair.Run(rng, true);
+    failures += !pair.Run(rng, false);
+  }
+  printf("Kernels : 1000 auto scales of another tensor after a window, %ld wrong\n", failures);
+  return failures;
+}
+
+TfLiteStatus RegisterOps(PreprocessorOpResolver& op_resolver, bool kws) {
+  TF_LITE_ENSURE_STATUS(op_resolver.AddReshape());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddCast());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddStridedSlice());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddConcatenation());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddMul());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddAdd());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddDiv());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddMinimum());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddMaximum());
+  if (kws) {
+    TF_LITE_ENSURE_STATUS(op_resolver.AddCustom("SignalWindow", tflite::Register_KWS_WINDOW()));
+    TF_LITE_ENSURE_STATUS(op_resolver.AddCustom("SignalFftAutoScale", tflite::Register_KWS_FFT_AUTO_SCALE()));
+  } else {
+    TF_LITE_ENSURE_STATUS(op_resolver.AddWindow());
+    TF_LITE_ENSURE_STATUS(op_resolver.AddFftAutoScale());
+  }
+  TF_LITE_ENSURE_STATUS(op_resolver.AddRfft());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddEnergy());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddFilterBank());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddFilterBankSquareRoot());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddFilterBankSpectralSubtraction());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddPCAN());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddFilterBankLog());
+  return kTfLiteOk;
+}
+
+/* Time spent in SignalWindow and SignalFftAutoScale */
+class WindowTimer : public tflite::MicroProfilerInterface {
+ public:
+  uint32_t BeginEvent(const char* tag) override {
+    timed_ = (strcmp(tag, "SignalWindow") == 0) || (strcmp(tag, "SignalFftAutoScale") == 0);
+    start_ = std::chrono::steady_clock::now();
+    return 0;
+  }
+  void EndEvent(uint32_t) override {
+    if (timed_) {
+      total_us_ += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_).count();
+    }
+  }
+  double total_us() const { return total_us_; }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+  bool timed_ = false;
+  double total_us_ = 0.0;
+};
+
+/* SignalWindow of a 1D input and SignalFftAutoScale of its output, the
+   graph where the FftAutoScale takes the max abs of the window */
+std::vector<uint8_t> WindowAutoScaleModel() {
+  /* The flatbuffers of TFLM have no default allocator */
+  flatbuffers::DefaultAllocator allocator;
+  flatbuffers::FlatBufferBuilder builder(1024, &allocator);
+  flexbuffers::Builder window_options;
+  window_options.Map([&]() { window_options.Int("shift", kWindowShift); });
+  window_options.Finish();
+  const std::vector<int16_t> window = HannWindow(kFrameSize);
+
+  const flatbuffers::Offset<tflite::Buffer> buffers[] = {
+      tflite::CreateBuffer(builder),
+      tflite::CreateBuffer(builder, builder.CreateVector(reinterpret_cast<const uint8_t*>(window.data()),
+                                                         window.size() * sizeof(int16_t)))};
+  const int32_t frame_shape[] = {kFrameSize};
+  auto tensor = [&](tflite::TensorType type, int dimensions, uint32_t buffer) {
+    return tflite::CreateTensor(builder, builder.CreateVector(frame_shape, dimensions), type, buffer);
+  };
+  const flatbuffers::Offset<tflite::Tensor> tensors[] = {
+      tensor(tflite::TensorType_INT16, 1, 0),  /* input */
+      tensor(tflite::TensorType_INT16, 1, 1),  /* window */
+      tensor(tflite::TensorType_INT16, 1, 0),  /* windowed */
+      tensor(tflite::TensorType_INT16, 1, 0),  /* scaled */
+      tensor(tflite::TensorType_INT32, 0, 0)}; /* scale bits */
+  const flatbuffers::Offset<tflite::OperatorCode> codes[] = {
+      tflite::CreateOperatorCode(builder, tflite::BuiltinOperator_CUSTOM, builder.CreateString("SignalWindow")),
+      tflite::CreateOperatorCode(builder, tflite::BuiltinOperator_CUSTOM,
+                                 builder.CreateString("SignalFftAutoScale"))};
+  const int32_t window_inputs[] = {0, 1};
+  const int32_t window_outputs[] = {2};
+  const int32_t scale_inputs[] = {2};
+  const int32_t scale_outputs[] = {3, 4};
+  const flatbuffers::Offset<tflite::Operator> operators[] = {
+      tflite::CreateOperator(builder, 0, builder.CreateVector(window_inputs, 2), builder.CreateVector(window_outputs, 1),
+                             tflite::BuiltinOptions_NONE, 0, builder.CreateVector(window_options.GetBuffer())),
+      tflite::CreateOperator(builder, 1, builder.CreateVector(scale_inputs, 1), builder.CreateVector(scale_outputs, 2))};
+  const int32_t graph_inputs[] = {0};
+  const flatbuffers::Offset<tflite::SubGraph> subgraph =
+      tflite::CreateSubGraph(builder, builder.CreateVector(tensors, 5), builder.CreateVector(graph_inputs, 1),
+                             builder.CreateVector(scale_outputs, 2), builder.CreateVector(operators, 2));
+  tflite::FinishModelBuffer(builder, tflite::CreateModel(builder, TFLITE_SCHEMA_VERSION, builder.CreateVector(codes, 2),
+                                                         builder.CreateVector(&subgraph, 1), 0,
+                                                         builder.CreateVector(buffers, 2)));
+  return std::vector<uint8_t>(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize());
+}
+
+/* The outputs of the stock kernels against the KWS ones, -1 when the
+   interpreters can't run */
+long CheckModel(const uint8_t* model_data, const char* name) {
+  const tflite::Model* model = tflite::GetModel(model_data);
+  static PreprocessorOpResolver stock_resolver;
+  static PreprocessorOpResolver kws_resolver;
+  static bool registered = false;
+  if (!registered) {
+    if ((RegisterOps(stock_resolver, false) != kTfLiteOk) || (RegisterOps(kws_resolver, true) != kTfLiteOk)) {
+      return -1;
+    }
+    registered = true;
+  }
+  alignas(16) static uint8_t stock_arena[kArenaSize];
+  alignas(16) static uint8_t kws_arena[kArenaSize];
+  WindowTimer stock_timer;
+  WindowTimer kws_timer;
+  tflite::MicroInterpreter stock(model, stock_resolver, stock_arena, kArenaSize, nullptr, &stock_timer);
+  tflite::MicroInterpreter kws(model, kws_resolver, kws_arena, kArenaSize, nullptr, &kws_timer);
+  if ((stock.AllocateTensors() != kTfLiteOk) || (kws.AllocateTensors() != kTfLiteOk)) {
+    return -1;
+  }
+
+  std::mt19937 rng(3);
+  long mismatches = 0;
+  for (int frame = 0; frame < kFrames; ++frame) {
+    const int kind = (frame / 100) % 4;
+    for (int i = 0; i < kFrameSize; ++i) {
+      const int16_t sample = RandomSample(rng, kind);
+      stock.input(0)->data.i16[i] = sample;
+      kws.input(0)->data.i16[i] = sample;
+    }
+    if ((stock.Invoke() != kTfLiteOk) || (kws.Invoke() != kTfLiteOk)) {
+      return -1;
+    }
+    bool same = true;
+    for (size_t i = 0; i < stock.outputs_size(); ++i) {
+      same = same && (memcmp(stock.output(i)->data.raw, kws.output(i)->data.raw, stock.output(i)->bytes) == 0);
+    }
+    mismatches += !same;
+  }
+  printf("%s : %d frames, %ld with different outputs, window + auto scale stock %.2f us, KWS %.2f us\n", name,
+         kFrames, mismatches, stock_timer.total_us() / kFrames, kws_timer.total_us() / kFrames);
+  return mismatches;
+}
+
+template <typename Function>
+double NanosecondsPerCall(Function function) {
+  double best = 1e30;
+  for (int run = 0; run < 15; ++run) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 2000; ++i) {
+      function();
+    }
+    best = std::min(best, std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / 2000);
+  }
+  return best;
+}
+
+void Benchmark() {
+  std::mt19937 rng(11);
+  alignas(16) static int16_t input[kFrameSize];
+  alignas(16) static int16_t output[kFrameSize];
+  alignas(16) static int16_t scaled[kFrameSize];
+  const std::vector<int16_t> window = HannWindow(kFrameSize);
+  for (int16_t& sample : input) {
+    sample = RandomSample(rng, 0);
+  }
+  const bool fits = tflite::KwsWindowFitsInt16(window.data(), kFrameSize, kWindowShift);
+  volatile int sink = 0;
+
+  const double scalar_ns = NanosecondsPerCall([&]() {
+    tflm_signal::ApplyWindow(input, window.data(), kFrameSize, kWindowShift, output);
+    sink = sink + tflite::tflm_signal::FftAutoScale(output, kFrameSize, scaled);
+  });
+  const double vector_ns = NanosecondsPerCall([&]() {
+    tflite::KwsApplyWindowMaxAbs(input, window.data(), kFrameSize, kWindowShift, fits, output);
+    sink = sink + tflite::KwsFftAutoScale(output, kFrameSize, scaled);
+  });
+  printf("Window + auto scale of %d samples : scalar %.0f ns, vector %.0f ns (best of 15)\n", kFrameSize, scalar_ns,
+         vector_ns);
+}
+
+}  // namespace
+
+int main() {
+  const long function_mismatches = CheckFunctions();
+  const long kernel_failures = CheckKernels();
+  const std::vector<uint8_t> direct_model = WindowAutoScaleModel();
+  const long model_mismatches = CheckModel(g_audio_preprocessor_int8_tflite, "Preprocessor model");
+  const long direct_mismatches = CheckModel(direct_model.data(), "1D Window -> FftAutoScale");
+  if ((model_mismatches < 0) || (direct_mismatches < 0)) {
+    fprintf(stderr, "The preprocessor model doesn't run\n");
+    return 1;
+  }
+  Benchmark();
+
+  const bool pass = (function_mismatches == 0) && (kernel_failures == 0) && (model_mismatches == 0) &&
+                    (direct_mismatches == 0);
+  printf("%s\n", pass ? "PASS" : "FAIL");
+  return pass ? 0 : 1;
+}
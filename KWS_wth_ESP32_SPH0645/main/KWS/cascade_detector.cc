@@ -0,0 +1,194 @@
+/*
+ *  cascade_detector.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "cascade_detector.h"
+
+#include <string.h>
+
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+#include "tensorflow/lite/micro/micro_log.h"
+#include "other/micro_model_settings.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+
+extern "C" {
+#include "keyword_spotting_config.h"
+}
+
+/* TAG used for serial message */
+static const char TAG[] = "KWS cascade";
+
+namespace {
+
+constexpr int kStage1ElementCount = KEYWORD_SPOTTING_CASCADE_ROWS * g_kFeatureSize;
+
+/* Stage 1 has its own arena, both interpreters must exist at the same time */
+alignas(16) uint8_t g_stage1_arena[KEYWORD_SPOTTING_CASCADE_ARENA_SIZE];
+tflite::MicroInterpreter *g_stage1_interpreter = nullptr;
+
+/* Noise floor of the energy detector, mean feature value in Q8 */
+int32_t g_noise_floor_q8 = -128 * 256;
+
+/* Strides left for which stage 2 still runs after a trigger */
+int g_hold_strides = 0;
+
+cascade_stats_t g_stats;
+
+}/* namespace */
+
+
+TfLiteStatus cascade_init(const uint8_t *stage1_model)
+{
+  memset( &g_stats , 0 , sizeof(g_stats) );
+  if( stage1_model == nullptr )
+  {
+    ESP_LOGI( TAG , "Stage 1 is the energy detector" );
+    return kTfLiteOk;
+  }
+
+  const tflite::Model *model = tflite::GetModel( stage1_model );
+  if( model->version() != TFLITE_SCHEMA_VERSION )
+  {
+    MicroPrintf("Stage 1 model is schema version %d not equal to supported version %d.",
+                model->version(), TFLITE_SCHEMA_VERSION);
+    return kTfLiteError;
+  }
+
+  /* Operators of the stage 1 model of the notebook */
+  static tflite::MicroMutableOpResolver<5> resolver;
+  if( (resolver.AddDepthwiseConv2D() != kTfLiteOk) ||
+      (resolver.AddFullyConnected() != kTfLiteOk) ||
+      (resolver.AddReshape() != kTfLiteOk) ||
+      (resolver.AddLogistic() != kTfLiteOk) ||
+      (resolver.AddSoftmax() != kTfLiteOk) )
+  {
+    return kTfLiteError;
+  }
+
+  static tflite::MicroInterpreter static_interpreter( model , resolver , g_stage1_arena , sizeof(g_stage1_arena) );
+  if( static_interpreter.AllocateTensors() != kTfLiteOk )
+  {
+    MicroPrintf("AllocateTensors() failed for the stage 1 model");
+    return kTfLiteError;
+  }
+
+  TfLiteTensor *input = static_interpreter.input(0);
+  if( (input->type != kTfLiteInt8) || (input->bytes != kStage1ElementCount) )
+  {
+    MicroPrintf("Stage 1 input must be %d int8 values (%d spectogram rows)", kStage1ElementCount , KEYWORD_SPOTTING_CASCADE_ROWS );
+    return kTfLiteError;
+  }
+
+  g_stage1_interpreter = &static_interpreter;
+  ESP_LOGI( TAG , "Stage 1 model uses %u bytes of arena" , (unsigned)static_interpreter.arena_used_bytes() );
+  return kTfLiteOk;
+}
+
+
+/* Score from 0 to 255 of the newest rows of the spectogram */
+static uint8_t cascade_stage1_score(const int8_t *feature_buffer)
+{
+  /* FeatureProvider keeps the newest rows at the end of the buffer */
+  const int8_t *newest_rows = feature_buffer + (g_kFeatureElementCount - kStage1ElementCount);
+
+  if( g_stage1_interpreter != nullptr )
+  {
+    TfLiteTensor *input = g_stage1_interpreter->input(0);
+    memcpy( input->data.int8 , newest_rows , kStage1ElementCount );
+    if( g_stage1_interpreter->Invoke() != kTfLiteOk )
+    {
+      /* Let stage 2 decide */
+      return 255;
+    }
+    /* The probability that a word is present */
+    TfLiteTensor *output = g_stage1_interpreter->output(0);
+    int32_t probability = output->data.int8[KEYWORD_SPOTTING_CASCADE_STAGE1_OUTPUT] - output->params.zero_point;
+    int32_t score = (int32_t)(probability * output->params.scale * 255.0f);
+    return (uint8_t)( (score < 0) ? 0 : ((score > 255) ? 255 : score) );
+  }
+
+  /* Energy detector : mean of the newest rows above the noise floor */
+  int32_t sum = 0;
+  for( int i = 0 ; i < kStage1ElementCount ; i++ )
+  {
+    sum += newest_rows[i];
+  }
+  int32_t mean_q8 = (sum * 256) / kStage1ElementCount;
+  int32_t score = ((mean_q8 - g_noise_floor_q8) * KEYWORD_SPOTTING_CASCADE_ENERGY_GAIN) >> 8;
+
+  /* The floor follows the quiet parts only, slowly (time constant of 32 strides) */
+  if( score < KEYWORD_SPOTTING_CASCADE_THRESHOLD )
+  {
+    g_noise_floor_q8 += (mean_q8 - g_noise_floor_q8) >> 5;
+  }
+  return (uint8_t)( (score < 0) ? 0 : ((score > 255) ? 255 : score) );
+}
+
+
+bool cascade_should_run_stage2(const int8_t *feature_buffer)
+{
+  const int64_t start_time = esp_timer_get_time();
+  uint8_t score = cascade_stage1_score( feature_buffer );
+  g_stats.stage1_us += esp_timer_get_time() - start_time;
+  g_stats.strides++;
+
+  if( score >= KEYWORD_SPOTTING_CASCADE_THRESHOLD )
+  {
+    g_stats.stage1_triggers++;
+    g_hold_strides = KEYWORD_SPOTTING_CASCADE_HOLD_STRIDES;
+  }
+
+  if( (g_stats.strides % KEYWORD_SPOTTING_CASCADE_LOG_STRIDES) == 0 )
+  {
+    cascade_log_stats();
+  }
+
+  if( g_hold_strides > 0 )
+  {
+    g_hold_strides--;
+    return true;
+  }
+  return false;
+}
+
+
+void cascade_stage2_done(int64_t invoke_us)
+{
+  g_stats.stage2_invokes++;
+  g_stats.stage2_us += invoke_us;
+}
+
+
+const cascade_stats_t *cascade_get_stats(void)
+{
+  return &g_stats;
+}
+
+
+void cascade_log_stats(void)
+{
+  if( g_stats.strides == 0 )
+  {
+    return;
+  }
+
+  /* Time that stage 2 would have taken on the skipped strides, minus the
+     time of stage 1 */
+  int64_t saved_us = 0;
+  if( g_stats.stage2_invokes > 0 )
+  {
+    int64_t stage2_mean_us = g_stats.stage2_us / g_stats.stage2_invokes;
+    saved_us = (int64_t)(g_stats.strides - g_stats.stage2_invokes) * stage2_mean_us - g_stats.stage1_us;
+  }
+
+  ESP_LOGI( TAG , "Strides %u, stage 1 triggers %u, stage 2 rate %u%%, stage 1 %d us/stride, CPU saved %d ms" ,
+            (unsigned)g_stats.strides , (unsigned)g_stats.stage1_triggers ,
+            (unsigned)((100 * g_stats.stage2_invokes) / g_stats.strides) ,
+            (int)(g_stats.stage1_us / g_stats.strides) , (int)(saved_us / 1000) );
+}
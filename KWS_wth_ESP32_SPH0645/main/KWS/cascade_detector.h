@@ -0,0 +1,51 @@
+/*
+ *  cascade_detector.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef CASCADE_DETECTOR_H_
+#define CASCADE_DETECTOR_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "tensorflow/lite/c/common.h"
+
+/* Two stages cascade :
+   Stage 1 is a tiny detector which runs on every stride, on the newest
+   KEYWORD_SPOTTING_CASCADE_ROWS rows of the spectogram given by FeatureProvider.
+   Stage 2 is the KWS model, it runs only when the stage 1 score crosses
+   KEYWORD_SPOTTING_CASCADE_THRESHOLD, and for KEYWORD_SPOTTING_CASCADE_HOLD_STRIDES
+   strides after, so the word can move to the middle of the spectogram.
+
+   Stage 1 is a TFLM model with its own small arena (see the stage 1 cells
+   of KWS_model/kaggle_make_model.ipynb), or an energy detector when no
+   model is given. */
+
+typedef struct
+{
+  uint32_t strides;          /* Times stage 1 ran */
+  uint32_t stage1_triggers;  /* Times the stage 1 score crossed the threshold */
+  uint32_t stage2_invokes;   /* Times stage 2 ran */
+  int64_t stage1_us;         /* Total time of stage 1 */
+  int64_t stage2_us;         /* Total time of stage 2 */
+} cascade_stats_t;
+
+/* stage1_model is the flatbuffer of the stage 1 model, or nullptr to use
+   the energy detector */
+TfLiteStatus cascade_init(const uint8_t *stage1_model);
+
+/* Run stage 1 on the spectogram, returns true if stage 2 must run */
+bool cascade_should_run_stage2(const int8_t *feature_buffer);
+
+/* Called after every stage 2 invoke with its duration */
+void cascade_stage2_done(int64_t invoke_us);
+
+const cascade_stats_t *cascade_get_stats(void);
+
+/* Print the invocation rate of both stages and the time saved */
+void cascade_log_stats(void);
+
+#endif /* CASCADE_DETECTOR_H_ */
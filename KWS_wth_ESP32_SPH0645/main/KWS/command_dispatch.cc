@@ -0,0 +1,178 @@
+/*
+ *  command_dispatch.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "command_dispatch.h"
+
+#include <string.h>
+
+#include "keyword_spotting_config.h"
+
+namespace {
+
+constexpr uint32_t kCapacity = KEYWORD_SPOTTING_COMMAND_QUEUE_SIZE;
+static_assert( (kCapacity & (kCapacity - 1)) == 0 , "The command queue must be a power of two" );
+
+typedef struct
+{
+  int label;
+  command_handler_t handler;
+  void *context;
+  bool ready;              /* Written last, the consumer skips the slot until then */
+} command_handler_entry_t;
+
+command_event_t g_events[kCapacity];
+uint32_t g_head = 0;       /* Next event of the producer */
+uint32_t g_tail = 0;       /* Next event of the consumer */
+command_handler_entry_t g_handlers[COMMAND_DISPATCH_MAX_HANDLERS];
+int g_handler_count = 0;   /* Slots claimed by command_dispatch_add_handler() */
+int64_t (*g_clock_us)(void) = nullptr;
+command_dispatch_stats_t g_stats;
+
+}/* namespace */
+
+
+static uint32_t command_dispatch_clock(void)
+{
+  return (g_clock_us != nullptr) ? (uint32_t) g_clock_us() : 0;
+}
+
+
+void command_dispatch_init(int64_t (*clock_us)(void))
+{
+  g_head = 0;
+  g_tail = 0;
+  for( int i = 0 ; i < COMMAND_DISPATCH_MAX_HANDLERS ; i++ )
+  {
+    g_handlers[i].ready = false;
+  }
+  g_handler_count = 0;
+  g_clock_us = clock_us;
+  memset( &g_stats , 0 , sizeof(g_stats) );
+}
+
+
+bool command_dispatch_add_handler(int label, command_handler_t handler, void *context)
+{
+  if( (handler == nullptr) || (label < COMMAND_DISPATCH_ALL_LABELS) || (label >= COMMAND_DISPATCH_MAX_LABELS) )
+  {
+    return false;
+  }
+  /* Every adder claims its own slot, also when they run at the same time */
+  int slot = __atomic_load_n( &g_handler_count , __ATOMIC_RELAXED );
+  do
+  {
+    if( slot >= COMMAND_DISPATCH_MAX_HANDLERS )
+    {
+      return false;
+    }
+  } while( !__atomic_compare_exchange_n( &g_handler_count , &slot , slot + 1 , true , __ATOMIC_ACQUIRE , __ATOMIC_RELAXED ) );
+
+  g_handlers[slot].label = label;
+  g_handlers[slot].handler = handler;
+  g_handlers[slot].context = context;
+  /* The consumer calls the new handler only once it is written */
+  __atomic_store_n( &g_handlers[slot].ready , true , __ATOMIC_RELEASE );
+  return true;
+}
+
+
+bool command_dispatch_post(int32_t time_ms, int label, int model_id, uint8_t score)
+{
+  const uint32_t head = g_head;
+  const uint32_t fill = head - __atomic_load_n( &g_tail , __ATOMIC_ACQUIRE );
+  if( fill >= kCapacity )
+  {
+    g_stats.dropped++;
+    return false;
+  }
+  if( fill >= kCapacity - kCapacity / 4 )
+  {
+    g_stats.busy_posts++;
+  }
+  if( fill + 1 > g_stats.max_fill )
+  {
+    g_stats.max_fill = fill + 1;
+  }
+
+  command_event_t *event = &g_events[head & (kCapacity - 1)];
+  event->time_ms = time_ms;
+  event->post_us = command_dispatch_clock();
+  event->label = (int16_t) label;
+  event->model_id = (uint8_t) model_id;
+  event->score = score;
+  /* The consumer reads the event only after the new head */
+  __atomic_store_n( &g_head , head + 1 , __ATOMIC_RELEASE );
+  g_stats.posted++;
+  return true;
+}
+
+
+int command_dispatch_run(int max_events)
+{
+  int events = 0;
+  while( events < max_events )
+  {
+    const uint32_t tail = g_tail;
+    if( tail == __atomic_load_n( &g_head , __ATOMIC_ACQUIRE ) )
+    {
+      break;
+    }
+    /* A copy, so the slot is given back to the producer before the handlers run */
+    const command_event_t event = g_events[tail & (kCapacity - 1)];
+    __atomic_store_n( &g_tail , tail + 1 , __ATOMIC_RELEASE );
+
+    const uint32_t start_us = command_dispatch_clock();
+    const int handler_count = __atomic_load_n( &g_handler_count , __ATOMIC_RELAXED );
+    for( int i = 0 ; i < handler_count ; i++ )
+    {
+      if( !__atomic_load_n( &g_handlers[i].ready , __ATOMIC_ACQUIRE ) )
+      {
+        continue;
+      }
+      if( (g_handlers[i].label == COMMAND_DISPATCH_ALL_LABELS) || (g_handlers[i].label == event.label) )
+      {
+        g_handlers[i].handler( &event , g_handlers[i].context );
+      }
+    }
+    const uint32_t end_us = command_dispatch_clock();
+
+    if( end_us - start_us > g_stats.max_handlers_us )
+    {
+      g_stats.max_handlers_us = end_us - start_us;
+    }
+    if( end_us - event.post_us > g_stats.max_delay_us )
+    {
+      g_stats.max_delay_us = end_us - event.post_us;
+    }
+    g_stats.handled++;
+    events++;
+  }
+  return events;
+}
+
+
+uint32_t command_dispatch_pending(void)
+{
+  return __atomic_load_n( &g_head , __ATOMIC_ACQUIRE ) - __atomic_load_n( &g_tail , __ATOMIC_ACQUIRE );
+}
+
+
+const command_dispatch_stats_t *command_dispatch_get_stats(void)
+{
+  return &g_stats;
+}
+
+
+void command_dispatch_count(const command_event_t *event, void *context)
+{
+  command_counters_t *counters = (command_counters_t *) context;
+  if( (event->label >= 0) && (event->label < COMMAND_DISPATCH_MAX_LABELS) )
+  {
+    counters->counts[event->label]++;
+    counters->last_time_ms[event->label] = event->time_ms;
+  }
+}
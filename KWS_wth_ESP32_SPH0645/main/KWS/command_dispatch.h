@@ -0,0 +1,84 @@
+/*
+ *  command_dispatch.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef COMMAND_DISPATCH_H_
+#define COMMAND_DISPATCH_H_
+
+#include <stdint.h>
+
+/* Actions taken on the detected commands, out of the inference task. The KWS
+   task posts every new command as a small event in a bounded ring, which
+   never blocks : when the ring is full the event is dropped and counted. A
+   responder task takes the events out with command_dispatch_run() and calls
+   the handlers of their label (a GPIO, a callback of the application, the
+   counters below), so a slow handler delays the next actions but never the
+   next inference.
+
+   The ring has one producer (the KWS task) and one consumer (the responder
+   task), the head and the tail are only written by one of them. The handlers
+   can be added from any task, also while the responder runs : every adder
+   claims its own slot, and the slot is used once it is written.
+
+   There is nothing of the ESP-IDF in this file, the clock is given to
+   command_dispatch_init(), so it runs on the host. */
+
+#define  COMMAND_DISPATCH_MAX_HANDLERS     (8)
+#define  COMMAND_DISPATCH_MAX_LABELS       (12)
+#define  COMMAND_DISPATCH_ALL_LABELS       (-1)
+
+typedef struct command_event_s
+{
+  int32_t time_ms;         /* Audio time of the detection */
+  uint32_t post_us;        /* Clock when it was posted, for the delay of the handlers */
+  int16_t label;           /* Index in the labels of the model */
+  uint8_t model_id;
+  uint8_t score;           /* Averaged score, 0 to 255 */
+} command_event_t;
+
+typedef void (*command_handler_t)(const command_event_t *event, void *context);
+
+typedef struct
+{
+  uint32_t posted;
+  uint32_t dropped;        /* The ring was full */
+  uint32_t busy_posts;     /* Posted when the ring was 3/4 full or more, the handlers are late */
+  uint32_t handled;        /* Events taken out by command_dispatch_run() */
+  uint32_t max_fill;
+  uint32_t max_delay_us;   /* From the post to the end of the handlers */
+  uint32_t max_handlers_us;
+} command_dispatch_stats_t;
+
+/* Counts of every label, for command_dispatch_count() */
+typedef struct
+{
+  uint32_t counts[COMMAND_DISPATCH_MAX_LABELS];
+  int32_t last_time_ms[COMMAND_DISPATCH_MAX_LABELS];
+} command_counters_t;
+
+/* Empties the ring and removes the handlers, clock_us gives the delays */
+void command_dispatch_init(int64_t (*clock_us)(void));
+
+/* handler is called with context for the events of label, or of every label
+   with COMMAND_DISPATCH_ALL_LABELS. Returns false when there is no room */
+bool command_dispatch_add_handler(int label, command_handler_t handler, void *context);
+
+/* From the producer only, never blocks. Returns false when the event is dropped */
+bool command_dispatch_post(int32_t time_ms, int label, int model_id, uint8_t score);
+
+/* From the consumer only : calls the handlers of at most max_events events,
+   returns how many were taken out */
+int command_dispatch_run(int max_events);
+
+/* Events waiting in the ring */
+uint32_t command_dispatch_pending(void);
+
+const command_dispatch_stats_t *command_dispatch_get_stats(void);
+
+/* A handler, context is a command_counters_t */
+void command_dispatch_count(const command_event_t *event, void *context);
+
+#endif /* COMMAND_DISPATCH_H_ */
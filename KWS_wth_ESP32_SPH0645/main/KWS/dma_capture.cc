@@ -0,0 +1,159 @@
+/*
+ *  dma_capture.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "dma_capture.h"
+
+#include <string.h>
+
+/* dma_capture_push() runs in the DMA receive interrupt, its code is in IRAM */
+#if defined(ESP_PLATFORM)
+#include "esp_attr.h"
+#else
+#define IRAM_ATTR
+#endif
+
+/* The indexes are shared by the interrupt and the reader, which may run on
+   the other core : the samples are written before the index is published */
+static IRAM_ATTR uint32_t dma_capture_load(const uint32_t *index)
+{
+  return __atomic_load_n( index , __ATOMIC_ACQUIRE );
+}
+
+static IRAM_ATTR void dma_capture_store(uint32_t *index, uint32_t value)
+{
+  __atomic_store_n( index , value , __ATOMIC_RELEASE );
+}
+
+
+void dma_capture_size_dma(int latency_ms, int slack_ms, int sample_rate, int channels,
+                          dma_capture_sizing_t *sizing)
+{
+  const uint32_t frame_bytes = sizeof(int32_t) * channels;
+  uint32_t frames = (uint32_t)latency_ms * sample_rate / 1000;
+  if( frames * frame_bytes > DMA_CAPTURE_MAX_DESCRIPTOR_BYTES )
+  {
+    frames = DMA_CAPTURE_MAX_DESCRIPTOR_BYTES / frame_bytes;
+  }
+  if( frames == 0 )
+  {
+    frames = 1;
+  }
+  sizing->dma_frame_num = frames;
+  sizing->buffer_us = (uint32_t)( (uint64_t)frames * 1000000 / sample_rate );
+
+  const uint32_t slack_us = (uint32_t)slack_ms * 1000;
+  sizing->dma_desc_num = (slack_us + sizing->buffer_us - 1) / sizing->buffer_us + 1;
+  if( sizing->dma_desc_num < 2 )
+  {
+    sizing->dma_desc_num = 2;
+  }
+}
+
+
+void dma_capture_init(dma_capture_t *capture, int channels, int16_t *storage, uint32_t capacity)
+{
+  memset( capture , 0 , sizeof(*capture) );
+  capture->channels = (channels > MIC_ARRAY_MAX_CHANNELS) ? MIC_ARRAY_MAX_CHANNELS : channels;
+  capture->capacity = capacity;
+  for( int c = 0 ; c < capture->channels ; c++ )
+  {
+    capture->rings[c] = storage + c * capacity;
+  }
+}
+
+
+uint32_t dma_capture_available(const dma_capture_t *capture)
+{
+  return dma_capture_load( &capture->write_index ) - dma_capture_load( &capture->read_index );
+}
+
+
+IRAM_ATTR bool dma_capture_push(dma_capture_t *capture, const int32_t *frames, int frame_count, int64_t now_us)
+{
+  capture->stats.blocks++;
+  capture->frames += frame_count;
+
+  const uint32_t write_index = capture->write_index;
+  const uint32_t filled = write_index - dma_capture_load( &capture->read_index );
+  if( filled + frame_count > capture->capacity )
+  {
+    capture->stats.dropped_blocks++;
+    return false;
+  }
+
+  /* Up to the end of the ring, then from its start */
+  const uint32_t position = write_index & (capture->capacity - 1);
+  const int first = ((uint32_t)frame_count < capture->capacity - position) ? frame_count : (int)(capture->capacity - position);
+  for( int c = 0 ; c < capture->channels ; c++ )
+  {
+    mic_array_extract_channel( frames , first , c , capture->channels , capture->rings[c] + position );
+    mic_array_extract_channel( frames + first * capture->channels , frame_count - first , c ,
+                               capture->channels , capture->rings[c] );
+  }
+  dma_capture_store( &capture->write_index , write_index + frame_count );
+
+  const uint32_t available = filled + frame_count;
+  if( available > capture->stats.max_fill )
+  {
+    capture->stats.max_fill = available;
+  }
+
+  if( dma_capture_load( &capture->waiting ) && (available >= capture->watermark) )
+  {
+    dma_capture_store( &capture->waiting , 0 );
+    capture->notify_us = now_us;
+    dma_capture_store( &capture->notified , 1 );
+    capture->stats.wakeups++;
+    return true;
+  }
+  return false;
+}
+
+
+bool dma_capture_arm(dma_capture_t *capture, uint32_t samples)
+{
+  capture->watermark = samples;
+  dma_capture_store( &capture->waiting , 1 );
+
+  /* A push between the store and here may have missed the waiting flag */
+  if( dma_capture_available( capture ) >= samples )
+  {
+    dma_capture_store( &capture->waiting , 0 );
+    return true;
+  }
+  return false;
+}
+
+
+int dma_capture_read(dma_capture_t *capture, int16_t *const *dest, int samples, int64_t now_us)
+{
+  capture->stats.reads++;
+  dma_capture_store( &capture->waiting , 0 );
+  if( dma_capture_load( &capture->notified ) )
+  {
+    const int64_t wakeup_us = now_us - capture->notify_us;
+    capture->stats.wakeup_us += wakeup_us;
+    if( wakeup_us > capture->stats.wakeup_max_us )
+    {
+      capture->stats.wakeup_max_us = wakeup_us;
+    }
+    dma_capture_store( &capture->notified , 0 );
+  }
+
+  const uint32_t available = dma_capture_available( capture );
+  const int count = ((uint32_t)samples < available) ? samples : (int)available;
+  const uint32_t read_index = capture->read_index;
+  const uint32_t position = read_index & (capture->capacity - 1);
+  const int first = ((uint32_t)count < capture->capacity - position) ? count : (int)(capture->capacity - position);
+  for( int c = 0 ; c < capture->channels ; c++ )
+  {
+    memcpy( dest[c] , capture->rings[c] + position , first * sizeof(int16_t) );
+    memcpy( dest[c] + first , capture->rings[c] , (count - first) * sizeof(int16_t) );
+  }
+  dma_capture_store( &capture->read_index , read_index + count );
+  return count;
+}
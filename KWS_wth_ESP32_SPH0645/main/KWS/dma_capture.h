@@ -0,0 +1,93 @@
+/*
+ *  dma_capture.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef DMA_CAPTURE_H_
+#define DMA_CAPTURE_H_
+
+#include <stdint.h>
+
+#include "mic_array.h"
+
+/* The capture ring of the i2s_std backend of the audio provider. The DMA
+   receive callback of the I2S channel gives every DMA buffer which is full
+   to dma_capture_push(), in the interrupt, which takes the 16 bits samples
+   of every microphone out of the 32 bits frames straight into its ring :
+   no capture task, no i2s_read() copy and no ring buffer semaphores.
+
+   There is one writer (the interrupt) and one reader (the KWS task), the
+   indexes are free running and only the owner of an index writes it, so
+   nothing is locked. The reader asks for a number of samples with
+   dma_capture_arm(), and the push which makes them available returns true so
+   the interrupt can wake it with a task notification.
+
+   There is nothing of the ESP-IDF in this file, the times are given by the
+   caller, so it runs on the host with a simulated DMA source. */
+
+/* Most bytes of one DMA descriptor of the I2S */
+#define  DMA_CAPTURE_MAX_DESCRIPTOR_BYTES      (4092)
+
+typedef struct
+{
+  uint32_t dma_frame_num;   /* Frames of every DMA buffer, one interrupt each */
+  uint32_t dma_desc_num;    /* DMA buffers */
+  uint32_t buffer_us;       /* Audio of one DMA buffer */
+} dma_capture_sizing_t;
+
+typedef struct
+{
+  uint32_t blocks;          /* DMA buffers given to dma_capture_push() */
+  uint32_t dropped_blocks;  /* DMA buffers lost because the ring was full */
+  uint32_t wakeups;         /* Pushes which woke the reader */
+  uint32_t reads;           /* Times dma_capture_read() ran */
+  uint32_t max_fill;        /* Most samples waiting in the ring, per microphone */
+  int64_t convert_us;       /* Time in the DMA callback, added by the caller */
+  int64_t convert_max_us;
+  int64_t wakeup_us;        /* From the push which woke the reader to its read */
+  int64_t wakeup_max_us;
+} dma_capture_stats_t;
+
+typedef struct
+{
+  int16_t *rings[MIC_ARRAY_MAX_CHANNELS];
+  uint32_t capacity;        /* Samples of every ring, a power of two */
+  int channels;
+  uint32_t write_index;     /* Written by the interrupt only */
+  uint32_t read_index;      /* Written by the reader only */
+  uint32_t watermark;       /* Samples the armed reader waits for */
+  uint32_t waiting;         /* The reader is armed */
+  uint32_t notified;        /* The last wake up was sent, and is not read yet */
+  int64_t notify_us;
+  uint64_t frames;          /* Frames captured since the init */
+  dma_capture_stats_t stats;
+} dma_capture_t;
+
+/* DMA buffers for a target latency : every buffer holds latency_ms of audio
+   (less when a descriptor can't hold it), and there are enough of them to
+   keep slack_ms while the interrupt is held off, plus the one the DMA fills */
+void dma_capture_size_dma(int latency_ms, int slack_ms, int sample_rate, int channels,
+                          dma_capture_sizing_t *sizing);
+
+/* storage holds capacity samples for every channel, one after the other,
+   capacity must be a power of two */
+void dma_capture_init(dma_capture_t *capture, int channels, int16_t *storage, uint32_t capacity);
+
+/* From the DMA callback : one full DMA buffer of interleaved 32 bits frames,
+   dropped when the ring can't hold it. Returns true when the reader has to be
+   woken up */
+bool dma_capture_push(dma_capture_t *capture, const int32_t *frames, int frame_count, int64_t now_us);
+
+/* Samples every ring holds */
+uint32_t dma_capture_available(const dma_capture_t *capture);
+
+/* The reader wants samples of every microphone. Returns true when they are
+   already there, else the push which brings them returns true */
+bool dma_capture_arm(dma_capture_t *capture, uint32_t samples);
+
+/* Up to samples of every microphone into dest[channel], returns how many */
+int dma_capture_read(dma_capture_t *capture, int16_t *const *dest, int samples, int64_t now_us);
+
+#endif /* DMA_CAPTURE_H_ */
@@ -0,0 +1,392 @@
+/*
+ *  feature_engine.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "feature_engine.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "tensorflow/lite/micro/micro_log.h"
+#include "other/micro_features_generator.h"
+#include "other/micro_model_settings.h"
+#include "kernels/fast_log_sqrt.h"
+#include "kernels/rfft_512.h"
+#include "kernels/window_auto_scale.h"
+#include "keyword_spotting_config.h"
+
+
+const feature_engine_config_t g_feature_engine_pcen =
+{
+  FEATURE_ENGINE_PCEN , kFeatureDurationMs , kFeatureStrideMs , g_kFeatureSize , g_kFeatureSize , 125 , 7500 , 0 , 0
+};
+
+/* Their range covers a quiet input (-80 dBFS noise) up to a full scale tone */
+const feature_engine_config_t g_feature_engine_log_mel =
+{
+  FEATURE_ENGINE_LOG_MEL , kFeatureDurationMs , kFeatureStrideMs , g_kFeatureSize , g_kFeatureSize , 125 , 7500 , 0 , 640
+};
+
+const feature_engine_config_t g_feature_engine_mfcc =
+{
+  FEATURE_ENGINE_MFCC , kFeatureDurationMs , kFeatureStrideMs , g_kFeatureSize , g_kFeatureSize , 125 , 7500 , -2048 , 3072
+};
+
+
+namespace {
+
+constexpr int kWindowBits = 12;
+constexpr int kMelWeightBits = 12;
+constexpr int kDctBits = 14;
+constexpr int kLogScale = 1 << 6;       /* Q6 natural log */
+constexpr int kLn2Q16 = 45426;          /* ln(2) in Q16 */
+
+constexpr int kStrideSamples = kFeatureStrideMs * kAudioSampleFrequency / 1000;
+constexpr int kHistorySamples = kMaxAudioSampleSize - kStrideSamples;
+constexpr int kSpectrumBins = tflite::kKwsRfftLength / 2 + 1;
+
+/* One mel filter, its non zero weights are from first_bin */
+typedef struct
+{
+  uint16_t first_bin;
+  uint16_t bin_count;
+  uint16_t weight_offset;
+} mel_channel_t;
+
+/* Copy of the active config, the caller may change or free its own. The
+   generation counts the configs which built new tables */
+feature_engine_config_t g_active_config;
+const feature_engine_config_t *g_active = nullptr;
+uint32_t g_generation = 0;
+bool g_pcen_initialized = false;
+
+/* The newest kMaxAudioSampleSize samples, the window is at their end */
+alignas(16) int16_t g_audio[kMaxAudioSampleSize];
+int g_window_size = 0;
+
+alignas(16) int16_t g_window[kMaxAudioSampleSize];
+bool g_window_fits = false;
+/* Windowed audio, zero padded to the FFT length */
+alignas(16) int16_t g_fft_input[tflite::kKwsRfftLength];
+Complex<int16_t> g_spectrum[kSpectrumBins];
+uint32_t g_energy[kSpectrumBins];
+
+/* Every bin is in two filters at most */
+mel_channel_t g_mel_channels[FEATURE_ENGINE_MAX_CHANNELS];
+uint16_t g_mel_weights[2 * kSpectrumBins];
+int g_first_bin = 0;
+int g_last_bin = 0;
+
+int32_t g_log_mel[FEATURE_ENGINE_MAX_CHANNELS];
+int16_t g_dct[g_kFeatureSize * FEATURE_ENGINE_MAX_CHANNELS];
+
+}/* namespace */
+
+
+static float feature_engine_hz_to_mel(float hz)
+{
+  return 1127.0f * logf( 1.0f + hz / 700.0f );
+}
+
+static TfLiteStatus feature_engine_check(const feature_engine_config_t *config)
+{
+  if( (config->stride_ms != kFeatureStrideMs) || (config->num_features != g_kFeatureSize) )
+  {
+    MicroPrintf("Feature engine : stride must be %d ms and features %d", kFeatureStrideMs, g_kFeatureSize);
+    return kTfLiteError;
+  }
+
+  if( config->type == FEATURE_ENGINE_PCEN )
+  {
+    /* Everything else is in the preprocessor graph */
+    if( (config->window_ms != kFeatureDurationMs) || (config->num_channels != g_kFeatureSize) )
+    {
+      MicroPrintf("Feature engine : PCEN is fixed to %d ms and %d channels", kFeatureDurationMs, g_kFeatureSize);
+      return kTfLiteError;
+    }
+    return kTfLiteOk;
+  }
+
+  if( (config->type != FEATURE_ENGINE_LOG_MEL) && (config->type != FEATURE_ENGINE_MFCC) )
+  {
+    MicroPrintf("Feature engine : unknown type %d", config->type);
+    return kTfLiteError;
+  }
+  if( (config->window_ms == 0) || (config->window_ms > kFeatureDurationMs) ||
+      (config->num_channels == 0) || (config->num_channels > FEATURE_ENGINE_MAX_CHANNELS) ||
+      (config->lower_band_hz >= config->upper_band_hz) || (config->upper_band_hz > kAudioSampleFrequency / 2) ||
+      (config->feature_max <= config->feature_min) )
+  {
+    MicroPrintf("Feature engine : bad window, channels, band or range");
+    return kTfLiteError;
+  }
+  if( (config->type == FEATURE_ENGINE_LOG_MEL) && (config->num_features != config->num_channels) )
+  {
+    MicroPrintf("Feature engine : log mel needs one feature per channel");
+    return kTfLiteError;
+  }
+  if( (config->type == FEATURE_ENGINE_MFCC) && (config->num_features > config->num_channels) )
+  {
+    MicroPrintf("Feature engine : more MFCC coefficients than channels");
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+/* Periodic Hann window in Q12, like the window of the preprocessor graph */
+static void feature_engine_build_window(int size)
+{
+  for( int i = 0 ; i < size ; i++ )
+  {
+    const float value = 0.5f - 0.5f * cosf( 2.0f * (float)M_PI * i / size );
+    g_window[i] = (int16_t) lroundf( value * (1 << kWindowBits) );
+  }
+  g_window_fits = tflite::KwsWindowFitsInt16( g_window , size , kWindowBits );
+  memset( g_fft_input , 0 , sizeof(g_fft_input) );
+}
+
+/* Triangular filters equally spaced on the mel scale, each one from the
+   center of the previous filter to the center of the next one */
+static TfLiteStatus feature_engine_build_mel(const feature_engine_config_t *config)
+{
+  const int channels = config->num_channels;
+  const float mel_low = feature_engine_hz_to_mel( config->lower_band_hz );
+  const float mel_step = (feature_engine_hz_to_mel( config->upper_band_hz ) - mel_low) / (channels + 1);
+  const float hz_per_bin = (float)kAudioSampleFrequency / tflite::kKwsRfftLength;
+
+  int weight_count = 0;
+  g_first_bin = kSpectrumBins;
+  g_last_bin = 0;
+  for( int c = 0 ; c < channels ; c++ )
+  {
+    const float left = mel_low + c * mel_step;
+    const float center = left + mel_step;
+    const float right = center + mel_step;
+
+    mel_channel_t *channel = &g_mel_channels[c];
+    channel->first_bin = 0;
+    channel->bin_count = 0;
+    channel->weight_offset = weight_count;
+    for( int bin = 0 ; bin < kSpectrumBins ; bin++ )
+    {
+      const float mel = feature_engine_hz_to_mel( bin * hz_per_bin );
+      if( (mel <= left) || (mel >= right) )
+      {
+        continue;
+      }
+      const float weight = (mel < center) ? (mel - left) / mel_step : (right - mel) / mel_step;
+      const long weight_q = lroundf( weight * (1 << kMelWeightBits) );
+      if( (weight_q == 0) && (channel->bin_count == 0) )
+      {
+        continue;
+      }
+      if( weight_count == (int)(sizeof(g_mel_weights) / sizeof(g_mel_weights[0])) )
+      {
+        return kTfLiteError;
+      }
+      if( channel->bin_count == 0 )
+      {
+        channel->first_bin = bin;
+      }
+      g_mel_weights[weight_count++] = (uint16_t) weight_q;
+      channel->bin_count = bin - channel->first_bin + 1;
+    }
+
+    if( channel->bin_count == 0 )
+    {
+      MicroPrintf("Feature engine : mel channel %d has no FFT bin, use fewer channels", c);
+      return kTfLiteError;
+    }
+    if( channel->first_bin < g_first_bin )
+    {
+      g_first_bin = channel->first_bin;
+    }
+    if( channel->first_bin + channel->bin_count > g_last_bin )
+    {
+      g_last_bin = channel->first_bin + channel->bin_count;
+    }
+  }
+  return kTfLiteOk;
+}
+
+/* Orthonormal DCT-II, the scale of every coefficient is in the table */
+static void feature_engine_build_dct(const feature_engine_config_t *config)
+{
+  const int channels = config->num_channels;
+  for( int k = 0 ; k < config->num_features ; k++ )
+  {
+    const float scale = sqrtf( ((k == 0) ? 1.0f : 2.0f) / channels );
+    for( int n = 0 ; n < channels ; n++ )
+    {
+      const float value = scale * cosf( (float)M_PI * k * (n + 0.5f) / channels );
+      g_dct[k * channels + n] = (int16_t) lroundf( value * (1 << kDctBits) );
+    }
+  }
+}
+
+/* The log mel magnitudes of the window at the end of g_audio, in Q6 */
+static void feature_engine_log_mel(int channels)
+{
+  const int16_t *window_audio = g_audio + kMaxAudioSampleSize - g_window_size;
+  tflite::KwsApplyWindowMaxAbs( window_audio , g_window , g_window_size , kWindowBits , g_window_fits , g_fft_input );
+  const int scale_bits = tflite::KwsFftAutoScale( g_fft_input , tflite::kKwsRfftLength , g_fft_input );
+  tflite::KwsRfft512Int16Apply( g_fft_input , g_spectrum );
+
+  /* Both parts are 16 bits, the sum fits 32 bits unsigned */
+  for( int bin = g_first_bin ; bin < g_last_bin ; bin++ )
+  {
+    const int32_t real = g_spectrum[bin].real;
+    const int32_t imag = g_spectrum[bin].imag;
+    g_energy[bin] = (uint32_t)(real * real) + (uint32_t)(imag * imag);
+  }
+
+  /* The square root halves the weight bits, and the auto scale gain of the
+     FFT input is taken out of the log */
+  const int32_t correction = (int32_t)((((int64_t)(kMelWeightBits / 2 + scale_bits) * kLn2Q16 * kLogScale) + (1 << 15)) >> 16);
+  for( int c = 0 ; c < channels ; c++ )
+  {
+    const mel_channel_t *channel = &g_mel_channels[c];
+    const uint16_t *weights = &g_mel_weights[channel->weight_offset];
+    const uint32_t *energy = &g_energy[channel->first_bin];
+    uint64_t sum = 0;
+    for( int i = 0 ; i < channel->bin_count ; i++ )
+    {
+      sum += (uint64_t)weights[i] * energy[i];
+    }
+
+    const uint32_t magnitude = tflite::KwsSqrt64( sum );
+    const int32_t log_value = (magnitude > 1) ? (int32_t) tflite::KwsLog32( magnitude , kLogScale ) : 0;
+    g_log_mel[c] = log_value - correction;
+  }
+}
+
+static bool feature_engine_same_config(const feature_engine_config_t *a, const feature_engine_config_t *b)
+{
+  return (a->type == b->type) && (a->window_ms == b->window_ms) && (a->stride_ms == b->stride_ms) &&
+         (a->num_channels == b->num_channels) && (a->num_features == b->num_features) &&
+         (a->lower_band_hz == b->lower_band_hz) && (a->upper_band_hz == b->upper_band_hz) &&
+         (a->feature_min == b->feature_min) && (a->feature_max == b->feature_max);
+}
+
+static int8_t feature_engine_quantize(int32_t value, const feature_engine_config_t *config)
+{
+  const int32_t range = config->feature_max - config->feature_min;
+  const int32_t offset = value - config->feature_min;
+  if( offset <= 0 )
+  {
+    return -128;
+  }
+  if( offset >= range )
+  {
+    return 127;
+  }
+  return (int8_t)( ((255 * offset + range / 2) / range) - 128 );
+}
+
+
+TfLiteStatus feature_engine_configure(const feature_engine_config_t *config)
+{
+  if( config == nullptr )
+  {
+    return kTfLiteError;
+  }
+  /* Nothing changed, the contents are compared as the same config may have
+     been edited */
+  if( (g_active != nullptr) && feature_engine_same_config( config , g_active ) )
+  {
+    return kTfLiteOk;
+  }
+  TF_LITE_ENSURE_STATUS( feature_engine_check( config ) );
+
+  if( config->type == FEATURE_ENGINE_PCEN )
+  {
+    /* The interpreter of the preprocessor is built once, its arena would be
+       allocated again by a second InitializeMicroFeatures() */
+    if( !g_pcen_initialized )
+    {
+      TF_LITE_ENSURE_STATUS( InitializeMicroFeatures() );
+      g_pcen_initialized = true;
+    }
+  }
+  else
+  {
+    g_window_size = config->window_ms * kAudioSampleFrequency / 1000;
+    feature_engine_build_window( g_window_size );
+    TF_LITE_ENSURE_STATUS( feature_engine_build_mel( config ) );
+    if( config->type == FEATURE_ENGINE_MFCC )
+    {
+      feature_engine_build_dct( config );
+    }
+  }
+
+  g_active_config = *config;
+  g_active = &g_active_config;
+  g_generation++;
+  return kTfLiteOk;
+}
+
+
+const feature_engine_config_t *feature_engine_active(void)
+{
+  return g_active;
+}
+
+
+uint32_t feature_engine_generation(void)
+{
+  return g_generation;
+}
+
+
+TfLiteStatus feature_engine_process(const int16_t *new_samples, int new_samples_size, int8_t *features)
+{
+  if( (g_active == nullptr) || (new_samples_size != kStrideSamples) )
+  {
+    MicroPrintf("Feature engine wants %d samples, got %d", kStrideSamples, new_samples_size);
+    return kTfLiteError;
+  }
+
+#if KEYWORD_SPOTTING_STREAMING_FRONTEND
+  /* The Framer of the streaming preprocessor keeps its own overlap */
+  if( g_active->type == FEATURE_ENGINE_PCEN )
+  {
+    return GenerateStreamingFeature( new_samples , new_samples_size , features );
+  }
+#endif
+
+  memmove( g_audio , g_audio + kStrideSamples , kHistorySamples * sizeof(int16_t) );
+  memcpy( g_audio + kHistorySamples , new_samples , kStrideSamples * sizeof(int16_t) );
+
+  if( g_active->type == FEATURE_ENGINE_PCEN )
+  {
+#if !KEYWORD_SPOTTING_STREAMING_FRONTEND
+    return GenerateFeature( g_audio , kMaxAudioSampleSize , features );
+#endif
+  }
+
+  const int channels = g_active->num_channels;
+  feature_engine_log_mel( channels );
+  if( g_active->type == FEATURE_ENGINE_LOG_MEL )
+  {
+    for( int c = 0 ; c < channels ; c++ )
+    {
+      features[c] = feature_engine_quantize( g_log_mel[c] , g_active );
+    }
+    return kTfLiteOk;
+  }
+
+  for( int k = 0 ; k < g_active->num_features ; k++ )
+  {
+    const int16_t *cosines = &g_dct[k * channels];
+    int64_t sum = 0;
+    for( int n = 0 ; n < channels ; n++ )
+    {
+      sum += (int32_t)cosines[n] * g_log_mel[n];
+    }
+    features[k] = feature_engine_quantize( (int32_t)((sum + (1 << (kDctBits - 1))) >> kDctBits) , g_active );
+  }
+  return kTfLiteOk;
+}
@@ -0,0 +1,83 @@
+/*
+ *  feature_engine.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef FEATURE_ENGINE_H_
+#define FEATURE_ENGINE_H_
+
+#include <stdint.h>
+
+#include "tensorflow/lite/c/common.h"
+
+/* The frontend which makes one spectogram row from every stride of audio.
+   Every model of the registry says which features it was trained on with a
+   feature_engine_config_t, and the engine is changed with the model.
+
+   - PCEN : the TFLM preprocessor model (noise reduction, PCAN gain control
+     and log), its window, stride and channels are fixed by the model graph.
+   - LOG_MEL : log of the mel filterbank magnitudes.
+   - MFCC : DCT-II (orthonormal) of the log mel magnitudes.
+
+   LOG_MEL and MFCC are fixed point : Hann window (Q12), FFT auto scale and
+   512 points FFT, energies on 32 bits, mel filters (Q12) summed on 64 bits,
+   square root and log of KWS/kernels, and the DCT with a Q14 table. Their
+   values are the natural log in Q6 (like the log scale of the microfrontend),
+   and are quantized to the int8 model input with feature_min and feature_max,
+   like the training script : round( 255 * (v - min) / (max - min) ) - 128.
+
+   Every engine keeps the overlap of the window with the previous stride, so
+   the strides have to be given in the audio order. */
+
+/* Most mel channels of LOG_MEL and MFCC */
+#define  FEATURE_ENGINE_MAX_CHANNELS      (64)
+
+typedef enum
+{
+  FEATURE_ENGINE_PCEN = 0,
+  FEATURE_ENGINE_LOG_MEL,
+  FEATURE_ENGINE_MFCC,
+} feature_engine_type_t;
+
+typedef struct
+{
+  feature_engine_type_t type;
+  uint16_t window_ms;      /* At most kFeatureDurationMs, the end of the window is the end of the stride */
+  uint16_t stride_ms;      /* Must be kFeatureStrideMs */
+  uint8_t num_channels;    /* Mel channels */
+  uint8_t num_features;    /* Values of one spectogram row, num_channels for LOG_MEL, the first coefficients for MFCC */
+  uint16_t lower_band_hz;
+  uint16_t upper_band_hz;
+  int16_t feature_min;     /* Quantization of LOG_MEL and MFCC, in the engine unit */
+  int16_t feature_max;
+} feature_engine_config_t;
+
+/* The features of the preprocessor model, used by the models which don't
+   have a config. The LOG_MEL and MFCC configs are the usual 30 ms / 20 ms
+   40 channels features, their range goes from a quiet input up to a full
+   scale tone. A model trained with other values needs its own config */
+extern const feature_engine_config_t g_feature_engine_pcen;
+extern const feature_engine_config_t g_feature_engine_log_mel;
+extern const feature_engine_config_t g_feature_engine_mfcc;
+
+/* Check the config and build the tables of its engine (window, mel filters
+   and DCT). Nothing is done if the active config has the same values. The
+   config is copied, the caller can change it after. The rows
+   made by the previous engine don't match the new ones, so the spectogram
+   has to be filled again */
+TfLiteStatus feature_engine_configure(const feature_engine_config_t *config);
+
+/* The copy of the active config, nullptr before the first configure */
+const feature_engine_config_t *feature_engine_active(void);
+
+/* Incremented every time feature_engine_configure() builds new tables, 0
+   before the first configure */
+uint32_t feature_engine_generation(void);
+
+/* One spectogram row (num_features values) from the new samples of one
+   stride (stride_ms of audio) */
+TfLiteStatus feature_engine_process(const int16_t *new_samples, int new_samples_size, int8_t *features);
+
+#endif /* FEATURE_ENGINE_H_ */
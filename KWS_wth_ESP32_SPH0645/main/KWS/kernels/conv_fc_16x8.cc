@@ -0,0 +1,264 @@
+/*
+ *  conv_fc_16x8.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "conv_fc_16x8.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/conv.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+
+namespace tflite {
+namespace {
+
+/* Products summed in an int32 before they are added to the int64
+   accumulator of a FULLY_CONNECTED row */
+constexpr int kFullyConnectedChunk = 256;
+
+/* The op data of the esp-nn CONV_2D, which also runs our Prepare */
+struct OpDataConv16x8 {
+  OpDataConv op_data;
+  int buffer_idx; /* Scratch buffer of its int8 path */
+};
+
+const TFLMRegistration& ConvRegistration() {
+  static TFLMRegistration registration = Register_CONV_2D();
+  return registration;
+}
+
+const TFLMRegistration& FullyConnectedRegistration() {
+  static TFLMRegistration registration = Register_FULLY_CONNECTED();
+  return registration;
+}
+
+void* Conv16x8Init(TfLiteContext* context, const char*, size_t) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  return context->AllocatePersistentBuffer(context, sizeof(OpDataConv16x8));
+}
+
+TfLiteStatus Conv16x8Prepare(TfLiteContext* context, TfLiteNode* node) {
+  TF_LITE_ENSURE_STATUS(ConvRegistration().prepare(context, node));
+
+  /* Conv16x8 adds no zero point, the int16 activations are symmetric */
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kConvInputTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  TfLiteTensor* output =
+      micro_context->AllocateTempOutputTensor(node, kConvOutputTensor);
+  TF_LITE_ENSURE(context, output != nullptr);
+  if (input->type == kTfLiteInt16) {
+    TF_LITE_ENSURE_EQ(context, input->params.zero_point, 0);
+    TF_LITE_ENSURE_EQ(context, output->params.zero_point, 0);
+  }
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(output);
+  return kTfLiteOk;
+}
+
+template <typename BiasType>
+void Conv16x8(const TfLiteConvParams& params, const OpDataConv& data,
+              const TfLiteEvalTensor* input, const TfLiteEvalTensor* filter,
+              const TfLiteEvalTensor* bias, TfLiteEvalTensor* output) {
+  const RuntimeShape input_shape = tflite::micro::GetTensorShape(input);
+  const RuntimeShape filter_shape = tflite::micro::GetTensorShape(filter);
+  const RuntimeShape output_shape = tflite::micro::GetTensorShape(output);
+
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  const int input_height = input_shape.Dims(1);
+  const int input_width = input_shape.Dims(2);
+  const int input_depth = input_shape.Dims(3);
+  const int filter_height = filter_shape.Dims(1);
+  const int filter_width = filter_shape.Dims(2);
+  const int output_height = output_shape.Dims(1);
+  const int output_width = output_shape.Dims(2);
+  const int output_depth = output_shape.Dims(3);
+  const int filter_size = filter_height * filter_width * input_depth;
+
+  const int16_t* input_data = tflite::micro::GetTensorData<int16_t>(input);
+  const int8_t* filter_data = tflite::micro::GetTensorData<int8_t>(filter);
+  const BiasType* bias_data =
+      tflite::micro::GetOptionalTensorData<BiasType>(bias);
+  int16_t* output_data = tflite::micro::GetTensorData<int16_t>(output);
+
+  for (int batch = 0; batch < batches; ++batch) {
+    const int16_t* batch_input =
+        input_data + batch * input_height * input_width * input_depth;
+    for (int out_y = 0; out_y < output_height; ++out_y) {
+      const int in_y_origin = (out_y * params.stride_height) - data.padding.height;
+      /* Clip the filter window to the image once, instead of testing every tap */
+      const int filter_y_start = std::max(0, -in_y_origin);
+      const int filter_y_end =
+          std::min(filter_height, input_height - in_y_origin);
+      for (int out_x = 0; out_x < output_width; ++out_x) {
+        const int in_x_origin =
+            (out_x * params.stride_width) - data.padding.width;
+        const int filter_x_start = std::max(0, -in_x_origin);
+        const int filter_x_end =
+            std::min(filter_width, input_width - in_x_origin);
+        /* The taps of one filter row are contiguous in the input */
+        const int row_length = (filter_x_end - filter_x_start) * input_depth;
+
+        for (int out_channel = 0; out_channel < output_depth; ++out_channel) {
+          const int8_t* filter_oc = filter_data + out_channel * filter_size;
+          int32_t acc = 0;
+          for (int filter_y = filter_y_start; filter_y < filter_y_end;
+               ++filter_y) {
+            const int16_t* input_ptr =
+                batch_input +
+                ((in_y_origin + filter_y) * input_width + in_x_origin +
+                 filter_x_start) * input_depth;
+            const int8_t* filter_ptr =
+                filter_oc +
+                (filter_y * filter_width + filter_x_start) * input_depth;
+            for (int i = 0; i < row_length; ++i) {
+              acc += filter_ptr[i] * input_ptr[i];
+            }
+          }
+          /* The bias and the requantization on the bias type, like the
+             reference kernel */
+          BiasType total = acc;
+          if (bias_data != nullptr) {
+            total += bias_data[out_channel];
+          }
+          int32_t scaled = MultiplyByQuantizedMultiplier(
+              total, data.per_channel_output_multiplier[out_channel],
+              data.per_channel_output_shift[out_channel]);
+          scaled = std::max(scaled, data.output_activation_min);
+          scaled = std::min(scaled, data.output_activation_max);
+          output_data[Offset(output_shape, batch, out_y, out_x, out_channel)] =
+              static_cast<int16_t>(scaled);
+        }
+      }
+    }
+  }
+}
+
+TfLiteStatus ConvEval(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto& params =
+      *static_cast<const TfLiteConvParams*>(node->builtin_data);
+  const auto& data = static_cast<const OpDataConv16x8*>(node->user_data)->op_data;
+
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kConvInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kConvWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kConvBiasTensor)
+          : nullptr;
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kConvOutputTensor);
+
+  const RuntimeShape input_shape = tflite::micro::GetTensorShape(input);
+  const RuntimeShape filter_shape = tflite::micro::GetTensorShape(filter);
+  const bool is_16x8 =
+      (input->type == kTfLiteInt16) && (filter->type == kTfLiteInt8) &&
+      (params.dilation_width_factor == 1) &&
+      (params.dilation_height_factor == 1) &&
+      /* No grouped convolution */
+      (input_shape.Dims(3) == filter_shape.Dims(3)) &&
+      (filter_shape.Dims(1) * filter_shape.Dims(2) * filter_shape.Dims(3) <=
+       kKws16x8MaxTaps);
+  if (!is_16x8) {
+    return ConvRegistration().invoke(context, node);
+  }
+
+  if ((bias != nullptr) && (bias->type == kTfLiteInt32)) {
+    Conv16x8<int32_t>(params, data, input, filter, bias, output);
+  } else {
+    Conv16x8<int64_t>(params, data, input, filter, bias, output);
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus FullyConnectedEval(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const auto& data = *static_cast<const OpDataFullyConnected*>(node->user_data);
+
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedBiasTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kFullyConnectedOutputTensor);
+
+  /* The 16x8 conversion makes symmetric activations and weights */
+  if ((input->type != kTfLiteInt16) || (filter->type != kTfLiteInt8) ||
+      (data.input_zero_point != 0) || (data.filter_zero_point != 0)) {
+    return FullyConnectedRegistration().invoke(context, node);
+  }
+
+  const RuntimeShape filter_shape = tflite::micro::GetTensorShape(filter);
+  const RuntimeShape output_shape = tflite::micro::GetTensorShape(output);
+  const int output_dim_count = output_shape.DimensionsCount();
+  const int batches = FlatSizeSkipDim(output_shape, output_dim_count - 1);
+  const int output_depth = output_shape.Dims(output_dim_count - 1);
+  const int accum_depth =
+      filter_shape.Dims(filter_shape.DimensionsCount() - 1);
+
+  const int16_t* input_data = tflite::micro::GetTensorData<int16_t>(input);
+  const int8_t* filter_data = tflite::micro::GetTensorData<int8_t>(filter);
+  const int64_t* bias_data =
+      tflite::micro::GetOptionalTensorData<int64_t>(bias);
+  int16_t* output_data = tflite::micro::GetTensorData<int16_t>(output);
+  for (int b = 0; b < batches; ++b) {
+    KwsFullyConnected16x8Rows(data, input_data + b * accum_depth, accum_depth,
+                              filter_data, bias_data, output_depth,
+                              output_data + b * output_depth);
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace
+
+void KwsFullyConnected16x8Rows(const OpDataFullyConnected& params,
+                               const int16_t* input, int accum_depth,
+                               const int8_t* filter, const int64_t* bias,
+                               int rows, int16_t* output) {
+  for (int row = 0; row < rows; ++row) {
+    const int8_t* filter_row = filter + row * accum_depth;
+    int64_t acc = 0;
+    for (int start = 0; start < accum_depth; start += kFullyConnectedChunk) {
+      const int end = std::min(start + kFullyConnectedChunk, accum_depth);
+      int32_t chunk = 0;
+      for (int d = start; d < end; ++d) {
+        chunk += filter_row[d] * input[d];
+      }
+      acc += chunk;
+    }
+    if (bias != nullptr) {
+      acc += bias[row];
+    }
+    int32_t scaled = MultiplyByQuantizedMultiplier(
+        acc, params.output_multiplier, params.output_shift);
+    scaled += params.output_zero_point;
+    scaled = std::max(scaled, params.output_activation_min);
+    scaled = std::min(scaled, params.output_activation_max);
+    output[row] = static_cast<int16_t>(scaled);
+  }
+}
+
+TFLMRegistration Register_KWS_CONV_2D_16X8() {
+  return tflite::micro::RegisterOp(Conv16x8Init, Conv16x8Prepare, ConvEval);
+}
+
+TFLMRegistration Register_KWS_FULLY_CONNECTED_16X8() {
+  return tflite::micro::RegisterOp(FullyConnectedRegistration().init,
+                                   FullyConnectedRegistration().prepare,
+                                   FullyConnectedEval);
+}
+
+}  // namespace tflite
@@ -0,0 +1,42 @@
+/*
+ *  conv_fc_16x8.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef KWS_KERNELS_CONV_FC_16X8_H_
+#define KWS_KERNELS_CONV_FC_16X8_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/micro/kernels/fully_connected.h"
+#include "tensorflow/lite/micro/micro_common.h"
+
+namespace tflite {
+
+/* CONV_2D and FULLY_CONNECTED of the 16x8 models (int16 activations, int8
+   weights, int64 or int32 bias). The int16 layers are computed with 32 bits
+   accumulators, the filter window clipped once per pixel and the bias
+   added at the end, bit-exact with the reference kernels of TFLM, which
+   accumulate every product on 64 bits. Every other case (int8, dilations,
+   filters of more than kKws16x8MaxTaps taps) runs the usual kernel (esp-nn
+   for int8).
+   Use them as : resolver.AddConv2D( Register_KWS_CONV_2D_16X8() ) */
+TFLMRegistration Register_KWS_CONV_2D_16X8();
+TFLMRegistration Register_KWS_FULLY_CONNECTED_16X8();
+
+/* |int16 x int8| < 2^22, so up to 511 products fit in an int32 */
+constexpr int kKws16x8MaxTaps = 511;
+
+/* `rows` output values of a 16x8 FULLY_CONNECTED, for one input row of
+   accum_depth values. filter has the rows of these outputs, bias is
+   nullptr or their bias. Used by fully_connected_streamed.cc on a tile */
+void KwsFullyConnected16x8Rows(const OpDataFullyConnected& params,
+                               const int16_t* input, int accum_depth,
+                               const int8_t* filter, const int64_t* bias,
+                               int rows, int16_t* output);
+
+}  // namespace tflite
+
+#endif /* KWS_KERNELS_CONV_FC_16X8_H_ */
@@ -0,0 +1,493 @@
+/*
+ *  conv_max_pool.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "conv_max_pool.h"
+#include "conv_fc_16x8.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include <esp_nn.h>
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/kernels/padding.h"
+#include "tensorflow/lite/micro/flatbuffer_utils.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/micro_log.h"
+
+namespace tflite {
+namespace {
+
+constexpr int kInputTensor = 0;
+constexpr int kFilterTensor = 1;
+constexpr int kBiasTensor = 2;
+constexpr int kOutputTensor = 0;
+
+/* Indices into the init flexbuffer's vector, the elements are ordered
+   alphabetically by parameter name (the name is in the comment). Padding and
+   activations use the flatbuffer schema enums, like CONV_2D options do. */
+constexpr int kActivationIndex = 0;        // 'activation'
+constexpr int kPaddingIndex = 1;           // 'padding'
+constexpr int kPoolActivationIndex = 2;    // 'pool_activation'
+constexpr int kPoolFilterHeightIndex = 3;  // 'pool_filter_height'
+constexpr int kPoolFilterWidthIndex = 4;   // 'pool_filter_width'
+constexpr int kPoolStrideHeightIndex = 5;  // 'pool_stride_height'
+constexpr int kPoolStrideWidthIndex = 6;   // 'pool_stride_width'
+constexpr int kStrideHeightIndex = 7;      // 'stride_height'
+constexpr int kStrideWidthIndex = 8;       // 'stride_width'
+
+struct OpDataConvMaxPool {
+  /* Parameters read from the flatbuffer */
+  TfLitePadding padding_type;
+  TfLiteFusedActivation activation;
+  TfLiteFusedActivation pool_activation;
+  int stride_width;
+  int stride_height;
+  int pool_filter_width;
+  int pool_filter_height;
+  int pool_stride_width;
+  int pool_stride_height;
+
+  /* Calculated in Prepare */
+  TfLitePaddingValues padding;
+  int conv_output_width;
+  int conv_output_height;
+  int32_t input_offset;
+  int32_t output_offset;
+  int32_t conv_activation_min;
+  int32_t conv_activation_max;
+  int32_t pool_activation_min;
+  int32_t pool_activation_max;
+  int32_t* per_channel_output_multiplier;
+  int32_t* per_channel_output_shift;
+  int rows_buffer_idx;   /* pool_filter_height conv output rows */
+  int window_buffer_idx; /* int8 : filter rows with the vertical padding */
+  int esp_nn_buffer_idx; /* int8 : esp-nn conv scratch, -1 when not needed */
+};
+
+TfLitePadding ToTfLitePadding(int32_t schema_padding) {
+  /* Padding_SAME = 0 , Padding_VALID = 1 in schema_generated.h */
+  return (schema_padding == 0) ? kTfLitePaddingSame : kTfLitePaddingValid;
+}
+
+void* Init(TfLiteContext* context, const char* buffer, size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  auto* data = static_cast<OpDataConvMaxPool*>(
+      context->AllocatePersistentBuffer(context, sizeof(OpDataConvMaxPool)));
+  if (data == nullptr || buffer == nullptr) {
+    return data;
+  }
+
+  tflite::FlexbufferWrapper fbw(reinterpret_cast<const uint8_t*>(buffer),
+                                length);
+  data->activation =
+      static_cast<TfLiteFusedActivation>(fbw.ElementAsInt32(kActivationIndex));
+  data->padding_type = ToTfLitePadding(fbw.ElementAsInt32(kPaddingIndex));
+  data->pool_activation = static_cast<TfLiteFusedActivation>(
+      fbw.ElementAsInt32(kPoolActivationIndex));
+  data->pool_filter_height = fbw.ElementAsInt32(kPoolFilterHeightIndex);
+  data->pool_filter_width = fbw.ElementAsInt32(kPoolFilterWidthIndex);
+  data->pool_stride_height = fbw.ElementAsInt32(kPoolStrideHeightIndex);
+  data->pool_stride_width = fbw.ElementAsInt32(kPoolStrideWidthIndex);
+  data->stride_height = fbw.ElementAsInt32(kStrideHeightIndex);
+  data->stride_width = fbw.ElementAsInt32(kStrideWidthIndex);
+  return data;
+}
+
+TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  auto* data = static_cast<OpDataConvMaxPool*>(node->user_data);
+
+  const bool has_bias = NumInputs(node) == 3;
+  TF_LITE_ENSURE(context, has_bias || NumInputs(node) == 2);
+  TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
+  TF_LITE_ENSURE(context, data->stride_width > 0 && data->stride_height > 0);
+  TF_LITE_ENSURE(context, data->pool_filter_width > 0 &&
+                              data->pool_filter_height > 0 &&
+                              data->pool_stride_width > 0 &&
+                              data->pool_stride_height > 0);
+
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kInputTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  TfLiteTensor* filter =
+      micro_context->AllocateTempInputTensor(node, kFilterTensor);
+  TF_LITE_ENSURE(context, filter != nullptr);
+  TfLiteTensor* bias =
+      has_bias ? micro_context->AllocateTempInputTensor(node, kBiasTensor)
+               : nullptr;
+  TfLiteTensor* output =
+      micro_context->AllocateTempOutputTensor(node, kOutputTensor);
+  TF_LITE_ENSURE(context, output != nullptr);
+
+  /* Only the int8 and 16x8 per-channel paths of our model are fused,
+     everything else should stay as separate CONV_2D and MAX_POOL_2D nodes */
+  TF_LITE_ENSURE(context, input->type == kTfLiteInt8 ||
+                              input->type == kTfLiteInt16);
+  TF_LITE_ENSURE_TYPES_EQ(context, filter->type, kTfLiteInt8);
+  TF_LITE_ENSURE_TYPES_EQ(context, output->type, input->type);
+  /* The 16x8 ConvRow adds no input offset, the int16 activations are
+     symmetric */
+  if (input->type == kTfLiteInt16) {
+    TF_LITE_ENSURE_EQ(context, input->params.zero_point, 0);
+    TF_LITE_ENSURE_EQ(context, output->params.zero_point, 0);
+  }
+  TF_LITE_ENSURE_EQ(context, NumDimensions(input), 4);
+  TF_LITE_ENSURE_EQ(context, NumDimensions(filter), 4);
+  TF_LITE_ENSURE_EQ(context, NumDimensions(output), 4);
+  TF_LITE_ENSURE_EQ(context, filter->quantization.type,
+                    kTfLiteAffineQuantization);
+  /* Grouped convolution is not used by the KWS models */
+  TF_LITE_ENSURE_EQ(context, input->dims->data[3], filter->dims->data[3]);
+  TF_LITE_ENSURE_EQ(context, output->dims->data[3], filter->dims->data[0]);
+
+  const int input_height = input->dims->data[1];
+  const int input_width = input->dims->data[2];
+  const int filter_height = filter->dims->data[1];
+  const int filter_width = filter->dims->data[2];
+  /* The 16x8 products are summed in an int32 */
+  TF_LITE_ENSURE(context, input->type == kTfLiteInt8 ||
+                              filter_height * filter_width *
+                                      input->dims->data[3] <=
+                                  kKws16x8MaxTaps);
+
+  /* Shape of the conv output that the unfused graph would have allocated */
+  data->padding = ComputePaddingHeightWidth(
+      data->stride_height, data->stride_width, 1, 1, input_height, input_width,
+      filter_height, filter_width, data->padding_type,
+      &data->conv_output_height, &data->conv_output_width);
+
+  /* MAX_POOL_2D of the KWS model always uses VALID padding */
+  const int pooled_height =
+      ComputeOutSize(kTfLitePaddingValid, data->conv_output_height,
+                     data->pool_filter_height, data->pool_stride_height);
+  const int pooled_width =
+      ComputeOutSize(kTfLitePaddingValid, data->conv_output_width,
+                     data->pool_filter_width, data->pool_stride_width);
+  TF_LITE_ENSURE_EQ(context, output->dims->data[1], pooled_height);
+  TF_LITE_ENSURE_EQ(context, output->dims->data[2], pooled_width);
+
+  /* MAX_POOL_2D keeps the quantization of its input, so the pooled output
+     scale and zero point are also the conv output ones */
+  const int num_channels = filter->dims->data[0];
+  data->per_channel_output_multiplier =
+      static_cast<int32_t*>(context->AllocatePersistentBuffer(
+          context, num_channels * sizeof(int32_t)));
+  data->per_channel_output_shift =
+      static_cast<int32_t*>(context->AllocatePersistentBuffer(
+          context, num_channels * sizeof(int32_t)));
+  TF_LITE_ENSURE(context, data->per_channel_output_multiplier != nullptr &&
+                              data->per_channel_output_shift != nullptr);
+
+  int32_t output_multiplier;
+  int output_shift;
+  TF_LITE_ENSURE_STATUS(tflite::PopulateConvolutionQuantizationParams(
+      context, input, filter, bias, output, data->activation,
+      &output_multiplier, &output_shift, &data->conv_activation_min,
+      &data->conv_activation_max, data->per_channel_output_multiplier,
+      data->per_channel_output_shift, num_channels));
+  TF_LITE_ENSURE_STATUS(CalculateActivationRangeQuantized(
+      context, data->pool_activation, output, &data->pool_activation_min,
+      &data->pool_activation_max));
+
+  data->input_offset = -input->params.zero_point;
+  data->output_offset = output->params.zero_point;
+
+  /* The conv output rows of one pooling window, the only part of the conv
+     activation tensor which is kept */
+  const int input_depth = input->dims->data[3];
+  const int row_size = data->conv_output_width * num_channels;
+  const size_t element_size = (input->type == kTfLiteInt8) ? 1 : 2;
+  TF_LITE_ENSURE_STATUS(context->RequestScratchBufferInArena(
+      context, data->pool_filter_height * row_size * element_size,
+      &data->rows_buffer_idx));
+  data->window_buffer_idx = -1;
+  data->esp_nn_buffer_idx = -1;
+
+  /* esp-nn computes one conv row from the filter_height input rows under
+     it, the rows out of the image are copied here at the input zero point */
+  if (input->type == kTfLiteInt8) {
+    TF_LITE_ENSURE_STATUS(context->RequestScratchBufferInArena(
+        context, filter_height * input_width * input_depth,
+        &data->window_buffer_idx));
+
+    data_dims_t input_dims = {.width = input_width,
+                              .height = filter_height,
+                              .channels = input_depth,
+                              1};
+    data_dims_t output_dims = {.width = data->conv_output_width,
+                               .height = 1,
+                               .channels = num_channels,
+                               1};
+    data_dims_t filter_dims = {
+        .width = filter_width, .height = filter_height, 0, 0};
+    conv_params_t conv_params = {
+        .in_offset = 0,
+        .out_offset = 0,
+        .stride = {data->stride_width, data->stride_height},
+        .padding = {data->padding.width, 0},
+        .dilation = {0, 0},
+        .activation = {-128, 127}};
+    const int scratch_size = esp_nn_get_conv_scratch_size(
+        &input_dims, &filter_dims, &output_dims, &conv_params);
+    if (scratch_size > 0) {
+      TF_LITE_ENSURE_STATUS(context->RequestScratchBufferInArena(
+          context, scratch_size, &data->esp_nn_buffer_idx));
+    }
+  }
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(filter);
+  if (bias != nullptr) {
+    micro_context->DeallocateTempTfLiteTensor(bias);
+  }
+  micro_context->DeallocateTempTfLiteTensor(output);
+  return kTfLiteOk;
+}
+
+/* Conv output row conv_y [conv_output_width, Cout] of one int8 clip, with
+   esp-nn like CONV_2D. esp-nn is given the filter_height input rows under the
+   row as a filter_height high image without vertical padding : in place when
+   they are all in the image, else copied with the missing rows at the input
+   zero point, which adds nothing to the sums like the CONV_2D padding does.
+   The horizontal padding is the one of the unfused CONV_2D. */
+void ConvRow(TfLiteContext* context, const OpDataConvMaxPool& data,
+             const int8_t* input, const RuntimeShape& input_shape,
+             const TfLiteEvalTensor* filter, const int32_t* bias, int conv_y,
+             int8_t* row) {
+  const RuntimeShape filter_shape = tflite::micro::GetTensorShape(filter);
+  const int input_height = input_shape.Dims(1);
+  const int input_width = input_shape.Dims(2);
+  const int input_depth = input_shape.Dims(3);
+  const int filter_height = filter_shape.Dims(1);
+  const int filter_width = filter_shape.Dims(2);
+  const int output_depth = filter_shape.Dims(0);
+  const int input_row_size = input_width * input_depth;
+
+  const int in_y_origin = (conv_y * data.stride_height) - data.padding.height;
+  const int8_t* window;
+  if ((in_y_origin >= 0) && (in_y_origin + filter_height <= input_height)) {
+    window = input + in_y_origin * input_row_size;
+  } else {
+    int8_t* padded = static_cast<int8_t*>(
+        context->GetScratchBuffer(context, data.window_buffer_idx));
+    for (int filter_y = 0; filter_y < filter_height; ++filter_y) {
+      const int in_y = in_y_origin + filter_y;
+      int8_t* padded_row = padded + filter_y * input_row_size;
+      if ((in_y >= 0) && (in_y < input_height)) {
+        std::memcpy(padded_row, input + in_y * input_row_size,
+                    input_row_size);
+      } else {
+        std::memset(padded_row, -data.input_offset, input_row_size);
+      }
+    }
+    window = padded;
+  }
+
+  data_dims_t input_dims = {.width = input_width,
+                            .height = filter_height,
+                            .channels = input_depth,
+                            1};
+  data_dims_t output_dims = {.width = data.conv_output_width,
+                             .height = 1,
+                             .channels = output_depth,
+                             1};
+  data_dims_t filter_dims = {
+      .width = filter_width, .height = filter_height, 0, 0};
+  conv_params_t conv_params = {
+      .in_offset = data.input_offset,
+      .out_offset = data.output_offset,
+      .stride = {data.stride_width, data.stride_height},
+      .padding = {data.padding.width, 0},
+      .dilation = {0, 0},
+      .activation = {data.conv_activation_min, data.conv_activation_max}};
+  quant_data_t quant_data = {.shift = data.per_channel_output_shift,
+                             .mult = data.per_channel_output_multiplier};
+  esp_nn_conv_s8(&input_dims, window, &filter_dims,
+                 tflite::micro::GetTensorData<int8_t>(filter), bias,
+                 &output_dims, row, &conv_params, &quant_data);
+}
+
+/* Conv output row conv_y of one 16x8 clip, esp-nn has no int16 conv. Same
+   arithmetic as reference_integer_ops::ConvPerChannel, the bias and the
+   requantization are on the bias type : int64 (usually) or int32 */
+template <typename BiasType>
+void ConvRow(TfLiteContext* /* context */, const OpDataConvMaxPool& data,
+             const int16_t* input, const RuntimeShape& input_shape,
+             const TfLiteEvalTensor* filter, const BiasType* bias, int conv_y,
+             int16_t* row) {
+  const RuntimeShape filter_shape = tflite::micro::GetTensorShape(filter);
+  const int input_height = input_shape.Dims(1);
+  const int input_width = input_shape.Dims(2);
+  const int input_depth = input_shape.Dims(3);
+  const int filter_height = filter_shape.Dims(1);
+  const int filter_width = filter_shape.Dims(2);
+  const int output_depth = filter_shape.Dims(0);
+  const int filter_size = filter_height * filter_width * input_depth;
+  const int8_t* filter_data = tflite::micro::GetTensorData<int8_t>(filter);
+
+  const int in_y_origin = (conv_y * data.stride_height) - data.padding.height;
+  /* Clip the filter window to the image once, instead of testing every tap */
+  const int filter_y_start = std::max(0, -in_y_origin);
+  const int filter_y_end = std::min(filter_height, input_height - in_y_origin);
+
+  for (int conv_x = 0; conv_x < data.conv_output_width; ++conv_x) {
+    const int in_x_origin = (conv_x * data.stride_width) - data.padding.width;
+    const int filter_x_start = std::max(0, -in_x_origin);
+    const int filter_x_end = std::min(filter_width, input_width - in_x_origin);
+
+    for (int out_channel = 0; out_channel < output_depth; ++out_channel) {
+      const int8_t* filter_oc = filter_data + out_channel * filter_size;
+      int32_t acc = 0;
+      for (int filter_y = filter_y_start; filter_y < filter_y_end; ++filter_y) {
+        const int in_y = in_y_origin + filter_y;
+        for (int filter_x = filter_x_start; filter_x < filter_x_end;
+             ++filter_x) {
+          const int in_x = in_x_origin + filter_x;
+          const int16_t* input_ptr =
+              input + (in_y * input_width + in_x) * input_depth;
+          const int8_t* filter_ptr =
+              filter_oc + (filter_y * filter_width + filter_x) * input_depth;
+          for (int in_channel = 0; in_channel < input_depth; ++in_channel) {
+            acc += filter_ptr[in_channel] * input_ptr[in_channel];
+          }
+        }
+      }
+      const BiasType total = acc + ((bias != nullptr) ? bias[out_channel] : 0);
+      int32_t scaled = MultiplyByQuantizedMultiplier(
+          total, data.per_channel_output_multiplier[out_channel],
+          data.per_channel_output_shift[out_channel]);
+      scaled += data.output_offset;
+      scaled = std::max(scaled, data.conv_activation_min);
+      scaled = std::min(scaled, data.conv_activation_max);
+      row[conv_x * output_depth + out_channel] = static_cast<int16_t>(scaled);
+    }
+  }
+}
+
+/* MAX_POOL_2D of the pool_filter_height conv rows into one output row. The
+   rows are in ring order, which a max does not care about */
+void MaxPoolRow(const OpDataConvMaxPool& data, const int8_t* rows,
+                int output_width, int depth, int8_t* output) {
+  esp_nn_max_pool_s8(rows, data.conv_output_width, data.pool_filter_height,
+                     output, output_width, 1, data.pool_stride_width, 1,
+                     data.pool_filter_width, data.pool_filter_height, 0, 0,
+                     data.pool_activation_min, data.pool_activation_max,
+                     depth);
+}
+
+void MaxPoolRow(const OpDataConvMaxPool& data, const int16_t* rows,
+                int output_width, int depth, int16_t* output) {
+  const int row_size = data.conv_output_width * depth;
+  for (int out_x = 0; out_x < output_width; ++out_x) {
+    const int conv_x_start = out_x * data.pool_stride_width;
+    for (int channel = 0; channel < depth; ++channel) {
+      int32_t max = data.pool_activation_min;
+      for (int pool_y = 0; pool_y < data.pool_filter_height; ++pool_y) {
+        const int16_t* pixel =
+            rows + pool_y * row_size + conv_x_start * depth + channel;
+        for (int pool_x = 0; pool_x < data.pool_filter_width; ++pool_x) {
+          max = std::max<int32_t>(max, pixel[pool_x * depth]);
+        }
+      }
+      max = std::min(max, data.pool_activation_max);
+      output[out_x * depth + channel] = static_cast<int16_t>(max);
+    }
+  }
+}
+
+template <typename InputType, typename BiasType>
+void EvalConvMaxPool(TfLiteContext* context, const OpDataConvMaxPool& data,
+                     const TfLiteEvalTensor* input,
+                     const TfLiteEvalTensor* filter,
+                     const TfLiteEvalTensor* bias, TfLiteEvalTensor* output) {
+  const RuntimeShape input_shape = tflite::micro::GetTensorShape(input);
+  const RuntimeShape output_shape = tflite::micro::GetTensorShape(output);
+
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  const int input_size = input_shape.FlatSize() / batches;
+  const int output_height = output_shape.Dims(1);
+  const int output_width = output_shape.Dims(2);
+  const int output_depth = output_shape.Dims(3);
+  const int row_size = data.conv_output_width * output_depth;
+
+  const InputType* input_data = tflite::micro::GetTensorData<InputType>(input);
+  const BiasType* bias_data =
+      (bias != nullptr) ? tflite::micro::GetTensorData<BiasType>(bias)
+                        : nullptr;
+  InputType* output_data = tflite::micro::GetTensorData<InputType>(output);
+  InputType* rows = static_cast<InputType*>(
+      context->GetScratchBuffer(context, data.rows_buffer_idx));
+
+  for (int batch = 0; batch < batches; ++batch) {
+    const InputType* batch_input = input_data + batch * input_size;
+    /* The conv output is computed one row at a time into a ring of
+       pool_filter_height rows, each row once : the rows shared by two
+       pooling windows (pool stride < pool filter) stay in the ring */
+    int next_conv_y = 0;
+    for (int out_y = 0; out_y < output_height; ++out_y) {
+      const int conv_y_start = out_y * data.pool_stride_height;
+      const int conv_y_end = conv_y_start + data.pool_filter_height;
+      for (int conv_y = std::max(next_conv_y, conv_y_start);
+           conv_y < conv_y_end; ++conv_y) {
+        ConvRow(context, data, batch_input, input_shape, filter, bias_data,
+                conv_y, rows + (conv_y % data.pool_filter_height) * row_size);
+      }
+      next_conv_y = conv_y_end;
+
+      MaxPoolRow(data, rows, output_width, output_depth,
+                 output_data + ((batch * output_height + out_y) * output_width) *
+                                   output_depth);
+    }
+  }
+}
+
+TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const auto& data = *static_cast<const OpDataConvMaxPool*>(node->user_data);
+
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kFilterTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kBiasTensor)
+          : nullptr;
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
+
+  if (input->type == kTfLiteInt8) {
+    void* scratch = (data.esp_nn_buffer_idx >= 0)
+                        ? context->GetScratchBuffer(context,
+                                                    data.esp_nn_buffer_idx)
+                        : nullptr;
+    esp_nn_set_conv_scratch_buf(scratch);
+    EvalConvMaxPool<int8_t, int32_t>(context, data, input, filter, bias,
+                                     output);
+  } else if ((bias != nullptr) && (bias->type == kTfLiteInt32)) {
+    EvalConvMaxPool<int16_t, int32_t>(context, data, input, filter, bias,
+                                      output);
+  } else {
+    EvalConvMaxPool<int16_t, int64_t>(context, data, input, filter, bias,
+                                      output);
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace
+
+TFLMRegistration* Register_KWS_CONV_MAX_POOL_2D() {
+  static TFLMRegistration r = tflite::micro::RegisterOp(Init, Prepare, Eval);
+  return &r;
+}
+
+}  // namespace tflite
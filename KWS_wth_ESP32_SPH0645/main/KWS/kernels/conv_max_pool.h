@@ -0,0 +1,31 @@
+/*
+ *  conv_max_pool.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef KWS_KERNELS_CONV_MAX_POOL_H_
+#define KWS_KERNELS_CONV_MAX_POOL_H_
+
+#include "tensorflow/lite/micro/micro_common.h"
+
+namespace tflite {
+
+/* Name of the custom operator in the flatbuffer, it is written by
+   KWS_model/fuse_conv_max_pool.py when it replaces a CONV_2D followed by a
+   MAX_POOL_2D with one node */
+constexpr const char* kKwsConvMaxPool2DOpName = "KwsConvMaxPool2D";
+
+/* Int8 (or 16x8) Conv2D (+ fused ReLU) and MaxPool2D in one kernel.
+   The conv output is computed one row at a time (by esp-nn for int8) into a
+   ring of pool_filter_height rows, every row once, and a row of the output is
+   pooled as soon as its window is complete. The conv activation tensor never
+   exists in the arena. Only registered with KEYWORD_SPOTTING_FUSED_CONV_POOL.
+   Inputs  : input [1,H,W,Cin] , filter [Cout,Fh,Fw,Cin] , bias [Cout] (optional)
+   Outputs : pooled output [1,Ph,Pw,Cout] */
+TFLMRegistration* Register_KWS_CONV_MAX_POOL_2D();
+
+}  // namespace tflite
+
+#endif /* KWS_KERNELS_CONV_MAX_POOL_H_ */
@@ -0,0 +1,285 @@
+/*
+ *  fast_log_sqrt.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "fast_log_sqrt.h"
+
+#include "signal/micro/kernels/filter_bank_square_root.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/flatbuffer_utils.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/micro_context.h"
+
+namespace tflite {
+namespace {
+
+/*** Square root ***/
+
+/* The table is indexed by the 9 top bits of the input */
+constexpr int kSqrtLutBits = 9;
+constexpr int kSqrtLutSize = 1 << kSqrtLutBits;
+/* Fraction bits of the table entries */
+constexpr int kSqrtLutFractionBits = 7;
+
+/* Smallest r with r * r >= value */
+constexpr uint32_t ConstexprCeilSqrt(uint32_t value) {
+  uint32_t low = 0;
+  uint32_t high = 1u << 16;
+  while (low < high) {
+    const uint32_t middle = (low + high) / 2;
+    if (middle * middle >= value) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+  return low;
+}
+
+struct SqrtTable {
+  uint16_t root[kSqrtLutSize];
+};
+
+/* ceil(sqrt(i + 1)) in Q7, so an input whose top bits are i has a root below
+   the entry : the Newton steps start above the root and never go under
+   floor(sqrt) */
+constexpr SqrtTable MakeSqrtTable() {
+  SqrtTable table = {};
+  for (int i = 0; i < kSqrtLutSize; ++i) {
+    table.root[i] = static_cast<uint16_t>(ConstexprCeilSqrt(
+        static_cast<uint32_t>(i + 1) << (2 * kSqrtLutFractionBits)));
+  }
+  return table;
+}
+
+constexpr SqrtTable kSqrtTable = MakeSqrtTable();
+
+inline int MostSignificantBit32(uint32_t x) { return 32 - __builtin_clz(x); }
+
+/* floor(sqrt(num)) for num > 0 */
+inline uint32_t FloorSqrt32(uint32_t num) {
+  /* Even shift which leaves the top kSqrtLutBits bits (or less for small
+     inputs), its root is then the table entry shifted by half of it */
+  const int msb = MostSignificantBit32(num);
+  const int shift =
+      (msb > kSqrtLutBits) ? ((msb - kSqrtLutBits + 1) & ~1) : 0;
+  const uint32_t estimate =
+      ((static_cast<uint32_t>(kSqrtTable.root[num >> shift]) << (shift / 2)) +
+       (1u << kSqrtLutFractionBits) - 1) >>
+      kSqrtLutFractionBits;
+
+  /* One Newton step from above, the result is floor(sqrt) or one more */
+  uint32_t root = (estimate + num / estimate) >> 1;
+  if (static_cast<uint64_t>(root) * root > num) {
+    --root;
+  }
+  return root;
+}
+
+/*** Log ***/
+
+/* Same table as signal/src/log.cc */
+const uint16_t kLogLut[] = {
+    0,    224,  442,  654,  861,  1063, 1259, 1450, 1636, 1817, 1992, 2163,
+    2329, 2490, 2646, 2797, 2944, 3087, 3224, 3358, 3487, 3611, 3732, 3848,
+    3960, 4068, 4172, 4272, 4368, 4460, 4549, 4633, 4714, 4791, 4864, 4934,
+    5001, 5063, 5123, 5178, 5231, 5280, 5326, 5368, 5408, 5444, 5477, 5507,
+    5533, 5557, 5578, 5595, 5610, 5622, 5631, 5637, 5640, 5641, 5638, 5633,
+    5626, 5615, 5602, 5586, 5568, 5547, 5524, 5498, 5470, 5439, 5406, 5370,
+    5332, 5291, 5249, 5203, 5156, 5106, 5054, 5000, 4944, 4885, 4825, 4762,
+    4697, 4630, 4561, 4490, 4416, 4341, 4264, 4184, 4103, 4020, 3935, 3848,
+    3759, 3668, 3575, 3481, 3384, 3286, 3186, 3084, 2981, 2875, 2768, 2659,
+    2549, 2437, 2323, 2207, 2090, 1971, 1851, 1729, 1605, 1480, 1353, 1224,
+    1094, 963,  830,  695,  559,  421,  282,  142,  0,    0};
+
+constexpr int kLogSegmentsLog2 = 7;
+constexpr int kLogScaleLog2 = 16;
+constexpr uint32_t kLogScale = 1u << kLogScaleLog2;
+constexpr uint32_t kLogCoeff = 45426; /* ln(2) in Q16 */
+
+/*** Kernels ***/
+
+constexpr int kInputTensor = 0;
+constexpr int kScaleBitsTensor = 1;
+constexpr int kOutputTensor = 0;
+
+// Indices into the init flexbuffer's vector of SignalFilterBankLog.
+constexpr int kInputCorrectionBitsIndex = 0;  // 'input_correction_bits'
+constexpr int kOutputScaleIndex = 1;          // 'output_scale'
+
+struct OpDataFilterBankLog {
+  int input_correction_bits;
+  int output_scale;
+};
+
+TfLiteStatus SquareRootEval(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kInputTensor);
+  const TfLiteEvalTensor* scale_bits =
+      tflite::micro::GetEvalInput(context, node, kScaleBitsTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
+
+  const uint64_t* input_data = tflite::micro::GetTensorData<uint64_t>(input);
+  const int32_t scale_down_bits =
+      *tflite::micro::GetTensorData<int32_t>(scale_bits);
+  uint32_t* output_data = tflite::micro::GetTensorData<uint32_t>(output);
+  const int num_channels = input->dims->data[0];
+  for (int i = 0; i < num_channels; ++i) {
+    output_data[i] = KwsSqrt64(input_data[i]) >> scale_down_bits;
+  }
+  return kTfLiteOk;
+}
+
+void* LogInit(TfLiteContext* context, const char* buffer, size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  auto* data = static_cast<OpDataFilterBankLog*>(
+      context->AllocatePersistentBuffer(context, sizeof(OpDataFilterBankLog)));
+  if (data == nullptr) {
+    return nullptr;
+  }
+
+  tflite::FlexbufferWrapper fbw(reinterpret_cast<const uint8_t*>(buffer),
+                                length);
+  data->input_correction_bits = fbw.ElementAsInt32(kInputCorrectionBitsIndex);
+  data->output_scale = fbw.ElementAsInt32(kOutputScaleIndex);
+  return data;
+}
+
+TfLiteStatus LogPrepare(TfLiteContext* context, TfLiteNode* node) {
+  TF_LITE_ENSURE_EQ(context, NumInputs(node), 1);
+  TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
+
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kInputTensor);
+  TfLiteTensor* output =
+      micro_context->AllocateTempOutputTensor(node, kOutputTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  TF_LITE_ENSURE(context, output != nullptr);
+
+  TF_LITE_ENSURE_EQ(context, NumDimensions(input), 1);
+  TF_LITE_ENSURE_EQ(context, NumDimensions(output), 1);
+
+  TF_LITE_ENSURE_TYPES_EQ(context, input->type, kTfLiteUInt32);
+  TF_LITE_ENSURE_TYPES_EQ(context, output->type, kTfLiteInt16);
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(output);
+  return kTfLiteOk;
+}
+
+TfLiteStatus LogEval(TfLiteContext* context, TfLiteNode* node) {
+  auto* data = static_cast<OpDataFilterBankLog*>(node->user_data);
+
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kInputTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
+
+  const uint32_t* input_data = tflite::micro::GetTensorData<uint32_t>(input);
+  int16_t* output_data = tflite::micro::GetTensorData<int16_t>(output);
+  const int num_channels = input->dims->data[0];
+  const uint32_t correction_bits = data->input_correction_bits;
+  const uint32_t output_scale = data->output_scale;
+  for (int i = 0; i < num_channels; ++i) {
+    const uint32_t scaled = input_data[i] << correction_bits;
+    uint32_t log_value = 0;
+    if (scaled > 1) {
+      log_value = KwsLog32(scaled, output_scale);
+      log_value = (log_value < static_cast<uint32_t>(INT16_MAX))
+                      ? log_value
+                      : static_cast<uint32_t>(INT16_MAX);
+    }
+    output_data[i] = static_cast<int16_t>(log_value);
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace
+
+uint16_t KwsSqrt32(uint32_t num) {
+  if (num == 0) {
+    return 0;
+  }
+  uint32_t root = FloorSqrt32(num);
+  /* Round to nearest like the bit by bit version : up if
+     num - root^2 > root, except at its 16 bits limit */
+  const uint32_t remainder = num - root * root;
+  if ((remainder > root) && (root != 0xFFFF)) {
+    ++root;
+  }
+  return static_cast<uint16_t>(root);
+}
+
+uint32_t KwsSqrt64(uint64_t num) {
+  /* Same shortcut (and off by one near 2^32) as Sqrt64 */
+  if ((num >> 32) == 0) {
+    return KwsSqrt32(static_cast<uint32_t>(num));
+  }
+
+  /* Root of the top word at an even shift, a ~2^-15 estimate from above */
+  const int msb = 64 - __builtin_clzll(num);
+  const int shift = (msb - 31) & ~1;
+  const uint64_t estimate =
+      static_cast<uint64_t>(FloorSqrt32(static_cast<uint32_t>(num >> shift)) +
+                            1)
+      << (shift / 2);
+
+  /* One Newton step, the result is at most 2 above floor(sqrt) */
+  uint64_t root = (estimate + num / estimate) >> 1;
+  if (root > 0xFFFFFFFF) {
+    root = 0xFFFFFFFF;
+  }
+  while (root * root > num) {
+    --root;
+  }
+
+  const uint64_t remainder = num - root * root;
+  if ((remainder > root) && (root != 0xFFFFFFFF)) {
+    ++root;
+  }
+  return static_cast<uint32_t>(root);
+}
+
+uint32_t KwsLog32(uint32_t x, uint32_t out_scale) {
+  const uint32_t integer = MostSignificantBit32(x) - 1;
+
+  /* The bits under the most significant one, in Q16 : shifting the most
+     significant bit to bit 31 replaces the two shifts of
+     Log2FractionPart32, with the same truncation */
+  const uint32_t frac = ((x << (31 - integer)) >> (31 - kLogScaleLog2)) &
+                        (kLogScale - 1);
+  const uint32_t base_seg = frac >> (kLogScaleLog2 - kLogSegmentsLog2);
+  const int32_t seg_offset =
+      frac & ((1u << (kLogScaleLog2 - kLogSegmentsLog2)) - 1);
+  const int32_t c0 = kLogLut[base_seg];
+  const int32_t c1 = kLogLut[base_seg + 1];
+  const int32_t rel_pos = ((c1 - c0) * seg_offset) >> kLogScaleLog2;
+  const uint32_t fraction = frac + c0 + rel_pos;
+
+  /* (kLogCoeff * ((integer << 16) + fraction) + round) >> 16 without the
+     64 bits product : the integer part is a multiple of 2^16 */
+  const uint32_t round = kLogScale / 2;
+  const uint32_t loge =
+      kLogCoeff * integer + ((kLogCoeff * fraction + round) >> kLogScaleLog2);
+  return (out_scale * loge + round) >> kLogScaleLog2;
+}
+
+TFLMRegistration* Register_KWS_FILTER_BANK_SQUARE_ROOT() {
+  static TFLMRegistration r = tflite::micro::RegisterOp(
+      nullptr, FilterBankSquareRootPrepare, SquareRootEval);
+  return &r;
+}
+
+TFLMRegistration* Register_KWS_FILTER_BANK_LOG() {
+  static TFLMRegistration r =
+      tflite::micro::RegisterOp(LogInit, LogPrepare, LogEval);
+  return &r;
+}
+
+}  // namespace tflite
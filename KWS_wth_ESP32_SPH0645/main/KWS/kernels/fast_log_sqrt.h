@@ -0,0 +1,43 @@
+/*
+ *  fast_log_sqrt.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef KWS_KERNELS_FAST_LOG_SQRT_H_
+#define KWS_KERNELS_FAST_LOG_SQRT_H_
+
+#include <stdint.h>
+
+#include "tensorflow/lite/micro/micro_common.h"
+
+namespace tflite {
+
+/* Bit exact versions of tflm_signal::Sqrt32(), Sqrt64() and Log32() over
+   their whole input range, without their data dependent loops :
+   - the square root starts from a table of the square roots of the 9 top bits
+     (taken at an even shift) and does one Newton step with a 32 bits
+     division, the 64 bits one does a second Newton step from the 32 bits
+     root of its top word, then both correct the last bit and round like the
+     bit by bit version (including its saturation at 0xFFFF for Sqrt32).
+   - the log normalizes its input with a count of leading zeros instead of
+     the branches of Log2FractionPart32, and splits the Q16 log2 * ln(2)
+     product so that it stays on 32 bits. */
+uint16_t KwsSqrt32(uint32_t num);
+uint32_t KwsSqrt64(uint64_t num);
+
+/* x must be > 0 */
+uint32_t KwsLog32(uint32_t x, uint32_t out_scale);
+
+/* SignalFilterBankSquareRoot and SignalFilterBankLog using the functions
+   above, with the same Prepare as the normal kernels.
+   Use them as :
+     op_resolver.AddCustom( "SignalFilterBankSquareRoot" , Register_KWS_FILTER_BANK_SQUARE_ROOT() )
+     op_resolver.AddCustom( "SignalFilterBankLog" , Register_KWS_FILTER_BANK_LOG() ) */
+TFLMRegistration* Register_KWS_FILTER_BANK_SQUARE_ROOT();
+TFLMRegistration* Register_KWS_FILTER_BANK_LOG();
+
+}  // namespace tflite
+
+#endif /* KWS_KERNELS_FAST_LOG_SQRT_H_ */
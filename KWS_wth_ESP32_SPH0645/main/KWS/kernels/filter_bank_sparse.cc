@@ -0,0 +1,295 @@
+/*
+ *  filter_bank_sparse.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "filter_bank_sparse.h"
+
+#include <stdint.h>
+
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/flatbuffer_utils.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/micro_ops.h"
+#include "tensorflow/lite/micro/micro_context.h"
+
+namespace tflite {
+namespace {
+
+constexpr int kInputTensor = 0;
+constexpr int kWeightTensor = 1;
+constexpr int kUnweightTensor = 2;
+constexpr int kChFreqStartsTensor = 3;
+constexpr int kChWeightStartsTensor = 4;
+constexpr int kChannelWidthsTensor = 5;
+constexpr int kOutputTensor = 0;
+
+// Indices into the init flexbuffer's vector.
+constexpr int kNumChannelsIndex = 0;  // 'num_channels'
+
+/* The non zero part of one half (rising or falling) of a triangular filter */
+struct FilterHalf {
+  const int16_t* weights;
+  int16_t bin_start;
+  int16_t bin_count;
+};
+
+/* One output channel : the rising half (weights) of its own filter and the
+   falling half (unweights) of the previous one */
+struct ChannelRow {
+  FilterHalf rising;
+  FilterHalf falling;
+  /* Biggest input for which sum(weights) * input still fits 32 bits */
+  uint32_t limit;
+};
+
+struct OpDataFilterBankSparse {
+  /* user_data of the normal SignalFilterBank kernel, only set when it is
+     used instead of the rows */
+  void* generic_data;
+  const char* init_buffer;
+  size_t init_length;
+  int32_t num_channels;
+  ChannelRow* rows;
+};
+
+const TFLMRegistration& GenericFilterBank() {
+  return *tflm_signal::Register_FILTER_BANK();
+}
+
+void* Init(TfLiteContext* context, const char* buffer, size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  auto* data = static_cast<OpDataFilterBankSparse*>(
+      context->AllocatePersistentBuffer(context,
+                                        sizeof(OpDataFilterBankSparse)));
+  if (data == nullptr) {
+    return nullptr;
+  }
+
+  tflite::FlexbufferWrapper fbw(reinterpret_cast<const uint8_t*>(buffer),
+                                length);
+  data->num_channels = fbw.ElementAsInt32(kNumChannelsIndex);
+  data->generic_data = nullptr;
+  data->rows = nullptr;
+  /* The options live in the model, the normal kernel is initialized by
+     Prepare only if it is needed */
+  data->init_buffer = buffer;
+  data->init_length = length;
+  return data;
+}
+
+/* Run a function of the normal kernel with its own user_data */
+template <typename Function>
+TfLiteStatus CallGeneric(Function function, TfLiteContext* context,
+                         TfLiteNode* node) {
+  auto* data = static_cast<OpDataFilterBankSparse*>(node->user_data);
+  node->user_data = data->generic_data;
+  const TfLiteStatus status = function(context, node);
+  node->user_data = data;
+  return status;
+}
+
+/* The rows need constant, positive weights */
+bool CanUseRows(const TfLiteTensor* weights, const TfLiteTensor* unweights,
+                const TfLiteTensor* freq_starts,
+                const TfLiteTensor* weight_starts,
+                const TfLiteTensor* widths) {
+  if (!IsConstantTensor(weights) || !IsConstantTensor(unweights) ||
+      !IsConstantTensor(freq_starts) || !IsConstantTensor(weight_starts) ||
+      !IsConstantTensor(widths)) {
+    return false;
+  }
+  const int weight_count = NumElements(weights);
+  for (int i = 0; i < weight_count; ++i) {
+    if ((weights->data.i16[i] < 0) || (unweights->data.i16[i] < 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Half of the filter of row `row` of the normal kernel, without the zero
+   weights at its ends, returns the sum of its weights */
+uint32_t MakeHalf(const int16_t* half_weights, const TfLiteTensor* freq_starts,
+                  const TfLiteTensor* weight_starts,
+                  const TfLiteTensor* widths, int row, FilterHalf* half) {
+  int first = 0;
+  int last = widths->data.i16[row];
+  half_weights += weight_starts->data.i16[row];
+  while ((first < last) && (half_weights[first] == 0)) {
+    ++first;
+  }
+  while ((last > first) && (half_weights[last - 1] == 0)) {
+    --last;
+  }
+
+  half->weights = half_weights + first;
+  half->bin_start = static_cast<int16_t>(freq_starts->data.i16[row] + first);
+  half->bin_count = static_cast<int16_t>(last - first);
+
+  uint32_t weight_sum = 0;
+  for (int j = first; j < last; ++j) {
+    weight_sum += static_cast<uint32_t>(half_weights[j]);
+  }
+  return weight_sum;
+}
+
+TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  auto* data = static_cast<OpDataFilterBankSparse*>(node->user_data);
+
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kInputTensor);
+  TfLiteTensor* weights =
+      micro_context->AllocateTempInputTensor(node, kWeightTensor);
+  TfLiteTensor* unweights =
+      micro_context->AllocateTempInputTensor(node, kUnweightTensor);
+  TfLiteTensor* freq_starts =
+      micro_context->AllocateTempInputTensor(node, kChFreqStartsTensor);
+  TfLiteTensor* weight_starts =
+      micro_context->AllocateTempInputTensor(node, kChWeightStartsTensor);
+  TfLiteTensor* widths =
+      micro_context->AllocateTempInputTensor(node, kChannelWidthsTensor);
+  TfLiteTensor* output =
+      micro_context->AllocateTempOutputTensor(node, kOutputTensor);
+  TF_LITE_ENSURE(context, (input != nullptr) && (weights != nullptr) &&
+                              (unweights != nullptr) &&
+                              (freq_starts != nullptr) &&
+                              (weight_starts != nullptr) &&
+                              (widths != nullptr) && (output != nullptr));
+  TF_LITE_ENSURE_EQ(context, NumInputs(node), 6);
+  TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
+  TF_LITE_ENSURE_TYPES_EQ(context, input->type, kTfLiteUInt32);
+  TF_LITE_ENSURE_TYPES_EQ(context, weights->type, kTfLiteInt16);
+  TF_LITE_ENSURE_TYPES_EQ(context, unweights->type, kTfLiteInt16);
+  TF_LITE_ENSURE_TYPES_EQ(context, freq_starts->type, kTfLiteInt16);
+  TF_LITE_ENSURE_TYPES_EQ(context, weight_starts->type, kTfLiteInt16);
+  TF_LITE_ENSURE_TYPES_EQ(context, widths->type, kTfLiteInt16);
+  TF_LITE_ENSURE_TYPES_EQ(context, output->type, kTfLiteUInt64);
+  TF_LITE_ENSURE_EQ(context, NumElements(output), data->num_channels);
+  TF_LITE_ENSURE_EQ(context, NumElements(weights), NumElements(unweights));
+  TF_LITE_ENSURE_EQ(context, NumElements(freq_starts), data->num_channels + 1);
+  TF_LITE_ENSURE_EQ(context, NumElements(weight_starts),
+                    data->num_channels + 1);
+  TF_LITE_ENSURE_EQ(context, NumElements(widths), data->num_channels + 1);
+
+  if (CanUseRows(weights, unweights, freq_starts, weight_starts, widths)) {
+    /* The bins and weights are checked once here, Eval doesn't check them */
+    for (int row = 0; row <= data->num_channels; ++row) {
+      const int width = widths->data.i16[row];
+      const int freq_start = freq_starts->data.i16[row];
+      const int weight_start = weight_starts->data.i16[row];
+      TF_LITE_ENSURE(context,
+                     (width >= 0) && (freq_start >= 0) && (weight_start >= 0));
+      TF_LITE_ENSURE(context, freq_start + width <= NumElements(input));
+      TF_LITE_ENSURE(context, weight_start + width <= NumElements(weights));
+    }
+
+    data->rows = static_cast<ChannelRow*>(context->AllocatePersistentBuffer(
+        context, data->num_channels * sizeof(ChannelRow)));
+    TF_LITE_ENSURE(context, data->rows != nullptr);
+
+    /* Output channel c is the row c + 1 of the normal kernel : the weights
+       of row c + 1 plus the unweights of row c (row 0 is its scratch) */
+    for (int channel = 0; channel < data->num_channels; ++channel) {
+      ChannelRow* row = &data->rows[channel];
+      const uint32_t weight_sum =
+          MakeHalf(GetTensorData<int16_t>(weights), freq_starts,
+                   weight_starts, widths, channel + 1, &row->rising) +
+          MakeHalf(GetTensorData<int16_t>(unweights), freq_starts,
+                   weight_starts, widths, channel, &row->falling);
+      row->limit = (weight_sum == 0) ? UINT32_MAX : (UINT32_MAX / weight_sum);
+    }
+  } else {
+    data->generic_data = GenericFilterBank().init(
+        context, data->init_buffer, data->init_length);
+    TF_LITE_ENSURE(context, data->generic_data != nullptr);
+  }
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(weights);
+  micro_context->DeallocateTempTfLiteTensor(unweights);
+  micro_context->DeallocateTempTfLiteTensor(freq_starts);
+  micro_context->DeallocateTempTfLiteTensor(weight_starts);
+  micro_context->DeallocateTempTfLiteTensor(widths);
+  micro_context->DeallocateTempTfLiteTensor(output);
+
+  if (data->generic_data != nullptr) {
+    return CallGeneric(GenericFilterBank().prepare, context, node);
+  }
+  return kTfLiteOk;
+}
+
+/* Sum of one half with a 32 bits accumulator, *max_input is updated with
+   the biggest input of the half */
+inline uint32_t AccumulateHalf32(const FilterHalf& half,
+                                 const uint32_t* input_data,
+                                 uint32_t* max_input) {
+  const uint32_t* input = input_data + half.bin_start;
+  uint32_t accumulator = 0;
+  uint32_t max_value = *max_input;
+  for (int j = 0; j < half.bin_count; ++j) {
+    const uint32_t value = input[j];
+    accumulator += static_cast<uint32_t>(half.weights[j]) * value;
+    max_value = (value > max_value) ? value : max_value;
+  }
+  *max_input = max_value;
+  return accumulator;
+}
+
+inline uint64_t AccumulateHalf64(const FilterHalf& half,
+                                 const uint32_t* input_data) {
+  const uint32_t* input = input_data + half.bin_start;
+  uint64_t accumulator = 0;
+  for (int j = 0; j < half.bin_count; ++j) {
+    accumulator += static_cast<uint32_t>(half.weights[j]) *
+                   static_cast<uint64_t>(input[j]);
+  }
+  return accumulator;
+}
+
+TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
+  auto* data = static_cast<OpDataFilterBankSparse*>(node->user_data);
+  if (data->generic_data != nullptr) {
+    return CallGeneric(GenericFilterBank().invoke, context, node);
+  }
+
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kInputTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
+  const uint32_t* input_data = tflite::micro::GetTensorData<uint32_t>(input);
+  uint64_t* output_data = tflite::micro::GetTensorData<uint64_t>(output);
+
+  for (int channel = 0; channel < data->num_channels; ++channel) {
+    const ChannelRow& row = data->rows[channel];
+    /* The 32 bits sum is exact if every input of the row is at most the
+       limit, since sum(weights) * limit <= UINT32_MAX (the proof is in
+       filter_bank_sparse.h). Otherwise (loud bins of the wide high
+       frequency channels) the row is summed again on 64 bits, like the
+       normal kernel */
+    uint32_t max_input = 0;
+    const uint32_t sum = AccumulateHalf32(row.rising, input_data, &max_input) +
+                         AccumulateHalf32(row.falling, input_data, &max_input);
+    if (max_input <= row.limit) {
+      output_data[channel] = sum;
+    } else {
+      output_data[channel] = AccumulateHalf64(row.rising, input_data) +
+                             AccumulateHalf64(row.falling, input_data);
+    }
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace
+
+TFLMRegistration* Register_KWS_FILTER_BANK() {
+  static TFLMRegistration r = tflite::micro::RegisterOp(Init, Prepare, Eval);
+  return &r;
+}
+
+}  // namespace tflite
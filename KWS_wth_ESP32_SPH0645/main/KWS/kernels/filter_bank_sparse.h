@@ -0,0 +1,38 @@
+/*
+ *  filter_bank_sparse.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef KWS_KERNELS_FILTER_BANK_SPARSE_H_
+#define KWS_KERNELS_FILTER_BANK_SPARSE_H_
+
+#include "tensorflow/lite/micro/micro_common.h"
+
+namespace tflite {
+
+/* SignalFilterBank with the triangular filters in a compact row form, built
+   once in Prepare from the constant weight tensors : every output channel is
+   one row with the rising half (weights) of its filter and the falling half
+   (unweights) of the previous one, without the zero weights at their ends
+   and without the scratch channel 0 of FilterbankAccumulateChannels().
+
+   The 64 bits multiply accumulate of the normal kernel is only needed when
+   the sum can overflow 32 bits. Prepare stores for every row the limit
+   L = UINT32_MAX / W (integer division), W being the sum of its weights.
+   Eval sums every row on 32 bits while it tracks the biggest input M, and
+   sums it again on 64 bits only when M > L, so the output is the same as
+   the normal kernel. The 32 bits sum is exact when M <= L : the weights
+   w and the inputs x are >= 0, so every partial sum is at most
+   sum(w * x) <= W * M <= W * L <= UINT32_MAX and nothing wraps.
+   W itself fits easily : at most 2 * 257 bins of weights below 2^15.
+
+   The normal kernel is used when the weights aren't constant or have
+   negative values.
+   Use it as : op_resolver.AddCustom( "SignalFilterBank" , Register_KWS_FILTER_BANK() ) */
+TFLMRegistration* Register_KWS_FILTER_BANK();
+
+}  // namespace tflite
+
+#endif /* KWS_KERNELS_FILTER_BANK_SPARSE_H_ */
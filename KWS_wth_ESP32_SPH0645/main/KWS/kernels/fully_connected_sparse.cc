@@ -0,0 +1,270 @@
+/*
+ *  fully_connected_sparse.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "fully_connected_sparse.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/flatbuffer_utils.h"
+#include "tensorflow/lite/micro/kernels/fully_connected.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/micro_log.h"
+
+namespace tflite {
+namespace {
+
+constexpr int kInputTensor = 0;
+constexpr int kValuesTensor = 1;
+constexpr int kBlockColumnsTensor = 2;
+constexpr int kRowBlocksTensor = 3;
+constexpr int kBiasTensor = 4;
+constexpr int kOutputTensor = 0;
+
+/* Indices into the init flexbuffer's vector, the elements are ordered
+   alphabetically by parameter name (the name is in the comment). The
+   activation uses the flatbuffer schema enum, like FULLY_CONNECTED does. */
+constexpr int kActivationIndex = 0;  // 'activation'
+constexpr int kBlockColsIndex = 1;   // 'block_cols'
+constexpr int kBlockRowsIndex = 2;   // 'block_rows'
+
+struct OpDataFullyConnectedSparse {
+  /* Parameters read from the flatbuffer, has_options is false without them */
+  bool has_options;
+  TfLiteFusedActivation activation;
+  int block_rows;
+  int block_cols;
+
+  /* Calculated in Prepare */
+  OpDataFullyConnected fully_connected;
+  int input_depth;
+  int output_depth;
+  /* input_offset x the sum of the weights of every output row, so the input
+     offset is not added to every input value */
+  int32_t* row_offsets;
+};
+
+void* Init(TfLiteContext* context, const char* buffer, size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  auto* data = static_cast<OpDataFullyConnectedSparse*>(
+      context->AllocatePersistentBuffer(context,
+                                        sizeof(OpDataFullyConnectedSparse)));
+  if (data == nullptr) {
+    return nullptr;
+  }
+  *data = {};
+  if (buffer == nullptr) {
+    return data;
+  }
+
+  tflite::FlexbufferWrapper fbw(reinterpret_cast<const uint8_t*>(buffer),
+                                length);
+  data->activation =
+      static_cast<TfLiteFusedActivation>(fbw.ElementAsInt32(kActivationIndex));
+  data->block_cols = fbw.ElementAsInt32(kBlockColsIndex);
+  data->block_rows = fbw.ElementAsInt32(kBlockRowsIndex);
+  data->has_options = true;
+  return data;
+}
+
+TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  auto* data = static_cast<OpDataFullyConnectedSparse*>(node->user_data);
+
+  TF_LITE_ENSURE_MSG(context, data->has_options,
+                     "The sparse FULLY_CONNECTED has no custom options");
+  TF_LITE_ENSURE(context, NumInputs(node) == 4 || NumInputs(node) == 5);
+  TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
+  /* The block shapes which have an Eval below */
+  TF_LITE_ENSURE(context,
+                 (data->block_rows == 1 && data->block_cols == 4) ||
+                     (data->block_rows == 4 && data->block_cols == 1));
+  const int block_size = data->block_rows * data->block_cols;
+
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kInputTensor);
+  TfLiteTensor* values =
+      micro_context->AllocateTempInputTensor(node, kValuesTensor);
+  TfLiteTensor* block_columns =
+      micro_context->AllocateTempInputTensor(node, kBlockColumnsTensor);
+  TfLiteTensor* row_blocks =
+      micro_context->AllocateTempInputTensor(node, kRowBlocksTensor);
+  TfLiteTensor* bias =
+      (NumInputs(node) == 5)
+          ? micro_context->AllocateTempInputTensor(node, kBiasTensor)
+          : nullptr;
+  TfLiteTensor* output =
+      micro_context->AllocateTempOutputTensor(node, kOutputTensor);
+  TF_LITE_ENSURE(context, input != nullptr && values != nullptr &&
+                              block_columns != nullptr &&
+                              row_blocks != nullptr && output != nullptr);
+
+  /* Only the int8 Dense of our models, the weights are constant */
+  TF_LITE_ENSURE_TYPES_EQ(context, input->type, kTfLiteInt8);
+  TF_LITE_ENSURE_TYPES_EQ(context, values->type, kTfLiteInt8);
+  TF_LITE_ENSURE_TYPES_EQ(context, output->type, kTfLiteInt8);
+  TF_LITE_ENSURE_TYPES_EQ(context, block_columns->type, kTfLiteInt16);
+  TF_LITE_ENSURE_TYPES_EQ(context, row_blocks->type, kTfLiteInt32);
+  TF_LITE_ENSURE(context, IsConstantTensor(values) &&
+                              IsConstantTensor(block_columns) &&
+                              IsConstantTensor(row_blocks));
+  if (bias != nullptr) {
+    TF_LITE_ENSURE_TYPES_EQ(context, bias->type, kTfLiteInt32);
+  }
+
+  data->input_depth = input->dims->data[input->dims->size - 1];
+  data->output_depth = output->dims->data[output->dims->size - 1];
+  const int row_block_count = NumElements(row_blocks) - 1;
+  const int block_count = NumElements(block_columns);
+  TF_LITE_ENSURE_EQ(context, row_block_count * data->block_rows,
+                    data->output_depth);
+  TF_LITE_ENSURE_EQ(context, data->input_depth % data->block_cols, 0);
+  TF_LITE_ENSURE_EQ(context, NumElements(values), block_count * block_size);
+  TF_LITE_ENSURE_EQ(context, NumElements(input) / data->input_depth,
+                    NumElements(output) / data->output_depth);
+
+  TF_LITE_ENSURE_OK(context, CalculateOpDataFullyConnected(
+                                 context, data->activation, input->type, input,
+                                 values, bias, output, &data->fully_connected));
+  TF_LITE_ENSURE_EQ(context, data->fully_connected.filter_zero_point, 0);
+
+  /* Check the encoding once, Eval trusts it, and sum the weights of the rows */
+  data->row_offsets = static_cast<int32_t*>(context->AllocatePersistentBuffer(
+      context, data->output_depth * sizeof(int32_t)));
+  TF_LITE_ENSURE(context, data->row_offsets != nullptr);
+  const int8_t* values_data = GetTensorData<int8_t>(values);
+  const int16_t* block_columns_data = GetTensorData<int16_t>(block_columns);
+  const int32_t* row_blocks_data = GetTensorData<int32_t>(row_blocks);
+  const int column_blocks = data->input_depth / data->block_cols;
+  const int32_t input_offset = -data->fully_connected.input_zero_point;
+  TF_LITE_ENSURE_EQ(context, row_blocks_data[0], 0);
+  TF_LITE_ENSURE_EQ(context, row_blocks_data[row_block_count], block_count);
+  for (int row_block = 0; row_block < row_block_count; row_block++) {
+    const int first = row_blocks_data[row_block];
+    const int last = row_blocks_data[row_block + 1];
+    TF_LITE_ENSURE(context, first <= last);
+    int32_t sums[4] = {0, 0, 0, 0};
+    for (int block = first; block < last; block++) {
+      TF_LITE_ENSURE(context, block_columns_data[block] >= 0 &&
+                                  block_columns_data[block] < column_blocks);
+      for (int i = 0; i < block_size; i++) {
+        sums[i / data->block_cols] += values_data[block * block_size + i];
+      }
+    }
+    for (int r = 0; r < data->block_rows; r++) {
+      data->row_offsets[row_block * data->block_rows + r] =
+          input_offset * sums[r];
+    }
+  }
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(values);
+  micro_context->DeallocateTempTfLiteTensor(block_columns);
+  micro_context->DeallocateTempTfLiteTensor(row_blocks);
+  if (bias != nullptr) {
+    micro_context->DeallocateTempTfLiteTensor(bias);
+  }
+  micro_context->DeallocateTempTfLiteTensor(output);
+  return kTfLiteOk;
+}
+
+/* One input row through the non-zero blocks, with the arithmetic of
+   esp_nn_fully_connected_s8 : the zero weights add nothing to the int32
+   accumulators, so skipping them gives the same outputs */
+template <int kBlockRows, int kBlockCols>
+void SparseRows(const OpDataFullyConnectedSparse& data, const int8_t* input,
+                const int8_t* values, const int16_t* block_columns,
+                const int32_t* row_blocks, const int32_t* bias,
+                int8_t* output) {
+  const OpDataFullyConnected& params = data.fully_connected;
+  const int row_block_count = data.output_depth / kBlockRows;
+  for (int row_block = 0; row_block < row_block_count; row_block++) {
+    int32_t acc[kBlockRows] = {};
+    for (int block = row_blocks[row_block]; block < row_blocks[row_block + 1];
+         block++) {
+      const int8_t* weights = values + block * (kBlockRows * kBlockCols);
+      const int8_t* input_ptr = input + block_columns[block] * kBlockCols;
+      for (int r = 0; r < kBlockRows; r++) {
+        for (int c = 0; c < kBlockCols; c++) {
+          acc[r] += weights[r * kBlockCols + c] * input_ptr[c];
+        }
+      }
+    }
+    for (int r = 0; r < kBlockRows; r++) {
+      const int row = row_block * kBlockRows + r;
+      int32_t value = acc[r] + data.row_offsets[row];
+      if (bias != nullptr) {
+        value += bias[row];
+      }
+      value = MultiplyByQuantizedMultiplier(value, params.output_multiplier,
+                                            params.output_shift);
+      value += params.output_zero_point;
+      value = std::max(value, params.output_activation_min);
+      value = std::min(value, params.output_activation_max);
+      output[row] = static_cast<int8_t>(value);
+    }
+  }
+}
+
+TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const auto& data =
+      *static_cast<const OpDataFullyConnectedSparse*>(node->user_data);
+
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kInputTensor);
+  const TfLiteEvalTensor* values =
+      tflite::micro::GetEvalInput(context, node, kValuesTensor);
+  const TfLiteEvalTensor* block_columns =
+      tflite::micro::GetEvalInput(context, node, kBlockColumnsTensor);
+  const TfLiteEvalTensor* row_blocks =
+      tflite::micro::GetEvalInput(context, node, kRowBlocksTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 5)
+          ? tflite::micro::GetEvalInput(context, node, kBiasTensor)
+          : nullptr;
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
+
+  const int8_t* input_data = tflite::micro::GetTensorData<int8_t>(input);
+  const int8_t* values_data = tflite::micro::GetTensorData<int8_t>(values);
+  const int16_t* block_columns_data =
+      tflite::micro::GetTensorData<int16_t>(block_columns);
+  const int32_t* row_blocks_data =
+      tflite::micro::GetTensorData<int32_t>(row_blocks);
+  const int32_t* bias_data =
+      tflite::micro::GetOptionalTensorData<int32_t>(bias);
+  int8_t* output_data = tflite::micro::GetTensorData<int8_t>(output);
+
+  const int batches =
+      tflite::micro::GetTensorShape(output).FlatSize() / data.output_depth;
+  for (int b = 0; b < batches; ++b) {
+    const int8_t* batch_input = input_data + b * data.input_depth;
+    int8_t* batch_output = output_data + b * data.output_depth;
+    if (data.block_rows == 1) {
+      SparseRows<1, 4>(data, batch_input, values_data, block_columns_data,
+                       row_blocks_data, bias_data, batch_output);
+    } else {
+      SparseRows<4, 1>(data, batch_input, values_data, block_columns_data,
+                       row_blocks_data, bias_data, batch_output);
+    }
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace
+
+TFLMRegistration* Register_KWS_FULLY_CONNECTED_SPARSE() {
+  static TFLMRegistration r = tflite::micro::RegisterOp(Init, Prepare, Eval);
+  return &r;
+}
+
+}  // namespace tflite
@@ -0,0 +1,34 @@
+/*
+ *  fully_connected_sparse.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef KWS_KERNELS_FULLY_CONNECTED_SPARSE_H_
+#define KWS_KERNELS_FULLY_CONNECTED_SPARSE_H_
+
+#include "tensorflow/lite/micro/micro_common.h"
+
+namespace tflite {
+
+/* Name of the custom operator in the flatbuffer, it is written by
+   KWS_model/sparse_fully_connected.py when it replaces a FULLY_CONNECTED whose
+   int8 weights are pruned by blocks */
+constexpr const char* kKwsSparseFullyConnectedOpName = "KwsSparseFullyConnected";
+
+/* Int8 FULLY_CONNECTED with block sparse weights (blocks of 1x4 or 4x1, rows x
+   input columns). Only the non-zero blocks are stored, row block by row block
+   (block CSR), and the zero blocks are never read from flash nor multiplied.
+   The outputs are bit-exact with the dense kernel on the pruned weights.
+   Inputs  : input [B,K] int8 , values [N,block_rows*block_cols] int8 (the
+             quantization of the dense weights) , block_columns [N] int16 (the
+             first column of each block / block_cols) , row_blocks
+             [rows/block_rows+1] int32 (offset of the first block of each row
+             block in values) , bias [rows] int32 (optional)
+   Outputs : output [B,rows] int8 */
+TFLMRegistration* Register_KWS_FULLY_CONNECTED_SPARSE();
+
+}  // namespace tflite
+
+#endif /* KWS_KERNELS_FULLY_CONNECTED_SPARSE_H_ */
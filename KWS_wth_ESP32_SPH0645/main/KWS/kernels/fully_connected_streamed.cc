@@ -0,0 +1,195 @@
+/*
+ *  fully_connected_streamed.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "fully_connected_streamed.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include <esp_nn.h>
+#include <esp_timer.h>
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/fully_connected.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "conv_fc_16x8.h"
+#include "weight_stream.h"
+
+extern "C" {
+#include "../keyword_spotting_config.h"
+}
+
+namespace tflite {
+namespace {
+
+struct OpDataFullyConnectedStreamed {
+  /* Must be the first member, the normal kernel uses the same user_data */
+  OpDataFullyConnected fully_connected;
+  int stream_slot; /* -1 when the weights are not streamed */
+  int tile_rows;   /* Output rows computed with one tile of weights */
+};
+
+/* Also runs the layers of the 16x8 models which are not streamed */
+const TFLMRegistration& FullyConnectedRegistration() {
+  static TFLMRegistration registration = Register_KWS_FULLY_CONNECTED_16X8();
+  return registration;
+}
+
+void* Init(TfLiteContext* context, const char* buffer, size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  return context->AllocatePersistentBuffer(
+      context, sizeof(OpDataFullyConnectedStreamed));
+}
+
+TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
+  TF_LITE_ENSURE_OK(context, FullyConnectedRegistration().prepare(context, node));
+
+  auto* data = static_cast<OpDataFullyConnectedStreamed*>(node->user_data);
+  data->stream_slot = -1;
+  data->tile_rows = 0;
+
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kFullyConnectedInputTensor);
+  TfLiteTensor* filter = micro_context->AllocateTempInputTensor(
+      node, kFullyConnectedWeightsTensor);
+  TfLiteTensor* bias =
+      micro_context->AllocateTempInputTensor(node, kFullyConnectedBiasTensor);
+  TF_LITE_ENSURE(context, input != nullptr && filter != nullptr);
+
+  const size_t filter_bytes = filter->bytes;
+  const int output_depth = filter->dims->data[0];
+  const int accum_depth = filter->dims->data[filter->dims->size - 1];
+  const size_t tile_capacity = KwsWeightStreamTileCapacity();
+
+  /* The tiles of a 16x8 layer go through KwsFullyConnected16x8Rows(),
+     which takes symmetric activations and an int64 bias */
+  const bool is_16x8 = (input->type == kTfLiteInt16) &&
+                       (data->fully_connected.input_zero_point == 0) &&
+                       (data->fully_connected.filter_zero_point == 0) &&
+                       ((bias == nullptr) || (bias->type == kTfLiteInt64));
+
+  /* Only the int8 weights which are constant (so in flash) and big enough
+     are worth streaming, at least one output row must fit in a tile */
+  if (((input->type == kTfLiteInt8) || is_16x8) &&
+      (filter->type == kTfLiteInt8) && IsConstantTensor(filter) &&
+      (filter_bytes >= KEYWORD_SPOTTING_WEIGHT_STREAM_MIN_TENSOR_SIZE) &&
+      (tile_capacity >= static_cast<size_t>(accum_depth))) {
+    const int tile_rows = std::min<int>(
+        output_depth, static_cast<int>(tile_capacity / accum_depth));
+    data->stream_slot = KwsWeightStreamRegister(
+        filter->data.data, filter_bytes, tile_rows * accum_depth);
+    data->tile_rows = tile_rows;
+  }
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(filter);
+  if (bias != nullptr) {
+    micro_context->DeallocateTempTfLiteTensor(bias);
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const auto& data =
+      *static_cast<const OpDataFullyConnectedStreamed*>(node->user_data);
+  if (data.stream_slot < 0) {
+    return FullyConnectedRegistration().invoke(context, node);
+  }
+
+  const int64_t start_time = esp_timer_get_time();
+
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedBiasTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kFullyConnectedOutputTensor);
+
+  const RuntimeShape filter_shape = tflite::micro::GetTensorShape(filter);
+  const RuntimeShape output_shape = tflite::micro::GetTensorShape(output);
+  const int filter_dim_count = filter_shape.DimensionsCount();
+  const int batches = output_shape.Dims(0);
+  const int output_depth = output_shape.Dims(1);
+  const int accum_depth = filter_shape.Dims(filter_dim_count - 1);
+
+  const int8_t* filter_data = tflite::micro::GetTensorData<int8_t>(filter);
+  const OpDataFullyConnected& params = data.fully_connected;
+
+  const int slot = data.stream_slot;
+  const int tile_rows = data.tile_rows;
+  const int tile_count = (output_depth + tile_rows - 1) / tile_rows;
+  auto tile_length = [&](int tile) {
+    return std::min(tile_rows, output_depth - tile * tile_rows) * accum_depth;
+  };
+
+  KwsWeightStreamFetch(slot, 0, filter_data, tile_length(0));
+  for (int tile = 0; tile < tile_count; tile++) {
+    const int buffer = tile & 1;
+    /* The other half was used by the previous tile, which is finished,
+       so the next tile can be copied into it while this one computes */
+    if (tile + 1 < tile_count) {
+      KwsWeightStreamFetch(slot, buffer ^ 1,
+                           filter_data + (tile + 1) * tile_rows * accum_depth,
+                           tile_length(tile + 1));
+    }
+    const int8_t* tile_data = KwsWeightStreamWait(slot, buffer);
+
+    const int row_start = tile * tile_rows;
+    const int rows = tile_length(tile) / accum_depth;
+    /* The tile is used by all the batches before moving to the next one */
+    if (input->type == kTfLiteInt16) {
+      const int16_t* input_data = tflite::micro::GetTensorData<int16_t>(input);
+      const int64_t* bias_data =
+          tflite::micro::GetOptionalTensorData<int64_t>(bias);
+      int16_t* output_data = tflite::micro::GetTensorData<int16_t>(output);
+      for (int b = 0; b < batches; ++b) {
+        KwsFullyConnected16x8Rows(
+            params, input_data + b * accum_depth, accum_depth, tile_data,
+            (bias_data != nullptr) ? bias_data + row_start : nullptr, rows,
+            output_data + b * output_depth + row_start);
+      }
+      continue;
+    }
+    const int8_t* input_data = tflite::micro::GetTensorData<int8_t>(input);
+    const int32_t* bias_data =
+        tflite::micro::GetOptionalTensorData<int32_t>(bias);
+    int8_t* output_data = tflite::micro::GetTensorData<int8_t>(output);
+    for (int b = 0; b < batches; ++b) {
+      esp_nn_fully_connected_s8(
+          input_data + b * accum_depth, -params.input_zero_point, accum_depth,
+          tile_data, -params.filter_zero_point,
+          (bias_data != nullptr) ? bias_data + row_start : nullptr,
+          output_data + b * output_depth + row_start, rows,
+          params.output_zero_point, params.output_shift,
+          params.output_multiplier, params.output_activation_min,
+          params.output_activation_max);
+    }
+  }
+
+  /* Start bringing the first tile of the next invoke, the audio capture
+     gives plenty of time for it. A tensor of one or two tiles stays in the
+     staging area, unless another streamed tensor takes its place */
+  if (tile_count > 1) {
+    KwsWeightStreamFetch(slot, 0, filter_data, tile_length(0));
+  }
+
+  KwsWeightStreamInvokeDone(slot, esp_timer_get_time() - start_time);
+  return kTfLiteOk;
+}
+
+}  // namespace
+
+TFLMRegistration Register_KWS_FULLY_CONNECTED_STREAMED() {
+  return tflite::micro::RegisterOp(Init, Prepare, Eval);
+}
+
+}  // namespace tflite
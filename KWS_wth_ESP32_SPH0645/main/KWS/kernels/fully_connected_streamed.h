@@ -0,0 +1,26 @@
+/*
+ *  fully_connected_streamed.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef KWS_KERNELS_FULLY_CONNECTED_STREAMED_H_
+#define KWS_KERNELS_FULLY_CONNECTED_STREAMED_H_
+
+#include "tensorflow/lite/micro/micro_common.h"
+
+namespace tflite {
+
+/* FULLY_CONNECTED which streams its int8 weights through the staging area of
+   weight_stream.h, when they are bigger than
+   KEYWORD_SPOTTING_WEIGHT_STREAM_MIN_TENSOR_SIZE. The output rows are computed
+   one tile of weights at a time, the next tile being prefetched meanwhile.
+   The int16 activations of the 16x8 models are streamed too. Every other
+   case runs Register_KWS_FULLY_CONNECTED_16X8() (esp-nn for int8).
+   Use it as : resolver.AddFullyConnected( Register_KWS_FULLY_CONNECTED_STREAMED() ) */
+TFLMRegistration Register_KWS_FULLY_CONNECTED_STREAMED();
+
+}  // namespace tflite
+
+#endif /* KWS_KERNELS_FULLY_CONNECTED_STREAMED_H_ */
@@ -0,0 +1,228 @@
+/*
+ *  noise_estimate.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "noise_estimate.h"
+
+#include <string.h>
+
+#include "signal/src/filter_bank_spectral_subtraction.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/flatbuffer_utils.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/micro_context.h"
+#include "tensorflow/lite/micro/micro_utils.h"
+
+namespace tflite {
+namespace {
+
+constexpr int kInputTensor = 0;
+constexpr int kOutputTensor = 0;
+constexpr int kNoiseEstimateTensor = 1;
+
+// Indices into the init flexbuffer's vector of
+// SignalFilterBankSpectralSubtraction.
+// Elements in the vectors are ordered alphabetically by parameter name.
+constexpr int kAlternateOneMinusSmoothingIndex = 0;
+constexpr int kAlternateSmoothingIndex = 1;
+constexpr int kClampingIndex = 2;
+constexpr int kMinSignalRemainingIndex = 3;
+constexpr int kNumChannelsIndex = 4;
+constexpr int kOneMinusSmoothingIndex = 5;
+constexpr int kSmoothingIndex = 6;
+constexpr int kSmoothingBitsIndex = 7;
+constexpr int kSpectralSubtractionBitsIndex = 8;
+
+struct OpDataNoiseEstimate {
+  tflm_signal::SpectralSubtractionConfig config;
+  uint32_t* noise_estimate;
+  /* Frames of the warmup already averaged, and frames left */
+  int warmup_count;
+  int warmup_left;
+};
+
+/* FilterbankSpectralSubtraction() where the estimate of every channel is the
+   running mean of the warmup frames */
+void WarmupSpectralSubtraction(OpDataNoiseEstimate* data,
+                               const uint32_t* input, uint32_t* output) {
+  const tflm_signal::SpectralSubtractionConfig& config = data->config;
+  const uint32_t count = data->warmup_count + 1;
+  for (int i = 0; i < config.num_channels; ++i) {
+    const uint32_t signal_scaled_up = input[i] << config.smoothing_bits;
+    const uint32_t previous = data->noise_estimate[i];
+    /* previous + (signal - previous) / count, on 64 bits for the sum */
+    data->noise_estimate[i] = static_cast<uint32_t>(
+        (static_cast<uint64_t>(previous) * (count - 1) + signal_scaled_up) /
+        count);
+
+    uint32_t estimate_scaled_up = data->noise_estimate[i];
+    if (estimate_scaled_up > signal_scaled_up) {
+      estimate_scaled_up = signal_scaled_up;
+      if (config.clamping) {
+        data->noise_estimate[i] = estimate_scaled_up;
+      }
+    }
+    const uint32_t floor =
+        (static_cast<uint64_t>(input[i]) * config.min_signal_remaining) >>
+        config.spectral_subtraction_bits;
+    const uint32_t subtracted =
+        (signal_scaled_up - estimate_scaled_up) >> config.smoothing_bits;
+    output[i] = subtracted > floor ? subtracted : floor;
+  }
+}
+
+void* NoiseEstimateInit(TfLiteContext* context, const char* buffer,
+                        size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  auto* data = static_cast<OpDataNoiseEstimate*>(
+      context->AllocatePersistentBuffer(context, sizeof(OpDataNoiseEstimate)));
+  if (data == nullptr) {
+    return nullptr;
+  }
+
+  tflite::FlexbufferWrapper fbw(reinterpret_cast<const uint8_t*>(buffer),
+                                length);
+  tflm_signal::SpectralSubtractionConfig& config = data->config;
+  config.alternate_one_minus_smoothing =
+      fbw.ElementAsInt32(kAlternateOneMinusSmoothingIndex);
+  config.alternate_smoothing = fbw.ElementAsInt32(kAlternateSmoothingIndex);
+  config.clamping = fbw.ElementAsBool(kClampingIndex);
+  config.min_signal_remaining = fbw.ElementAsInt32(kMinSignalRemainingIndex);
+  config.num_channels = fbw.ElementAsInt32(kNumChannelsIndex);
+  config.one_minus_smoothing = fbw.ElementAsInt32(kOneMinusSmoothingIndex);
+  config.smoothing = fbw.ElementAsInt32(kSmoothingIndex);
+  config.smoothing_bits = fbw.ElementAsInt32(kSmoothingBitsIndex);
+  config.spectral_subtraction_bits =
+      fbw.ElementAsInt32(kSpectralSubtractionBitsIndex);
+
+  data->noise_estimate = static_cast<uint32_t*>(
+      context->AllocatePersistentBuffer(
+          context, config.num_channels * sizeof(uint32_t)));
+  if (data->noise_estimate == nullptr) {
+    return nullptr;
+  }
+  return data;
+}
+
+TfLiteStatus NoiseEstimatePrepare(TfLiteContext* context, TfLiteNode* node) {
+  TF_LITE_ENSURE_EQ(context, NumInputs(node), 1);
+  TF_LITE_ENSURE_EQ(context, NumOutputs(node), 2);
+
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kInputTensor);
+  TfLiteTensor* output =
+      micro_context->AllocateTempOutputTensor(node, kOutputTensor);
+  TfLiteTensor* noise_estimate =
+      micro_context->AllocateTempOutputTensor(node, kNoiseEstimateTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  TF_LITE_ENSURE(context, output != nullptr);
+  TF_LITE_ENSURE(context, noise_estimate != nullptr);
+
+  auto* data = static_cast<OpDataNoiseEstimate*>(node->user_data);
+  TF_LITE_ENSURE_EQ(context, NumDimensions(input), 1);
+  TF_LITE_ENSURE_EQ(context, NumDimensions(output), 1);
+  TF_LITE_ENSURE_EQ(context, NumDimensions(noise_estimate), 1);
+  TF_LITE_ENSURE_EQ(context, ElementCount(*noise_estimate->dims),
+                    data->config.num_channels);
+  TF_LITE_ENSURE_TYPES_EQ(context, input->type, kTfLiteUInt32);
+  TF_LITE_ENSURE_TYPES_EQ(context, output->type, kTfLiteUInt32);
+  TF_LITE_ENSURE_TYPES_EQ(context, noise_estimate->type, kTfLiteUInt32);
+
+  memset(data->noise_estimate, 0,
+         data->config.num_channels * sizeof(uint32_t));
+  data->warmup_count = 0;
+  data->warmup_left = 0;
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(output);
+  micro_context->DeallocateTempTfLiteTensor(noise_estimate);
+  return kTfLiteOk;
+}
+
+TfLiteStatus NoiseEstimateEval(TfLiteContext* context, TfLiteNode* node) {
+  auto* data = static_cast<OpDataNoiseEstimate*>(node->user_data);
+
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kInputTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
+  TfLiteEvalTensor* noise_estimate =
+      tflite::micro::GetEvalOutput(context, node, kNoiseEstimateTensor);
+
+  const uint32_t* input_data = tflite::micro::GetTensorData<uint32_t>(input);
+  uint32_t* output_data = tflite::micro::GetTensorData<uint32_t>(output);
+
+  /* A warmup asked since the last invoke */
+  auto* control = static_cast<KwsNoiseEstimateControl*>(
+      GetMicroContext(context)->external_context());
+  if (control != nullptr && control->warmup_frames >= 0) {
+    data->warmup_count = 0;
+    data->warmup_left = control->warmup_frames;
+    control->warmup_frames = -1;
+  }
+  if (control != nullptr) {
+    control->estimate = data->noise_estimate;
+    control->num_channels = data->config.num_channels;
+  }
+
+  if (data->warmup_left > 0) {
+    WarmupSpectralSubtraction(data, input_data, output_data);
+    ++data->warmup_count;
+    --data->warmup_left;
+  } else {
+    tflm_signal::FilterbankSpectralSubtraction(&data->config, input_data,
+                                               output_data,
+                                               data->noise_estimate);
+  }
+  memcpy(tflite::micro::GetTensorData<uint32_t>(noise_estimate),
+         data->noise_estimate, data->config.num_channels * sizeof(uint32_t));
+  return kTfLiteOk;
+}
+
+void NoiseEstimateReset(TfLiteContext* context, void* buffer) {
+  auto* data = static_cast<OpDataNoiseEstimate*>(buffer);
+  memset(data->noise_estimate, 0,
+         data->config.num_channels * sizeof(uint32_t));
+  data->warmup_count = 0;
+  data->warmup_left = 0;
+}
+
+}  // namespace
+
+TFLMRegistration* Register_KWS_FILTER_BANK_SPECTRAL_SUBTRACTION() {
+  static TFLMRegistration r = tflite::micro::RegisterOp(
+      NoiseEstimateInit, NoiseEstimatePrepare, NoiseEstimateEval,
+      /*Free*/ nullptr, NoiseEstimateReset);
+  return &r;
+}
+
+int KwsNoiseEstimateChannels(const KwsNoiseEstimateControl* control) {
+  return (control->estimate != nullptr) ? control->num_channels : 0;
+}
+
+TfLiteStatus KwsNoiseEstimateGet(const KwsNoiseEstimateControl* control,
+                                 uint32_t* estimate, int num_channels) {
+  if (num_channels != KwsNoiseEstimateChannels(control) || num_channels == 0) {
+    return kTfLiteError;
+  }
+  memcpy(estimate, control->estimate, num_channels * sizeof(uint32_t));
+  return kTfLiteOk;
+}
+
+TfLiteStatus KwsNoiseEstimateSet(KwsNoiseEstimateControl* control,
+                                 const uint32_t* estimate, int num_channels) {
+  if (num_channels != KwsNoiseEstimateChannels(control) || num_channels == 0) {
+    return kTfLiteError;
+  }
+  memcpy(control->estimate, estimate, num_channels * sizeof(uint32_t));
+  /* The node stops its warmup at the next invoke */
+  control->warmup_frames = 0;
+  return kTfLiteOk;
+}
+
+}  // namespace tflite
@@ -0,0 +1,57 @@
+/*
+ *  noise_estimate.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef KWS_KERNELS_NOISE_ESTIMATE_H_
+#define KWS_KERNELS_NOISE_ESTIMATE_H_
+
+#include <stdint.h>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/micro/micro_common.h"
+
+namespace tflite {
+
+/* SignalFilterBankSpectralSubtraction with a warmup of its noise estimate,
+   which is the only adaptive state of the preprocessor (PCAN takes the
+   estimate as an input and keeps nothing). The output is the same as the
+   normal kernel, except in the warmup frames.
+   Use it as :
+     op_resolver.AddCustom( "SignalFilterBankSpectralSubtraction" , Register_KWS_FILTER_BANK_SPECTRAL_SUBTRACTION() )
+   Every node keeps its estimate in its own op data. */
+TFLMRegistration* Register_KWS_FILTER_BANK_SPECTRAL_SUBTRACTION();
+
+/* The warmup of the kernel is asked through the external context of its
+   interpreter : interpreter.SetMicroExternalContext( &control ) once after
+   AllocateTensors(), then warmup_frames = frames starts a warmup at the next
+   invoke. The estimate of these frames is their mean instead of the low pass
+   filter, so it follows a new noise level after frames invokes instead of the
+   ~1/smoothing frames of the filter, and then the filter goes on from there.
+   0 stops the warmup, the kernel sets it back to -1.
+   At every invoke the node also puts its estimate (in its own op data) in
+   the control, for the functions below. Set warmup_frames to -1 and the
+   other members to 0 before the first invoke */
+struct KwsNoiseEstimateControl {
+  int warmup_frames;
+  uint32_t* estimate;
+  int num_channels;
+};
+
+/* Number of channels of the estimate of the node, 0 before its first invoke */
+int KwsNoiseEstimateChannels(const KwsNoiseEstimateControl* control);
+
+/* Copy the estimate (in the kernel scale, input << smoothing_bits) out of
+   and into the node, num_channels must be KwsNoiseEstimateChannels(). They
+   must not run during an invoke of the interpreter. The set also stops a
+   warmup, asked or running */
+TfLiteStatus KwsNoiseEstimateGet(const KwsNoiseEstimateControl* control,
+                                 uint32_t* estimate, int num_channels);
+TfLiteStatus KwsNoiseEstimateSet(KwsNoiseEstimateControl* control,
+                                 const uint32_t* estimate, int num_channels);
+
+}  // namespace tflite
+
+#endif /* KWS_KERNELS_NOISE_ESTIMATE_H_ */
@@ -0,0 +1,349 @@
+/*
+ *  rfft_512.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "rfft_512.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "signal/micro/kernels/rfft.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/flatbuffer_utils.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace tflite {
+namespace {
+
+/* The real FFT of 512 points is a complex FFT of 256 points */
+constexpr int kComplexLength = kKwsRfftLength / 2;
+constexpr int kStageCount = 4; /* 4^4 = 256 */
+
+struct Q15Complex {
+  int16_t real;
+  int16_t imag;
+};
+
+/*** Compile time tables ***/
+constexpr double kPi = 3.14159265358979323846;
+
+/* sin(x) for x in [-pi, pi], the Taylor series is exact to double precision
+   with 12 terms in this range */
+constexpr double ConstexprSin(double x) {
+  double term = x;
+  double sum = x;
+  for (int n = 1; n < 12; ++n) {
+    term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr double WrapAngle(double x) {
+  while (x > kPi) x -= 2.0 * kPi;
+  while (x < -kPi) x += 2.0 * kPi;
+  return x;
+}
+
+constexpr int16_t ToQ15(double value) {
+  const double scaled = value * 32768.0;
+  const double rounded = (scaled >= 0.0) ? scaled + 0.5 : scaled - 0.5;
+  return (rounded >= 32767.0)    ? 32767
+         : (rounded <= -32768.0) ? -32768
+                                 : static_cast<int16_t>(rounded);
+}
+
+/* exp(j * angle) in Q15 */
+constexpr Q15Complex Q15Exp(double angle) {
+  return {ToQ15(ConstexprSin(WrapAngle(angle + kPi / 2.0))),
+          ToQ15(ConstexprSin(WrapAngle(angle)))};
+}
+
+template <int N>
+struct TwiddleTable {
+  Q15Complex w[N];
+};
+
+/* W^k = exp(-2j*pi*k/256) for the radix-4 stages */
+constexpr TwiddleTable<kComplexLength> MakeStageTwiddles() {
+  TwiddleTable<kComplexLength> table = {};
+  for (int k = 0; k < kComplexLength; ++k) {
+    table.w[k] = Q15Exp(-2.0 * kPi * k / kComplexLength);
+  }
+  return table;
+}
+
+/* exp(-j*pi*(k/256 + 1/2)) for k = 0..128, used to unpack the real spectrum
+   (the same as the super twiddles of kiss_fftr) */
+constexpr TwiddleTable<kComplexLength / 2 + 1> MakeSplitTwiddles() {
+  TwiddleTable<kComplexLength / 2 + 1> table = {};
+  for (int k = 0; k <= kComplexLength / 2; ++k) {
+    table.w[k] = Q15Exp(-kPi * (static_cast<double>(k) / kComplexLength + 0.5));
+  }
+  return table;
+}
+
+/* Radix-4 digit reversal of the 4 digits of an index of 0..255 */
+struct DigitReverseTable {
+  uint8_t index[kComplexLength];
+};
+
+constexpr DigitReverseTable MakeDigitReverse() {
+  DigitReverseTable table = {};
+  for (int i = 0; i < kComplexLength; ++i) {
+    int reversed = 0;
+    int value = i;
+    for (int digit = 0; digit < kStageCount; ++digit) {
+      reversed = (reversed << 2) | (value & 3);
+      value >>= 2;
+    }
+    table.index[i] = static_cast<uint8_t>(reversed);
+  }
+  return table;
+}
+
+constexpr TwiddleTable<kComplexLength> kStageTwiddles = MakeStageTwiddles();
+constexpr TwiddleTable<kComplexLength / 2 + 1> kSplitTwiddles =
+    MakeSplitTwiddles();
+constexpr DigitReverseTable kDigitReverse = MakeDigitReverse();
+
+/*** FFT ***/
+struct Complex32 {
+  int32_t real;
+  int32_t imag;
+};
+
+inline int16_t SaturateInt16(int32_t value) {
+  return (value > INT16_MAX)   ? INT16_MAX
+         : (value < INT16_MIN) ? INT16_MIN
+                               : static_cast<int16_t>(value);
+}
+
+/* a * w with a Q15 twiddle, rounded */
+inline Complex32 MulTwiddle(Q15Complex a, Q15Complex w) {
+  return {(a.real * w.real - a.imag * w.imag + (1 << 14)) >> 15,
+          (a.real * w.imag + a.imag * w.real + (1 << 14)) >> 15};
+}
+
+inline Complex32 ToComplex32(Q15Complex a) { return {a.real, a.imag}; }
+
+/* One radix-4 decimation in time butterfly, the result is divided by 4
+   (like the kiss_fft stages) so the 4 stages scale the FFT by 1/256.
+   The first butterfly of every group has W^0 twiddles, which are skipped */
+template <bool kUnitTwiddles>
+inline void Butterfly4(Q15Complex* data, int stride, Q15Complex w1,
+                       Q15Complex w2, Q15Complex w3) {
+  const Complex32 a0 = ToComplex32(data[0]);
+  const Complex32 a1 = kUnitTwiddles ? ToComplex32(data[stride])
+                                     : MulTwiddle(data[stride], w1);
+  const Complex32 a2 = kUnitTwiddles ? ToComplex32(data[2 * stride])
+                                     : MulTwiddle(data[2 * stride], w2);
+  const Complex32 a3 = kUnitTwiddles ? ToComplex32(data[3 * stride])
+                                     : MulTwiddle(data[3 * stride], w3);
+
+  const Complex32 b0 = {a0.real + a2.real, a0.imag + a2.imag};
+  const Complex32 b1 = {a0.real - a2.real, a0.imag - a2.imag};
+  const Complex32 b2 = {a1.real + a3.real, a1.imag + a3.imag};
+  const Complex32 b3 = {a1.real - a3.real, a1.imag - a3.imag};
+
+  /* Forward transform : y1 = b1 - j*b3 , y3 = b1 + j*b3 */
+  data[0] = {SaturateInt16((b0.real + b2.real + 2) >> 2),
+             SaturateInt16((b0.imag + b2.imag + 2) >> 2)};
+  data[stride] = {SaturateInt16((b1.real + b3.imag + 2) >> 2),
+                  SaturateInt16((b1.imag - b3.real + 2) >> 2)};
+  data[2 * stride] = {SaturateInt16((b0.real - b2.real + 2) >> 2),
+                      SaturateInt16((b0.imag - b2.imag + 2) >> 2)};
+  data[3 * stride] = {SaturateInt16((b1.real - b3.imag + 2) >> 2),
+                      SaturateInt16((b1.imag + b3.real + 2) >> 2)};
+}
+
+void ComplexFft256(Q15Complex* data) {
+  for (int span = 4; span <= kComplexLength; span *= 4) {
+    const int quarter = span / 4;
+    const int twiddle_step = kComplexLength / span;
+    for (int group = 0; group < kComplexLength; group += span) {
+      const Q15Complex unit = {INT16_MAX, 0};
+      Butterfly4<true>(&data[group], quarter, unit, unit, unit);
+      for (int j = 1; j < quarter; ++j) {
+        Butterfly4<false>(&data[group + j], quarter,
+                          kStageTwiddles.w[j * twiddle_step],
+                          kStageTwiddles.w[2 * j * twiddle_step],
+                          kStageTwiddles.w[3 * j * twiddle_step]);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void KwsRfft512Int16Apply(const int16_t* input, Complex<int16_t>* output) {
+  /* Pack the even samples into the real part and the odd ones into the
+     imaginary part, in digit reversed order for the DIT stages */
+  Q15Complex data[kComplexLength];
+  for (int i = 0; i < kComplexLength; ++i) {
+    const int n = kDigitReverse.index[i];
+    data[i] = {input[2 * n], input[2 * n + 1]};
+  }
+
+  ComplexFft256(data);
+
+  /* Unpack : X[k] = (E[k] + W512^k * O[k]) / 2 with
+     E[k] = (Z[k] + conj(Z[256-k])) / 2 and O[k] = (Z[k] - conj(Z[256-k])) / 2j
+     which gives the same 1/512 scaling as kiss_fftr */
+  const int32_t dc_real = data[0].real;
+  const int32_t dc_imag = data[0].imag;
+  output[0] = {SaturateInt16((dc_real + dc_imag + 1) >> 1), 0};
+  output[kComplexLength] = {SaturateInt16((dc_real - dc_imag + 1) >> 1), 0};
+
+  for (int k = 1; k <= kComplexLength / 2; ++k) {
+    const Q15Complex zk = data[k];
+    const Q15Complex znk = data[kComplexLength - k];
+    /* f1 = Z[k] + conj(Z[256-k]) , f2 = Z[k] - conj(Z[256-k]) */
+    const int32_t f1_real = zk.real + znk.real;
+    const int32_t f1_imag = zk.imag - znk.imag;
+    const int32_t f2_real = zk.real - znk.real;
+    const int32_t f2_imag = zk.imag + znk.imag;
+    const Q15Complex w = kSplitTwiddles.w[k];
+    const int32_t tw_real = (f2_real * w.real - f2_imag * w.imag + (1 << 14)) >> 15;
+    const int32_t tw_imag = (f2_real * w.imag + f2_imag * w.real + (1 << 14)) >> 15;
+
+    output[k] = {SaturateInt16((f1_real + tw_real + 2) >> 2),
+                 SaturateInt16((f1_imag + tw_imag + 2) >> 2)};
+    output[kComplexLength - k] = {SaturateInt16((f1_real - tw_real + 2) >> 2),
+                                  SaturateInt16((tw_imag - f1_imag + 2) >> 2)};
+  }
+}
+
+namespace {
+
+constexpr int kInputTensor = 0;
+constexpr int kOutputTensor = 0;
+constexpr int kFftLengthIndex = 1;  // 'fft_length'
+
+struct OpDataRfft512 {
+  /* Not null when the FFT isn't the specialized one, it is then the
+     user_data of the normal SignalRfft kernel */
+  void* generic_data;
+  int32_t input_size;
+  int32_t input_length;
+  int32_t output_length;
+  int scratch_buffer_index;
+};
+
+const TFLMRegistration& GenericRfft() {
+  return *tflm_signal::Register_RFFT();
+}
+
+void* Init(TfLiteContext* context, const char* buffer, size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  auto* data = static_cast<OpDataRfft512*>(
+      context->AllocatePersistentBuffer(context, sizeof(OpDataRfft512)));
+  if (data == nullptr) {
+    return nullptr;
+  }
+
+  const uint8_t* buffer_t = reinterpret_cast<const uint8_t*>(buffer);
+  const flexbuffers::Map& m = flexbuffers::GetRoot(buffer_t, length).AsMap();
+  tflite::FlexbufferWrapper fbw(buffer_t, length);
+  const auto tensor_type = static_cast<tflite::TensorType>(m["T"].AsInt32());
+  const int32_t fft_length = fbw.ElementAsInt32(kFftLengthIndex);
+
+  data->generic_data = nullptr;
+  if ((tensor_type != TensorType_INT16) || (fft_length != kKwsRfftLength)) {
+    data->generic_data = GenericRfft().init(context, buffer, length);
+  }
+  return data;
+}
+
+/* Run a function of the normal kernel with its own user_data */
+template <typename Function>
+TfLiteStatus CallGeneric(Function function, TfLiteContext* context,
+                         TfLiteNode* node) {
+  auto* data = static_cast<OpDataRfft512*>(node->user_data);
+  node->user_data = data->generic_data;
+  const TfLiteStatus status = function(context, node);
+  node->user_data = data;
+  return status;
+}
+
+TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  auto* data = static_cast<OpDataRfft512*>(node->user_data);
+  if (data->generic_data != nullptr) {
+    return CallGeneric(GenericRfft().prepare, context, node);
+  }
+
+  TF_LITE_ENSURE_EQ(context, NumInputs(node), 1);
+  TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
+
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kInputTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  TfLiteTensor* output =
+      micro_context->AllocateTempOutputTensor(node, kOutputTensor);
+  TF_LITE_ENSURE(context, output != nullptr);
+
+  TF_LITE_ENSURE_EQ(context, NumDimensions(input), NumDimensions(output));
+  TF_LITE_ENSURE_TYPES_EQ(context, input->type, kTfLiteInt16);
+  TF_LITE_ENSURE_TYPES_EQ(context, output->type, kTfLiteInt16);
+
+  RuntimeShape input_shape = GetTensorShape(input);
+  RuntimeShape output_shape = GetTensorShape(output);
+  data->input_length = input_shape.Dims(input_shape.DimensionsCount() - 1);
+  data->input_size = input_shape.FlatSize();
+  /* Divide by 2 because output is complex */
+  data->output_length =
+      output_shape.Dims(output_shape.DimensionsCount() - 1) / 2;
+  TF_LITE_ENSURE(context, data->input_length <= kKwsRfftLength);
+  TF_LITE_ENSURE_EQ(context, data->output_length, kKwsRfftLength / 2 + 1);
+
+  TF_LITE_ENSURE_STATUS(context->RequestScratchBufferInArena(
+      context, kKwsRfftLength * sizeof(int16_t),
+      &data->scratch_buffer_index));
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(output);
+  return kTfLiteOk;
+}
+
+TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
+  auto* data = static_cast<OpDataRfft512*>(node->user_data);
+  if (data->generic_data != nullptr) {
+    return CallGeneric(GenericRfft().invoke, context, node);
+  }
+
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kInputTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
+  const int16_t* input_data = tflite::micro::GetTensorData<int16_t>(input);
+  Complex<int16_t>* output_data =
+      tflite::micro::GetTensorData<Complex<int16_t>>(output);
+  int16_t* work_area = static_cast<int16_t*>(
+      context->GetScratchBuffer(context, data->scratch_buffer_index));
+
+  for (int input_idx = 0, output_idx = 0; input_idx < data->input_size;
+       input_idx += data->input_length, output_idx += data->output_length) {
+    memcpy(work_area, &input_data[input_idx],
+           sizeof(int16_t) * data->input_length);
+    /* Zero pad input to FFT length */
+    memset(&work_area[data->input_length], 0,
+           sizeof(int16_t) * (kKwsRfftLength - data->input_length));
+    KwsRfft512Int16Apply(work_area, &output_data[output_idx]);
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace
+
+TFLMRegistration* Register_KWS_RFFT_512() {
+  static TFLMRegistration r = tflite::micro::RegisterOp(Init, Prepare, Eval);
+  return &r;
+}
+
+}  // namespace tflite
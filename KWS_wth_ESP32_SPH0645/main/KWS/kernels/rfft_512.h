@@ -0,0 +1,43 @@
+/*
+ *  rfft_512.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef KWS_KERNELS_RFFT_512_H_
+#define KWS_KERNELS_RFFT_512_H_
+
+#include <stdint.h>
+
+#include "signal/src/complex.h"
+#include "tensorflow/lite/micro/micro_common.h"
+
+namespace tflite {
+
+/* The only FFT length of the frontend : the 30 ms window (480 samples at
+   16 kHz) zero padded to the next power of 2 */
+constexpr int kKwsRfftLength = 512;
+
+/* Int16 real FFT of kKwsRfftLength points, specialized at compile time.
+   The 512 real samples are packed into 256 complex ones, transformed by four
+   radix-4 stages (256 = 4^4) with constexpr twiddle tables, and unpacked into
+   the 257 bins of the real spectrum.
+   Like kiss_fftr (RfftInt16Apply) the output is scaled by 1/512. Every stage
+   rounds and keeps its sums on 32 bits : on the noise, tones and full scale
+   signals of host_checks/rfft_512_check.cc the output is at most 1.7 LSB
+   from the exact DFT / 512 (on bin 0, whose sum goes through every rounding),
+   0.3 LSB on average, where kiss_fftr goes up to 18 LSB on full scale tones.
+   It is not bit-exact with RfftInt16Apply, the preprocessor only uses it
+   with KEYWORD_SPOTTING_FAST_RFFT. */
+void KwsRfft512Int16Apply(const int16_t* input,
+                          Complex<int16_t>* output);
+
+/* SignalRfft which uses KwsRfft512Int16Apply() for int16 FFTs of 512 points,
+   and the normal kernel (kiss_fft) for any other FFT.
+   Use it as : op_resolver.AddRfft( Register_KWS_RFFT_512() ) */
+TFLMRegistration* Register_KWS_RFFT_512();
+
+}  // namespace tflite
+
+#endif /* KWS_KERNELS_RFFT_512_H_ */
@@ -0,0 +1,139 @@
+/*
+ *  softmax_elided.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "softmax_elided.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/micro_context.h"
+#include "tensorflow/lite/micro/micro_graph.h"
+#include "tensorflow/lite/micro/micro_log.h"
+
+namespace tflite {
+namespace {
+
+constexpr int kInputTensor = 0;
+constexpr int kOutputTensor = 0;
+
+/* The tensor `tensor_index` of the node is an output of the model */
+bool IsSubgraphOutput(MicroContext* micro_context, int tensor_index) {
+  const TfLiteEvalTensor* tensor = micro_context->GetEvalTensor(tensor_index);
+  MicroGraph& graph = micro_context->graph();
+  for (int subgraph = 0; subgraph < graph.NumSubgraphs(); ++subgraph) {
+    for (size_t i = 0; i < graph.NumSubgraphOutputs(subgraph); ++i) {
+      if (graph.GetSubgraphOutput(subgraph, i) == tensor) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
+  TF_LITE_ENSURE_EQ(context, NumInputs(node), 1);
+  TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
+
+  MicroContext* micro_context = GetMicroContext(context);
+  /* Only the recognizer makes the softmax of the logits, an operator after
+     the SOFTMAX would take the logits as probabilities */
+  TF_LITE_ENSURE_MSG(
+      context, IsSubgraphOutput(micro_context, node->outputs->data[kOutputTensor]),
+      "The elided SOFTMAX must make an output of the model");
+
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kInputTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  TfLiteTensor* output =
+      micro_context->AllocateTempOutputTensor(node, kOutputTensor);
+  TF_LITE_ENSURE(context, output != nullptr);
+
+  /* Only the int8 (or 16x8) classifier of our models */
+  TF_LITE_ENSURE(context, input->type == kTfLiteInt8 ||
+                              input->type == kTfLiteInt16);
+  TF_LITE_ENSURE_TYPES_EQ(context, output->type, input->type);
+  TF_LITE_ENSURE_EQ(context, NumElements(input), NumElements(output));
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(output);
+  return kTfLiteOk;
+}
+
+TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kInputTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
+
+  const size_t element_size = (input->type == kTfLiteInt16) ? 2 : 1;
+  if (output->data.data != input->data.data) {
+    std::memcpy(output->data.data, input->data.data,
+                tflite::micro::GetTensorShape(input).FlatSize() * element_size);
+  }
+  return kTfLiteOk;
+}
+
+bool IsSoftmax(const Model* model, const Operator* op) {
+  const OperatorCode* code =
+      model->operator_codes()->Get(op->opcode_index());
+  /* New converters keep small opcodes in deprecated_builtin_code as well */
+  const int builtin_code = std::max<int>(code->builtin_code(),
+                                         code->deprecated_builtin_code());
+  return builtin_code == BuiltinOperator_SOFTMAX;
+}
+
+}  // namespace
+
+TFLMRegistration* Register_KWS_SOFTMAX_ELIDED() {
+  static TFLMRegistration r = tflite::micro::RegisterOp(nullptr, Prepare, Eval);
+  return &r;
+}
+
+TfLiteStatus KwsModelLogits(const Model* model, float* scale,
+                            int32_t* zero_point, bool* has_softmax) {
+  if ((model == nullptr) || (model->subgraphs() == nullptr) ||
+      (model->subgraphs()->size() == 0)) {
+    return kTfLiteError;
+  }
+  const SubGraph* subgraph = model->subgraphs()->Get(0);
+  if ((subgraph->outputs() == nullptr) || (subgraph->outputs()->size() == 0) ||
+      (subgraph->tensors() == nullptr)) {
+    return kTfLiteError;
+  }
+
+  /* The operator which writes the output, the last one in our models */
+  int32_t logits = subgraph->outputs()->Get(0);
+  *has_softmax = false;
+  if (subgraph->operators() != nullptr) {
+    for (const Operator* op : *subgraph->operators()) {
+      if ((op->outputs() != nullptr) && (op->outputs()->size() > 0) &&
+          (op->outputs()->Get(0) == logits) && IsSoftmax(model, op) &&
+          (op->inputs() != nullptr) && (op->inputs()->size() > 0)) {
+        logits = op->inputs()->Get(0);
+        *has_softmax = true;
+        break;
+      }
+    }
+  }
+
+  const Tensor* tensor = subgraph->tensors()->Get(logits);
+  const QuantizationParameters* quantization = tensor->quantization();
+  if ((quantization == nullptr) || (quantization->scale() == nullptr) ||
+      (quantization->scale()->size() != 1) ||
+      (quantization->zero_point() == nullptr) ||
+      (quantization->zero_point()->size() != 1)) {
+    MicroPrintf("The logits of the model are not quantized per tensor");
+    return kTfLiteError;
+  }
+  *scale = quantization->scale()->Get(0);
+  *zero_point = static_cast<int32_t>(quantization->zero_point()->Get(0));
+  return kTfLiteOk;
+}
+
+}  // namespace tflite
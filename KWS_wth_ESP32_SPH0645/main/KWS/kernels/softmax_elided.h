@@ -0,0 +1,39 @@
+/*
+ *  softmax_elided.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef KWS_KERNELS_SOFTMAX_ELIDED_H_
+#define KWS_KERNELS_SOFTMAX_ELIDED_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/micro/micro_common.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace tflite {
+
+/* Registered in place of SOFTMAX when only the argmax and the thresholds of
+   the outputs are needed : the output gets a copy of the int8 logits, so
+   there is no exp, no division, no scratch buffer and no op data in the
+   arena. The output keeps the quantization of the softmax in the
+   flatbuffer, KwsModelLogits() gives the one of the logits.
+   Prepare fails when the output of the SOFTMAX is not an output of the
+   model, the logits would go to the next operators.
+   Inputs  : logits [1,N] int8 (int16 for the 16x8 models)
+   Outputs : logits [1,N] of the input type */
+TFLMRegistration* Register_KWS_SOFTMAX_ELIDED();
+
+/* Scale and zero point of the logits of `model` : the input of the SOFTMAX
+   which makes the output of the model, or the output itself when there is
+   no SOFTMAX (stripped by KWS_model/strip_softmax.py). *has_softmax says
+   which one it is */
+TfLiteStatus KwsModelLogits(const Model* model, float* scale,
+                            int32_t* zero_point, bool* has_softmax);
+
+}  // namespace tflite
+
+#endif /* KWS_KERNELS_SOFTMAX_ELIDED_H_ */
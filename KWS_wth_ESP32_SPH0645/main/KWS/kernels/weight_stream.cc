@@ -0,0 +1,220 @@
+/*
+ *  weight_stream.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "weight_stream.h"
+
+#include <cstring>
+
+#include <esp_log.h>
+#include <esp_timer.h>
+
+/* FreeRTOS */
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "../telemetry.h"
+
+extern "C" {
+#include "../keyword_spotting_config.h"
+}
+
+namespace tflite {
+namespace {
+
+/* TAG used for serial message */
+const char TAG[] = "KWS weights";
+
+constexpr size_t kTileCapacity = KEYWORD_SPOTTING_WEIGHT_STREAM_STAGING_SIZE / 2;
+
+/* The staging area is a static array so that it is always in internal RAM,
+   even when the arena is moved to the PSRAM */
+alignas(16) uint8_t g_staging[2 * kTileCapacity];
+
+/* One half of the staging area. `requested` is increased for every copy
+   which is asked for, and `completed` takes its value when the copy is done,
+   so a kernel never uses a half which is still being written */
+struct StagingHalf {
+  const void* src;
+  size_t length;
+  uint32_t requested;
+  volatile uint32_t completed;
+};
+StagingHalf g_halves[2];
+
+struct FetchRequest {
+  int buffer;
+  const void* src;
+  size_t length;
+  uint32_t sequence;
+};
+
+KwsWeightStreamStats g_stats[KEYWORD_SPOTTING_WEIGHT_STREAM_MAX_TENSORS];
+int g_stats_count = 0;
+
+QueueHandle_t g_fetch_queue = nullptr;
+SemaphoreHandle_t g_fetch_done = nullptr;
+bool g_initialized = false;
+
+uint8_t* StagingHalfData(int buffer) {
+  return g_staging + buffer * kTileCapacity;
+}
+
+/* The prefetch task, it is pinned to the other core than the keyword
+   spotting task, so the copies run in parallel with the kernels */
+void weight_stream_prefetch_task(void* pvParameter) {
+  FetchRequest request;
+  for (;;) {
+    if (xQueueReceive(g_fetch_queue, &request, portMAX_DELAY) == pdTRUE) {
+      std::memcpy(StagingHalfData(request.buffer), request.src,
+                  request.length);
+      /* The data must be visible to the other core before the sequence */
+      __sync_synchronize();
+      g_halves[request.buffer].completed = request.sequence;
+      xSemaphoreGive(g_fetch_done);
+    }
+  }
+}
+
+}  // namespace
+
+TfLiteStatus KwsWeightStreamInit(void) {
+  if (g_initialized) {
+    return kTfLiteOk;
+  }
+
+#if (KEYWORD_SPOTTING_WEIGHT_STREAM_PREFETCH_TASK == 1)
+  g_fetch_queue = xQueueCreate(2, sizeof(FetchRequest));
+  g_fetch_done = xSemaphoreCreateBinary();
+  if ((g_fetch_queue == nullptr) || (g_fetch_done == nullptr)) {
+    ESP_LOGE(TAG, "Can't create the prefetch queue");
+    return kTfLiteError;
+  }
+
+  BaseType_t task_status = xTaskCreatePinnedToCore(
+      &weight_stream_prefetch_task, "weights prefetch",
+      KEYWORD_SPOTTING_WEIGHT_STREAM_TASK_STACK_SIZE, NULL,
+      KEYWORD_SPOTTING_WEIGHT_STREAM_TASK_PRIORITY, NULL,
+      KEYWORD_SPOTTING_WEIGHT_STREAM_TASK_CORE_ID);
+  if (task_status != pdPASS) {
+    ESP_LOGE(TAG, "Can't create the prefetch task");
+    return kTfLiteError;
+  }
+#endif
+
+  g_initialized = true;
+  return kTfLiteOk;
+}
+
+size_t KwsWeightStreamTileCapacity(void) {
+  return g_initialized ? kTileCapacity : 0;
+}
+
+int KwsWeightStreamRegister(const void* tensor_data, size_t tensor_bytes,
+                            size_t tile_bytes) {
+  /* The kernel is prepared again, for example after a model swap which put
+     other weights at the same address, so forget the tiles of this tensor */
+  const uint8_t* tensor_start = static_cast<const uint8_t*>(tensor_data);
+  for (StagingHalf& half : g_halves) {
+    const uint8_t* src = static_cast<const uint8_t*>(half.src);
+    if ((src >= tensor_start) && (src < tensor_start + tensor_bytes)) {
+      half.src = nullptr;
+      half.length = 0;
+    }
+  }
+
+  for (int slot = 0; slot < g_stats_count; slot++) {
+    if (g_stats[slot].tensor_data == tensor_data) {
+      g_stats[slot].tensor_bytes = tensor_bytes;
+      g_stats[slot].tile_bytes = tile_bytes;
+      return slot;
+    }
+  }
+  if (g_stats_count == KEYWORD_SPOTTING_WEIGHT_STREAM_MAX_TENSORS) {
+    return -1;
+  }
+
+  KwsWeightStreamStats& stats = g_stats[g_stats_count];
+  std::memset(&stats, 0, sizeof(stats));
+  stats.tensor_data = tensor_data;
+  stats.tensor_bytes = tensor_bytes;
+  stats.tile_bytes = tile_bytes;
+  return g_stats_count++;
+}
+
+void KwsWeightStreamFetch(int slot, int buffer, const void* src,
+                          size_t length) {
+  StagingHalf& half = g_halves[buffer];
+  /* The tile is already there (or on its way), when the whole tensor fits in
+     one tile it stays in the staging area between invokes */
+  if ((half.src == src) && (half.length == length)) {
+    return;
+  }
+  half.src = src;
+  half.length = length;
+  half.requested++;
+
+  if (g_fetch_queue != nullptr) {
+    FetchRequest request = {buffer, src, length, half.requested};
+    xQueueSend(g_fetch_queue, &request, portMAX_DELAY);
+  }
+  /* Without the prefetch task the copy is done in KwsWeightStreamWait() */
+}
+
+const int8_t* KwsWeightStreamWait(int slot, int buffer) {
+  StagingHalf& half = g_halves[buffer];
+  KwsWeightStreamStats& stats = g_stats[slot];
+  stats.tiles++;
+
+  if (half.completed == half.requested) {
+    stats.prefetch_hits++;
+  } else {
+    stats.prefetch_misses++;
+    const int64_t start_time = esp_timer_get_time();
+    if (g_fetch_queue == nullptr) {
+      std::memcpy(StagingHalfData(buffer), half.src, half.length);
+      half.completed = half.requested;
+    } else {
+      while (half.completed != half.requested) {
+        xSemaphoreTake(g_fetch_done, portMAX_DELAY);
+      }
+    }
+    stats.stall_us += esp_timer_get_time() - start_time;
+  }
+  return reinterpret_cast<const int8_t*>(StagingHalfData(buffer));
+}
+
+void KwsWeightStreamInvokeDone(int slot, int64_t invoke_us) {
+  KwsWeightStreamStats& stats = g_stats[slot];
+  stats.invokes++;
+  stats.last_invoke_us = invoke_us;
+  if (invoke_us > stats.worst_invoke_us) {
+    stats.worst_invoke_us = invoke_us;
+  }
+}
+
+const KwsWeightStreamStats* KwsWeightStreamGetStats(int slot) {
+  if ((slot < 0) || (slot >= g_stats_count)) {
+    return nullptr;
+  }
+  return &g_stats[slot];
+}
+
+void KwsWeightStreamLogStats(void) {
+  for (int slot = 0; slot < g_stats_count; slot++) {
+    const KwsWeightStreamStats& stats = g_stats[slot];
+    telemetry_log(TELEMETRY_WEIGHT_STREAM_PREFETCH, slot,
+                  static_cast<int32_t>(stats.prefetch_hits),
+                  static_cast<int32_t>(stats.prefetch_misses));
+    telemetry_log(TELEMETRY_WEIGHT_STREAM_LATENCY, slot,
+                  static_cast<int32_t>(stats.stall_us),
+                  static_cast<int32_t>(stats.worst_invoke_us));
+  }
+}
+
+}  // namespace tflite
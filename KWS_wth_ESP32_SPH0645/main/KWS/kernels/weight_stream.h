@@ -0,0 +1,75 @@
+/*
+ *  weight_stream.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef KWS_KERNELS_WEIGHT_STREAM_H_
+#define KWS_KERNELS_WEIGHT_STREAM_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+
+/* Weight streaming of large constant tensors.
+   The model flatbuffer stays in the memory-mapped flash, and the kernels which
+   use it (see fully_connected_streamed.h) copy the weights tile by tile into
+   a small staging area in internal RAM, which is split into two halves.
+   While a kernel computes with one half, a prefetch task on the other core
+   copies the next tile into the other half, so the flash cache misses are
+   paid sequentially, and hidden behind the computation when it is long enough.
+
+   Every streamed tensor has its own statistics slot:
+   a prefetch "hit" is a tile which was already in the staging area when the
+   kernel needed it, a "miss" is a tile the kernel had to wait for. */
+struct KwsWeightStreamStats {
+  const void* tensor_data;  /* Address of the weights in flash */
+  uint32_t tensor_bytes;
+  uint32_t tile_bytes;
+  uint32_t invokes;
+  uint32_t tiles;
+  uint32_t prefetch_hits;
+  uint32_t prefetch_misses;
+  int64_t stall_us;        /* Time spent waiting for tiles, all invokes */
+  int64_t last_invoke_us;  /* Time of the last invoke of the kernel */
+  int64_t worst_invoke_us; /* Worst time of one invoke of the kernel */
+};
+
+/* Create the staging area and the prefetch task, it must be called before
+   AllocateTensors(), because the kernels ask for the tile size in Prepare */
+TfLiteStatus KwsWeightStreamInit(void);
+
+/* Size of one half of the staging area, 0 if streaming is not available */
+size_t KwsWeightStreamTileCapacity(void);
+
+/* Get a statistics slot for a tensor, the same slot is returned when the
+   interpreter is prepared again. Returns -1 if all the slots are used */
+int KwsWeightStreamRegister(const void* tensor_data, size_t tensor_bytes,
+                            size_t tile_bytes);
+
+/* Start copying `length` bytes of `src` into staging half `buffer` (0 or 1),
+   the copy runs on the prefetch task when it exists, else it is done here */
+void KwsWeightStreamFetch(int slot, int buffer, const void* src,
+                          size_t length);
+
+/* Wait until staging half `buffer` is filled and return its address */
+const int8_t* KwsWeightStreamWait(int slot, int buffer);
+
+/* Called by the kernels at the end of every invoke */
+void KwsWeightStreamInvokeDone(int slot, int64_t invoke_us);
+
+/* Statistics of slot `slot`, nullptr if it is not used */
+const KwsWeightStreamStats* KwsWeightStreamGetStats(int slot);
+
+/* Put the statistics of all the streamed tensors in the telemetry ring, two
+   records per tensor. It never blocks, the records are printed by the
+   telemetry task */
+void KwsWeightStreamLogStats(void);
+
+}  // namespace tflite
+
+#endif /* KWS_KERNELS_WEIGHT_STREAM_H_ */
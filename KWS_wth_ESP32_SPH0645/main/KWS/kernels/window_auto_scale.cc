@@ -0,0 +1,534 @@
+/*
+ *  window_auto_scale.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "window_auto_scale.h"
+
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+#include "sdkconfig.h"
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define KWS_WINDOW_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define KWS_WINDOW_NEON 1
+#elif defined(__XTENSA__) && CONFIG_IDF_TARGET_ESP32S3
+#define KWS_WINDOW_PIE 1
+#endif
+
+#include "signal/micro/kernels/fft_auto_scale_kernel.h"
+#include "signal/src/fft_auto_scale.h"
+#include "signal/src/max_abs.h"
+#include "signal/src/msb.h"
+#include "signal/src/window.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/flatbuffer_utils.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/micro_context.h"
+
+namespace tflite {
+namespace {
+
+/* int16 lanes of one vector */
+constexpr int kLanes = 8;
+
+/* Max and min of a block of kLanes * n values, 0 included */
+struct MaxMin {
+  int16_t max;
+  int16_t min;
+};
+
+#if KWS_WINDOW_PIE
+/* The PIE loads and stores ignore the 4 low address bits */
+inline bool IsAligned(const void* pointer) {
+  return (reinterpret_cast<uintptr_t>(pointer) & 15) == 0;
+}
+
+/* Horizontal max and min of the two vectors stored by the asm blocks */
+MaxMin ReduceLanes(const int16_t* lanes) {
+  MaxMin result = {0, 0};
+  for (int i = 0; i < kLanes; ++i) {
+    result.max = (lanes[i] > result.max) ? lanes[i] : result.max;
+    result.min = (lanes[kLanes + i] < result.min) ? lanes[kLanes + i]
+                                                  : result.min;
+  }
+  return result;
+}
+
+/* EE.VMUL.S16 keeps the low 16 bits of (x * w) >> SAR, which is the saturated
+   ApplyWindow() only when the products can't overflow (see
+   KwsWindowFitsInt16()), the caller checks it */
+MaxMin WindowBlocks(const int16_t* input, const int16_t* window, int blocks,
+                    int shift, int16_t* output) {
+  alignas(16) int16_t lanes[2 * kLanes];
+  int16_t* lanes_pointer = lanes;
+  asm volatile(
+      "wsr.sar %[shift]\n"
+      "ee.zero.q q3\n"
+      "ee.zero.q q4\n"
+      "loopgtz %[blocks], 1f\n"
+      "ee.vld.128.ip q0, %[input], 16\n"
+      "ee.vld.128.ip q1, %[window], 16\n"
+      "ee.vmul.s16 q2, q0, q1\n"
+      "ee.vmax.s16 q3, q3, q2\n"
+      "ee.vmin.s16 q4, q4, q2\n"
+      "ee.vst.128.ip q2, %[output], 16\n"
+      "1:\n"
+      "ee.vst.128.ip q3, %[lanes], 16\n"
+      "ee.vst.128.ip q4, %[lanes], 16\n"
+      : [input] "+r"(input), [window] "+r"(window), [output] "+r"(output),
+        [lanes] "+r"(lanes_pointer)
+      : [blocks] "r"(blocks), [shift] "r"(shift)
+      : "memory");
+  return ReduceLanes(lanes);
+}
+
+MaxMin MaxMinBlocks(const int16_t* input, int blocks) {
+  alignas(16) int16_t lanes[2 * kLanes];
+  int16_t* lanes_pointer = lanes;
+  asm volatile(
+      "ee.zero.q q3\n"
+      "ee.zero.q q4\n"
+      "loopgtz %[blocks], 1f\n"
+      "ee.vld.128.ip q0, %[input], 16\n"
+      "ee.vmax.s16 q3, q3, q0\n"
+      "ee.vmin.s16 q4, q4, q0\n"
+      "1:\n"
+      "ee.vst.128.ip q3, %[lanes], 16\n"
+      "ee.vst.128.ip q4, %[lanes], 16\n"
+      : [input] "+r"(input), [lanes] "+r"(lanes_pointer)
+      : [blocks] "r"(blocks)
+      : "memory");
+  return ReduceLanes(lanes);
+}
+
+/* x * (1 << bits) with SAR = 0, the auto scale chooses bits so that the
+   products fit 16 bits */
+void ShiftBlocks(const int16_t* input, int blocks, int bits, int16_t* output) {
+  const int16_t scale = static_cast<int16_t>(1 << bits);
+  const int zero = 0;
+  asm volatile(
+      "wsr.sar %[zero]\n"
+      "ee.vldbc.16 q1, %[scale]\n"
+      "loopgtz %[blocks], 1f\n"
+      "ee.vld.128.ip q0, %[input], 16\n"
+      "ee.vmul.s16 q2, q0, q1\n"
+      "ee.vst.128.ip q2, %[output], 16\n"
+      "1:\n"
+      : [input] "+r"(input), [output] "+r"(output)
+      : [blocks] "r"(blocks), [scale] "r"(&scale), [zero] "r"(zero)
+      : "memory");
+}
+
+#elif KWS_WINDOW_SSE2
+inline bool IsAligned(const void*) { return true; }
+
+MaxMin ReduceLanes(__m128i max, __m128i min) {
+  alignas(16) int16_t lanes[2 * kLanes];
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes), max);
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes + kLanes), min);
+  MaxMin result = {0, 0};
+  for (int i = 0; i < kLanes; ++i) {
+    result.max = (lanes[i] > result.max) ? lanes[i] : result.max;
+    result.min = (lanes[kLanes + i] < result.min) ? lanes[kLanes + i]
+                                                  : result.min;
+  }
+  return result;
+}
+
+/* The 32 bits products from mullo / mulhi, shifted, and packed back with
+   the saturation of ApplyWindow() */
+MaxMin WindowBlocks(const int16_t* input, const int16_t* window, int blocks,
+                    int shift, int16_t* output) {
+  const __m128i count = _mm_cvtsi32_si128(shift);
+  __m128i max = _mm_setzero_si128();
+  __m128i min = _mm_setzero_si128();
+  for (int i = 0; i < blocks * kLanes; i += kLanes) {
+    const __m128i x =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    const __m128i w =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(window + i));
+    const __m128i low = _mm_mullo_epi16(x, w);
+    const __m128i high = _mm_mulhi_epi16(x, w);
+    const __m128i product0 = _mm_sra_epi32(_mm_unpacklo_epi16(low, high), count);
+    const __m128i product1 = _mm_sra_epi32(_mm_unpackhi_epi16(low, high), count);
+    const __m128i y = _mm_packs_epi32(product0, product1);
+    max = _mm_max_epi16(max, y);
+    min = _mm_min_epi16(min, y);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), y);
+  }
+  return ReduceLanes(max, min);
+}
+
+MaxMin MaxMinBlocks(const int16_t* input, int blocks) {
+  __m128i max = _mm_setzero_si128();
+  __m128i min = _mm_setzero_si128();
+  for (int i = 0; i < blocks * kLanes; i += kLanes) {
+    const __m128i x =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    max = _mm_max_epi16(max, x);
+    min = _mm_min_epi16(min, x);
+  }
+  return ReduceLanes(max, min);
+}
+
+void ShiftBlocks(const int16_t* input, int blocks, int bits, int16_t* output) {
+  const __m128i count = _mm_cvtsi32_si128(bits);
+  for (int i = 0; i < blocks * kLanes; i += kLanes) {
+    const __m128i x =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                     _mm_sll_epi16(x, count));
+  }
+}
+
+#elif KWS_WINDOW_NEON
+inline bool IsAligned(const void*) { return true; }
+
+MaxMin WindowBlocks(const int16_t* input, const int16_t* window, int blocks,
+                    int shift, int16_t* output) {
+  const int32x4_t count = vdupq_n_s32(-shift);
+  int16x8_t max = vdupq_n_s16(0);
+  int16x8_t min = vdupq_n_s16(0);
+  for (int i = 0; i < blocks * kLanes; i += kLanes) {
+    const int16x8_t x = vld1q_s16(input + i);
+    const int16x8_t w = vld1q_s16(window + i);
+    const int32x4_t product0 =
+        vshlq_s32(vmull_s16(vget_low_s16(x), vget_low_s16(w)), count);
+    const int32x4_t product1 =
+        vshlq_s32(vmull_s16(vget_high_s16(x), vget_high_s16(w)), count);
+    const int16x8_t y = vcombine_s16(vqmovn_s32(product0), vqmovn_s32(product1));
+    max = vmaxq_s16(max, y);
+    min = vminq_s16(min, y);
+    vst1q_s16(output + i, y);
+  }
+  const MaxMin result = {vmaxvq_s16(max), vminvq_s16(min)};
+  return result;
+}
+
+MaxMin MaxMinBlocks(const int16_t* input, int blocks) {
+  int16x8_t max = vdupq_n_s16(0);
+  int16x8_t min = vdupq_n_s16(0);
+  for (int i = 0; i < blocks * kLanes; i += kLanes) {
+    const int16x8_t x = vld1q_s16(input + i);
+    max = vmaxq_s16(max, x);
+    min = vminq_s16(min, x);
+  }
+  const MaxMin result = {vmaxvq_s16(max), vminvq_s16(min)};
+  return result;
+}
+
+void ShiftBlocks(const int16_t* input, int blocks, int bits, int16_t* output) {
+  const int16x8_t count = vdupq_n_s16(static_cast<int16_t>(bits));
+  for (int i = 0; i < blocks * kLanes; i += kLanes) {
+    vst1q_s16(output + i, vshlq_s16(vld1q_s16(input + i), count));
+  }
+}
+#endif
+
+#if KWS_WINDOW_PIE || KWS_WINDOW_SSE2 || KWS_WINDOW_NEON
+constexpr bool kHaveVectors = true;
+#else
+constexpr bool kHaveVectors = false;
+inline bool IsAligned(const void*) { return false; }
+MaxMin WindowBlocks(const int16_t*, const int16_t*, int, int, int16_t*) {
+  return MaxMin{0, 0};
+}
+MaxMin MaxMinBlocks(const int16_t*, int) { return MaxMin{0, 0}; }
+void ShiftBlocks(const int16_t*, int, int, int16_t*) {}
+#endif
+
+void MergeMaxMin(MaxMin* result, int16_t value) {
+  result->max = (value > result->max) ? value : result->max;
+  result->min = (value < result->min) ? value : result->min;
+}
+
+/* MaxAbs16() of the values, from their max and min. MaxAbs16() stores
+   -(-32768) in an int16 and goes on with the wrapped value, only the scalar
+   function gives its result then */
+int16_t MaxAbsOf(const MaxMin& range, const int16_t* values, int size) {
+  if (range.min == INT16_MIN) {
+    return tflm_signal::MaxAbs16(values, size);
+  }
+  return (range.max >= -range.min) ? range.max
+                                   : static_cast<int16_t>(-range.min);
+}
+
+MaxMin WindowMaxMin(const int16_t* input, const int16_t* window, int size,
+                    int shift, bool window_fits, int16_t* output) {
+  MaxMin range = {0, 0};
+  int done = 0;
+  if (kHaveVectors && window_fits && IsAligned(input) && IsAligned(window) &&
+      IsAligned(output)) {
+    const int blocks = size / kLanes;
+    if (blocks > 0) {
+      range = WindowBlocks(input, window, blocks, shift, output);
+      done = blocks * kLanes;
+    }
+  }
+  if (done < size) {
+    ::tflm_signal::ApplyWindow(input + done, window + done, size - done, shift,
+                               output + done);
+    for (int i = done; i < size; ++i) {
+      MergeMaxMin(&range, output[i]);
+    }
+  }
+  return range;
+}
+
+MaxMin RangeOf(const int16_t* input, int size) {
+  MaxMin range = {0, 0};
+  int done = 0;
+  if (kHaveVectors && IsAligned(input)) {
+    const int blocks = size / kLanes;
+    if (blocks > 0) {
+      range = MaxMinBlocks(input, blocks);
+      done = blocks * kLanes;
+    }
+  }
+  for (int i = done; i < size; ++i) {
+    MergeMaxMin(&range, input[i]);
+  }
+  return range;
+}
+
+/* The end of FftAutoScale() once the max abs is known */
+int AutoScaleWithMaxAbs(const int16_t* input, int size, int16_t max,
+                        int16_t* output) {
+  int scale_bits = (sizeof(int16_t) * 8) -
+                   tflm_signal::MostSignificantBit32(max) - 1;
+  if (scale_bits <= 0) {
+    scale_bits = 0;
+  }
+
+  int done = 0;
+  if (kHaveVectors && IsAligned(input) && IsAligned(output)) {
+    const int blocks = size / kLanes;
+    if (blocks > 0) {
+      ShiftBlocks(input, blocks, scale_bits, output);
+      done = blocks * kLanes;
+    }
+  }
+  for (int i = done; i < size; ++i) {
+    output[i] = input[i] * (1 << scale_bits);
+  }
+  return scale_bits;
+}
+
+/*** Kernels ***/
+
+constexpr int kInputTensor = 0;
+constexpr int kWeightsTensor = 1;
+constexpr int kOutputTensor = 0;
+constexpr int kScaleBitTensor = 1;
+
+// Indices into the init flexbuffer's vector of SignalWindow.
+constexpr int kShiftIndex = 0;  // 'shift'
+
+struct OpDataWindow {
+  int32_t shift;
+  int32_t input_size;
+  bool window_fits;
+  /* Copy of the weights in the arena for PIE, which needs them 16 bytes
+     aligned, nullptr when the weights tensor is used */
+  int16_t* aligned_window;
+};
+
+/* Max abs of the last window output, taken by the next FftAutoScale when
+   its input is this output tensor : the same eval tensor and data. Only the
+   window writes this tensor, another tensor of the same size can be at the
+   same address when the planner reused the buffer. A Reshape which copies
+   the window output (the planner of TFLM doesn't run it in place) gives
+   another tensor, then the FftAutoScale reads its input */
+struct WindowMaxAbs {
+  const TfLiteEvalTensor* tensor;
+  const int16_t* data;
+  int32_t size;
+  int16_t max_abs;
+};
+
+WindowMaxAbs g_window_max_abs = {nullptr, nullptr, 0, 0};
+
+void* WindowInit(TfLiteContext* context, const char* buffer, size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  auto* data = static_cast<OpDataWindow*>(
+      context->AllocatePersistentBuffer(context, sizeof(OpDataWindow)));
+  if (data == nullptr) {
+    return nullptr;
+  }
+
+  tflite::FlexbufferWrapper fbw(reinterpret_cast<const uint8_t*>(buffer),
+                                length);
+  data->shift = fbw.ElementAsInt32(kShiftIndex);
+  return data;
+}
+
+TfLiteStatus WindowPrepare(TfLiteContext* context, TfLiteNode* node) {
+  TF_LITE_ENSURE_EQ(context, NumInputs(node), 2);
+  TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
+
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kInputTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  TfLiteTensor* weights =
+      micro_context->AllocateTempInputTensor(node, kWeightsTensor);
+  TF_LITE_ENSURE(context, weights != nullptr);
+  TfLiteTensor* output =
+      micro_context->AllocateTempOutputTensor(node, kOutputTensor);
+  TF_LITE_ENSURE(context, output != nullptr);
+
+  TF_LITE_ENSURE(context, NumDimensions(input) >= 1);
+  TF_LITE_ENSURE_EQ(context, NumDimensions(weights), 1);
+  TF_LITE_ENSURE_EQ(context, NumDimensions(input), NumDimensions(output));
+  TF_LITE_ENSURE_TYPES_EQ(context, input->type, kTfLiteInt16);
+  TF_LITE_ENSURE_TYPES_EQ(context, weights->type, kTfLiteInt16);
+  TF_LITE_ENSURE_TYPES_EQ(context, output->type, kTfLiteInt16);
+
+  auto* data = static_cast<OpDataWindow*>(node->user_data);
+  data->input_size = GetTensorShape(input).FlatSize();
+  /* The weights must be known to use the vector multiply of PIE */
+  const int weight_size = weights->dims->data[0];
+  data->window_fits =
+      IsConstantTensor(weights) &&
+      KwsWindowFitsInt16(GetTensorData<int16_t>(weights), weight_size,
+                         data->shift);
+
+  data->aligned_window = nullptr;
+#if KWS_WINDOW_PIE
+  /* The weights are in the model, which has no alignment in flash */
+  if (data->window_fits && !IsAligned(GetTensorData<int16_t>(weights))) {
+    data->aligned_window = static_cast<int16_t*>(
+        context->AllocatePersistentBuffer(context,
+                                          weight_size * sizeof(int16_t)));
+    TF_LITE_ENSURE(context, data->aligned_window != nullptr);
+    memcpy(data->aligned_window, GetTensorData<int16_t>(weights),
+           weight_size * sizeof(int16_t));
+  }
+#endif
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(weights);
+  micro_context->DeallocateTempTfLiteTensor(output);
+  return kTfLiteOk;
+}
+
+TfLiteStatus WindowEval(TfLiteContext* context, TfLiteNode* node) {
+  auto* data = static_cast<OpDataWindow*>(node->user_data);
+
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kInputTensor);
+  const TfLiteEvalTensor* weights =
+      tflite::micro::GetEvalInput(context, node, kWeightsTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
+
+  const int16_t* input_data = tflite::micro::GetTensorData<int16_t>(input);
+  const int16_t* weight_data = (data->aligned_window != nullptr)
+                                   ? data->aligned_window
+                                   : tflite::micro::GetTensorData<int16_t>(weights);
+  int16_t* output_data = tflite::micro::GetTensorData<int16_t>(output);
+  const int weight_size = weights->dims->data[0];
+
+  MaxMin range = {0, 0};
+  for (int i = 0; i < data->input_size; i += weight_size) {
+    const MaxMin frame =
+        WindowMaxMin(&input_data[i], weight_data, weight_size, data->shift,
+                     data->window_fits, &output_data[i]);
+    MergeMaxMin(&range, frame.max);
+    MergeMaxMin(&range, frame.min);
+  }
+
+  g_window_max_abs.tensor = output;
+  g_window_max_abs.data = output_data;
+  g_window_max_abs.size = data->input_size;
+  g_window_max_abs.max_abs = MaxAbsOf(range, output_data, data->input_size);
+  return kTfLiteOk;
+}
+
+TfLiteStatus AutoScaleEval(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kInputTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
+  TfLiteEvalTensor* scale_bit =
+      tflite::micro::GetEvalOutput(context, node, kScaleBitTensor);
+
+  const int16_t* input_data = tflite::micro::GetTensorData<int16_t>(input);
+  int16_t* output_data = tflite::micro::GetTensorData<int16_t>(output);
+  int32_t* scale_bit_data = tflite::micro::GetTensorData<int32_t>(scale_bit);
+  const int size = output->dims->data[0];
+
+  int16_t max_abs;
+  if ((g_window_max_abs.tensor == input) &&
+      (g_window_max_abs.data == input_data) &&
+      (g_window_max_abs.size == size)) {
+    max_abs = g_window_max_abs.max_abs;
+  } else {
+    max_abs = MaxAbsOf(RangeOf(input_data, size), input_data, size);
+  }
+  g_window_max_abs.tensor = nullptr;
+
+  *scale_bit_data = AutoScaleWithMaxAbs(input_data, size, max_abs, output_data);
+  return kTfLiteOk;
+}
+
+}  // namespace
+
+/* The vector multiply of PIE doesn't saturate, it gives ApplyWindow() only
+   when -(1 << shift) < w <= (1 << shift), so |x * w| >> shift fits 16 bits.
+   The multiply of SSE2 / NEON saturates like ApplyWindow() */
+bool KwsWindowFitsInt16(const int16_t* window, int size, int shift) {
+#if KWS_WINDOW_PIE
+  const int32_t limit = static_cast<int32_t>(1) << shift;
+  for (int i = 0; i < size; ++i) {
+    if ((window[i] <= -limit) || (window[i] > limit)) {
+      return false;
+    }
+  }
+  return true;
+#else
+  (void)window;
+  (void)size;
+  (void)shift;
+  return true;
+#endif
+}
+
+int16_t KwsApplyWindowMaxAbs(const int16_t* input, const int16_t* window,
+                             int size, int shift, bool window_fits,
+                             int16_t* output) {
+  const MaxMin range =
+      WindowMaxMin(input, window, size, shift, window_fits, output);
+  return MaxAbsOf(range, output, size);
+}
+
+int16_t KwsMaxAbs16(const int16_t* input, int size) {
+  return MaxAbsOf(RangeOf(input, size), input, size);
+}
+
+int KwsFftAutoScale(const int16_t* input, int size, int16_t* output) {
+  return AutoScaleWithMaxAbs(input, size, KwsMaxAbs16(input, size), output);
+}
+
+TFLMRegistration* Register_KWS_WINDOW() {
+  static TFLMRegistration r =
+      tflite::micro::RegisterOp(WindowInit, WindowPrepare, WindowEval);
+  return &r;
+}
+
+TFLMRegistration* Register_KWS_FFT_AUTO_SCALE() {
+  static TFLMRegistration r =
+      tflite::micro::RegisterOp(nullptr, FftAutoScalePrepare, AutoScaleEval);
+  return &r;
+}
+
+}  // namespace tflite
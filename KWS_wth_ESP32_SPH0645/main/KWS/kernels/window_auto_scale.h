@@ -0,0 +1,59 @@
+/*
+ *  window_auto_scale.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef KWS_KERNELS_WINDOW_AUTO_SCALE_H_
+#define KWS_KERNELS_WINDOW_AUTO_SCALE_H_
+
+#include <stdint.h>
+
+#include "tensorflow/lite/micro/micro_common.h"
+
+namespace tflite {
+
+/* Vector versions of tflm_signal::ApplyWindow(), MaxAbs16() and
+   FftAutoScale(), 8 int16 lanes at a time :
+   - ESP32-S3 : PIE 128 bits instructions (EE.VMUL.S16 with the shift in SAR,
+     EE.VMAX.S16 / EE.VMIN.S16), on 16 bytes aligned buffers.
+   - host : SSE2 or NEON, to run the same code off target.
+   - any other target : the scalar loops.
+   They are bit exact with the scalar functions, including the saturation of
+   the window and the result of MaxAbs16() when the input has -32768 (which
+   takes the scalar function).
+
+   The max abs is a max and a min over the lanes, so the window computes it
+   on its output for free. */
+
+/* False when the vector multiply can't give ApplyWindow() with this window
+   (PIE doesn't saturate), then KwsApplyWindowMaxAbs() takes the scalar loop.
+   It reads the whole window, call it once when the window is built */
+bool KwsWindowFitsInt16(const int16_t* window, int size, int shift);
+
+/* ApplyWindow() which also returns MaxAbs16() of its output, window_fits is
+   KwsWindowFitsInt16() of the window */
+int16_t KwsApplyWindowMaxAbs(const int16_t* input, const int16_t* window,
+                             int size, int shift, bool window_fits,
+                             int16_t* output);
+
+int16_t KwsMaxAbs16(const int16_t* input, int size);
+
+/* FftAutoScale(), returns the scale bits */
+int KwsFftAutoScale(const int16_t* input, int size, int16_t* output);
+
+/* SignalWindow and SignalFftAutoScale using the functions above. The window
+   keeps the max abs of its output, and the next FftAutoScale whose input is
+   this output tensor uses it instead of reading its input again. In the
+   preprocessor graph a Reshape copies the window output first, so the
+   FftAutoScale reads its input there (the vector max and min).
+   Use them as :
+     op_resolver.AddCustom( "SignalWindow" , Register_KWS_WINDOW() )
+     op_resolver.AddCustom( "SignalFftAutoScale" , Register_KWS_FFT_AUTO_SCALE() ) */
+TFLMRegistration* Register_KWS_WINDOW();
+TFLMRegistration* Register_KWS_FFT_AUTO_SCALE();
+
+}  // namespace tflite
+
+#endif /* KWS_KERNELS_WINDOW_AUTO_SCALE_H_ */
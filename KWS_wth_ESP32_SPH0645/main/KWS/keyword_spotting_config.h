@@ -12,4 +12,199 @@
 #define  KEYWORD_SPOTTING_APP_TASK_PRIORITY         (1)
 #define  KEYWORD_SPOTTING_APP_TASK_CORE_ID          (1)
 
+/* Number of models the model registry can hold */
+#define  KEYWORD_SPOTTING_MAX_MODELS                  (4)
+
+/* Streaming models (the streaming DS-CNN of the notebook, SVDF, circular
+   buffers) : the model takes one row of 40 features per invoke and keeps the
+   rows it needs in its state (variable tensors, VAR_HANDLE), instead of the
+   whole 49 x 40 spectogram. A model whose input is one row is run on every
+   new row, the others on the spectogram. STREAMING_ENABLE 1 adds their
+   operators to the resolver */
+#define  KEYWORD_SPOTTING_STREAMING_ENABLE            (0)
+
+/* 16x8 models (int16 activations, int8 weights, converted with
+   EXPERIMENTAL_TFLITE_BUILTINS_ACTIVATIONS_INT16_WEIGHTS_INT8 in the
+   notebook) : the int8 features are converted to their int16 input with a
+   table, FEATURE_SCALE and FEATURE_ZERO_POINT give the real value of the
+   features (the input quantization of the int8 models), and their int16
+   outputs are given to the recognizer as int8. INT16_ENABLE 1 puts the 16x8
+   CONV_2D and FULLY_CONNECTED of kernels/conv_fc_16x8.h in the resolver,
+   without them the 16x8 models run on the reference kernels */
+#define  KEYWORD_SPOTTING_INT16_ENABLE                (0)
+#define  KEYWORD_SPOTTING_FEATURE_SCALE               (0.102328435f)
+#define  KEYWORD_SPOTTING_FEATURE_ZERO_POINT          (-128)
+
+/* Fused Conv2D + MaxPool2D models (KWS_model/fuse_conv_max_pool.py) : the
+   conv output rows are pooled as soon as a pooling window is complete, so the
+   arena of the int8 model goes from 21.7 KB to 8.5 KB. The conv rows are made
+   by esp-nn, on the host it is as fast as the unfused pair (within 3 %), not
+   measured on the ESP32-S3 yet. 0 does not register the fused operator */
+#define  KEYWORD_SPOTTING_FUSED_CONV_POOL             (0)
+
+/* Two stages cascade (KWS/cascade_detector.h), a tiny stage 1 detector runs on
+   every stride and the KWS model only when its score (0 to 255) crosses THRESHOLD */
+#define  KEYWORD_SPOTTING_CASCADE_ENABLE              (0)
+#define  KEYWORD_SPOTTING_CASCADE_ROWS                (16)   /* Newest spectogram rows seen by stage 1 */
+#define  KEYWORD_SPOTTING_CASCADE_THRESHOLD           (128)
+#define  KEYWORD_SPOTTING_CASCADE_HOLD_STRIDES        (25)   /* Stage 2 keeps running 500 ms after a trigger */
+#define  KEYWORD_SPOTTING_CASCADE_ENERGY_GAIN         (4)    /* Score of the energy detector per feature step above the floor */
+#define  KEYWORD_SPOTTING_CASCADE_STAGE1_OUTPUT       (0)    /* Output of the stage 1 model which is the word probability */
+#define  KEYWORD_SPOTTING_CASCADE_STAGE1_PARTITION    "kws_stage1"  /* Data partition of the stage 1 model, the energy detector runs without it */
+#define  KEYWORD_SPOTTING_CASCADE_ARENA_SIZE          (1024*6)
+#define  KEYWORD_SPOTTING_CASCADE_LOG_STRIDES         (500)
+
+/* Weight streaming (KWS/kernels/weight_stream.h), the constant int8 weights
+   bigger than MIN_TENSOR_SIZE are copied from flash into a staging area of
+   STAGING_SIZE bytes (two tiles), by a prefetch task on the other core.
+   Off until it is measured on the board against the weights read in place
+   from flash. The hits, misses and stalls of every streamed tensor go to the
+   telemetry ring every LOG_STRIDES iterations */
+#define  KEYWORD_SPOTTING_WEIGHT_STREAM_ENABLE             (0)
+#define  KEYWORD_SPOTTING_WEIGHT_STREAM_STAGING_SIZE       (1024*16)
+#define  KEYWORD_SPOTTING_WEIGHT_STREAM_MIN_TENSOR_SIZE    (1024*32)
+#define  KEYWORD_SPOTTING_WEIGHT_STREAM_MAX_TENSORS        (4)
+#define  KEYWORD_SPOTTING_WEIGHT_STREAM_PREFETCH_TASK      (1)
+#define  KEYWORD_SPOTTING_WEIGHT_STREAM_TASK_STACK_SIZE    (1024*2)
+#define  KEYWORD_SPOTTING_WEIGHT_STREAM_TASK_PRIORITY      (2)
+#define  KEYWORD_SPOTTING_WEIGHT_STREAM_TASK_CORE_ID       (0)
+#define  KEYWORD_SPOTTING_WEIGHT_STREAM_LOG_STRIDES        (500)
+
+/* Streaming preprocessor (KWS_model/make_streaming_preprocessor.py), the feature
+   model takes only the 20 ms of new audio of every stride and keeps the 10 ms
+   overlap in its SignalFramer state, instead of the history buffer of the
+   audio provider. The features are the same as the normal preprocessor */
+#define  KEYWORD_SPOTTING_STREAMING_FRONTEND          (0)
+
+/* Radix-4 FFT of the preprocessor (KWS/kernels/rfft_512.h) : 1 registers it
+   for the 512 points SignalRfft, 0 keeps the kiss_fftr kernel of TFLM. It is
+   faster and closer to the exact DFT, but not bit-exact with kiss_fftr which
+   made the training features, host_checks/rfft_512_check.cc gives the error
+   and the time of both */
+#define  KEYWORD_SPOTTING_FAST_RFFT                   (0)
+
+/* Compact FilterBank of the preprocessor (KWS/kernels/filter_bank_sparse.h) :
+   1 registers it for SignalFilterBank, 0 keeps the stock kernel. Both give
+   the same output, the compact one sums on 32 bits where it can't overflow,
+   which only pays on a CPU without a 64 bits multiply accumulate. On x86 it
+   is slower (1.2 us against 0.9 us per frame, host_checks/filter_bank_bench.cc),
+   keep 0 until it is measured faster on the ESP32-S3 */
+#define  KEYWORD_SPOTTING_COMPACT_FILTER_BANK         (0)
+
+/* Frames (20 ms each) of fast noise estimate warmup at start and after
+   keyword_spotting_app_relese(), instead of the low pass filter which needs
+   seconds to follow a new noise level. 0 keeps the old estimate */
+#define  KEYWORD_SPOTTING_RESUME_WARMUP_FRAMES        (10)
+
+/* 1 keeps a snapshot of the noise estimate from keyword_spotting_app_suspend()
+   and puts it back in keyword_spotting_app_relese(), instead of the warmup.
+   The snapshot is exact when the device resumes where it was suspended, the
+   warmup follows a new place faster (host_checks/resume_check.cc) */
+#define  KEYWORD_SPOTTING_RESUME_SNAPSHOT             (0)
+
+/* Microphones on the I2S data line (1 or 2), the SEL pin of the second SPH0645
+   is high. With 2, every microphone has its own ring buffer and one stride of
+   both is combined before the feature engine (KWS/mic_array.h), by MIC_MODE :
+   0 the channel with the highest energy, 1 delay and sum */
+#define  KEYWORD_SPOTTING_MIC_CHANNELS                (1)
+#define  KEYWORD_SPOTTING_MIC_MODE                    (1)
+#define  KEYWORD_SPOTTING_MIC_MAX_DELAY               (4)    /* Samples, 8.5 cm between the microphones at 16 kHz */
+#define  KEYWORD_SPOTTING_MIC_LOG_STRIDES             (500)
+
+/* Noise and echo suppression of the audio before the feature engine
+   (KWS/noise_suppressor.h) : a Wiener gain on every FFT bin, and an NLMS echo
+   canceller of AEC_TAPS taps when the audio played by the device is given to
+   PushReferenceSamples_KWS(). 0 taps removes the echo canceller */
+#define  KEYWORD_SPOTTING_NOISE_SUPPRESSION           (0)
+#define  KEYWORD_SPOTTING_NS_MIN_GAIN                 (3277)  /* Q15, -20 dB */
+#define  KEYWORD_SPOTTING_AEC_TAPS                    (128)   /* 8 ms of echo path */
+#define  KEYWORD_SPOTTING_AEC_STEP                    (4096)  /* NLMS step in Q15, 0.125 */
+#define  KEYWORD_SPOTTING_NS_BUDGET_US                (2000)  /* Warning when a stride takes longer */
+#define  KEYWORD_SPOTTING_NS_LOG_STRIDES              (500)
+
+/* Capture backend : 0 the legacy I2S driver and its capture task, which
+   polls i2s_read() into the ring buffers, 1 the i2s_std channel driver, whose
+   DMA receive callback puts every full DMA buffer into the capture ring
+   (KWS/dma_capture.h) and wakes the KWS task when its stride is there. Every
+   DMA buffer holds CAPTURE_LATENCY_MS of audio, and there are enough of them
+   to keep CAPTURE_ISR_SLACK_MS while the interrupt is held off. The callback
+   is in IRAM : with CONFIG_I2S_ISR_IRAM_SAFE it also runs during flash
+   writes, without it the slack covers them */
+#define  KEYWORD_SPOTTING_I2S_STD_DRIVER              (0)
+#define  KEYWORD_SPOTTING_CAPTURE_LATENCY_MS          (10)
+#define  KEYWORD_SPOTTING_CAPTURE_ISR_SLACK_MS        (30)
+#define  KEYWORD_SPOTTING_CAPTURE_RING_SAMPLES        (16384) /* Per microphone, a power of two, ~1 s */
+#define  KEYWORD_SPOTTING_CAPTURE_LOG_STRIDES         (500)
+
+/* Power management (KWS/power_governor.h), needs CONFIG_PM_ENABLE : the KWS
+   task sleeps until a stride of audio is captured instead of polling, and
+   holds an ESP_PM_CPU_FREQ_MAX lock only for the features and the inference.
+   The frequency of this lock is the lowest of PM_FREQS_MHZ which does the
+   peak work of PM_WINDOW_STRIDES iterations in PM_TARGET_LOAD % of a stride.
+   Between the iterations the CPU waits at PM_MIN_FREQ_MHZ, the I2S driver
+   keeps the APB clock (and no light sleep) while it captures. The average
+   current is estimated from PM_ACTIVE_UA and PM_IDLE_UA, rough values for
+   the ESP32-S3 to replace with a measurement of the board */
+#define  KEYWORD_SPOTTING_POWER_MANAGEMENT            (0)
+#define  KEYWORD_SPOTTING_PM_MIN_FREQ_MHZ             (80)
+#define  KEYWORD_SPOTTING_PM_LEVELS                   (3)
+#define  KEYWORD_SPOTTING_PM_FREQS_MHZ                { 80 , 160 , 240 }
+#define  KEYWORD_SPOTTING_PM_ACTIVE_UA                { 32000 , 45000 , 58000 }
+#define  KEYWORD_SPOTTING_PM_IDLE_UA                  (22000)
+#define  KEYWORD_SPOTTING_PM_TARGET_LOAD              (70)
+#define  KEYWORD_SPOTTING_PM_WINDOW_STRIDES           (50)   /* 1 s before going down */
+#define  KEYWORD_SPOTTING_PM_LOG_STRIDES              (500)
+
+/* Telemetry (KWS/telemetry.h) : the logs of the capture and inference paths
+   are records in a lock-free ring of TELEMETRY_RECORDS (a power of two), which
+   a low priority task on the other core prints every TELEMETRY_DRAIN_MS.
+   TELEMETRY_BINARY 1 writes the records as they are on the console instead,
+   for KWS_model/decode_telemetry.py */
+#define  KEYWORD_SPOTTING_TELEMETRY_RECORDS           (64)
+#define  KEYWORD_SPOTTING_TELEMETRY_BINARY            (0)
+#define  KEYWORD_SPOTTING_TELEMETRY_DRAIN_MS          (50)
+#define  KEYWORD_SPOTTING_TELEMETRY_TASK_STACK_SIZE   (1024*3)
+#define  KEYWORD_SPOTTING_TELEMETRY_TASK_PRIORITY     (1)
+#define  KEYWORD_SPOTTING_TELEMETRY_TASK_CORE_ID      (0)
+
+/* Post-processing (other/recognize_commands.h), the scores (0 to 255) of the
+   last WINDOW_MS are averaged. A word is detected at THRESHOLD, and again only
+   after its score went under RELEASE and SUPPRESSION_MS passed. While silence
+   or unknown is on top, the scores of every word are followed with a weight
+   of 1 / 2^ADAPT_SHIFT (0 disables it), and the threshold of a word goes up
+   to their mean + ADAPT_MARGIN_Q4 / 16 deviations, at most MAX_THRESHOLD.
+   KWS_model/sweep_thresholds.py finds these values on labelled recordings */
+#define  KEYWORD_SPOTTING_RECOGNIZE_WINDOW_MS         (800)  /* At most 50 results */
+#define  KEYWORD_SPOTTING_RECOGNIZE_MINIMUM_COUNT     (3)
+#define  KEYWORD_SPOTTING_RECOGNIZE_THRESHOLD         (200)
+#define  KEYWORD_SPOTTING_RECOGNIZE_RELEASE           (100)
+#define  KEYWORD_SPOTTING_RECOGNIZE_SUPPRESSION_MS    (1500)
+#define  KEYWORD_SPOTTING_RECOGNIZE_ADAPT_SHIFT       (5)
+#define  KEYWORD_SPOTTING_RECOGNIZE_ADAPT_MARGIN_Q4   (48)
+#define  KEYWORD_SPOTTING_RECOGNIZE_MAX_THRESHOLD     (245)
+
+/* Command dispatch (KWS/command_dispatch.h) : the new commands are posted to
+   a queue of COMMAND_QUEUE_SIZE events (a power of two), the handlers run in
+   the responder task on the other core. RESPONDER_GPIO 1 turns on the LED of
+   RESPONDER_GPIO_PINS (one per label, -1 for none) of the detected label.
+   The drops and the posts to a 3/4 full queue are logged every
+   RESPONDER_LOG_MS when they changed */
+#define  KEYWORD_SPOTTING_COMMAND_QUEUE_SIZE          (16)
+#define  KEYWORD_SPOTTING_RESPONDER_TASK_STACK_SIZE   (1024*3)
+#define  KEYWORD_SPOTTING_RESPONDER_TASK_PRIORITY     (2)
+#define  KEYWORD_SPOTTING_RESPONDER_TASK_CORE_ID      (0)
+#define  KEYWORD_SPOTTING_RESPONDER_GPIO              (0)
+#define  KEYWORD_SPOTTING_RESPONDER_GPIO_PINS         { -1 , -1 , -1 , -1 }
+#define  KEYWORD_SPOTTING_RESPONDER_LOG_MS            (10000)
+
+/* Softmax elision : the recognizer takes the logits (the input of the
+   Softmax) and makes their softmax with a table, which gives the same scores
+   (other/recognize_commands.h), so the graph doesn't need its Softmax.
+   0 : the Softmax of the models runs, 1 : it is replaced at load time by a
+   copy of its input (kernels/softmax_elided.h), a model with a Softmax which
+   doesn't make its output fails to load, 2 : the Softmax isn't in the
+   resolver, all the models are stripped by KWS_model/strip_softmax.py.
+   A model without Softmax always gives its logits */
+#define  KEYWORD_SPOTTING_SOFTMAX_ELISION             (1)
+
 #endif /* KEYWORD_SPOTTING_INTERFACE_H_ */
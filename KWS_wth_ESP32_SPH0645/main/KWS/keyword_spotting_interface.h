@@ -8,10 +8,25 @@
 #ifndef KEYWORD_SPOTTING_INTERFACE_H_
 #define KEYWORD_SPOTTING_INTERFACE_H_
 
+#include <stdint.h>
+
 /***** Functions prototypes *****/
 void keyword_spotting_app_start(void);
 void keyword_spotting_app_suspend(void);
 void keyword_spotting_app_relese(void);
+/* Switch to another registered model (model_registry.h) without rebooting,
+   returns pdFALSE if there is no model with this name */
+uint8_t keyword_spotting_app_select_model(const char *name);
+/* Detection threshold and release level (scores from 0 to 255) and
+   suppression of a label of the active model, until the model changes.
+   Returns pdFALSE if the model has no such label */
+uint8_t keyword_spotting_app_set_threshold(const char *label, uint8_t threshold, uint8_t release, int32_t suppression_ms);
+/* Calls handler in the responder task for every new command with this label
+   of the active model, or for all of them if label is NULL. The handler can
+   take its time, the inference doesn't wait for it (command_dispatch.h).
+   Returns pdFALSE if there is no such label or no room for the handler */
+struct command_event_s;
+uint8_t keyword_spotting_app_add_command_handler(const char *label, void (*handler)(const struct command_event_s *event, void *context), void *context);
 
 
 #endif /* KEYWORD_SPOTTING_INTERFACE_H_ */
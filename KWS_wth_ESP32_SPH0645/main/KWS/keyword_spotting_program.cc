@@ -10,14 +10,30 @@
 #include "tensorflow/lite/micro/micro_mutable_op_resolver.h" /* Provides the operations used by the interpreter to run the model.*/
 #include "tensorflow/lite/schema/schema_generated.h"         /* Contains the schema for the TensorFlow Lite FlatBuffer model file format. */
 #include "tensorflow/lite/micro/micro_interpreter.h"         
+#include "tensorflow/lite/micro/micro_utils.h"
 #include "tensorflow/lite/micro/system_setup.h"
 #include "other/recognize_commands.h"
 #include "other/audio_provider.h"
 #include "other/command_responder.h"
 #include "other/micro_model_settings.h"
 #include "other/yes_micro_features_data.h"
+#include "kernels/conv_max_pool.h"
+#include "kernels/conv_fc_16x8.h"
+#include "kernels/fully_connected_streamed.h"
+#include "kernels/fully_connected_sparse.h"
+#include "kernels/weight_stream.h"
+#include "kernels/softmax_elided.h"
+#include "model_registry.h"
+#include "feature_engine.h"
+#include "cascade_detector.h"
+#include "power_governor.h"
+#include "telemetry.h"
+#include "command_dispatch.h"
 #include <esp_log.h>
+#include <esp_timer.h>
 #include "esp_heap_caps.h"
+#include <string.h>
+#include <math.h>
 
 
 /* FreeRTOS */
@@ -25,12 +41,21 @@
 #include "freertos/event_groups.h"
 #include "freertos/task.h"
 #include "other/micro_model_settings.h"
+#include "keyword_spotting_config.h"
+#if ( KEYWORD_SPOTTING_I2S_STD_DRIVER == 0 )
 #include "driver/i2s.h"
+#endif
+#if ( KEYWORD_SPOTTING_POWER_MANAGEMENT == 1 )
+#include "esp_pm.h"
+#endif
 // #include "driver/gpio.h"
 
 /* Other C libraries */
 extern "C" {
 #include "other/feature_provider.h" /* This library used to extract audio features from the input data, like spectogram */
+#if !USE_FFT
+#include "other/micro_features_generator.h"
+#endif
 #include "keyword_spotting_interface.h"
 #include "keyword_spotting_config.h"
 #include "keyword_spotting_model.h"
@@ -47,19 +72,60 @@ static uint8_t g_keyword_spotting_task_status = pdFALSE;
 /* Keyword spotting task handler */
 static TaskHandle_t g_keyword_spotting_task_handler;
 
+/* Responder task handler, notified by the keyword spotting task for every new command */
+static TaskHandle_t g_responder_task_handler;
+
+/* Detections of every label, counted by the responder task */
+static command_counters_t g_command_counters;
+#if ( KEYWORD_SPOTTING_RESPONDER_GPIO == 1 )
+static const int g_responder_pins[] = KEYWORD_SPOTTING_RESPONDER_GPIO_PINS;
+#endif
+
 /* Reset the number of slices */
 extern bool g_reset_slice_needed;
 
+#if ( KEYWORD_SPOTTING_RESUME_SNAPSHOT == 1 ) && !USE_FFT
+/* Noise estimate of the preprocessor at the last suspend */
+static MicroFeaturesState g_suspend_features_state;
+extern bool g_resume_state_restored;
+#endif
+
+/* Model requested by keyword_spotting_app_select_model(), -1 if none */
+static volatile int g_requested_model_id = -1;
+
+/* Label config requested by keyword_spotting_app_set_threshold(), -1 if none */
+static volatile int g_requested_label = -1;
+static RecognizeCommands::LabelConfig g_requested_label_config;
+
+/* Zero point of the scores given to the recognizer, the one of the logits
+   when the Softmax is elided */
+static int32_t g_scores_zero_point = 0;
+
+/* The int16 outputs of a 16x8 model are shifted right by g_output_shift
+   and moved by g_output_offset, to give int8 scores to the recognizer */
+static int g_output_shift = 0;
+static int32_t g_output_offset = 0;
+static int8_t g_output_scores[kMaxRecognizedCategories];
+
 /* Static function prototype */
 static void keyword_spotting_Init(void);
+static TfLiteStatus keyword_spotting_bind_model(void);
+static TfLiteStatus keyword_spotting_bind_recognizer(void);
 static void keyword_spotting_loop(void);
+static void keyword_spotting_set_input(const int8_t *features, int count);
+static void keyword_spotting_process_output(int32_t time);
 static void keyword_spotting_app_task(void *pvParameter);
+static void keyword_spotting_telemetry_task(void *pvParameter);
+static void keyword_spotting_responder_task(void *pvParameter);
+#if ( KEYWORD_SPOTTING_POWER_MANAGEMENT == 1 )
+static void keyword_spotting_power_init(void);
+static void keyword_spotting_power_loop(void);
+#endif
 
 
 /*** Declare variable ***/
 /* Globals, used for compatibility with Arduino-style sketches. */
 namespace {
-const tflite::Model* g_myModel = nullptr; /* Contains our model */
 tflite::MicroInterpreter* g_interpreter = nullptr; /* An interpreter used to */
 tflite::ErrorReporter* g_error_reporter = nullptr; /* Used to handle error reporting */  
 TfLiteTensor* g_input = nullptr;  /* My input  */
@@ -67,6 +133,9 @@ TfLiteTensor* g_output = nullptr; /* My output */
 
 int32_t g_previous_time = 0; 
 int8_t* g_model_input_buffer = nullptr; /* Input buffer */
+int16_t* g_model_input_buffer_16 = nullptr; /* Input buffer of a 16x8 model, nullptr for int8 */
+int16_t g_input_table[256]; /* int16 input of the 16x8 model for every int8 feature */
+bool g_streaming_model = false; /* The model takes one row of the spectogram per invoke */
 
 
 /* In tensorFlow micro, they avoid any dynamic allocation, to avoid fragmentation, so we declare an array, 
@@ -93,41 +162,202 @@ RecognizeCommands* g_recognizer = nullptr; /* Recongnizer to store output of our
 }/* namespace */
 
 
-static void keyword_spotting_Init(void)
+/* Give the labels and the output quantization of the active model to the
+   recognizer, all the labels with the thresholds of the config */
+static TfLiteStatus keyword_spotting_bind_recognizer(void)
 {
-    /*** Load model ***/
-    /* Map the model into a usable data structure. This doesn't involve any
-       copying or parsing, it's a very lightweight operation. */
-    g_myModel = tflite::GetModel(g_model);
-    /* Check model version */
-    if( g_myModel->version() != TFLITE_SCHEMA_VERSION ) 
-    {
-      MicroPrintf("Model provided is schema version %d not equal to supported "
-      "version %d.", g_myModel->version(), TFLITE_SCHEMA_VERSION);
-      return;
+    const model_registry_entry_t *active_model = model_registry_active();
+
+    /* The output is the Softmax, or the logits when the model has no Softmax
+       or when it is elided */
+    float scale;
+    int32_t zero_point;
+    bool has_softmax;
+    if( tflite::KwsModelLogits( tflite::GetModel( active_model->data ) , &scale , &zero_point , &has_softmax ) != kTfLiteOk )
+    {
+      return kTfLiteError;
+    }
+    const bool logits = ( KEYWORD_SPOTTING_SOFTMAX_ELISION != 0 ) || !has_softmax;
+    if( !logits )
+    {
+      const TfLiteTensor *output = g_interpreter->output(0);
+      scale = output->params.scale;
+      zero_point = output->params.zero_point;
+    }
+    /* The int16 softmax is 0 to 32767 (1/32768) and the int16 logits are
+       symmetric, their high bits are int8 scores */
+    g_output_shift = 0;
+    g_output_offset = 0;
+    if( g_interpreter->output(0)->type == kTfLiteInt16 )
+    {
+      if( ( zero_point != 0 ) || ( active_model->label_count > kMaxRecognizedCategories ) )
+      {
+        MicroPrintf("The int16 output of model %s is not symmetric" , active_model->name );
+        return kTfLiteError;
+      }
+      g_output_shift = logits ? 8 : 7;
+      g_output_offset = logits ? 0 : -128;
+      scale *= (float)( 1 << g_output_shift );
+      zero_point = g_output_offset;
+    }
+    g_scores_zero_point = zero_point;
+
+    /* The thresholds are converted once to the int8 outputs of the model,
+       the scores are never dequantized. The logits are given their softmax
+       by the recognizer, with a table */
+    if( ( g_recognizer->SetOutputQuantization( scale , zero_point , logits ) != kTfLiteOk ) ||
+        ( g_recognizer->SetLabels( active_model->labels , active_model->label_count ) != kTfLiteOk ) )
+    {
+      return kTfLiteError;
+    }
+    for( int i = 0 ; i < active_model->label_count ; i++ )
+    {
+      RecognizeCommands::LabelConfig label_config = g_recognizer->label_config( i );
+      label_config.release = KEYWORD_SPOTTING_RECOGNIZE_RELEASE;
+      g_recognizer->SetLabelConfig( i , label_config );
+    }
+    MicroPrintf("Model %s : decisions on the %s" , active_model->name , logits ? "logits" : "softmax" );
+    return kTfLiteOk;
+}
+
+/* Take the interpreter of the active model, and check its input. Nothing is
+   taken from a model whose input can't hold what keyword_spotting_set_input()
+   writes in it */
+static TfLiteStatus keyword_spotting_bind_model(void)
+{
+    tflite::MicroInterpreter *interpreter = model_registry_interpreter();
+    if( interpreter == nullptr )
+    {
+      return kTfLiteError;
+    }
+
+    /*** Define Model inputs ***/
+    /* The input size is defines in the model array */
+    TfLiteTensor *input_tensor = interpreter->input(0);
+    if( input_tensor == nullptr )
+    {
+      return kTfLiteError;
+    }
+    const TfLiteIntArray *dims = input_tensor->dims;
+    /* Make sure that the datatype is int8, or int16 for the 16x8 models */
+    const bool input_type_ok = ( input_tensor->type == kTfLiteInt8 ) || ( input_tensor->type == kTfLiteInt16 );
+    /* A streaming model takes the newest row only, and keeps the others in its state */
+    const bool streaming_model = input_type_ok && ( tflite::ElementCount( *dims ) == g_kFeatureSize );
+    /* The others take the whole spectogram : the input is 4D, the first dimention is a wrapper,
+       the second and third are our spectogram and the last one is its single channel */
+    const bool spectogram_model = input_type_ok && ( dims->size == 4 ) &&
+                                  ( dims->data[0] == 1 ) && ( dims->data[1] == g_kFeatureCount ) &&
+                                  ( dims->data[2] == g_kFeatureSize ) && ( dims->data[3] == 1 );
+    if( !streaming_model && !spectogram_model )
+    {
+      MicroPrintf("Bad input tensor parameters in model %s : type=%d , array size=%d" , model_registry_active()->name , input_tensor->type , dims->size );
+      for( int i = 0 ; i < dims->size ; i++ )
+      {
+        MicroPrintf("  dimension %d = %d" , i , dims->data[i] );
+      }
+      return kTfLiteError;
+    }
+
+    /* Gives the interpreter where the input buffer is actually stored */
+    g_interpreter = interpreter;
+    g_input = input_tensor; /* Inialize the input */
+    g_streaming_model = streaming_model;
+    if( g_streaming_model )
+    {
+      MicroPrintf("Model %s is streaming, one row per invoke" , model_registry_active()->name );
+    }
+    g_model_input_buffer = tflite::GetTensorData<int8_t>(g_input);
+    g_model_input_buffer_16 = nullptr;
+    if( g_input->type == kTfLiteInt16 )
+    {
+      /* The same real value as the int8 feature, on the int16 quantization of the model */
+      for( int feature = -128 ; feature < 128 ; feature++ )
+      {
+        const float value = ( feature - KEYWORD_SPOTTING_FEATURE_ZERO_POINT ) * KEYWORD_SPOTTING_FEATURE_SCALE;
+        long input = lroundf( value / g_input->params.scale ) + g_input->params.zero_point;
+        input = ( input < INT16_MIN ) ? INT16_MIN : ( ( input > INT16_MAX ) ? INT16_MAX : input );
+        g_input_table[(uint8_t)feature] = (int16_t)input;
+      }
+      g_model_input_buffer_16 = tflite::GetTensorData<int16_t>(g_input);
+    }
+
+    /* The frontend of the model, when it changes the rows of the spectogram
+       made by the old one don't mean anything to the new model */
+    const uint32_t previous_generation = feature_engine_generation();
+    if( feature_engine_configure( model_registry_active()->features ) != kTfLiteOk )
+    {
+      MicroPrintf("Can't configure the features of model %s" , model_registry_active()->name );
+      return kTfLiteError;
+    }
+    if( (previous_generation != 0) && (previous_generation != feature_engine_generation()) )
+    {
+      g_reset_slice_needed = true;
+    }
+
+    /* The thresholds and the averaged results are per label of the model */
+    if( g_recognizer != nullptr )
+    {
+      return keyword_spotting_bind_recognizer();
     }
+    return kTfLiteOk;
+}
 
+static void keyword_spotting_Init(void)
+{
     /*** Resolve operator ***/
     /* Put only the operation implementations we need to save reduce memory usage, like conv2D, conv3D or sigmoid*/
     /* We can use netron web page to see the operators in the model */
-    static tflite::MicroMutableOpResolver<5> resolver; /* I will use 4 operator */
+    /* I will use 6 operator, 5 without Softmax, 1 more for the fused Conv2D + MaxPool2D and 9 more for the streaming models */
+    static tflite::MicroMutableOpResolver< ( ( KEYWORD_SPOTTING_SOFTMAX_ELISION == 2 ) ? 5 : 6 ) +
+                                          ( ( KEYWORD_SPOTTING_FUSED_CONV_POOL == 1 ) ? 1 : 0 ) +
+                                          ( ( KEYWORD_SPOTTING_STREAMING_ENABLE == 1 ) ? 9 : 0 ) > resolver;
+#if ( KEYWORD_SPOTTING_WEIGHT_STREAM_ENABLE == 1 )
+    /* The staging area must exist before AllocateTensors(), the Dense kernel
+       decides in its Prepare if its weights are streamed from flash */
+    if( tflite::KwsWeightStreamInit() != kTfLiteOk )
+    {
+      return;
+    }
+    if (resolver.AddFullyConnected( tflite::Register_KWS_FULLY_CONNECTED_STREAMED() )/*Dense*/ != kTfLiteOk)  
+    { 
+        return;
+    }
+#else
+#if ( KEYWORD_SPOTTING_INT16_ENABLE == 1 )
+    if (resolver.AddFullyConnected( tflite::Register_KWS_FULLY_CONNECTED_16X8() )/*Dense*/ != kTfLiteOk)  
+#else
     if (resolver.AddFullyConnected()/*Dense*/ != kTfLiteOk)  
+#endif
     { 
         return;
     }
+#endif
     // if( resolver.AddDepthwiseConv2D()/*Conv2D*/ != kTfLiteOk )
     // {
     //   return;
     // } 
+    /* The recognizer can make the softmax of the logits, see KEYWORD_SPOTTING_SOFTMAX_ELISION */
+#if ( KEYWORD_SPOTTING_SOFTMAX_ELISION == 0 )
     if( resolver.AddSoftmax()/*Softmax*/ != kTfLiteOk )
     {
       return;
     }
+#elif ( KEYWORD_SPOTTING_SOFTMAX_ELISION == 1 )
+    if( resolver.AddSoftmax( *tflite::Register_KWS_SOFTMAX_ELIDED() ) != kTfLiteOk )
+    {
+      return;
+    }
+#endif
     if( resolver.AddReshape() != kTfLiteOk )
     {
       return;
     }
+    /* The 16x8 kernels run the int8 models with esp-nn */
+#if ( KEYWORD_SPOTTING_INT16_ENABLE == 1 )
+    if( resolver.AddConv2D( tflite::Register_KWS_CONV_2D_16X8() ) != kTfLiteOk )
+#else
     if( resolver.AddConv2D() != kTfLiteOk )
+#endif
     {
       return;
     }
@@ -139,6 +369,32 @@ static void keyword_spotting_Init(void)
     {
       return;
     }
+#if ( KEYWORD_SPOTTING_FUSED_CONV_POOL == 1 )
+    /* Conv2D + MaxPool2D fused by KWS_model/fuse_conv_max_pool.py, models which are
+       not fused still run with the Conv2D and MaxPool2D operators above */
+    if( resolver.AddCustom( tflite::kKwsConvMaxPool2DOpName , tflite::Register_KWS_CONV_MAX_POOL_2D() ) != kTfLiteOk )
+    {
+      return;
+    }
+#endif
+    /* Dense with block sparse weights, written by KWS_model/sparse_fully_connected.py */
+    if( resolver.AddCustom( tflite::kKwsSparseFullyConnectedOpName , tflite::Register_KWS_FULLY_CONNECTED_SPARSE() ) != kTfLiteOk )
+    {
+      return;
+    }
+#if ( KEYWORD_SPOTTING_STREAMING_ENABLE == 1 )
+    /* The streaming models : dilated depthwise convs with their rows in
+       resource variables (the notebook), SVDF and circular buffers with
+       their rows in variable tensors */
+    if( ( resolver.AddDepthwiseConv2D() != kTfLiteOk ) || ( resolver.AddSvdf() != kTfLiteOk ) ||
+        ( resolver.AddCircularBuffer() != kTfLiteOk ) || ( resolver.AddConcatenation() != kTfLiteOk ) ||
+        ( resolver.AddStridedSlice() != kTfLiteOk ) || ( resolver.AddVarHandle() != kTfLiteOk ) ||
+        ( resolver.AddReadVariable() != kTfLiteOk ) || ( resolver.AddAssignVariable() != kTfLiteOk ) ||
+        ( resolver.AddCallOnce() != kTfLiteOk ) )
+    {
+      return;
+    }
+#endif
     // if( resolver.AddMul() != kTfLiteOk )
     // {
     //   return;
@@ -164,37 +420,26 @@ static void keyword_spotting_Init(void)
 
   
 
-    /*** Initalize interpreter ***/
-    /* Initalize the interpreter to run the model with. */
-    /* It takes the Mymodel, resolver, tensor arena and arean size */
-    static tflite::MicroInterpreter static_interpreter( g_myModel, resolver, g_tensor_arena, g_kTensorArenaSize );
-    g_interpreter = &static_interpreter;
-
+    /*** Register the models ***/
+    /* All the models share the resolver and the tensor arena, only the
+       interpreter is built again when the active model changes */
+    model_registry_init( &resolver , g_tensor_arena , g_kTensorArenaSize );
+    int model_id = model_registry_add( "commands" , g_model , g_model_len , kCategoryLabels , kCategoryCount );
+    /* Other models can be added here, for example from a data partition :
+       model_registry_add_partition( "wake word" , "kws_wake" , wake_labels , 2 );
+       and a model trained on other features says it with :
+       model_registry_set_features( wake_id , &g_feature_engine_mfcc ); */
 
-    /*** Allocate Arena in interpreter ***/
-    TfLiteStatus allocate_status = g_interpreter->AllocateTensors();
-    if (allocate_status != kTfLiteOk) 
+    /*** Initalize interpreter ***/
+    /* Initalize the interpreter to run the model with, and allocate the arena */
+    if( model_registry_activate( model_id ) != kTfLiteOk )
     {
-      MicroPrintf("AllocateTensors() failed");
       return;
     }
-
-
-    /*** Define Model inputs ***/
-    /* The input size is defines in the model array */
-    /* Gives the interpreter where the input buffer is actually stored */
-    g_input = g_interpreter->input(0); /* Inialize the input */
-    if ( (g_input->dims->size != 4 ) ||  /* The input is 4D, the first dimention is a wrapper, and the second is our spectogram */
-    (g_input->dims->data[0] != 1) || /* Check the wrapper size */
-    ( g_input->dims->data[1]/*Spectogram arr size*/ != 49  ) || 
-    (g_input->type != kTfLiteInt8 ) ) /* Make sure that the datatype is int8 */
+    if( keyword_spotting_bind_model() != kTfLiteOk )
     {
-      printf("%d  %d, spectogram shape=%d\n" , g_input->dims->size , g_input->dims->data[0] , g_input->dims->data[1]  );
-      MicroPrintf("Bad input tensor parameters in model : spectogram=%d %d %d %d, type=%d , array size=%d" , g_input->dims->data[0] ,g_input->dims->data[1] , g_input->dims->data[2] , g_input->dims->data[3] , g_input->type , g_input->dims->size  );
-      // return;
+      return;
     }
-    printf("%d  %d, spectogram shape=%d\n" , g_input->dims->size , g_input->dims->data[0] , g_input->dims->data[1]  );
-    g_model_input_buffer = tflite::GetTensorData<int8_t>(g_input);
 
     /*** Setup main loop ***/
     // Prepare to access the audio spectrograms from a microphone or other source
@@ -206,15 +451,72 @@ static void keyword_spotting_Init(void)
     g_feature_provider = &static_feature_provider;
     
     /* Recognize the command */
-    static RecognizeCommands static_recognizer(g_error_reporter);
+    static RecognizeCommands static_recognizer( g_error_reporter , KEYWORD_SPOTTING_RECOGNIZE_WINDOW_MS ,
+                                                KEYWORD_SPOTTING_RECOGNIZE_THRESHOLD , KEYWORD_SPOTTING_RECOGNIZE_SUPPRESSION_MS ,
+                                                KEYWORD_SPOTTING_RECOGNIZE_MINIMUM_COUNT );
     g_recognizer = &static_recognizer;
+    g_recognizer->SetAdaptation( { KEYWORD_SPOTTING_RECOGNIZE_ADAPT_SHIFT , KEYWORD_SPOTTING_RECOGNIZE_ADAPT_MARGIN_Q4 ,
+                                   KEYWORD_SPOTTING_RECOGNIZE_MAX_THRESHOLD } );
+    if( keyword_spotting_bind_recognizer() != kTfLiteOk )
+    {
+      return;
+    }
     g_previous_time = 0;
 
+#if ( KEYWORD_SPOTTING_CASCADE_ENABLE == 1 )
+    /* The stage 1 model made by the notebook is flashed in its own data
+       partition, it is registered like the other models but runs in the
+       interpreter of the cascade. Without it, or if it can't be used, stage 1
+       is the energy detector */
+    static const char *const stage1_labels[] = { "word" };
+    const model_registry_entry_t *stage1_model =
+        model_registry_get( model_registry_add_partition( "stage 1" , KEYWORD_SPOTTING_CASCADE_STAGE1_PARTITION , stage1_labels , 1 ) );
+    if( ( stage1_model == nullptr ) || ( cascade_init( stage1_model->data ) != kTfLiteOk ) )
+    {
+      if( cascade_init( nullptr ) != kTfLiteOk )
+      {
+        return;
+      }
+    }
+#endif
+
 }
 
 uint8_t g_flag = 0;
 static void keyword_spotting_loop(void)
 {
+    /* Switch the model between two inferences, the feature provider keeps its
+       spectogram so the new model can run on the next slice */
+    if( g_requested_model_id >= 0 )
+    {
+      int model_id = g_requested_model_id;
+      g_requested_model_id = -1;
+      const int previous_model_id = model_registry_active_id();
+      if( ( model_registry_activate( model_id ) != kTfLiteOk ) || ( keyword_spotting_bind_model() != kTfLiteOk ) )
+      {
+        /* When the new model can't be allocated the registry has already built the
+           previous one again, when its input is wrong it is built here. Its tensors
+           are new ones, so they are bound again */
+        if( ( previous_model_id < 0 ) || ( model_registry_activate( previous_model_id ) != kTfLiteOk ) ||
+            ( keyword_spotting_bind_model() != kTfLiteOk ) )
+        {
+          MicroPrintf("Can't switch model, and no model to go back to");
+          g_interpreter = nullptr;
+          return;
+        }
+        MicroPrintf("Can't switch model, keeping %s" , model_registry_active()->name );
+      }
+    }
+    if( g_requested_label >= 0 )
+    {
+      int label = g_requested_label;
+      g_requested_label = -1;
+      if( g_recognizer->SetLabelConfig( label , g_requested_label_config ) != kTfLiteOk )
+      {
+        MicroPrintf("Bad thresholds for label %d" , label );
+      }
+    }
+
     if(g_reset_slice_needed)
     {
       g_previous_time = 0;
@@ -246,76 +548,277 @@ static void keyword_spotting_loop(void)
       return;
     }
 
-    /* Copy feature buffer(spectogram) to input tensor of the model */
-    for (int i = 0; i < g_kFeatureElementCount; i++)
+    if( g_streaming_model )
+    {
+      /* The state of the model is older than the spectogram (first rows, a
+         model switch, a gap in the audio), it starts again from the rows of
+         the spectogram */
+      if( how_many_new_slices >= g_kFeatureCount )
+      {
+        model_registry_reset_state();
+      }
+      /* One invoke per new row, the oldest first. The cascade doesn't apply,
+         the model must see all the rows. After a reset only the last result
+         goes to the recognizer, the others are made on part of the window */
+      for( int row = g_kFeatureCount - how_many_new_slices ; row < g_kFeatureCount ; row++ )
+      {
+        keyword_spotting_set_input( &g_feature_buffer[row * g_kFeatureSize] , g_kFeatureSize );
+        if( g_interpreter->Invoke() != kTfLiteOk )
+        {
+          MicroPrintf( "Invoke failed");
+          return;
+        }
+        if( ( how_many_new_slices < g_kFeatureCount ) || ( row == g_kFeatureCount - 1 ) )
+        {
+          keyword_spotting_process_output( current_time - ( g_kFeatureCount - 1 - row ) * kFeatureStrideMs );
+        }
+      }
+    }
+    else
+    {
+#if ( KEYWORD_SPOTTING_CASCADE_ENABLE == 1 )
+      /* Stage 1 runs on every stride, the model below only when it found something */
+      if( !cascade_should_run_stage2( g_feature_buffer ) )
+      {
+        return;
+      }
+      const int64_t stage2_start_time = esp_timer_get_time();
+#endif
+
+      /* Copy feature buffer(spectogram) to input tensor of the model */
+      keyword_spotting_set_input( g_feature_buffer , g_kFeatureElementCount );
+
+      /*** Inference stage ***/
+      /* Call the interpreter to run the model.*/
+      TfLiteStatus invoke_status = g_interpreter->Invoke();
+      if (invoke_status != kTfLiteOk) 
+      {
+        MicroPrintf( "Invoke failed");
+        return;
+      }
+#if ( KEYWORD_SPOTTING_CASCADE_ENABLE == 1 )
+      cascade_stage2_done( esp_timer_get_time() - stage2_start_time );
+#endif
+      keyword_spotting_process_output( current_time );
+    }
+
+#if ( KEYWORD_SPOTTING_WEIGHT_STREAM_ENABLE == 1 )
+    /* Hits, misses and latency of the streamed weights, in the telemetry ring */
+    static uint32_t weight_stream_strides = 0;
+    if( ( ++weight_stream_strides % KEYWORD_SPOTTING_WEIGHT_STREAM_LOG_STRIDES ) == 0 )
     {
-      g_model_input_buffer[i]/*Input to the model*/ = g_feature_buffer[i]/*Spectogram*/;
-      // printf( "%d," , g_model_input_buffer[i] );
+      tflite::KwsWeightStreamLogStats();
     }
-    // printf("\n\n\n");
+#endif
 
-    /*** Inference stage ***/
-    /* Call the interpreter to run the model.*/
-    TfLiteStatus invoke_status = g_interpreter->Invoke();
-    if (invoke_status != kTfLiteOk) 
+}
+
+/* Give `count` int8 features to the input of the model, converted with the
+   table for a 16x8 model */
+static void keyword_spotting_set_input(const int8_t *features, int count)
+{
+    if( g_model_input_buffer_16 == nullptr )
     {
-      MicroPrintf( "Invoke failed");
+      memcpy( g_model_input_buffer , features , count );
       return;
     }
+    for( int i = 0 ; i < count ; i++ )
+    {
+      g_model_input_buffer_16[i] = g_input_table[(uint8_t)features[i]];
+    }
+}
 
+/* The results of one invoke, made at `time` (ms of audio) */
+static void keyword_spotting_process_output(int32_t time)
+{
     /*** Post-processing stage ***/
-#if(0)
     /* How does this method work? */
     /* For every new window
      * 1) Store new infrence 
      * 2) Calculate new score for all words
      * 3) Output new average score
+     * 4) Compare it with the threshold of the word, which goes up with the
+     *    scores the word gets in silence and noise
      */
     TfLiteTensor* output = g_interpreter->output(0); /* A pointer to the output out network */
-    const char* found_command = nullptr; /* True if a command is found, False if not */
-    uint8_t score = 0;
+    int found_index = 0;
+    uint8_t score = 0; /* Average score from 0 to 255 */
     bool is_new_command = false;
     /* This function make saves the last inferene and take the average between them to make prediction */
-    TfLiteStatus process_status = g_recognizer->ProcessLatestResults(output, current_time, &found_command, &score, &is_new_command);
-
+    const int8_t *scores = tflite::GetTensorData<int8_t>(output);
+    if( output->type == kTfLiteInt16 )
+    {
+      const int16_t *output_16 = tflite::GetTensorData<int16_t>(output);
+      const int rounding = ( 1 << g_output_shift ) >> 1;
+      for( int i = 0 ; i < model_registry_active()->label_count ; i++ )
+      {
+        int32_t value = ( ( output_16[i] + rounding ) >> g_output_shift ) + g_output_offset;
+        g_output_scores[i] = (int8_t)( ( value > 127 ) ? 127 : value );
+      }
+      scores = g_output_scores;
+    }
+    TfLiteStatus process_status = g_recognizer->ProcessLatestScores( scores , g_scores_zero_point ,
+                                                                     time , &found_index , &score , &is_new_command );
     if (process_status != kTfLiteOk) 
     {
-      MicroPrintf("RecognizeCommands::ProcessLatestResults() failed");
+      MicroPrintf("RecognizeCommands::ProcessLatestScores() failed");
       return;
     }
 
-    /* This function is the action that will be taken with the predicted command */
-    RespondToCommand(current_time, found_command, score, is_new_command); 
+    if( is_new_command )
+    {
+      /* Printed by the telemetry task */
+      telemetry_log( TELEMETRY_DETECTION , found_index , model_registry_active_id() , score );
+    }
+
+    /* The action is taken by the responder task, this only posts the command */
+    if( RespondToCommand( time , model_registry_active_id() , found_index , score , is_new_command ) && is_new_command )
+    {
+      xTaskNotifyGive( g_responder_task_handler );
+    }
+}
+
+#if ( KEYWORD_SPOTTING_POWER_MANAGEMENT == 1 )
+namespace {
+esp_pm_lock_handle_t g_pm_cpu_lock = nullptr;
+power_governor_t g_power_governor;
+int64_t g_pm_work_end_time = 0;
+}/* namespace */
+
+/* Frequency of the CPU_FREQ_MAX lock for a governor level */
+static void keyword_spotting_power_set_level(int level)
+{
+  esp_pm_config_t pm_config = {
+    .max_freq_mhz = g_power_governor.freq_mhz[level],
+    .min_freq_mhz = KEYWORD_SPOTTING_PM_MIN_FREQ_MHZ,
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+    .light_sleep_enable = true,
+#else
+    .light_sleep_enable = false,
+#endif
+  };
+  esp_err_t status = esp_pm_configure( &pm_config );
+  if( status != ESP_OK )
+  {
+    ESP_LOGW( TAG , "esp_pm_configure( %d MHz ) failed : %s" , pm_config.max_freq_mhz , esp_err_to_name( status ) );
+  }
+}
+
+static void keyword_spotting_power_init(void)
+{
+  const uint16_t freqs_mhz[KEYWORD_SPOTTING_PM_LEVELS] = KEYWORD_SPOTTING_PM_FREQS_MHZ;
+  const uint32_t active_ua[KEYWORD_SPOTTING_PM_LEVELS] = KEYWORD_SPOTTING_PM_ACTIVE_UA;
+  power_governor_init( &g_power_governor , freqs_mhz , active_ua , KEYWORD_SPOTTING_PM_LEVELS ,
+                       KEYWORD_SPOTTING_PM_IDLE_UA , kFeatureStrideMs * 1000 ,
+                       KEYWORD_SPOTTING_PM_TARGET_LOAD , KEYWORD_SPOTTING_PM_WINDOW_STRIDES );
+
+  ESP_ERROR_CHECK( esp_pm_lock_create( ESP_PM_CPU_FREQ_MAX , 0 , "kws" , &g_pm_cpu_lock ) );
+  keyword_spotting_power_set_level( g_power_governor.level );
+  g_pm_work_end_time = esp_timer_get_time();
+}
+
+/* Sleep until a stride is captured, then the features and the inference at
+   the frequency of the governor */
+static void keyword_spotting_power_loop(void)
+{
+  if( WaitForNewAudio_KWS( 200 ) != kTfLiteOk )
+  {
+    telemetry_log( TELEMETRY_CAPTURE_NO_AUDIO , 200 , 0 , 0 );
+  }
+
+  const int64_t work_start_time = esp_timer_get_time();
+  esp_pm_lock_acquire( g_pm_cpu_lock );
+  keyword_spotting_loop();
+  esp_pm_lock_release( g_pm_cpu_lock );
+  const int64_t work_end_time = esp_timer_get_time();
 
+  const int level = g_power_governor.level;
+  if( power_governor_update( &g_power_governor , (uint32_t)( work_end_time - work_start_time ) ,
+                             (uint32_t)( work_start_time - g_pm_work_end_time ) ) != level )
+  {
+    keyword_spotting_power_set_level( g_power_governor.level );
+  }
+  g_pm_work_end_time = work_end_time;
+
+  const power_governor_stats_t *stats = &g_power_governor.stats;
+  if( ( stats->iterations % KEYWORD_SPOTTING_PM_LOG_STRIDES ) == 0 )
+  {
+    ESP_LOGI( TAG , "Power : %d MHz, ~%d uA average, busy %d us max, %u overruns, %u level changes" ,
+              g_power_governor.freq_mhz[g_power_governor.level] , (int) power_governor_average_ua( &g_power_governor ) ,
+              (int) stats->max_busy_us , (unsigned) stats->overruns , (unsigned) stats->level_changes );
+  }
+}
+#endif
+
+/* Called by telemetry_log(), also from the DMA receive interrupt */
+static IRAM_ATTR int64_t keyword_spotting_telemetry_clock(void)
+{
+  return esp_timer_get_time();
+}
+
+/* Prints the telemetry records (or writes them for decode_telemetry.py) on
+   the other core, so the capture and the inference never wait for the UART */
+static void keyword_spotting_telemetry_task(void *pvParameter)
+{
+  telemetry_record_t record;
+#if ( KEYWORD_SPOTTING_TELEMETRY_BINARY == 0 )
+  char line[128];
+#endif
+  for(;;)
+  {
+    while( telemetry_pop( &record ) )
+    {
+#if ( KEYWORD_SPOTTING_TELEMETRY_BINARY == 1 )
+      fwrite( &record , sizeof(record) , 1 , stdout );
 #else
-    TfLiteTensor* output = g_interpreter->output(0);
-    float output_scale = output->params.scale; /* 0.0039062 */
-    int output_zero_point = output->params.zero_point;  /* -128 */
-
-    /* Find the max keyword from kCategoryCount words */
-    int max_idx = 0;
-    float max_result = 0.0;
-    for (int i = 0; i < kCategoryCount; i++) 
-    {
-      /* The output is from -127 to 128, so we will quantive it first */
-      float current_result = (tflite::GetTensorData<int8_t>(output)[i] - output_zero_point) * output_scale;
-      /* Find max word percent */
-      if (current_result > max_result) 
+      const model_registry_entry_t *active_model = model_registry_active();
+      if( ( record.id == TELEMETRY_DETECTION ) && ( active_model != nullptr ) &&
+          ( record.args[1] == model_registry_active_id() ) && ( record.args[0] < active_model->label_count ) )
       {
-        max_result = current_result; // update max result
-        max_idx = i; // update category
+        MicroPrintf( "Detected %7s, score: %3d%%" , active_model->labels[record.args[0]] , (int)( record.args[2] * 100 / 256 ) );
       }
+      else
+      {
+        telemetry_format( &record , line , sizeof(line) );
+        ESP_LOGI( TAG , "%u us : %s" , (unsigned) record.time_us , line );
+      }
+#endif
     }
+#if ( KEYWORD_SPOTTING_TELEMETRY_BINARY == 1 )
+    fflush( stdout );
+#endif
+    vTaskDelay( pdMS_TO_TICKS( KEYWORD_SPOTTING_TELEMETRY_DRAIN_MS ) );
+  }
+}
 
-    // if ( max_result > 0.9f ) 
+/* Runs the handlers of the commands posted by the keyword spotting task, and
+   logs when the queue was full or close to it */
+static void keyword_spotting_responder_task(void *pvParameter)
+{
+  uint32_t reported_dropped = 0;
+  uint32_t reported_busy_posts = 0;
+  TickType_t last_log_time = xTaskGetTickCount();
+  for(;;)
+  {
+    ulTaskNotifyTake( pdTRUE , pdMS_TO_TICKS( KEYWORD_SPOTTING_RESPONDER_LOG_MS ) );
+    while( command_dispatch_run( KEYWORD_SPOTTING_COMMAND_QUEUE_SIZE ) > 0 )
     {
-      MicroPrintf("Detected %7s, score: %.2f", kCategoryLabels[max_idx] , static_cast<double>(max_result));
     }
 
-#endif  
-    /* To reset watchdog */
-    vTaskDelay( 5000/portMAX_DELAY );
-
+    if( ( xTaskGetTickCount() - last_log_time ) >= pdMS_TO_TICKS( KEYWORD_SPOTTING_RESPONDER_LOG_MS ) )
+    {
+      const command_dispatch_stats_t *stats = command_dispatch_get_stats();
+      const uint32_t dropped = stats->dropped;
+      const uint32_t busy_posts = stats->busy_posts;
+      if( ( dropped != reported_dropped ) || ( busy_posts != reported_busy_posts ) )
+      {
+        telemetry_log( TELEMETRY_COMMAND_BACKPRESSURE , dropped - reported_dropped , busy_posts - reported_busy_posts , stats->max_handlers_us );
+        reported_dropped = dropped;
+        reported_busy_posts = busy_posts;
+      }
+      last_log_time = xTaskGetTickCount();
+    }
+  }
 }
 
 /* The Task function for freeRTOS */
@@ -323,12 +826,33 @@ static void keyword_spotting_app_task(void *pvParameter)
 {
   /* Initalize keyword spotting */
   keyword_spotting_Init();
+#if ( KEYWORD_SPOTTING_POWER_MANAGEMENT == 1 )
+  keyword_spotting_power_init();
+#endif
   
   /* Keyword spotting loop*/
 	ESP_LOGI( TAG , "Entring infinity loop" );
   for(;;)
   {
+    /* No model to run, after a failed init or a failed switch without a model
+       to go back to. The task waits for keyword_spotting_app_relese() */
+    if( g_interpreter == nullptr )
+    {
+      ESP_LOGE( TAG , "No model to run, keyword spotting stopped" );
+      vTaskSuspend( NULL );
+      continue;
+    }
+#if ( KEYWORD_SPOTTING_POWER_MANAGEMENT == 1 )
+    keyword_spotting_power_loop();
+#else
+    /* Sleep until a stride is captured, the idle task runs meanwhile and
+       resets the watchdog */
+    if( WaitForNewAudio_KWS( 200 ) != kTfLiteOk )
+    {
+      telemetry_log( TELEMETRY_CAPTURE_NO_AUDIO , 200 , 0 , 0 );
+    }
     keyword_spotting_loop();
+#endif
   }
 
 }
@@ -341,6 +865,23 @@ void keyword_spotting_app_start(void)
   {
       ESP_LOGI( TAG , "Starting keyword spotting Application" );
 
+      /* The telemetry ring and its task, before anything logs in it */
+      telemetry_init( keyword_spotting_telemetry_clock );
+      BaseType_t telemetry_task_status = xTaskCreatePinnedToCore( &keyword_spotting_telemetry_task , "telemetry task" , KEYWORD_SPOTTING_TELEMETRY_TASK_STACK_SIZE , NULL , KEYWORD_SPOTTING_TELEMETRY_TASK_PRIORITY , NULL , KEYWORD_SPOTTING_TELEMETRY_TASK_CORE_ID );
+      configASSERT(telemetry_task_status == pdPASS);
+
+      /* The command queue, its handlers and the task which runs them */
+      command_dispatch_init( keyword_spotting_telemetry_clock );
+      command_dispatch_add_handler( COMMAND_DISPATCH_ALL_LABELS , command_dispatch_count , &g_command_counters );
+#if ( KEYWORD_SPOTTING_RESPONDER_GPIO == 1 )
+      if( CommandResponderGpioInit( g_responder_pins , sizeof(g_responder_pins) / sizeof(g_responder_pins[0]) ) == kTfLiteOk )
+      {
+        command_dispatch_add_handler( COMMAND_DISPATCH_ALL_LABELS , CommandResponderGpio , (void *) g_responder_pins );
+      }
+#endif
+      BaseType_t responder_task_status = xTaskCreatePinnedToCore( &keyword_spotting_responder_task , "responder task" , KEYWORD_SPOTTING_RESPONDER_TASK_STACK_SIZE , NULL , KEYWORD_SPOTTING_RESPONDER_TASK_PRIORITY , &g_responder_task_handler , KEYWORD_SPOTTING_RESPONDER_TASK_CORE_ID );
+      configASSERT(responder_task_status == pdPASS);
+
       /* Start keyword spotting task in FreeRTOS */
       BaseType_t TaskStatus = xTaskCreatePinnedToCore( &keyword_spotting_app_task , "keyword task" , KEYWORD_SPOTTING_APP_TASK_STACK_SIZE , NULL , KEYWORD_SPOTTING_APP_TASK_PRIORITY , &g_keyword_spotting_task_handler , KEYWORD_SPOTTING_APP_TASK_CORE_ID );
       configASSERT(TaskStatus == pdPASS); /* Is a MACRO, If the condition is false, It will enter an infinity loop */
@@ -352,6 +893,44 @@ void keyword_spotting_app_start(void)
 
 
 
+uint8_t keyword_spotting_app_select_model(const char *name)
+{
+  int model_id = model_registry_find( name );
+  if( model_id < 0 )
+  {
+    ESP_LOGE( TAG , "Model %s is not registered" , name );
+    return pdFALSE;
+  }
+
+  /* The keyword spotting task does the switch between two inferences */
+  g_requested_model_id = model_id;
+  return pdTRUE;
+}
+
+uint8_t keyword_spotting_app_set_threshold(const char *label, uint8_t threshold, uint8_t release, int32_t suppression_ms)
+{
+  const model_registry_entry_t *active_model = model_registry_active();
+  if( (active_model == nullptr) || (g_recognizer == nullptr) || (release > threshold) )
+  {
+    return pdFALSE;
+  }
+  for( int i = 0 ; i < active_model->label_count ; i++ )
+  {
+    if( strcmp( active_model->labels[i] , label ) == 0 )
+    {
+      /* Applied by the keyword spotting task before its next inference */
+      g_requested_label_config = g_recognizer->label_config( i );
+      g_requested_label_config.threshold = threshold;
+      g_requested_label_config.release = release;
+      g_requested_label_config.suppression_ms = suppression_ms;
+      g_requested_label = i;
+      return pdTRUE;
+    }
+  }
+  ESP_LOGE( TAG , "Label %s is not in model %s" , label , active_model->name );
+  return pdFALSE;
+}
+
 void keyword_spotting_app_suspend(void)
 {
   
@@ -362,10 +941,21 @@ void keyword_spotting_app_suspend(void)
 
       vTaskSuspend( g_keyword_spotting_task_handler );
       // vTaskSuspend( g_capture_audio_task_handler );
+
+#if ( KEYWORD_SPOTTING_RESUME_SNAPSHOT == 1 ) && !USE_FFT
+      /* When the task stopped in an invoke of the preprocessor, every channel
+         is from the frame before or from the stopped one */
+      if( SaveMicroFeaturesState( &g_suspend_features_state ) != kTfLiteOk )
+      {
+        ESP_LOGW( TAG , "No noise estimate to keep over the suspend" );
+      }
+#endif
       
+#if ( KEYWORD_SPOTTING_I2S_STD_DRIVER == 0 )
       uint8_t l_32bit_audio_buffer[10];
       size_t data_size;
       ESP_ERROR_CHECK( i2s_read( I2S_NUM , (void *)(l_32bit_audio_buffer) , 1 , &data_size , pdMS_TO_TICKS(100) /*Timeout*/ ) ); 
+#endif
 
       g_keyword_spotting_task_status = pdFALSE;
   }
@@ -383,6 +973,10 @@ void keyword_spotting_app_relese(void)
       /* Close I2S driver */
       // i2s_driver_install( I2S_NUM , &i2s_config, 0 , NULL );
 
+#if ( KEYWORD_SPOTTING_RESUME_SNAPSHOT == 1 ) && !USE_FFT
+      /* The task is still suspended, so it doesn't run the preprocessor */
+      g_resume_state_restored = ( RestoreMicroFeaturesState( &g_suspend_features_state ) == kTfLiteOk );
+#endif
       vTaskResume( g_keyword_spotting_task_handler );
       g_reset_slice_needed = true;
       // vTaskResume( g_capture_audio_task_handler );
@@ -393,8 +987,25 @@ void keyword_spotting_app_relese(void)
 }
 
 
-
-
-
-
-
+uint8_t keyword_spotting_app_add_command_handler(const char *label, void (*handler)(const struct command_event_s *event, void *context), void *context)
+{
+  int label_index = COMMAND_DISPATCH_ALL_LABELS;
+  if( label != NULL )
+  {
+    const model_registry_entry_t *active_model = model_registry_active();
+    for( int i = 0 ; ( active_model != nullptr ) && ( i < active_model->label_count ) ; i++ )
+    {
+      if( strcmp( active_model->labels[i] , label ) == 0 )
+      {
+        label_index = i;
+        break;
+      }
+    }
+    if( label_index == COMMAND_DISPATCH_ALL_LABELS )
+    {
+      ESP_LOGE( TAG , "Label %s is not in the active model" , label );
+      return pdFALSE;
+    }
+  }
+  return command_dispatch_add_handler( label_index , handler , context ) ? pdTRUE : pdFALSE;
+}
@@ -0,0 +1,155 @@
+/*
+ *  mic_array.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "mic_array.h"
+
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+#include "esp_attr.h"
+#else
+#define IRAM_ATTR
+#endif
+
+namespace {
+
+/* Weight of the new frame in the low pass filters, 1 / 2^kSmoothingBits */
+constexpr int kSmoothingBits = 3;
+
+}/* namespace */
+
+
+void mic_array_init(mic_array_t *array, mic_array_mode_t mode, int channels, int max_delay)
+{
+  memset( array , 0 , sizeof(*array) );
+  array->mode = mode;
+  array->channels = (channels > MIC_ARRAY_MAX_CHANNELS) ? MIC_ARRAY_MAX_CHANNELS : channels;
+  array->max_delay = (max_delay > MIC_ARRAY_MAX_DELAY) ? MIC_ARRAY_MAX_DELAY : max_delay;
+}
+
+
+IRAM_ATTR void mic_array_extract_channel(const int32_t *frames, int frame_count, int channel, int channels, int16_t *output)
+{
+  const int32_t *sample = frames + channel;
+  for( int i = 0 ; i < frame_count ; i++ )
+  {
+    /* The SPH0645 gives 18 bits in the top of the 32 bits slot, see the
+       shifts tried in the capture task */
+    output[i] = (int16_t)( (sample[0] >> 15) & 0xFFFF );
+    sample += channels;
+  }
+}
+
+
+static int64_t mic_array_energy(const int16_t *input, int size)
+{
+  int64_t energy = 0;
+  for( int i = 0 ; i < size ; i++ )
+  {
+    energy += (int32_t)input[i] * input[i];
+  }
+  return energy;
+}
+
+static void mic_array_best_channel(mic_array_t *array, const int16_t *const *inputs, int size, int16_t *output)
+{
+  for( int c = 0 ; c < array->channels ; c++ )
+  {
+    array->stats.frame_energy[c] = mic_array_energy( inputs[c] , size );
+    array->energy[c] += (array->stats.frame_energy[c] - array->energy[c]) >> kSmoothingBits;
+  }
+
+  /* Change only when the other channel is 1 dB louder (x 5/4) */
+  for( int c = 0 ; c < array->channels ; c++ )
+  {
+    if( (c != array->channel) && (array->energy[c] * 4 > array->energy[array->channel] * 5) )
+    {
+      array->channel = c;
+    }
+  }
+
+  array->stats.selected_frames[array->channel]++;
+  memcpy( output , inputs[array->channel] , size * sizeof(int16_t) );
+}
+
+static void mic_array_delay_and_sum(mic_array_t *array, const int16_t *const *inputs, int size, int16_t *output)
+{
+  const int max_delay = array->max_delay;
+
+  /* Every channel after the history of its previous frame, so the samples
+     before the frame are at negative indexes of first and second */
+  int16_t samples[2][MIC_ARRAY_MAX_DELAY + MIC_ARRAY_MAX_FRAME];
+  for( int c = 0 ; c < 2 ; c++ )
+  {
+    memcpy( samples[c] , array->history[c] , max_delay * sizeof(int16_t) );
+    memcpy( samples[c] + max_delay , inputs[c] , size * sizeof(int16_t) );
+    array->stats.frame_energy[c] = mic_array_energy( inputs[c] , size );
+  }
+  const int16_t *first = samples[0] + max_delay;
+  const int16_t *second = samples[1] + max_delay;
+
+  /* second[n] is first[n - delay], on the samples of the frame for which
+     first[n - delay] is known for every delay */
+  int best_delay = 0;
+  int64_t best_correlation = INT64_MIN;
+  for( int delay = -max_delay ; delay <= max_delay ; delay++ )
+  {
+    int64_t correlation = 0;
+    for( int n = 0 ; n < size - max_delay ; n++ )
+    {
+      correlation += (int32_t)second[n] * first[n - delay];
+    }
+    int64_t *smoothed = &array->correlation[delay + max_delay];
+    *smoothed += (correlation - *smoothed) >> kSmoothingBits;
+    if( *smoothed > best_correlation )
+    {
+      best_correlation = *smoothed;
+      best_delay = delay;
+    }
+  }
+  array->stats.delay = best_delay;
+
+  /* Delay the channel which is ahead */
+  if( best_delay >= 0 )
+  {
+    for( int n = 0 ; n < size ; n++ )
+    {
+      output[n] = (int16_t)( ((int32_t)first[n - best_delay] + second[n]) >> 1 );
+    }
+  }
+  else
+  {
+    for( int n = 0 ; n < size ; n++ )
+    {
+      output[n] = (int16_t)( ((int32_t)first[n] + second[n + best_delay]) >> 1 );
+    }
+  }
+
+  for( int c = 0 ; c < 2 ; c++ )
+  {
+    memcpy( array->history[c] , samples[c] + size , max_delay * sizeof(int16_t) );
+  }
+}
+
+
+void mic_array_combine(mic_array_t *array, const int16_t *const *inputs, int size, int16_t *output)
+{
+  array->stats.frames++;
+  if( array->channels < 2 )
+  {
+    array->stats.selected_frames[0]++;
+    memcpy( output , inputs[0] , size * sizeof(int16_t) );
+  }
+  else if( array->mode == MIC_ARRAY_DELAY_AND_SUM )
+  {
+    mic_array_delay_and_sum( array , inputs , size , output );
+  }
+  else
+  {
+    mic_array_best_channel( array , inputs , size , output );
+  }
+}
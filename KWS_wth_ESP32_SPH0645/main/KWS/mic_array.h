@@ -0,0 +1,69 @@
+/*
+ *  mic_array.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef MIC_ARRAY_H_
+#define MIC_ARRAY_H_
+
+#include <stdint.h>
+
+/* Two microphones on the same I2S data line (the SEL pin of the second
+   SPH0645 is high), captured as interleaved 32 bits frames. Every channel
+   is taken out of the frames into its own ring buffer, and one stride of
+   every channel is combined into the mono audio of the feature engine :
+
+   - BEST_CHANNEL : the channel with the highest frame energy (low pass
+     filtered, with a 1 dB hysteresis so it doesn't flip on every stride).
+   - DELAY_AND_SUM : the mean of both channels, with the second one shifted
+     by the delay which maximizes their cross correlation (also low pass
+     filtered over the strides), searched in +/- max_delay samples.
+
+   There is nothing of the ESP-IDF in this file, so it runs on the host on
+   the samples of a stereo WAV file. */
+
+#define  MIC_ARRAY_MAX_CHANNELS      (2)
+#define  MIC_ARRAY_MAX_DELAY         (8)     /* 17 cm between the microphones at 16 kHz */
+#define  MIC_ARRAY_MAX_FRAME         (512)   /* Samples of one channel given to mic_array_combine() */
+
+typedef enum
+{
+  MIC_ARRAY_BEST_CHANNEL = 0,
+  MIC_ARRAY_DELAY_AND_SUM,
+} mic_array_mode_t;
+
+typedef struct
+{
+  uint32_t frames;                                  /* Times mic_array_combine() ran */
+  uint32_t selected_frames[MIC_ARRAY_MAX_CHANNELS]; /* Frames where the channel was the best one */
+  int64_t frame_energy[MIC_ARRAY_MAX_CHANNELS];     /* Sum of squares of the last frame */
+  int delay;                                        /* Samples the second channel is behind the first one */
+  int64_t extract_us[MIC_ARRAY_MAX_CHANNELS];       /* Time taken out of the I2S frames, added by the capture */
+  int64_t combine_us;                               /* Time of mic_array_combine(), added by the caller */
+} mic_array_stats_t;
+
+typedef struct
+{
+  mic_array_mode_t mode;
+  int channels;
+  int max_delay;
+  int channel;                                      /* Best channel */
+  int64_t energy[MIC_ARRAY_MAX_CHANNELS];           /* Low pass filtered frame energy */
+  int64_t correlation[2 * MIC_ARRAY_MAX_DELAY + 1]; /* Low pass filtered, from -max_delay */
+  int16_t history[MIC_ARRAY_MAX_CHANNELS][MIC_ARRAY_MAX_DELAY]; /* Last samples of the previous frame */
+  mic_array_stats_t stats;
+} mic_array_t;
+
+void mic_array_init(mic_array_t *array, mic_array_mode_t mode, int channels, int max_delay);
+
+/* Sample `channel` of every frame of the interleaved I2S data, scaled to
+   16 bits like the mono capture */
+void mic_array_extract_channel(const int32_t *frames, int frame_count, int channel, int channels, int16_t *output);
+
+/* One mono frame from `size` samples of every channel, size must be at most
+   MIC_ARRAY_MAX_FRAME. With one channel it is a copy */
+void mic_array_combine(mic_array_t *array, const int16_t *const *inputs, int size, int16_t *output);
+
+#endif /* MIC_ARRAY_H_ */
@@ -0,0 +1,323 @@
+/*
+ *  model_registry.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "model_registry.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <new>
+
+#include "tensorflow/lite/schema/schema_generated.h"
+#include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/micro/micro_resource_variable.h"
+#include "tensorflow/lite/schema/schema_utils.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+#include "esp_heap_caps.h"
+#include "esp_partition.h"
+
+extern "C" {
+#include "keyword_spotting_config.h"
+}
+
+/* TAG used for serial message */
+static const char TAG[] = "KWS models";
+
+namespace {
+
+model_registry_entry_t g_models[KEYWORD_SPOTTING_MAX_MODELS];
+int g_model_count = 0;
+int g_active_model = -1;
+int64_t g_last_switch_us = 0;
+
+const tflite::MicroOpResolver *g_resolver = nullptr;
+uint8_t *g_tensor_arena = nullptr;
+size_t g_tensor_arena_size = 0;
+
+/* The interpreter is built in this buffer with placement new, so it can be
+   destroyed and built again for another model without any heap allocation */
+alignas(tflite::MicroInterpreter) uint8_t g_interpreter_buffer[sizeof(tflite::MicroInterpreter)];
+tflite::MicroInterpreter *g_interpreter = nullptr;
+
+/* State of a streaming model made of VAR_HANDLE, in the arena */
+tflite::MicroResourceVariables *g_resource_variables = nullptr;
+
+}/* namespace */
+
+
+/* Number of VAR_HANDLE of the model, the resource variables of its state */
+static int model_registry_variable_count(const tflite::Model *model)
+{
+  int count = 0;
+  for( const tflite::SubGraph *subgraph : *model->subgraphs() )
+  {
+    if( subgraph->operators() == nullptr )
+    {
+      continue;
+    }
+    for( const tflite::Operator *op : *subgraph->operators() )
+    {
+      const tflite::OperatorCode *code = model->operator_codes()->Get( op->opcode_index() );
+      if( tflite::GetBuiltinCode( code ) == tflite::BuiltinOperator_VAR_HANDLE )
+      {
+        count++;
+      }
+    }
+  }
+  return count;
+}
+
+
+/* Build the interpreter of `model_id`, the old one must be destroyed */
+static TfLiteStatus model_registry_build(int model_id)
+{
+  const tflite::Model *model = tflite::GetModel( g_models[model_id].data );
+  if( model->version() != TFLITE_SCHEMA_VERSION )
+  {
+    MicroPrintf("Model %s is schema version %d not equal to supported version %d.",
+                g_models[model_id].name , model->version(), TFLITE_SCHEMA_VERSION);
+    return kTfLiteError;
+  }
+
+  /* The arena is cleared by the new allocator, the persistent buffers of the
+     previous model are simply overwritten */
+  g_resource_variables = nullptr;
+  const int variable_count = model_registry_variable_count( model );
+  if( variable_count == 0 )
+  {
+    g_interpreter = new (g_interpreter_buffer) tflite::MicroInterpreter( model, *g_resolver, g_tensor_arena, g_tensor_arena_size );
+  }
+  else
+  {
+    /* The resource variables are kept in the arena of the interpreter, so
+       their allocator is made first */
+    tflite::MicroAllocator *allocator = tflite::MicroAllocator::Create( g_tensor_arena , g_tensor_arena_size );
+    g_resource_variables = (allocator != nullptr) ? tflite::MicroResourceVariables::Create( allocator , variable_count ) : nullptr;
+    if( g_resource_variables == nullptr )
+    {
+      MicroPrintf("No room for the %d variables of model %s", variable_count, g_models[model_id].name);
+      return kTfLiteError;
+    }
+    g_interpreter = new (g_interpreter_buffer) tflite::MicroInterpreter( model, *g_resolver, allocator, g_resource_variables );
+  }
+  if( g_interpreter->AllocateTensors() != kTfLiteOk )
+  {
+    MicroPrintf("AllocateTensors() failed for model %s", g_models[model_id].name);
+    g_interpreter->~MicroInterpreter();
+    g_interpreter = nullptr;
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+
+void model_registry_init(const tflite::MicroOpResolver *resolver, uint8_t *tensor_arena, size_t tensor_arena_size)
+{
+  g_resolver = resolver;
+  g_tensor_arena = tensor_arena;
+  g_tensor_arena_size = tensor_arena_size;
+}
+
+
+int model_registry_add(const char *name, const uint8_t *data, size_t size, const char *const *labels, uint8_t label_count)
+{
+  if( (g_model_count == KEYWORD_SPOTTING_MAX_MODELS) || (data == nullptr) )
+  {
+    ESP_LOGE( TAG , "Can't add model %s" , name );
+    return -1;
+  }
+
+  model_registry_entry_t *entry = &g_models[g_model_count];
+  entry->name = name;
+  entry->data = data;
+  entry->size = size;
+  entry->labels = labels;
+  entry->label_count = label_count;
+  entry->features = &g_feature_engine_pcen;
+  ESP_LOGI( TAG , "Model %s added, %u bytes, %u labels" , name , (unsigned)size , label_count );
+  return g_model_count++;
+}
+
+
+int model_registry_add_partition(const char *name, const char *partition_label, const char *const *labels, uint8_t label_count)
+{
+  const esp_partition_t *partition = esp_partition_find_first( ESP_PARTITION_TYPE_DATA , ESP_PARTITION_SUBTYPE_ANY , partition_label );
+  if( partition == nullptr )
+  {
+    ESP_LOGE( TAG , "Partition %s not found" , partition_label );
+    return -1;
+  }
+
+  /* The mapping is never released, the model can be selected again later */
+  const void *data = nullptr;
+  esp_partition_mmap_handle_t map_handle;
+  if( esp_partition_mmap( partition , 0 , partition->size , ESP_PARTITION_MMAP_DATA , &data , &map_handle ) != ESP_OK )
+  {
+    ESP_LOGE( TAG , "Can't map partition %s" , partition_label );
+    return -1;
+  }
+
+  return model_registry_add( name , static_cast<const uint8_t *>(data) , partition->size , labels , label_count );
+}
+
+
+int model_registry_add_file(const char *name, const char *path, const char *const *labels, uint8_t label_count)
+{
+  FILE *file = fopen( path , "rb" );
+  if( file == nullptr )
+  {
+    ESP_LOGE( TAG , "Can't open %s" , path );
+    return -1;
+  }
+  long size = -1;
+  if( fseek( file , 0 , SEEK_END ) == 0 )
+  {
+    size = ftell( file );
+  }
+  if( (size <= 0) || (fseek( file , 0 , SEEK_SET ) != 0) )
+  {
+    ESP_LOGE( TAG , "Can't get the size of %s" , path );
+    fclose( file );
+    return -1;
+  }
+
+  /* The flatbuffer needs the same alignment as the g_model array */
+  uint8_t *data = (uint8_t *) heap_caps_aligned_alloc( 8 , size , MALLOC_CAP_8BIT );
+  if( data == nullptr )
+  {
+    ESP_LOGE( TAG , "No memory for the %ld bytes of %s" , size , path );
+    fclose( file );
+    return -1;
+  }
+  if( fread( data , 1 , size , file ) != (size_t)size )
+  {
+    ESP_LOGE( TAG , "Can't read %s" , path );
+    heap_caps_free( data );
+    fclose( file );
+    return -1;
+  }
+  fclose( file );
+
+  int model_id = model_registry_add( name , data , size , labels , label_count );
+  if( model_id < 0 )
+  {
+    heap_caps_free( data );
+  }
+  return model_id;
+}
+
+
+TfLiteStatus model_registry_set_features(int model_id, const feature_engine_config_t *features)
+{
+  if( (model_id < 0) || (model_id >= g_model_count) || (features == nullptr) )
+  {
+    return kTfLiteError;
+  }
+  g_models[model_id].features = features;
+  return kTfLiteOk;
+}
+
+
+int model_registry_find(const char *name)
+{
+  for( int i = 0 ; i < g_model_count ; i++ )
+  {
+    if( strcmp( g_models[i].name , name ) == 0 )
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+const model_registry_entry_t *model_registry_get(int model_id)
+{
+  return ( (model_id >= 0) && (model_id < g_model_count) ) ? &g_models[model_id] : nullptr;
+}
+
+
+TfLiteStatus model_registry_activate(int model_id)
+{
+  if( (model_id < 0) || (model_id >= g_model_count) || (g_resolver == nullptr) )
+  {
+    return kTfLiteError;
+  }
+  /* Nothing changed */
+  if( model_id == g_active_model )
+  {
+    return kTfLiteOk;
+  }
+
+  const int64_t start_time = esp_timer_get_time();
+
+  /* Only the interpreter is rebuilt, the op resolver, the arena and the
+     frontend are the same for every model. A MicroInterpreter is bound to
+     one flatbuffer : the tensors, the memory plan and the op data of the
+     kernels (Init / Prepare) all come from it, and TFLM has no way to give
+     another model to an interpreter. So even with the same operators the
+     new model is allocated from scratch, in the same arena, without heap */
+  if( g_interpreter != nullptr )
+  {
+    g_interpreter->~MicroInterpreter();
+    g_interpreter = nullptr;
+  }
+
+  if( model_registry_build( model_id ) != kTfLiteOk )
+  {
+    /* Go back to the previous model, so the application keeps running */
+    if( (g_active_model >= 0) && (model_registry_build( g_active_model ) != kTfLiteOk) )
+    {
+      g_active_model = -1;
+    }
+    return kTfLiteError;
+  }
+
+  g_active_model = model_id;
+  g_last_switch_us = esp_timer_get_time() - start_time;
+  ESP_LOGI( TAG , "Active model is %s, switched in %d us" , g_models[model_id].name , (int)g_last_switch_us );
+  return kTfLiteOk;
+}
+
+
+tflite::MicroInterpreter *model_registry_interpreter(void)
+{
+  return g_interpreter;
+}
+
+
+const model_registry_entry_t *model_registry_active(void)
+{
+  return (g_active_model >= 0) ? &g_models[g_active_model] : nullptr;
+}
+
+
+int model_registry_active_id(void)
+{
+  return g_active_model;
+}
+
+
+TfLiteStatus model_registry_reset_state(void)
+{
+  if( g_interpreter == nullptr )
+  {
+    return kTfLiteError;
+  }
+  /* The variable tensors (SVDF, ...) and the resource variables */
+  if( g_interpreter->Reset() != kTfLiteOk )
+  {
+    return kTfLiteError;
+  }
+  return (g_resource_variables != nullptr) ? g_resource_variables->ResetAll() : kTfLiteOk;
+}
+
+
+int64_t model_registry_last_switch_us(void)
+{
+  return g_last_switch_us;
+}
@@ -0,0 +1,80 @@
+/*
+ *  model_registry.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef MODEL_REGISTRY_H_
+#define MODEL_REGISTRY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_op_resolver.h"
+#include "feature_engine.h"
+
+/* A model which can be selected at runtime, for example a "wake word" model
+   and a "command set" model. The flatbuffer is either an array of the
+   application (like g_model), a data partition mapped from flash, or a file
+   read into RAM. */
+typedef struct
+{
+  const char *name;
+  const uint8_t *data;         /* The flatbuffer */
+  size_t size;
+  const char *const *labels;   /* Name of every output category */
+  uint8_t label_count;
+  const feature_engine_config_t *features;  /* Frontend the model was trained on, g_feature_engine_pcen by default */
+} model_registry_entry_t;
+
+/* All the models share the same op resolver (so it must have the operators
+   of every model) and the same tensor arena */
+void model_registry_init(const tflite::MicroOpResolver *resolver, uint8_t *tensor_arena, size_t tensor_arena_size);
+
+/* Add a model, returns its id or -1 if the registry is full */
+int model_registry_add(const char *name, const uint8_t *data, size_t size, const char *const *labels, uint8_t label_count);
+
+/* Add a model stored in a data partition (partitions.csv), the partition is
+   memory-mapped so the flatbuffer isn't copied. Returns -1 on error */
+int model_registry_add_partition(const char *name, const char *partition_label, const char *const *labels, uint8_t label_count);
+
+/* Add a model read from a file (SPIFFS, SD card, ...), the flatbuffer is
+   copied into the heap. Returns -1 on error */
+int model_registry_add_file(const char *name, const char *path, const char *const *labels, uint8_t label_count);
+
+/* Set the frontend of model `model_id`, the config must stay valid while the
+   model is registered. It is applied by the application when the model
+   becomes active */
+TfLiteStatus model_registry_set_features(int model_id, const feature_engine_config_t *features);
+
+/* Id of the model called `name`, -1 if it doesn't exist */
+int model_registry_find(const char *name);
+
+/* The model `model_id`, nullptr if it doesn't exist. A model can be used
+   without being activated, like the stage 1 model of the cascade which has
+   its own interpreter */
+const model_registry_entry_t *model_registry_get(int model_id);
+
+/* Build the interpreter of model `model_id` in the shared arena. Nothing is
+   done if it is already the active model. If the new model can't be
+   allocated, the previous one is built again and kTfLiteError is returned */
+TfLiteStatus model_registry_activate(int model_id);
+
+/* The interpreter of the active model, nullptr before the first activate */
+tflite::MicroInterpreter *model_registry_interpreter(void);
+
+/* The active model, nullptr before the first activate */
+const model_registry_entry_t *model_registry_active(void);
+int model_registry_active_id(void);
+
+/* Back to the state of a new interpreter : the variable tensors (SVDF) and
+   the resource variables (VAR_HANDLE) of a streaming model, which keeps the
+   rows it has seen. Nothing is done for a model without state */
+TfLiteStatus model_registry_reset_state(void);
+
+/* Time taken by the last model switch, in microseconds */
+int64_t model_registry_last_switch_us(void);
+
+#endif /* MODEL_REGISTRY_H_ */
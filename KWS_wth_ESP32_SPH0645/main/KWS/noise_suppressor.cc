@@ -0,0 +1,261 @@
+/*
+ *  noise_suppressor.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "noise_suppressor.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "signal/src/irfft.h"
+#include "signal/src/overlap_add.h"
+#include "tensorflow/lite/micro/micro_log.h"
+#include "kernels/rfft_512.h"
+#include "kernels/window_auto_scale.h"
+#include "keyword_spotting_config.h"
+
+namespace {
+
+constexpr int kHop = NOISE_SUPPRESSOR_STRIDE / 2;
+constexpr int kFrame = 2 * kHop;
+constexpr int kFftLength = tflite::kKwsRfftLength;
+constexpr int kBins = kFftLength / 2 + 1;
+
+constexpr int kWindowBits = 14;
+constexpr int kGainBits = 15;
+/* The FFT kernel scales by 1 / kFftLength and the int32 inverse FFT too, so
+   the spectrum is scaled up by kFftLength (9 bits) between them */
+constexpr int kFftLengthBits = 9;
+
+/* The FFT auto scale gives at most 15 bits, the power of every frame is
+   scaled back to the same reference so the noise estimate can follow it */
+constexpr int kMaxScaleBits = 15;
+
+/* Noise estimate : down by 1/4 of the difference, up by 1/128 (1.3 s) */
+constexpr int kNoiseDownBits = 2;
+constexpr int kNoiseUpBits = 7;
+
+/* Echo canceller */
+constexpr int kAecTaps = KEYWORD_SPOTTING_AEC_TAPS;
+constexpr int kAecWeightBits = 24;
+constexpr int64_t kAecRegularization = (int64_t)kAecTaps * 64 * 64;
+
+/* The newest kFrame samples, the analysis frame */
+alignas(16) int16_t g_frame[kFrame];
+alignas(16) int16_t g_window[kFrame];
+bool g_window_fits = false;
+alignas(16) int16_t g_fft_input[kFftLength];
+Complex<int16_t> g_spectrum[kBins];
+Complex<int32_t> g_filtered[kBins];
+int32_t g_time_output[kFftLength];
+int16_t g_frame_output[kFrame];
+int16_t g_overlap[kFrame];
+
+/* State of the int32 inverse FFT of the TFLM signal library */
+alignas(8) uint8_t g_irfft_state[8 * 1024];
+void *g_irfft = nullptr;
+
+uint64_t g_noise[kBins];
+int32_t g_gain[kBins];
+bool g_noise_valid = false;
+
+#if ( KEYWORD_SPOTTING_AEC_TAPS > 0 )
+/* The reference of the previous taps is before the new stride */
+int16_t g_reference[kAecTaps + NOISE_SUPPRESSOR_STRIDE];
+int32_t g_aec_weights[kAecTaps];
+int64_t g_reference_energy = 0;
+#endif
+int16_t g_echo_free[NOISE_SUPPRESSOR_STRIDE];
+
+noise_suppressor_stats_t g_stats;
+
+}/* namespace */
+
+
+static int16_t noise_suppressor_saturate(int32_t value)
+{
+  return (value > INT16_MAX) ? INT16_MAX : ((value < INT16_MIN) ? INT16_MIN : (int16_t)value);
+}
+
+#if ( KEYWORD_SPOTTING_AEC_TAPS > 0 )
+/* NLMS : echo = sum( w * reference ), w += step * error * reference / energy */
+static void noise_suppressor_cancel_echo(const int16_t *input, const int16_t *reference, int16_t *output)
+{
+  memcpy( g_reference + kAecTaps , reference , NOISE_SUPPRESSOR_STRIDE * sizeof(int16_t) );
+  for( int n = 0 ; n < NOISE_SUPPRESSOR_STRIDE ; n++ )
+  {
+    /* x[i] is the reference i samples ago, x[0] the newest one */
+    const int16_t *x = &g_reference[kAecTaps + n];
+    const int32_t oldest = x[-kAecTaps];
+    g_reference_energy += (int32_t)x[0] * x[0] - oldest * oldest;
+
+    int64_t echo = 0;
+    for( int i = 0 ; i < kAecTaps ; i++ )
+    {
+      echo += (int64_t)g_aec_weights[i] * x[-i];
+    }
+    const int32_t error = (int32_t)input[n] - (int32_t)((echo + (1 << (kAecWeightBits - 1))) >> kAecWeightBits);
+    output[n] = noise_suppressor_saturate( error );
+
+    /* Weight step per unit of reference, in Q24 */
+    const int64_t step = ((int64_t)KEYWORD_SPOTTING_AEC_STEP * error * (1 << (kAecWeightBits - 15))) / (g_reference_energy + kAecRegularization);
+    for( int i = 0 ; i < kAecTaps ; i++ )
+    {
+      g_aec_weights[i] += (int32_t)(step * x[-i]);
+    }
+  }
+  memmove( g_reference , g_reference + NOISE_SUPPRESSOR_STRIDE , kAecTaps * sizeof(int16_t) );
+}
+#endif
+
+/* Wiener gain of every bin from the power of this frame, in Q15 */
+static void noise_suppressor_update_gains(int scale_bits)
+{
+  const int power_shift = 2 * (kMaxScaleBits - scale_bits);
+  int64_t gain_sum = 0;
+  for( int k = 0 ; k < kBins ; k++ )
+  {
+    const int32_t real = g_spectrum[k].real;
+    const int32_t imag = g_spectrum[k].imag;
+    const uint64_t power = ((uint64_t)((uint32_t)(real * real) + (uint32_t)(imag * imag))) << power_shift;
+
+    if( !g_noise_valid )
+    {
+      g_noise[k] = power;
+    }
+    else if( power < g_noise[k] )
+    {
+      g_noise[k] -= (g_noise[k] - power) >> kNoiseDownBits;
+    }
+    else
+    {
+      g_noise[k] += (power - g_noise[k]) >> kNoiseUpBits;
+    }
+
+    /* (P - N) / P on the top 16 bits of P, so the division is on 32 bits */
+    int32_t gain = 0;
+    if( power > g_noise[k] )
+    {
+      const int bits = 64 - __builtin_clzll( power );
+      const int shift = (bits > 16) ? (bits - 16) : 0;
+      const uint32_t top = (uint32_t)(power >> shift);
+      const uint32_t difference = (uint32_t)((power - g_noise[k]) >> shift);
+      gain = (top > 0) ? (int32_t)(((uint64_t)difference << kGainBits) / top) : 0;
+    }
+    if( gain < KEYWORD_SPOTTING_NS_MIN_GAIN )
+    {
+      gain = KEYWORD_SPOTTING_NS_MIN_GAIN;
+    }
+    /* Mean of this gain and the previous one, against the musical noise */
+    g_gain[k] = (g_gain[k] + gain + 1) >> 1;
+    gain_sum += g_gain[k];
+  }
+  g_noise_valid = true;
+  g_stats.mean_gain = (int32_t)(gain_sum / kBins);
+}
+
+/* One hop : window, FFT, gains, inverse FFT, window and overlap add */
+static void noise_suppressor_hop(const int16_t *input, int16_t *output)
+{
+  memmove( g_frame , g_frame + kHop , kHop * sizeof(int16_t) );
+  memcpy( g_frame + kHop , input , kHop * sizeof(int16_t) );
+
+  tflite::KwsApplyWindowMaxAbs( g_frame , g_window , kFrame , kWindowBits , g_window_fits , g_fft_input );
+  const int scale_bits = tflite::KwsFftAutoScale( g_fft_input , kFftLength , g_fft_input );
+  tflite::KwsRfft512Int16Apply( g_fft_input , g_spectrum );
+
+  noise_suppressor_update_gains( scale_bits );
+  for( int k = 0 ; k < kBins ; k++ )
+  {
+    g_filtered[k].real = (g_spectrum[k].real * g_gain[k]) >> (kGainBits - kFftLengthBits);
+    g_filtered[k].imag = (g_spectrum[k].imag * g_gain[k]) >> (kGainBits - kFftLengthBits);
+  }
+  tflite::tflm_signal::IrfftInt32Apply( g_irfft , g_filtered , g_time_output );
+
+  /* Back to the input scale, the part of the frame after kFrame is the
+     filter tail in the zero padding, cut by the synthesis window */
+  const int32_t rounding = (scale_bits > 0) ? (1 << (scale_bits - 1)) : 0;
+  for( int i = 0 ; i < kFrame ; i++ )
+  {
+    const int32_t sample = (g_time_output[i] + rounding) >> scale_bits;
+    g_frame_output[i] = noise_suppressor_saturate( (sample * g_window[i] + (1 << (kWindowBits - 1))) >> kWindowBits );
+  }
+  tflm_signal::OverlapAdd( g_frame_output , g_overlap , kFrame , output , kHop );
+}
+
+
+TfLiteStatus noise_suppressor_init(void)
+{
+  if( tflite::tflm_signal::IrfftInt32GetNeededMemory( kFftLength ) > sizeof(g_irfft_state) )
+  {
+    MicroPrintf("Noise suppressor : inverse FFT needs %u bytes", (unsigned) tflite::tflm_signal::IrfftInt32GetNeededMemory( kFftLength ));
+    return kTfLiteError;
+  }
+  g_irfft = tflite::tflm_signal::IrfftInt32Init( kFftLength , g_irfft_state , sizeof(g_irfft_state) );
+
+  /* Periodic square root Hann, its square adds up to 1 at 50 % overlap */
+  for( int i = 0 ; i < kFrame ; i++ )
+  {
+    g_window[i] = (int16_t) lroundf( sinf( (float)M_PI * i / kFrame ) * (1 << kWindowBits) );
+  }
+  g_window_fits = tflite::KwsWindowFitsInt16( g_window , kFrame , kWindowBits );
+
+  memset( g_frame , 0 , sizeof(g_frame) );
+  memset( g_fft_input , 0 , sizeof(g_fft_input) );
+  memset( g_overlap , 0 , sizeof(g_overlap) );
+  memset( g_noise , 0 , sizeof(g_noise) );
+  for( int k = 0 ; k < kBins ; k++ )
+  {
+    g_gain[k] = 1 << kGainBits;
+  }
+  g_noise_valid = false;
+#if ( KEYWORD_SPOTTING_AEC_TAPS > 0 )
+  memset( g_reference , 0 , sizeof(g_reference) );
+  memset( g_aec_weights , 0 , sizeof(g_aec_weights) );
+  g_reference_energy = 0;
+#endif
+  memset( &g_stats , 0 , sizeof(g_stats) );
+  return kTfLiteOk;
+}
+
+
+void noise_suppressor_process(const int16_t *input, const int16_t *reference, int16_t *output)
+{
+  g_stats.strides++;
+  const int16_t *audio = input;
+#if ( KEYWORD_SPOTTING_AEC_TAPS > 0 )
+  if( reference != nullptr )
+  {
+    noise_suppressor_cancel_echo( input , reference , g_echo_free );
+    audio = g_echo_free;
+    g_stats.echo_strides++;
+  }
+#else
+  (void) reference;
+#endif
+
+  g_stats.input_energy = 0;
+  g_stats.echo_free_energy = 0;
+  for( int n = 0 ; n < NOISE_SUPPRESSOR_STRIDE ; n++ )
+  {
+    g_stats.input_energy += (int32_t)input[n] * input[n];
+    g_stats.echo_free_energy += (int32_t)audio[n] * audio[n];
+  }
+
+  /* The hops read from g_echo_free, so output can be input */
+  if( audio != g_echo_free )
+  {
+    memcpy( g_echo_free , audio , NOISE_SUPPRESSOR_STRIDE * sizeof(int16_t) );
+  }
+  noise_suppressor_hop( g_echo_free , output );
+  noise_suppressor_hop( g_echo_free + kHop , output + kHop );
+}
+
+
+noise_suppressor_stats_t *noise_suppressor_get_stats(void)
+{
+  return &g_stats;
+}
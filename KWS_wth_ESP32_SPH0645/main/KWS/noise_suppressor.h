@@ -0,0 +1,59 @@
+/*
+ *  noise_suppressor.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef NOISE_SUPPRESSOR_H_
+#define NOISE_SUPPRESSOR_H_
+
+#include <stdint.h>
+
+#include "tensorflow/lite/c/common.h"
+
+/* Suppression of the stationary noise (HVAC, fans) and of the prompts played
+   by the device, on the audio before the feature engine. The spectral
+   subtraction of the preprocessor only sees the mel channels after the
+   projection, this stage works on every FFT bin :
+
+   - Echo : when the played audio is given as reference, an NLMS filter of
+     KEYWORD_SPOTTING_AEC_TAPS taps (int32 Q24 weights) learns the echo path
+     and subtracts its estimate from the microphone. It has no double talk
+     detector, its small step (KEYWORD_SPOTTING_AEC_STEP) keeps it from
+     diverging much on the near end speech.
+   - Noise : STFT of 20 ms frames every 10 ms (square root Hann analysis and
+     synthesis windows, FFT auto scale and the 512 points FFT kernel), a
+     noise power estimate per bin which follows the minimum (fast down, ~1.3 s
+     up), a Wiener gain (P - N) / P per bin, in Q15, smoothed over two frames
+     and floored at KEYWORD_SPOTTING_NS_MIN_GAIN, then the int32 inverse FFT
+     of the TFLM signal library (the int16 one loses the 9 bits of its 1/512
+     scaling) and overlap add.
+
+   All the work per stride is fixed (no data dependent loops), so its time is
+   bounded. The output is 10 ms (one hop) behind the input. */
+
+/* New samples of every call, one feature stride */
+#define  NOISE_SUPPRESSOR_STRIDE      (320)
+
+typedef struct
+{
+  uint32_t strides;         /* Times noise_suppressor_process() ran */
+  uint32_t echo_strides;    /* Strides with a reference */
+  int32_t mean_gain;        /* Mean gain of the bins of the last frame, Q15 */
+  int64_t input_energy;     /* Sum of squares of the last stride, before and after the echo canceller */
+  int64_t echo_free_energy;
+  int64_t process_us;       /* Total time, added by the caller */
+} noise_suppressor_stats_t;
+
+/* Clears the noise estimate, the echo filter and the overlap */
+TfLiteStatus noise_suppressor_init(void);
+
+/* One stride, reference is the audio played by the device over the same
+   samples or nullptr when nothing is played. input and output can be the
+   same buffer */
+void noise_suppressor_process(const int16_t *input, const int16_t *reference, int16_t *output);
+
+noise_suppressor_stats_t *noise_suppressor_get_stats(void);
+
+#endif /* NOISE_SUPPRESSOR_H_ */
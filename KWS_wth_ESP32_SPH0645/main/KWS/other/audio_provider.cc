@@ -24,7 +24,13 @@ limitations under the License.
 #include "freertos/FreeRTOS.h"
 // clang-format on
 
+#include "../keyword_spotting_config.h"
+#if ( KEYWORD_SPOTTING_I2S_STD_DRIVER == 1 )
+#include "driver/i2s_std.h"
+#else
 #include "driver/i2s.h"
+#endif
+#include "esp_attr.h"
 #include "esp_log.h"
 #include "esp_spi_flash.h"
 #include "esp_system.h"
@@ -32,6 +38,10 @@ limitations under the License.
 #include "freertos/task.h"
 #include "ringbuf.h"
 #include "micro_model_settings.h"
+#include "../dma_capture.h"
+#include "../mic_array.h"
+#include "../noise_suppressor.h"
+#include "../telemetry.h"
 #include <soc/i2s_reg.h>
 
 using namespace std;
@@ -41,12 +51,28 @@ using namespace std;
 
 static const char* TAG = "TF_LITE_AUDIO_PROVIDER";
 
+#if ( KEYWORD_SPOTTING_I2S_STD_DRIVER == 1 )
+/* The I2S receive channel, its DMA callback fills g_dma_capture */
+i2s_chan_handle_t g_i2s_rx_channel;
+
+/* The task which reads the audio, woken by the DMA callback */
+TaskHandle_t g_capture_reader_task_handler;
+#else
 /* Capture audio task handler */
 TaskHandle_t g_capture_audio_task_handler;
+#endif
 
-/* ringbuffer to hold the incoming audio data */
+/* ringbuffer to hold the incoming audio data (of the first microphone) */
 ringbuf_t* g_KWS_audio_capture_buffer;
 
+/* One ringbuffer per microphone, the first one is g_KWS_audio_capture_buffer */
+ringbuf_t* g_KWS_channel_capture_buffer[KEYWORD_SPOTTING_MIC_CHANNELS];
+
+#if ( KEYWORD_SPOTTING_NOISE_SUPPRESSION == 1 )
+/* Audio played by the device, the reference of the echo canceller */
+ringbuf_t* g_KWS_reference_buffer;
+#endif
+
 volatile int32_t g_latest_audio_timestamp = 0;
 /* model requires 20ms new data from g_audio_capture_buffer and 10ms old data
  * each time , storing old data in the histrory buffer , {
@@ -68,12 +94,127 @@ int16_t g_audio_output_buffer_KWS[kMaxAudioSampleSize];
 bool g_is_audio_initialized = false;
 int16_t g_history_buffer[history_samples_to_keep];
 
+#if ( KEYWORD_SPOTTING_I2S_STD_DRIVER == 1 )
+/* Ring of every microphone, filled in the DMA callback */
+dma_capture_t g_dma_capture;
+int16_t g_dma_capture_storage[KEYWORD_SPOTTING_MIC_CHANNELS * KEYWORD_SPOTTING_CAPTURE_RING_SAMPLES];
+dma_capture_sizing_t g_dma_sizing;
+#else
 uint8_t g_i2s_read_buffer32[i2s_bytes_to_read]  ;
-uint8_t g_i2s_read_buffer16[i2s_bytes_to_read/2];
+
+/* 16bit samples of every microphone, out of the interleaved 32bit frames */
+constexpr int32_t i2s_frames_to_read = i2s_bytes_to_read / 4 / KEYWORD_SPOTTING_MIC_CHANNELS;
+int16_t g_i2s_channel_buffer16[KEYWORD_SPOTTING_MIC_CHANNELS][i2s_frames_to_read];
+#endif
+
+#if ( KEYWORD_SPOTTING_MIC_CHANNELS > 1 )
+/* One stride of every microphone, combined into the KWS audio */
+int16_t g_channel_stride_buffer[KEYWORD_SPOTTING_MIC_CHANNELS][new_samples_to_get];
+mic_array_t g_mic_array;
+#endif
+
+#if ( KEYWORD_SPOTTING_NOISE_SUPPRESSION == 1 )
+int16_t g_reference_stride_buffer[new_samples_to_get];
+#endif
 
 }  // namespace
 
 
+#if ( KEYWORD_SPOTTING_I2S_STD_DRIVER == 1 )
+/* Every full DMA buffer, in the interrupt : the samples of every microphone
+   into the capture ring, and the reader woken when its stride is there. It
+   and what it calls are in IRAM, it runs while the flash cache is disabled
+   when CONFIG_I2S_ISR_IRAM_SAFE is set */
+static IRAM_ATTR bool OnDmaReceive_KWS(i2s_chan_handle_t handle, i2s_event_data_t* event, void* user_ctx)
+{
+  const int64_t start_time = esp_timer_get_time();
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
+  const int32_t* frames = (const int32_t*) event->dma_buf;
+#else
+  const int32_t* frames = *(const int32_t* const*) event->data;
+#endif
+  const int frame_count = event->size / 4 / KEYWORD_SPOTTING_MIC_CHANNELS;
+  const uint32_t dropped_blocks = g_dma_capture.stats.dropped_blocks;
+  const bool wake_reader = dma_capture_push(&g_dma_capture, frames, frame_count, start_time);
+  if (g_dma_capture.stats.dropped_blocks != dropped_blocks)
+  {
+    telemetry_log(TELEMETRY_CAPTURE_DMA_DROPPED, frame_count, (int32_t) g_dma_capture.stats.dropped_blocks, 0);
+  }
+
+  /* The time follows the captured frames, also the dropped ones */
+  g_latest_audio_timestamp = (int32_t)(g_dma_capture.frames / (kAudioSampleFrequency / 1000));
+
+  const int64_t convert_us = esp_timer_get_time() - start_time;
+  g_dma_capture.stats.convert_us += convert_us;
+  if (convert_us > g_dma_capture.stats.convert_max_us)
+  {
+    g_dma_capture.stats.convert_max_us = convert_us;
+  }
+
+  BaseType_t task_woken = pdFALSE;
+  if (wake_reader)
+  {
+    vTaskNotifyGiveFromISR(g_capture_reader_task_handler, &task_woken);
+  }
+  return task_woken == pdTRUE;
+}
+
+/* The I2S channel on the i2s_std driver, its DMA buffers sized from
+   KEYWORD_SPOTTING_CAPTURE_LATENCY_MS */
+static void i2s_std_init(void)
+{
+  dma_capture_size_dma(KEYWORD_SPOTTING_CAPTURE_LATENCY_MS, KEYWORD_SPOTTING_CAPTURE_ISR_SLACK_MS,
+                       kAudioSampleFrequency, KEYWORD_SPOTTING_MIC_CHANNELS, &g_dma_sizing);
+
+  i2s_chan_config_t chan_config = I2S_CHANNEL_DEFAULT_CONFIG(I2S_NUM, I2S_ROLE_MASTER);
+  chan_config.dma_desc_num = g_dma_sizing.dma_desc_num;
+  chan_config.dma_frame_num = g_dma_sizing.dma_frame_num;
+  ESP_ERROR_CHECK( i2s_new_channel(&chan_config, NULL, &g_i2s_rx_channel) );
+
+  i2s_std_config_t std_config = {
+      .clk_cfg = I2S_STD_CLK_DEFAULT_CONFIG(kAudioSampleFrequency),
+#if ( KEYWORD_SPOTTING_MIC_CHANNELS > 1 )
+      .slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_32BIT, I2S_SLOT_MODE_STEREO), /* both microphones, interleaved frames */
+#else
+      .slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_32BIT, I2S_SLOT_MODE_MONO),   /* left slot only */
+#endif
+      .gpio_cfg = {
+          .mclk = I2S_GPIO_UNUSED,
+          .bclk = (gpio_num_t) MICROPHONE_I2S_CLK_PIN,
+          .ws   = (gpio_num_t) MICROPHONE_I2S_WS_PIN,
+          .dout = I2S_GPIO_UNUSED,
+          .din  = (gpio_num_t) MICROPHONE_I2S_DOUT_PIN,
+          .invert_flags = {
+              .mclk_inv = false,
+              .bclk_inv = false,
+              .ws_inv   = false,
+          },
+      },
+  };
+  ESP_ERROR_CHECK( i2s_channel_init_std_mode(g_i2s_rx_channel, &std_config) );
+
+  /* The same sph0645 timing fix as the legacy driver */
+  #if CONFIG_IDF_TARGET_ESP32
+    REG_SET_BIT(I2S_TIMING_REG(I2S_NUM), BIT(1));
+    REG_SET_BIT( I2S_CONF_REG(I2S_NUM)  , I2S_RX_MSB_SHIFT );
+  #elif CONFIG_IDF_TARGET_ESP32S3
+    REG_SET_BIT(I2S_TX_TIMING_REG(I2S_NUM), BIT(1));
+    REG_SET_BIT( I2S_RX_CONF_REG(I2S_NUM)  , I2S_RX_MSB_SHIFT );
+  #endif
+
+  i2s_event_callbacks_t callbacks = {
+      .on_recv = OnDmaReceive_KWS,
+  };
+  ESP_ERROR_CHECK( i2s_channel_register_event_callback(g_i2s_rx_channel, &callbacks, NULL) );
+  ESP_ERROR_CHECK( i2s_channel_enable(g_i2s_rx_channel) );
+
+  ESP_LOGI(TAG, "I2S std capture : %u DMA buffers of %u frames (%u us)",
+           (unsigned) g_dma_sizing.dma_desc_num, (unsigned) g_dma_sizing.dma_frame_num,
+           (unsigned) g_dma_sizing.buffer_us);
+}
+
+#else
+
 #if NO_I2S_SUPPORT
   // nothing to be done here
 #else
@@ -85,7 +226,11 @@ static void i2s_init(void)
       .mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX) , /* use i2s master, mean esp will genrate the clock, and RX mode to recive the audio data */
       .sample_rate = kAudioSampleFrequency,  /* Sampling rate */ 
       .bits_per_sample = I2S_BITS_PER_SAMPLE_32BIT, /* sph0645 should use 32bit sample, but inmp441 can use 16bit or 32bit */
+#if ( KEYWORD_SPOTTING_MIC_CHANNELS > 1 )
+      .channel_format = I2S_CHANNEL_FMT_RIGHT_LEFT, /* both microphones, interleaved frames */
+#else
       .channel_format = I2S_CHANNEL_FMT_ONLY_LEFT,  /* use only left channel */
+#endif
       .communication_format = (i2s_comm_format_t)I2S_COMM_FORMAT_STAND_I2S , /* Use I2S Philips standard  */
       .intr_alloc_flags = ESP_INTR_FLAG_LEVEL1, /* configare intrrupt flage to level 1, means lower priority */
       /* What is dma_buf_len and dma_buf_count : https://youtu.be/ejyt-kWmys8?si=HaH6Jtu8VxTwzFjP */
@@ -163,20 +308,29 @@ static void CaptureSamples(void* arg)
 
     if (bytes_read <= 0) /* Means it didn't read any audio data */
     {
-      ESP_LOGE(TAG, "Error in I2S read : %d", bytes_read);
+      telemetry_log(TELEMETRY_CAPTURE_READ_ERROR, (int32_t) bytes_read, 0, 0);
     } else /* It reads some audio data only */
     {
       if (bytes_read < i2s_bytes_to_read) /* It reads only a some data, not all the data */ 
       {
-        ESP_LOGW(TAG, "Partial I2S read");
+        telemetry_log(TELEMETRY_CAPTURE_PARTIAL_READ, (int32_t) bytes_read, i2s_bytes_to_read, 0);
       }
 
 
-      /* Rescale the 32bit data to 16bit */
-      for (int i = 0; i < bytes_read / 4; ++i)
+      /* Rescale the 32bit data to 16bit, every microphone into its own
+         buffer, the frames are interleaved when there are two */
+      const int frames_read = bytes_read / 4 / KEYWORD_SPOTTING_MIC_CHANNELS;
+      int kws_bytes_written = 0;
+      for (int channel = 0; channel < KEYWORD_SPOTTING_MIC_CHANNELS; ++channel)
       {
-        ( (int16_t *) g_i2s_read_buffer16 )[i] = ( ((int32_t *) g_i2s_read_buffer32)[i] >> 15 )&(0xFFFF) ;
-      }
+        const int64_t extract_start_time = esp_timer_get_time();
+        mic_array_extract_channel((const int32_t *) g_i2s_read_buffer32, frames_read, channel,
+                                  KEYWORD_SPOTTING_MIC_CHANNELS, g_i2s_channel_buffer16[channel]);
+#if ( KEYWORD_SPOTTING_MIC_CHANNELS > 1 )
+        g_mic_array.stats.extract_us[channel] += esp_timer_get_time() - extract_start_time;
+#else
+        (void) extract_start_time;
+#endif
                                                                                             /*
                                                                                              32bit samples : 4045734399,4046553599,4026073599,4077781503
 
@@ -187,21 +341,25 @@ static void CaptureSamples(void* arg)
                                                                                              14 : is good but low voice 
                                                                                              15 : idea without any lose
                                                                                              */
-     
-      bytes_read = bytes_read / 2; /* Divide the size of read bytes by 2, because we use 32bit sample */
-
-      /* Write bytes read by i2s into a KWS ring buffer */
-      int kws_bytes_written = rb_write(g_KWS_audio_capture_buffer, (uint8_t*)g_i2s_read_buffer16, bytes_read, pdMS_TO_TICKS(100));
-      
 
-      
-      /* Check if the bytes written correctly or not for KWS */
-      if( kws_bytes_written < bytes_read && kws_bytes_written > 0 ) /* If the buffer is about to full, it will not write the whole array in it */
-      {
-        ESP_LOGI(TAG, "KWS : Could only write %d bytes out of %d", kws_bytes_written, bytes_read);
-      }else if ( kws_bytes_written <= 0 ) /* The ring buffer is full, so it will not write any data */
-      {
-        ESP_LOGE(TAG, "KWS : Could Not Write in Ring Buffer: %d ", kws_bytes_written);
+        /* Write bytes read by i2s into the KWS ring buffer of this microphone */
+        const int channel_bytes = frames_read * sizeof(int16_t);
+        int bytes_written = rb_write(g_KWS_channel_capture_buffer[channel], (uint8_t*)g_i2s_channel_buffer16[channel], channel_bytes, pdMS_TO_TICKS(100));
+
+        /* Check if the bytes written correctly or not for KWS */
+        if( bytes_written < channel_bytes && bytes_written > 0 ) /* If the buffer is about to full, it will not write the whole array in it */
+        {
+          telemetry_log(TELEMETRY_CAPTURE_RING_PARTIAL, bytes_written, channel_bytes, channel);
+        }else if ( bytes_written <= 0 ) /* The ring buffer is full, so it will not write any data */
+        {
+          telemetry_log(TELEMETRY_CAPTURE_RING_FULL, bytes_written, channel, 0);
+        }
+
+        /* The time follows the first microphone */
+        if (channel == 0)
+        {
+          kws_bytes_written = bytes_written;
+        }
       }
 
 
@@ -216,24 +374,56 @@ static void CaptureSamples(void* arg)
   vTaskDelete(NULL);
 }
 
+#endif /* KEYWORD_SPOTTING_I2S_STD_DRIVER */
+
 
 TfLiteStatus InitAudioRecording() 
 {
-  /* Initalize the ringbuffers */
-  g_KWS_audio_capture_buffer = rb_init("tf_ringbuffer", kAudioCaptureBufferSizeKWS);
+#if ( KEYWORD_SPOTTING_I2S_STD_DRIVER == 1 )
+  /* The capture ring of every microphone, read by this task */
+  dma_capture_init(&g_dma_capture, KEYWORD_SPOTTING_MIC_CHANNELS, g_dma_capture_storage,
+                   KEYWORD_SPOTTING_CAPTURE_RING_SAMPLES);
+  g_capture_reader_task_handler = xTaskGetCurrentTaskHandle();
+#else
+  /* Initalize the ringbuffers, one per microphone */
+  for (int channel = 0; channel < KEYWORD_SPOTTING_MIC_CHANNELS; ++channel)
+  {
+    g_KWS_channel_capture_buffer[channel] = rb_init("tf_ringbuffer", kAudioCaptureBufferSizeKWS);
 
-  /* Check ringbuffer intalizing */
-  if (!g_KWS_audio_capture_buffer) 
+    /* Check ringbuffer intalizing */
+    if (!g_KWS_channel_capture_buffer[channel]) 
+    {
+      ESP_LOGE(TAG, "Error creating KWS ring buffer %d", channel);
+      return kTfLiteError;
+    }
+  }
+  g_KWS_audio_capture_buffer = g_KWS_channel_capture_buffer[0];
+#endif
+
+#if ( KEYWORD_SPOTTING_NOISE_SUPPRESSION == 1 )
+  g_KWS_reference_buffer = rb_init("tf_reference", kAudioCaptureBufferSizeKWS);
+  if (!g_KWS_reference_buffer || (noise_suppressor_init() != kTfLiteOk)) 
   {
-    ESP_LOGE(TAG, "Error creating KWS ring buffer");
+    ESP_LOGE(TAG, "Error creating the noise suppressor");
     return kTfLiteError;
   }
+#endif
+
+#if ( KEYWORD_SPOTTING_MIC_CHANNELS > 1 )
+  mic_array_init(&g_mic_array, (mic_array_mode_t) KEYWORD_SPOTTING_MIC_MODE,
+                 KEYWORD_SPOTTING_MIC_CHANNELS, KEYWORD_SPOTTING_MIC_MAX_DELAY);
+#endif
 
+#if ( KEYWORD_SPOTTING_I2S_STD_DRIVER == 1 )
+  /* No capture task, the DMA callback fills the ring */
+  i2s_std_init();
+#else
   /* create CaptureSamples Task which will get the i2s_data from mic and fill it
    * in the ring buffer */
 
   /* Create the task in CORE 1 */
   xTaskCreatePinnedToCore( CaptureSamples , "CaptureSamples" , 1024*4 , NULL, 10, &g_capture_audio_task_handler , 1);
+#endif
   while (!g_latest_audio_timestamp) 
   {
     vTaskDelay(1); // one tick delay to avoid watchdog
@@ -242,45 +432,214 @@ TfLiteStatus InitAudioRecording()
   return kTfLiteOk;
 }
 
-/***
- * This function gets audio samples for KWS task, which fills it's ring buffer
-*/
-TfLiteStatus GetAudioSamples_KWS(int start_ms, int duration_ms,
-                             int* audio_samples_size, int16_t** audio_samples) 
+#if ( KEYWORD_SPOTTING_I2S_STD_DRIVER == 1 )
+/* Time in the DMA callback and from the callback to this task, per DMA
+   buffer and per stride */
+static void LogCaptureStats_KWS(void)
 {
-  /* If it's is the first time, Init the microphone */
-  if (!g_is_audio_initialized) 
+  const dma_capture_stats_t* stats = &g_dma_capture.stats;
+  ESP_LOGI(TAG, "Capture : DMA to ring %d us/buffer (max %d), ring to task %d us/stride (max %d), dropped %u/%u buffers, most %u samples waiting",
+           (int)(stats->convert_us / (stats->blocks ? stats->blocks : 1)), (int) stats->convert_max_us,
+           (int)(stats->wakeup_us / (stats->wakeups ? stats->wakeups : 1)), (int) stats->wakeup_max_us,
+           (unsigned) stats->dropped_blocks, (unsigned) stats->blocks, (unsigned) stats->max_fill);
+}
+
+/* Sleeps until the DMA callback says a stride is in the ring */
+static TfLiteStatus WaitForStride_KWS(int timeout_ms)
+{
+  if (!dma_capture_arm(&g_dma_capture, new_samples_to_get))
   {
-    TfLiteStatus init_status = InitAudioRecording();
-    if (init_status != kTfLiteOk) {
-      return init_status;
+    while (dma_capture_available(&g_dma_capture) < (uint32_t) new_samples_to_get)
+    {
+      if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms)) == 0)
+      {
+        return kTfLiteError;
+      }
     }
-    g_is_audio_initialized = true;
   }
+  return kTfLiteOk;
+}
 
-  /* copy 160 samples (320 bytes) into output_buff from history */
-  memcpy((void*)(g_audio_output_buffer_KWS), (void*)(g_history_buffer),
-         history_samples_to_keep * sizeof(int16_t));
+/* Reads new_samples_to_get samples of every microphone into dest[channel],
+   sleeps until the DMA callback says they are there */
+static void ReadStrideSamples_KWS(int16_t* const* dest)
+{
+  if (WaitForStride_KWS(200) != kTfLiteOk)
+  {
+    telemetry_log(TELEMETRY_CAPTURE_NO_AUDIO, 200, 0, 0);
+  }
 
-  /* copy 320 samples (640 bytes) from rb at ( int16_t*(g_audio_output_buffer_KWS) +
-   * 160 ), first 160 samples (320 bytes) will be from history */
-  int bytes_read = rb_read(g_KWS_audio_capture_buffer,
-              ((uint8_t*)(g_audio_output_buffer_KWS + history_samples_to_keep)),
+  const int samples_read = dma_capture_read(&g_dma_capture, dest, new_samples_to_get, esp_timer_get_time());
+  if (samples_read < new_samples_to_get) 
+  {
+    ESP_LOGD(TAG, " Partial Read of Data by Model ");
+    ESP_LOGV(TAG, " Could only read %d samples when required %d samples ",
+             samples_read, (int) new_samples_to_get);
+  }
+
+  if ((g_dma_capture.stats.reads % KEYWORD_SPOTTING_CAPTURE_LOG_STRIDES) == 0)
+  {
+    LogCaptureStats_KWS();
+  }
+}
+#else
+/* Reads new_samples_to_get samples of one KWS ring buffer into dest */
+static void ReadChannelSamples_KWS(ringbuf_t* buffer, int16_t* dest)
+{
+  int bytes_read = rb_read(buffer, (uint8_t*)(dest),
               new_samples_to_get * sizeof(int16_t), pdMS_TO_TICKS(200));
   
   /* Check reading */
   if (bytes_read < 0) 
   {
-    ESP_LOGE(TAG, " Model Could not read data from Ring Buffer");
+    telemetry_log(TELEMETRY_MODEL_READ_ERROR, bytes_read, 0, 0);
   }
   else if (bytes_read < new_samples_to_get * sizeof(int16_t)) 
   {
     ESP_LOGD(TAG, "RB FILLED RIGHT NOW IS %d",
-             rb_filled(g_KWS_audio_capture_buffer));
+             rb_filled(buffer));
     ESP_LOGD(TAG, " Partial Read of Data by Model ");
     ESP_LOGV(TAG, " Could only read %d bytes when required %d bytes ",
              bytes_read, (int) (new_samples_to_get * sizeof(int16_t)));
   }
+}
+
+/* Reads new_samples_to_get samples of every microphone into dest[channel] */
+static void ReadStrideSamples_KWS(int16_t* const* dest)
+{
+  for (int channel = 0; channel < KEYWORD_SPOTTING_MIC_CHANNELS; ++channel)
+  {
+    ReadChannelSamples_KWS(g_KWS_channel_capture_buffer[channel], dest[channel]);
+  }
+}
+
+/* The ring buffer has no watermark, its fill is checked every tick */
+static TfLiteStatus WaitForStride_KWS(int timeout_ms)
+{
+  const TickType_t start_tick = xTaskGetTickCount();
+  while (rb_filled(g_KWS_audio_capture_buffer) < (int)(new_samples_to_get * sizeof(int16_t)))
+  {
+    if ((xTaskGetTickCount() - start_tick) >= pdMS_TO_TICKS(timeout_ms))
+    {
+      return kTfLiteError;
+    }
+    vTaskDelay(1);
+  }
+  return kTfLiteOk;
+}
+#endif
+
+#if ( KEYWORD_SPOTTING_MIC_CHANNELS > 1 )
+/* CPU time of every microphone and of the combination, per stride */
+static void LogMicArrayStats_KWS(void)
+{
+  const mic_array_stats_t* stats = &g_mic_array.stats;
+  for (int channel = 0; channel < KEYWORD_SPOTTING_MIC_CHANNELS; ++channel)
+  {
+    ESP_LOGI(TAG, "Mic %d : extract %d us/stride, selected %u/%u strides, energy %lld",
+             channel, (int)(stats->extract_us[channel] / (stats->frames ? stats->frames : 1)),
+             (unsigned) stats->selected_frames[channel], (unsigned) stats->frames,
+             (long long) stats->frame_energy[channel]);
+  }
+  ESP_LOGI(TAG, "Mic array : %s %d us/stride, delay %d samples",
+           (g_mic_array.mode == MIC_ARRAY_DELAY_AND_SUM) ? "delay and sum" : "best channel",
+           (int)(stats->combine_us / (stats->frames ? stats->frames : 1)), stats->delay);
+}
+#endif
+
+#if ( KEYWORD_SPOTTING_NOISE_SUPPRESSION == 1 )
+/* Echo and noise suppression of one stride, with the reference when the
+   device played something over it */
+static void SuppressNoise_KWS(int16_t* samples)
+{
+  const int16_t* reference = nullptr;
+  const int reference_bytes = new_samples_to_get * sizeof(int16_t);
+  if (rb_filled(g_KWS_reference_buffer) >= reference_bytes)
+  {
+    rb_read(g_KWS_reference_buffer, (uint8_t*)g_reference_stride_buffer, reference_bytes, 0);
+    reference = g_reference_stride_buffer;
+  }
+
+  const int64_t start_time = esp_timer_get_time();
+  noise_suppressor_process(samples, reference, samples);
+  const int64_t stride_us = esp_timer_get_time() - start_time;
+
+  noise_suppressor_stats_t* stats = noise_suppressor_get_stats();
+  stats->process_us += stride_us;
+  if (stride_us > KEYWORD_SPOTTING_NS_BUDGET_US)
+  {
+    telemetry_log(TELEMETRY_NS_OVER_BUDGET, (int32_t) stride_us, KEYWORD_SPOTTING_NS_BUDGET_US, 0);
+  }
+  if ((stats->strides % KEYWORD_SPOTTING_NS_LOG_STRIDES) == 0)
+  {
+    ESP_LOGI(TAG, "Noise suppressor : %d us/stride, mean gain %d/32768, echo on %u/%u strides, energy %lld -> %lld",
+             (int)(stats->process_us / (stats->strides ? stats->strides : 1)), (int) stats->mean_gain,
+             (unsigned) stats->echo_strides, (unsigned) stats->strides,
+             (long long) stats->input_energy, (long long) stats->echo_free_energy);
+  }
+}
+#endif
+
+/* Reads new_samples_to_get samples of the KWS audio into dest, which is the
+   combination of every microphone when there are two. The microphone is
+   initialized in the first call */
+static TfLiteStatus ReadNewSamples_KWS(int16_t* dest)
+{
+  /* If it's is the first time, Init the microphone */
+  if (!g_is_audio_initialized) 
+  {
+    TfLiteStatus init_status = InitAudioRecording();
+    if (init_status != kTfLiteOk) {
+      return init_status;
+    }
+    g_is_audio_initialized = true;
+  }
+
+#if ( KEYWORD_SPOTTING_MIC_CHANNELS > 1 )
+  int16_t* channels[KEYWORD_SPOTTING_MIC_CHANNELS];
+  for (int channel = 0; channel < KEYWORD_SPOTTING_MIC_CHANNELS; ++channel)
+  {
+    channels[channel] = g_channel_stride_buffer[channel];
+  }
+  ReadStrideSamples_KWS(channels);
+
+  const int64_t combine_start_time = esp_timer_get_time();
+  mic_array_combine(&g_mic_array, channels, new_samples_to_get, dest);
+  g_mic_array.stats.combine_us += esp_timer_get_time() - combine_start_time;
+
+  if ((g_mic_array.stats.frames % KEYWORD_SPOTTING_MIC_LOG_STRIDES) == 0)
+  {
+    LogMicArrayStats_KWS();
+  }
+#else
+  int16_t* channels[1] = { dest };
+  ReadStrideSamples_KWS(channels);
+#endif
+
+#if ( KEYWORD_SPOTTING_NOISE_SUPPRESSION == 1 )
+  SuppressNoise_KWS(dest);
+#endif
+
+  return kTfLiteOk;
+}
+
+/***
+ * This function gets audio samples for KWS task, which fills it's ring buffer
+*/
+TfLiteStatus GetAudioSamples_KWS(int start_ms, int duration_ms,
+                             int* audio_samples_size, int16_t** audio_samples) 
+{
+  /* copy 160 samples (320 bytes) into output_buff from history */
+  memcpy((void*)(g_audio_output_buffer_KWS), (void*)(g_history_buffer),
+         history_samples_to_keep * sizeof(int16_t));
+
+  /* copy 320 samples (640 bytes) from rb at ( int16_t*(g_audio_output_buffer_KWS) +
+   * 160 ), first 160 samples (320 bytes) will be from history */
+  TfLiteStatus read_status = ReadNewSamples_KWS(g_audio_output_buffer_KWS + history_samples_to_keep);
+  if (read_status != kTfLiteOk) 
+  {
+    return read_status;
+  }
 
   /* copy 320 bytes from output_buff into history */
   memcpy((void*)(g_history_buffer),
@@ -292,6 +651,56 @@ TfLiteStatus GetAudioSamples_KWS(int start_ms, int duration_ms,
   return kTfLiteOk;
 }
 
+/***
+ * Same as GetAudioSamples_KWS but for the streaming preprocessor, it gets only
+ * the 320 new samples of the stride, the overlap is kept by the model Framer
+*/
+TfLiteStatus GetNewAudioSamples_KWS(int* audio_samples_size, int16_t** audio_samples) 
+{
+  TfLiteStatus read_status = ReadNewSamples_KWS(g_audio_output_buffer_KWS);
+  if (read_status != kTfLiteOk) 
+  {
+    return read_status;
+  }
+
+  *audio_samples_size = new_samples_to_get;
+  *audio_samples = g_audio_output_buffer_KWS;
+  return kTfLiteOk;
+}
+
+
+TfLiteStatus PushReferenceSamples_KWS(const int16_t* samples, int samples_size)
+{
+#if ( KEYWORD_SPOTTING_NOISE_SUPPRESSION == 1 )
+  if (!g_is_audio_initialized) 
+  {
+    return kTfLiteError;
+  }
+  const int bytes = samples_size * sizeof(int16_t);
+  if (rb_write(g_KWS_reference_buffer, (uint8_t*)samples, bytes, 0) < bytes)
+  {
+    ESP_LOGW(TAG, "Reference buffer full");
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+#else
+  (void) samples;
+  (void) samples_size;
+  return kTfLiteOk;
+#endif
+}
+
+
+TfLiteStatus WaitForNewAudio_KWS(int timeout_ms)
+{
+  /* The capture starts with the first read */
+  if (!g_is_audio_initialized) 
+  {
+    return kTfLiteOk;
+  }
+  return WaitForStride_KWS(timeout_ms);
+}
+
 
 int32_t LatestAudioTimestamp() 
 {
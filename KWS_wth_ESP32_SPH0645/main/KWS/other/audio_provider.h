@@ -31,6 +31,23 @@ limitations under the License.
 TfLiteStatus GetAudioSamples_KWS(int start_ms, int duration_ms,
                              int* audio_samples_size, int16_t** audio_samples);
 
+// Returns only the new samples of one feature stride (20 ms), without the
+// overlap with the previous window. Used by the streaming preprocessor, which
+// keeps this overlap inside the model.
+TfLiteStatus GetNewAudioSamples_KWS(int* audio_samples_size, int16_t** audio_samples);
+
+// Gives the audio played by the device (16 kHz, 16 bits) to the echo
+// canceller of the noise suppressor, in the same time as it is played, so it
+// lines up with the microphone. Nothing is done when the noise suppression is
+// disabled.
+TfLiteStatus PushReferenceSamples_KWS(const int16_t* samples, int samples_size);
+
+// Sleeps until one stride of new audio is captured, or timeout_ms. With the
+// i2s_std capture the DMA callback wakes the task, the legacy capture checks
+// its ring buffer every tick. Returns at once before the first read, which
+// starts the capture.
+TfLiteStatus WaitForNewAudio_KWS(int timeout_ms);
+
 TfLiteStatus GetAudioSamples_voice_stream(int* audio_samples_size, int16_t** audio_samples);
 
 // Returns the time that audio data was last captured in milliseconds. There's
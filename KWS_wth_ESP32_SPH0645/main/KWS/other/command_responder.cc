@@ -14,15 +14,45 @@ limitations under the License.
 ==============================================================================*/
 
 #include "command_responder.h"
+#include "driver/gpio.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
-// The default implementation writes out the name of the recognized command
-// to the error console. Real applications will want to take some custom
-// action instead, and should implement their own versions of this function.
-void RespondToCommand(int32_t current_time, const char* found_command , float score, bool is_new_command) {
-  // if (is_new_command) 
-  {
-    score = (score/255)*100;
-    MicroPrintf("Heard %s %.2f ", found_command, score );
+namespace {
+int g_gpio_count = 0;
+}  // namespace
+
+// The default implementation posts the new commands, the handlers added to
+// the command dispatch take the action. Real applications will want to add
+// their own handler with keyword_spotting_app_add_command_handler().
+bool RespondToCommand(int32_t current_time, int model_id, int found_index,
+                      uint8_t score, bool is_new_command) {
+  if (!is_new_command) {
+    return true;
+  }
+  return command_dispatch_post(current_time, found_index, model_id, score);
+}
+
+TfLiteStatus CommandResponderGpioInit(const int* pins, int count) {
+  for (int i = 0; i < count; ++i) {
+    if (pins[i] < 0) {
+      continue;
+    }
+    if ((gpio_set_direction(static_cast<gpio_num_t>(pins[i]),
+                            GPIO_MODE_OUTPUT) != ESP_OK) ||
+        (gpio_set_level(static_cast<gpio_num_t>(pins[i]), 0) != ESP_OK)) {
+      MicroPrintf("Can't use GPIO %d for label %d", pins[i], i);
+      return kTfLiteError;
+    }
+  }
+  g_gpio_count = count;
+  return kTfLiteOk;
+}
+
+void CommandResponderGpio(const command_event_t* event, void* context) {
+  const int* pins = static_cast<const int*>(context);
+  for (int i = 0; i < g_gpio_count; ++i) {
+    if (pins[i] >= 0) {
+      gpio_set_level(static_cast<gpio_num_t>(pins[i]), (i == event->label) ? 1 : 0);
+    }
   }
 }
@@ -19,12 +19,22 @@ limitations under the License.
 #define TENSORFLOW_LITE_MICRO_EXAMPLES_MICRO_SPEECH_COMMAND_RESPONDER_H_
 
 #include "tensorflow/lite/c/common.h"
-
-// Called every time the results of an audio recognition run are available. The
-// human-readable name of any recognized command is in the `found_command`
-// argument, `score` has the numerical confidence, and `is_new_command` is set
-// if the previous command was different to this one.
-void RespondToCommand(int32_t current_time, const char* found_command,
-                      float score, bool is_new_command);
+#include "../command_dispatch.h"
+
+// Called every time the results of an audio recognition run are available.
+// `found_index` is the label of the recognized command in the active model,
+// `score` its averaged score from 0 to 255, and `is_new_command` is set when
+// it was just detected. New commands are posted to the command dispatch queue
+// and the handlers run in the responder task, so this never blocks. Returns
+// false when the queue was full and the command was dropped.
+bool RespondToCommand(int32_t current_time, int model_id, int found_index,
+                      uint8_t score, bool is_new_command);
+
+// Drives one LED per label, `pins` has one GPIO per label of the model, or -1.
+TfLiteStatus CommandResponderGpioInit(const int* pins, int count);
+
+// A command dispatch handler, with the `pins` given to CommandResponderGpioInit()
+// as context: turns on the LED of the detected label and the others off.
+void CommandResponderGpio(const command_event_t* event, void* context);
 
 #endif  // TENSORFLOW_LITE_MICRO_EXAMPLES_MICRO_SPEECH_COMMAND_RESPONDER_H_
@@ -27,6 +27,7 @@ limitations under the License.
   #include "micro_features_micro_features_generator.h"
 #else
   #include "micro_features_generator.h"
+  #include "../feature_engine.h"
   Features g_features;
 #endif
 
@@ -44,6 +45,9 @@ const char *TAG = "feature_provider";
 
 bool g_reset_slice_needed = true;
 
+/* The noise estimate was restored by keyword_spotting_app_relese(), no warmup */
+bool g_resume_state_restored = false;
+
 /* Constaractor */
 FeatureProvider::FeatureProvider(int feature_size, int8_t* feature_data)
     : feature_size_(feature_size),
@@ -193,12 +197,17 @@ TfLiteStatus FeatureProvider::PopulateFeatureData(
   // If this is the first call, make sure we don't use any cached information.
   if ( is_first_run_ ) 
   {
-    TfLiteStatus init_status = InitializeMicroFeatures();
-    if (init_status != kTfLiteOk) 
+    /* The model registry configures the engine of its active model, the
+       preprocessor model is used when there is no model yet */
+    if (feature_engine_active() == nullptr) 
     {
-      return init_status;
+      TfLiteStatus init_status = feature_engine_configure(&g_feature_engine_pcen);
+      if (init_status != kTfLiteOk) 
+      {
+        return init_status;
+      }
     }
-    ESP_LOGI(TAG, "InitializeMicroFeatures successful");
+    ESP_LOGI(TAG, "Feature engine %d ready", feature_engine_active()->type);
     is_first_run_ = false;
     slices_needed = 10;
   }
@@ -208,6 +217,13 @@ TfLiteStatus FeatureProvider::PopulateFeatureData(
   {
     slices_needed = 10;
     g_reset_slice_needed = false;
+    /* The noise estimate is from before the suspend, learn the current noise
+       again from the first frames */
+    if( !g_resume_state_restored )
+    {
+      WarmupMicroFeatures( KEYWORD_SPOTTING_RESUME_WARMUP_FRAMES );
+    }
+    g_resume_state_restored = false;
   }
 
 #if 1
@@ -261,37 +277,23 @@ TfLiteStatus FeatureProvider::PopulateFeatureData(
       int audio_samples_size = 30;
       // TODO(petewarden): Fix bug that leads to non-zero slice_start_ms
 
-      /* GetAudioSamples doesn't consume any time, becuse it reads from a ring buffer */
-      GetAudioSamples_KWS((slice_start_ms > 0 ? slice_start_ms : 0),
-                      kFeatureDurationMs, &audio_samples_size,
-                      &audio_samples);
-
-      if (audio_samples_size < kMaxAudioSampleSize) 
-      {
-        MicroPrintf("Audio data size %d too small, want %d",
-                    audio_samples_size, kMaxAudioSampleSize);
-        return kTfLiteError;
-      }
       int8_t* new_slice_data = feature_data_ + (new_slice * g_kFeatureSize);
-      // size_t num_samples_read;
-      // TfLiteStatus generate_status = GenerateMicroFeatures(
-      //     audio_samples, audio_samples_size, kFeatureSize,
-      //     new_slice_data, &num_samples_read);
-      
-      /* GenerateFeatures function consume alot of time */
-      TfLiteStatus generate_status = GenerateFeatures(
-            audio_samples, audio_samples_size, &g_features);
+
+      /* Only the new 20 ms, the feature engine keeps the 10 ms overlap, so
+         every stride still has to go through it in order when catching up,
+         and slice_start_ms isn't needed */
+      (void) slice_start_ms;
+      GetNewAudioSamples_KWS(&audio_samples_size, &audio_samples);
+
+      /* The engine of the active model (log mel, MFCC or the preprocessor
+         model), this is the part which consumes alot of time */
+      TfLiteStatus generate_status = feature_engine_process(
+            audio_samples, audio_samples_size, new_slice_data);
       if (generate_status != kTfLiteOk) 
       {
         return generate_status;
       }
 
-      // copy features
-      for (int j = 0; j < g_kFeatureSize; ++j) 
-      {
-        new_slice_data[j] = g_features[0][j];
-      }
-
     }
 
   }
@@ -43,6 +43,29 @@ void FftCompute(struct FftState* state, const int16_t* input,
             reinterpret_cast<kiss_fft_cpx*>(state->output));
 }
 
+void FftComputeEnergy(struct FftState* state, int input_scale_shift,
+                      int start_index, int end_index, int32_t* energy) {
+  const size_t input_size = state->input_size;
+  const size_t fft_size = state->fft_size;
+
+  // Scale the window in place.
+  int16_t* fft_input = state->input;
+  size_t i;
+  for (i = 0; i < input_size; ++i) {
+    fft_input[i] = static_cast<int16_t>(static_cast<uint16_t>(fft_input[i])
+                                        << input_scale_shift);
+  }
+  // Zero out whatever else remains in the top part of the input, like
+  // FftCompute(), so nothing depends on FftReset() having been called.
+  for (; i < fft_size; ++i) {
+    fft_input[i] = 0;
+  }
+
+  // Apply the FFT, the energies come out of its last stage.
+  kiss_fftr_energy(reinterpret_cast<kiss_fftr_cfg>(state->scratch),
+                   state->input, start_index, end_index, energy);
+}
+
 void FftInit(struct FftState* state) {
   // All the initialization is done in FftPopulateState()
 }
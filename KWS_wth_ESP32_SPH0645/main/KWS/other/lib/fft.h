@@ -39,6 +39,17 @@ struct FftState {
 void FftCompute(struct FftState* state, const int16_t* input,
                 int input_scale_shift);
 
+// Fused FFT for the frontend : the window must already be in state->input
+// (input_size values, see WindowProcessSamplesToBuffer()), it is scaled in
+// place by input_scale_shift and transformed, and only the energies
+// (real^2 + imag^2) of the bins [start_index, end_index) are written, to
+// energy[start_index] .. energy[end_index - 1]. The result is bit exact with
+// FftCompute() followed by FilterbankConvertFftComplexToEnergy().
+// The zero padding of state->input is written here too, energy can be
+// state->output.
+void FftComputeEnergy(struct FftState* state, int input_scale_shift,
+                      int start_index, int end_index, int32_t* energy);
+
 void FftInit(struct FftState* state);
 
 void FftReset(struct FftState* state);
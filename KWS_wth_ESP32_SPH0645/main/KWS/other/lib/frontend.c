@@ -25,22 +25,21 @@ struct FrontendOutput FrontendProcessSamples(struct FrontendState* state,
   output.size = 0;
 
   // Try to apply the window - if it fails, return and wait for more data.
-  if (!WindowProcessSamples(&state->window, samples, num_samples,
-                            num_samples_read)) {
+  // The window is written straight into the FFT input, which is scaled in
+  // place so that the fixed point FFT can have as much resolution as
+  // possible.
+  if (!WindowProcessSamplesToBuffer(&state->window, samples, num_samples,
+                                    num_samples_read, state->fft.input)) {
     return output;
   }
-
-  // Apply the FFT to the window's output (and scale it so that the fixed point
-  // FFT can have as much resolution as possible).
   int input_shift =
       15 - MostSignificantBit32(state->window.max_abs_output_value);
-  FftCompute(&state->fft, state->window.output, input_shift);
 
-  // We can re-ruse the fft's output buffer to hold the energy.
+  // We can re-ruse the fft's output buffer to hold the energy, the FFT only
+  // computes the energy of the bins used by the filterbank.
   int32_t* energy = (int32_t*)state->fft.output;
-
-  FilterbankConvertFftComplexToEnergy(&state->filterbank, state->fft.output,
-                                      energy);
+  FftComputeEnergy(&state->fft, input_shift, state->filterbank.start_index,
+                   state->filterbank.end_index, energy);
 
   FilterbankAccumulateChannels(&state->filterbank, energy);
   uint32_t* scaled_filterbank = FilterbankSqrt(&state->filterbank, input_shift);
@@ -120,6 +120,61 @@ void kiss_fftr(kiss_fftr_cfg st,const kiss_fft_scalar *timedata,kiss_fft_cpx *fr
     }
 }
 
+/* Patched. kiss_fftr fused with the energy of the bins [start_bin, end_bin) */
+static void kf_store_energy(int k,int start_bin,int end_bin,kiss_fft_scalar r,kiss_fft_scalar i,int32_t *energy)
+{
+    if (k >= start_bin && k < end_bin) {
+        const int32_t real = r;
+        const int32_t imag = i;
+        const uint32_t mag_squared = (real * real) + (imag * imag);
+        energy[k] = mag_squared;
+    }
+}
+
+void kiss_fftr_energy(kiss_fftr_cfg st,const kiss_fft_scalar *timedata,int start_bin,int end_bin,int32_t *energy)
+{
+    int k,ncfft,first_k,last_k;
+    kiss_fft_cpx fpnk,fpk,f1k,f2k,tw,tdc;
+
+    if ( st->substate->inverse) {
+        return;
+    }
+
+    ncfft = st->substate->nfft;
+
+    kiss_fft( st->substate , (const kiss_fft_cpx*)timedata, st->tmpbuf );
+
+    tdc.r = st->tmpbuf[0].r;
+    tdc.i = st->tmpbuf[0].i;
+    C_FIXDIV(tdc,2);
+    kf_store_energy(0, start_bin, end_bin, tdc.r + tdc.i, 0, energy);
+    kf_store_energy(ncfft, start_bin, end_bin, tdc.r - tdc.i, 0, energy);
+
+    /* Every k gives the bins k and ncfft-k, only visit the k which give
+       at least one bin of the range */
+    first_k = start_bin < ncfft - end_bin + 1 ? start_bin : ncfft - end_bin + 1;
+    if (first_k < 1)
+        first_k = 1;
+    last_k = end_bin - 1 > ncfft - start_bin ? end_bin - 1 : ncfft - start_bin;
+    if (last_k > ncfft/2)
+        last_k = ncfft/2;
+
+    for ( k=first_k;k <= last_k ; ++k ) {
+        fpk    = st->tmpbuf[k];
+        fpnk.r =   st->tmpbuf[ncfft-k].r;
+        fpnk.i = - st->tmpbuf[ncfft-k].i;
+        C_FIXDIV(fpk,2);
+        C_FIXDIV(fpnk,2);
+
+        C_ADD( f1k, fpk , fpnk );
+        C_SUB( f2k, fpk , fpnk );
+        C_MUL( tw , f2k , st->super_twiddles[k-1]);
+
+        kf_store_energy(k, start_bin, end_bin, HALF_OF(f1k.r + tw.r), HALF_OF(f1k.i + tw.i), energy);
+        kf_store_energy(ncfft-k, start_bin, end_bin, HALF_OF(f1k.r - tw.r), HALF_OF(tw.i - f1k.i), energy);
+    }
+}
+
 void kiss_fftri(kiss_fftr_cfg st,const kiss_fft_cpx *freqdata,kiss_fft_scalar *timedata)
 {
     /* input buffer timedata is stored row-wise */
@@ -32,6 +32,13 @@ void kiss_fftr(kiss_fftr_cfg cfg,const kiss_fft_scalar *timedata,kiss_fft_cpx *f
  output freqdata has nfft/2+1 complex points
 */
 
+void kiss_fftr_energy(kiss_fftr_cfg cfg,const kiss_fft_scalar *timedata,int start_bin,int end_bin,int32_t *energy);
+/*
+ Patched. Same as kiss_fftr, but the last (real split) stage writes only
+ energy[k] = r*r + i*i of the output bins start_bin <= k < end_bin,
+ bit exact with the freqdata of kiss_fftr.
+*/
+
 void kiss_fftri(kiss_fftr_cfg cfg,const kiss_fft_cpx *freqdata,kiss_fft_scalar *timedata);
 /*
  input freqdata has  nfft/2+1 complex points
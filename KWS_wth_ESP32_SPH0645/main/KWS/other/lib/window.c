@@ -18,6 +18,13 @@ limitations under the License.
 
 int WindowProcessSamples(struct WindowState* state, const int16_t* samples,
                          size_t num_samples, size_t* num_samples_read) {
+  return WindowProcessSamplesToBuffer(state, samples, num_samples,
+                                      num_samples_read, state->output);
+}
+
+int WindowProcessSamplesToBuffer(struct WindowState* state,
+                                 const int16_t* samples, size_t num_samples,
+                                 size_t* num_samples_read, int16_t* output) {
   const int size = state->size;
 
   // Copy samples from the samples buffer over to our local input.
@@ -38,7 +45,6 @@ int WindowProcessSamples(struct WindowState* state, const int16_t* samples,
   // Apply the window to the input.
   const int16_t* coefficients = state->coefficients;
   const int16_t* input = state->input;
-  int16_t* output = state->output;
   int i;
   int16_t max_abs_output_value = 0;
   for (i = 0; i < size; ++i) {
@@ -40,6 +40,13 @@ struct WindowState {
 int WindowProcessSamples(struct WindowState* state, const int16_t* samples,
                          size_t num_samples, size_t* num_samples_read);
 
+// Same as WindowProcessSamples, but the windowed samples are written to output
+// (state->size values) instead of state->output. The frontend gives the FFT
+// input buffer, so the window is applied straight where the FFT reads it.
+int WindowProcessSamplesToBuffer(struct WindowState* state,
+                                 const int16_t* samples, size_t num_samples,
+                                 size_t* num_samples_read, int16_t* output);
+
 void WindowReset(struct WindowState* state);
 
 #ifdef __cplusplus
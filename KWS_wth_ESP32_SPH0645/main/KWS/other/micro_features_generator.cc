@@ -18,13 +18,23 @@ limitations under the License.
 #include <cmath>
 #include <cstring>
 #include <esp_log.h>
-#include "audio_preprocessor_int8_model_data.h"
+#include "../keyword_spotting_config.h"
+#if KEYWORD_SPOTTING_STREAMING_FRONTEND
+  #include "audio_preprocessor_streaming_int8_model_data.h"
+#else
+  #include "audio_preprocessor_int8_model_data.h"
+#endif
 #include "tensorflow/lite/schema/schema_generated.h"
 #include "tensorflow/lite/micro/micro_log.h"
 #include "tensorflow/lite/micro/micro_interpreter.h"
 #include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
 #include "tensorflow/lite/micro/micro_log.h"
 #include "micro_model_settings.h"
+#include "../kernels/rfft_512.h"
+#include "../kernels/filter_bank_sparse.h"
+#include "../kernels/fast_log_sqrt.h"
+#include "../kernels/noise_estimate.h"
+#include "../kernels/window_auto_scale.h"
 #include "esp_heap_caps.h"
 
 namespace {
@@ -37,6 +47,10 @@ tflite::MicroInterpreter* interpreter = nullptr;
 
 constexpr size_t kArenaSize = 16 * 1024;
 
+/* Warmup and snapshot of the noise estimate kernel, the external context of
+   the interpreter */
+tflite::KwsNoiseEstimateControl g_noise_estimate_control = { -1 , nullptr , 0 };
+
 /* If we use a externa PSRAM, so we will allocate the arena in it, not in internal ram */
 #if ( USED_PSRAM == 1 )
   uint8_t *g_arena = (uint8_t *) heap_caps_malloc( kArenaSize , MALLOC_CAP_SPIRAM ) ; 
@@ -48,7 +62,12 @@ constexpr int kAudioSampleDurationCount =
     kFeatureDurationMs * kAudioSampleFrequency / 1000;
 constexpr int kAudioSampleStrideCount =
     kFeatureStrideMs * kAudioSampleFrequency / 1000;
+#if KEYWORD_SPOTTING_STREAMING_FRONTEND
+/* One more operator, the SignalFramer at the input of the streaming model */
+using AudioPreprocessorOpResolver = tflite::MicroMutableOpResolver<19>;
+#else
 using AudioPreprocessorOpResolver = tflite::MicroMutableOpResolver<18>;
+#endif
 }  // namespace
 
 TfLiteStatus RegisterOps(AudioPreprocessorOpResolver& op_resolver) {
@@ -61,15 +80,26 @@ TfLiteStatus RegisterOps(AudioPreprocessorOpResolver& op_resolver) {
   TF_LITE_ENSURE_STATUS(op_resolver.AddDiv());
   TF_LITE_ENSURE_STATUS(op_resolver.AddMinimum());
   TF_LITE_ENSURE_STATUS(op_resolver.AddMaximum());
-  TF_LITE_ENSURE_STATUS(op_resolver.AddWindow());
-  TF_LITE_ENSURE_STATUS(op_resolver.AddFftAutoScale());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddCustom("SignalWindow", tflite::Register_KWS_WINDOW()));
+  TF_LITE_ENSURE_STATUS(op_resolver.AddCustom("SignalFftAutoScale", tflite::Register_KWS_FFT_AUTO_SCALE()));
+#if KEYWORD_SPOTTING_FAST_RFFT
+  TF_LITE_ENSURE_STATUS(op_resolver.AddRfft(tflite::Register_KWS_RFFT_512()));
+#else
   TF_LITE_ENSURE_STATUS(op_resolver.AddRfft());
+#endif
   TF_LITE_ENSURE_STATUS(op_resolver.AddEnergy());
+#if KEYWORD_SPOTTING_COMPACT_FILTER_BANK
+  TF_LITE_ENSURE_STATUS(op_resolver.AddCustom("SignalFilterBank", tflite::Register_KWS_FILTER_BANK()));
+#else
   TF_LITE_ENSURE_STATUS(op_resolver.AddFilterBank());
-  TF_LITE_ENSURE_STATUS(op_resolver.AddFilterBankSquareRoot());
-  TF_LITE_ENSURE_STATUS(op_resolver.AddFilterBankSpectralSubtraction());
+#endif
+  TF_LITE_ENSURE_STATUS(op_resolver.AddCustom("SignalFilterBankSquareRoot", tflite::Register_KWS_FILTER_BANK_SQUARE_ROOT()));
+  TF_LITE_ENSURE_STATUS(op_resolver.AddCustom("SignalFilterBankSpectralSubtraction", tflite::Register_KWS_FILTER_BANK_SPECTRAL_SUBTRACTION()));
   TF_LITE_ENSURE_STATUS(op_resolver.AddPCAN());
-  TF_LITE_ENSURE_STATUS(op_resolver.AddFilterBankLog());
+  TF_LITE_ENSURE_STATUS(op_resolver.AddCustom("SignalFilterBankLog", tflite::Register_KWS_FILTER_BANK_LOG()));
+#if KEYWORD_SPOTTING_STREAMING_FRONTEND
+  TF_LITE_ENSURE_STATUS(op_resolver.AddFramer());
+#endif
   return kTfLiteOk;
 }
 
@@ -78,7 +108,11 @@ TfLiteStatus InitializeMicroFeatures() {
 
   // Map the model into a usable data structure. This doesn't involve any
   // copying or parsing, it's a very lightweight operation.
+#if KEYWORD_SPOTTING_STREAMING_FRONTEND
+  model = tflite::GetModel(g_audio_preprocessor_streaming_int8_tflite);
+#else
   model = tflite::GetModel(g_audio_preprocessor_int8_tflite);
+#endif
   if (model->version() != TFLITE_SCHEMA_VERSION) {
     MicroPrintf("Model provided for Feature generator is schema version %d "
                 "not equal to supported version %d.", model->version(), TFLITE_SCHEMA_VERSION);
@@ -95,6 +129,7 @@ TfLiteStatus InitializeMicroFeatures() {
     MicroPrintf("AllocateTensors failed for Feature provider model. Line %d", __LINE__);
     return kTfLiteError;
   }
+  TF_LITE_ENSURE_STATUS(interpreter->SetMicroExternalContext(&g_noise_estimate_control));
 
   // MicroPrintf("AudioPreprocessor model arena size = %u",
   //             interpreter.arena_used_bytes());
@@ -143,3 +178,59 @@ TfLiteStatus GenerateFeatures(const int16_t* audio_data,
 
   return kTfLiteOk;
 }
+
+TfLiteStatus SaveMicroFeaturesState(MicroFeaturesState* state)
+{
+  state->valid = false;
+  TF_LITE_ENSURE_STATUS(tflite::KwsNoiseEstimateGet(&g_noise_estimate_control, state->noise_estimate, g_kFeatureSize));
+  state->valid = true;
+  return kTfLiteOk;
+}
+
+TfLiteStatus RestoreMicroFeaturesState(const MicroFeaturesState* state)
+{
+  if (!state->valid) 
+  {
+    return kTfLiteError;
+  }
+  return tflite::KwsNoiseEstimateSet(&g_noise_estimate_control, state->noise_estimate, g_kFeatureSize);
+}
+
+void WarmupMicroFeatures(int frames)
+{
+  g_noise_estimate_control.warmup_frames = (frames > 0) ? frames : 0;
+}
+
+#if KEYWORD_SPOTTING_STREAMING_FRONTEND == 0
+TfLiteStatus GenerateFeature(const int16_t* audio_data,
+                             const int audio_data_size,
+                             int8_t* feature_output)
+{
+  if (audio_data_size != kAudioSampleDurationCount) 
+  {
+    MicroPrintf("Feature generator wants %d samples, got %d",
+                kAudioSampleDurationCount, audio_data_size);
+    return kTfLiteError;
+  }
+
+  return GenerateSingleFeature(audio_data, audio_data_size, feature_output,
+                               interpreter);
+}
+#else
+TfLiteStatus GenerateStreamingFeature(const int16_t* new_samples,
+                                      const int new_samples_size,
+                                      int8_t* feature_output)
+{
+  /* The model input is one stride of new audio, its Framer adds the overlap
+     with the previous stride */
+  if (new_samples_size != kAudioSampleStrideCount) 
+  {
+    MicroPrintf("Streaming feature generator wants %d samples, got %d",
+                kAudioSampleStrideCount, new_samples_size);
+    return kTfLiteError;
+  }
+
+  return GenerateSingleFeature(new_samples, new_samples_size, feature_output,
+                               interpreter);
+}
+#endif
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include "tensorflow/lite/c/common.h"
 #include "micro_model_settings.h"
+#include "../keyword_spotting_config.h"
 
 using Features = int8_t[g_kFeatureCount][g_kFeatureSize];
 
@@ -34,4 +35,40 @@ TfLiteStatus GenerateFeatures(const int16_t* audio_data,
                               const size_t audio_data_size,
                               Features* features_output);
 
+// The adaptive state of the preprocessor, which is the noise estimate of its
+// spectral subtraction (one value per filterbank channel). PCAN uses this
+// estimate and keeps nothing else.
+struct MicroFeaturesState {
+  uint32_t noise_estimate[g_kFeatureSize];
+  bool valid;
+};
+
+// Copies the state out of and back into the preprocessor, between two
+// invokes, for example over a suspend or in RTC memory over a deep sleep. The
+// state must come from the same preprocessor model. Both fail before the
+// first frame. The restore also stops a warmup.
+TfLiteStatus SaveMicroFeaturesState(MicroFeaturesState* state);
+TfLiteStatus RestoreMicroFeaturesState(const MicroFeaturesState* state);
+
+// The noise estimate of the next frames is their mean instead of the slow low
+// pass filter, so it follows the noise of a new place in a few frames after a
+// resume. These frames should be noise, speech in them raises the estimate
+// until the filter brings it down again.
+void WarmupMicroFeatures(int frames);
+
+#if KEYWORD_SPOTTING_STREAMING_FRONTEND == 0
+// Makes one feature row from one window (kFeatureDurationMs of audio, which
+// overlaps the previous window by kFeatureDurationMs - kFeatureStrideMs).
+TfLiteStatus GenerateFeature(const int16_t* audio_data,
+                             const int audio_data_size,
+                             int8_t* feature_output);
+#else
+// Makes one feature row from the new samples of one stride (320 samples) with
+// the streaming preprocessor, which keeps the overlap with the previous stride
+// in its own state, so the calls have to follow the audio order.
+TfLiteStatus GenerateStreamingFeature(const int16_t* new_samples,
+                                      const int new_samples_size,
+                                      int8_t* feature_output);
+#endif
+
 #endif  // TENSORFLOW_LITE_MICRO_EXAMPLES_MICRO_SPEECH_MICRO_FEATURES_MICRO_FEATURES_GENERATOR_H_
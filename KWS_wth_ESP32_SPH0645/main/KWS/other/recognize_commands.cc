@@ -15,8 +15,23 @@ limitations under the License.
 
 #include "recognize_commands.h"
 
+#include <cmath>
+#include <cstring>
 #include <limits>
 
+namespace {
+
+bool IsBackgroundLabel(const char* label) {
+  return (strcmp(label, "silence") == 0) || (strcmp(label, "unknown") == 0) ||
+         (strcmp(label, "_silence_") == 0) || (strcmp(label, "_unknown_") == 0);
+}
+
+// Scale and zero point of a softmax output.
+constexpr float kSoftmaxScale = 1.0f / 256.0f;
+constexpr int32_t kSoftmaxZeroPoint = -128;
+
+}  // namespace
+
 RecognizeCommands::RecognizeCommands(tflite::ErrorReporter* error_reporter,
                                      int32_t average_window_duration_ms,
                                      uint8_t detection_threshold,
@@ -27,9 +42,172 @@ RecognizeCommands::RecognizeCommands(tflite::ErrorReporter* error_reporter,
       detection_threshold_(detection_threshold),
       suppression_ms_(suppression_ms),
       minimum_count_(minimum_count),
+      labels_(nullptr),
+      label_count_(0),
+      adaptation_{0, 0, 255},
       previous_results_(error_reporter) {
-  previous_top_label_ = "silence";
-  previous_top_label_time_ = std::numeric_limits<int32_t>::min();
+  SetOutputQuantization(kSoftmaxScale, kSoftmaxZeroPoint);
+  SetLabels(kCategoryLabels, kCategoryCount);
+}
+
+TfLiteStatus RecognizeCommands::SetLabels(const char* const* labels,
+                                          int count) {
+  if ((count <= 0) || (count > kMaxRecognizedCategories)) {
+    MicroPrintf("RecognizeCommands takes 1 to %d labels, not %d",
+                kMaxRecognizedCategories, count);
+    return kTfLiteError;
+  }
+  labels_ = labels;
+  label_count_ = count;
+  for (int i = 0; i < count; ++i) {
+    label_configs_[i].threshold = detection_threshold_;
+    label_configs_[i].release = detection_threshold_ / 2;
+    label_configs_[i].suppression_ms = suppression_ms_;
+    label_configs_[i].background = IsBackgroundLabel(labels[i]);
+    active_[i] = false;
+    last_detection_time_[i] = std::numeric_limits<int32_t>::min();
+    background_mean_q16_[i] = 0;
+    background_deviation_q16_[i] = 0;
+  }
+  background_seen_ = false;
+  previous_top_index_ = 0;
+  previous_results_.clear();
+  QuantizeThresholds();
+  return kTfLiteOk;
+}
+
+TfLiteStatus RecognizeCommands::SetLabelConfig(int label,
+                                               const LabelConfig& config) {
+  if ((label < 0) || (label >= label_count_) ||
+      (config.release > config.threshold)) {
+    return kTfLiteError;
+  }
+  label_configs_[label] = config;
+  QuantizeThresholds();
+  return kTfLiteOk;
+}
+
+void RecognizeCommands::SetAdaptation(const AdaptationConfig& config) {
+  adaptation_ = config;
+  QuantizeThresholds();
+}
+
+TfLiteStatus RecognizeCommands::SetOutputQuantization(float scale,
+                                                      int32_t zero_point,
+                                                      bool logits) {
+  // The scores must have some resolution, and 256 / scale must fit.
+  if (!(scale >= 1.0f / 65536.0f) || !(scale <= 256.0f)) {
+    MicroPrintf("Output scale %f can't be used by RecognizeCommands",
+                static_cast<double>(scale));
+    return kTfLiteError;
+  }
+  logits_ = logits;
+  if (logits_) {
+    // The scores are then the softmax made by SoftmaxOfLogits()
+    for (int difference = 0; difference < 256; ++difference) {
+      exp_q20_[difference] = static_cast<uint32_t>(
+          std::lround(1048576.0 * std::exp(-static_cast<double>(scale) * difference)));
+    }
+    logits_zero_point_ = zero_point;
+    scale = kSoftmaxScale;
+    zero_point = kSoftmaxZeroPoint;
+  }
+  output_zero_point_ = zero_point;
+  q16_per_score_q8_ = std::llround(65536.0 / scale);
+  score_per_q16_q32_ = std::llround(scale * 16777216.0);
+  QuantizeThresholds();
+  previous_results_.clear();
+  return kTfLiteOk;
+}
+
+// A score (probability x 256) as a Q16 output minus its zero point, rounded
+// up. It is exact for a softmax output (1/256), else the decisions can only
+// differ from the float ones within 1/65536 of an output step.
+int32_t RecognizeCommands::ToQ16(uint8_t score) const {
+  const int64_t value_q16 = (score * q16_per_score_q8_ + 255) >> 8;
+  return (value_q16 > std::numeric_limits<int32_t>::max())
+             ? std::numeric_limits<int32_t>::max()
+             : static_cast<int32_t>(value_q16);
+}
+
+uint8_t RecognizeCommands::ToScore(int32_t value_q16) const {
+  const int64_t score = (value_q16 * score_per_q16_q32_) >> 32;
+  return (score < 0) ? 0 : ((score > 255) ? 255 : score);
+}
+
+// The thresholds in the domain of the outputs, once per change of the
+// config, so the results are only compared with integers.
+void RecognizeCommands::QuantizeThresholds() {
+  for (int i = 0; i < label_count_; ++i) {
+    threshold_q16_[i] = ToQ16(label_configs_[i].threshold);
+    release_q16_[i] = ToQ16(label_configs_[i].release);
+  }
+  max_threshold_q16_ = ToQ16(adaptation_.max_threshold);
+}
+
+int32_t RecognizeCommands::EffectiveThresholdQ16(int label) const {
+  const int32_t threshold = threshold_q16_[label];
+  if ((adaptation_.shift <= 0) || !background_seen_) {
+    return threshold;
+  }
+  int64_t adaptive = background_mean_q16_[label] +
+                     ((static_cast<int64_t>(adaptation_.margin_q4) *
+                       background_deviation_q16_[label]) >> 4);
+  if (adaptive > max_threshold_q16_) {
+    adaptive = max_threshold_q16_;
+  }
+  return (adaptive > threshold) ? static_cast<int32_t>(adaptive) : threshold;
+}
+
+uint8_t RecognizeCommands::EffectiveThreshold(int label) const {
+  if (EffectiveThresholdQ16(label) == threshold_q16_[label]) {
+    return label_configs_[label].threshold;
+  }
+  return ToScore(EffectiveThresholdQ16(label));
+}
+
+// The int8 softmax of the logits, rounded to the nearest like the softmax
+// kernel, so the scores are the ones of the model with its softmax.
+void RecognizeCommands::SoftmaxOfLogits(const int8_t* logits,
+                                        int8_t* scores) const {
+  int top = logits[0];
+  for (int i = 1; i < label_count_; ++i) {
+    if (logits[i] > top) {
+      top = logits[i];
+    }
+  }
+  // At most 12 x 2^20, and a term x 256 at most 2^28
+  uint32_t sum_q20 = 0;
+  for (int i = 0; i < label_count_; ++i) {
+    sum_q20 += exp_q20_[top - logits[i]];
+  }
+  for (int i = 0; i < label_count_; ++i) {
+    const int32_t score =
+        static_cast<int32_t>((exp_q20_[top - logits[i]] * 256u + sum_q20 / 2) / sum_q20);
+    scores[i] = static_cast<int8_t>(
+        ((score > 255) ? 255 : score) + kSoftmaxZeroPoint);
+  }
+}
+
+// Follows the averaged scores of the keywords while the background is on top.
+void RecognizeCommands::AdaptThresholds(const int32_t* average_q16) {
+  for (int i = 0; i < label_count_; ++i) {
+    if (label_configs_[i].background) {
+      continue;
+    }
+    if (!background_seen_) {
+      background_mean_q16_[i] = average_q16[i];
+      background_deviation_q16_[i] = 0;
+      continue;
+    }
+    background_mean_q16_[i] += (average_q16[i] - background_mean_q16_[i]) >> adaptation_.shift;
+    int32_t deviation = average_q16[i] - background_mean_q16_[i];
+    if (deviation < 0) {
+      deviation = -deviation;
+    }
+    background_deviation_q16_[i] += (deviation - background_deviation_q16_[i]) >> adaptation_.shift;
+  }
+  background_seen_ = true;
 }
 
 TfLiteStatus RecognizeCommands::ProcessLatestResults(
@@ -39,38 +217,62 @@ TfLiteStatus RecognizeCommands::ProcessLatestResults(
   /* Make some error checking */
   if ((latest_results->dims->size != 2) ||
       (latest_results->dims->data[0] != 1) ||
-      (latest_results->dims->data[1] != kCategoryCount)) 
+      (latest_results->dims->data[1] != label_count_)) 
   {
-    TF_LITE_REPORT_ERROR(
-        error_reporter_,
+    MicroPrintf(
         "The results for recognition should contain %d elements, but there are "
         "%d in an %d-dimensional shape",
-        kCategoryCount, latest_results->dims->data[1],
+        label_count_, latest_results->dims->data[1],
         latest_results->dims->size);
     return kTfLiteError;
   }
 
   if (latest_results->type != kTfLiteInt8) {
-    TF_LITE_REPORT_ERROR(
-        error_reporter_,
+    MicroPrintf(
         "The results for recognition should be int8_t elements, but are %d",
         latest_results->type);
     return kTfLiteError;
   }
 
-  
+  int found_index = 0;
+  TfLiteStatus status = ProcessLatestScores(
+      latest_results->data.int8, latest_results->params.zero_point,
+      current_time_ms, &found_index, score, is_new_command);
+  *found_command = labels_[found_index];
+  return status;
+}
+
+TfLiteStatus RecognizeCommands::ProcessLatestScores(
+    const int8_t* scores, int32_t zero_point, const int32_t current_time_ms,
+    int* found_index, uint8_t* score, bool* is_new_command)
+{
+  const int32_t expected_zero_point =
+      logits_ ? logits_zero_point_ : output_zero_point_;
+  if (zero_point != expected_zero_point) {
+    MicroPrintf("The output zero point %d is not the one set, %d", zero_point,
+                expected_zero_point);
+    return kTfLiteError;
+  }
+  int8_t softmax[kMaxRecognizedCategories];
+  if (logits_) {
+    SoftmaxOfLogits(scores, softmax);
+    scores = softmax;
+    zero_point = output_zero_point_;
+  }
   if ((!previous_results_.empty()) &&
-      (current_time_ms < previous_results_.front().time_)) {
-    TF_LITE_REPORT_ERROR(
-        error_reporter_,
+      (current_time_ms < previous_results_.back().time_)) {
+    MicroPrintf(
         "Results must be fed in increasing time order, but received a "
         "timestamp of %d that was earlier than the previous one of %d",
-        current_time_ms, previous_results_.front().time_);
+        current_time_ms, previous_results_.back().time_);
+    *found_index = previous_top_index_;
+    *score = 0;
+    *is_new_command = false;
     return kTfLiteError;
   }
 
   // Add the latest results to the head of the queue.
-  previous_results_.push_back({current_time_ms, latest_results->data.int8});
+  previous_results_.push_back({current_time_ms, scores, zero_point, label_count_});
 
   // Prune any earlier results that are too old for the averaging window.
   const int64_t time_limit = current_time_ms - average_window_duration_ms_;
@@ -85,67 +287,70 @@ TfLiteStatus RecognizeCommands::ProcessLatestResults(
   const int64_t samples_duration = current_time_ms - earliest_time;
   if ((how_many_results < minimum_count_) ||
       (samples_duration < (average_window_duration_ms_ / 4))) {
-    *found_command = previous_top_label_;
+    *found_index = previous_top_index_;
     *score = 0;
     *is_new_command = false;
     return kTfLiteOk;
   }
 
-  // Calculate the average score across all the results in the window.
-  int32_t average_scores[kCategoryCount];
+  // Calculate the average score across all the results in the window, Q16.
+  int32_t average_q16[kMaxRecognizedCategories] = {};
   for (int offset = 0; offset < previous_results_.size(); ++offset) 
   {
-    PreviousResultsQueue::Result previous_result =
-        previous_results_.from_front(offset);
-    const int8_t* scores = previous_result.scores;
-    for (int i = 0; i < kCategoryCount; ++i) 
+    const int16_t* result_scores = previous_results_.from_front(offset).scores;
+    for (int i = 0; i < label_count_; ++i) 
     {
-      if (offset == 0) 
-      {
-        average_scores[i] = scores[i] + 128;
-      } else 
-      {
-        average_scores[i] += scores[i] + 128;
-      }
+      average_q16[i] += result_scores[i];
     }
   }
 
-  for (int i = 0; i < kCategoryCount; ++i) 
+  for (int i = 0; i < label_count_; ++i) 
   {
-    average_scores[i] /= how_many_results;
+    average_q16[i] = (average_q16[i] * 65536) / how_many_results;
   }
 
-  // Find the current highest scoring category.
+  // Find the current highest scoring category, the scale doesn't change it.
   int current_top_index = 0;
-  int32_t current_top_score = 0;
-  for (int i = 0; i < kCategoryCount; ++i) {
-    if (average_scores[i] > current_top_score) {
-      current_top_score = average_scores[i];
+  int32_t current_top_q16 = average_q16[0];
+  for (int i = 1; i < label_count_; ++i) {
+    if (average_q16[i] > current_top_q16) {
+      current_top_q16 = average_q16[i];
       current_top_index = i;
     }
   }
-  const char* current_top_label = kCategoryLabels[current_top_index];
 
-  // If we've recently had another label trigger, assume one that occurs too
+  if ((adaptation_.shift > 0) && label_configs_[current_top_index].background) {
+    AdaptThresholds(average_q16);
+  }
+
+  // A label can be detected again once its score went under its release.
+  for (int i = 0; i < label_count_; ++i) {
+    if (active_[i] && (average_q16[i] < release_q16_[i])) {
+      active_[i] = false;
+    }
+  }
+
+  // If we've recently had this label trigger, assume one that occurs too
   // soon afterwards is a bad result.
+  const LabelConfig& top_config = label_configs_[current_top_index];
   int64_t time_since_last_top;
-  if ((previous_top_label_ == kCategoryLabels[0]) ||
-      (previous_top_label_time_ == std::numeric_limits<int32_t>::min())) {
+  if (last_detection_time_[current_top_index] == std::numeric_limits<int32_t>::min()) {
     time_since_last_top = std::numeric_limits<int32_t>::max();
   } else {
-    time_since_last_top = current_time_ms - previous_top_label_time_;
+    time_since_last_top = current_time_ms - last_detection_time_[current_top_index];
   }
-  if ((current_top_score > detection_threshold_) &&
-      ((current_top_label != previous_top_label_) ||
-       (time_since_last_top > suppression_ms_))) {
-    previous_top_label_ = current_top_label;
-    previous_top_label_time_ = current_time_ms;
+  if (!top_config.background && !active_[current_top_index] &&
+      (current_top_q16 >= EffectiveThresholdQ16(current_top_index)) &&
+      (time_since_last_top > top_config.suppression_ms)) {
+    active_[current_top_index] = true;
+    last_detection_time_[current_top_index] = current_time_ms;
+    previous_top_index_ = current_top_index;
     *is_new_command = true;
   } else {
     *is_new_command = false;
   }
-  *found_command = current_top_label;
-  *score = current_top_score;
+  *found_index = current_top_index;
+  *score = ToScore(current_top_q16);
 
   return kTfLiteOk;
-}
\ No newline at end of file
+}
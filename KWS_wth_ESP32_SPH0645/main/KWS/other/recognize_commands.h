@@ -21,6 +21,10 @@ limitations under the License.
 #include "tensorflow/lite/c/common.h"
 #include "micro_model_settings.h"
 #include "tensorflow/lite/core/api/error_reporter.h"
+#include "tensorflow/lite/micro/micro_log.h"
+
+// Most output categories of a model given to RecognizeCommands.
+constexpr int kMaxRecognizedCategories = 12;
 
 // Partial implementation of std::dequeue, just providing the functionality
 // that's needed to keep a record of previous neural network results over a
@@ -34,20 +38,26 @@ class PreviousResultsQueue {
       : error_reporter_(error_reporter), front_index_(0), size_(0) {}
 
   // Data structure that holds an inference result, and the time when it
-  // was recorded.
+  // was recorded. The scores are the int8 outputs minus their zero point,
+  // from -255 to 255.
   struct Result {
     Result() : time_(0), scores() {}
-    Result(int32_t time, int8_t* input_scores) : time_(time) {
-      for (int i = 0; i < kCategoryCount; ++i) {
-        scores[i] = input_scores[i];
+    Result(int32_t time, const int8_t* outputs, int32_t zero_point, int count)
+        : time_(time), scores() {
+      for (int i = 0; i < count; ++i) {
+        scores[i] = outputs[i] - zero_point;
       }
     }
     int32_t time_;
-    int8_t scores[kCategoryCount];
+    int16_t scores[kMaxRecognizedCategories];
   };
 
   int size() { return size_; }
   bool empty() { return size_ == 0; }
+  void clear() {
+    front_index_ = 0;
+    size_ = 0;
+  }
   Result& front() { return results_[front_index_]; }
   Result& back() {
     int back_index = front_index_ + (size_ - 1);
@@ -59,9 +69,7 @@ class PreviousResultsQueue {
 
   void push_back(const Result& entry) {
     if (size() >= kMaxResults) {
-      TF_LITE_REPORT_ERROR(
-          error_reporter_,
-          "Couldn't push_back latest result, too many already!");
+      MicroPrintf("Couldn't push_back latest result, too many already!");
       return;
     }
     size_ += 1;
@@ -70,8 +78,7 @@ class PreviousResultsQueue {
 
   Result pop_front() {
     if (size() <= 0) {
-      TF_LITE_REPORT_ERROR(error_reporter_,
-                           "Couldn't pop_front result, none present!");
+      MicroPrintf("Couldn't pop_front result, none present!");
       return Result();
     }
     Result result = front();
@@ -88,8 +95,7 @@ class PreviousResultsQueue {
   // queue.
   Result& from_front(int offset) {
     if ((offset < 0) || (offset >= size_)) {
-      TF_LITE_REPORT_ERROR(error_reporter_,
-                           "Attempt to read beyond the end of the queue!");
+      MicroPrintf("Attempt to read beyond the end of the queue!");
       offset = size_ - 1;
     }
     int index = front_index_ + offset;
@@ -118,8 +124,44 @@ class PreviousResultsQueue {
 // processing method. The timestamp for each subsequent call should be
 // increasing from the previous, since the class is designed to process a stream
 // of data over time.
+//
+// Every label has its own decision, on the averaged int8 outputs minus their
+// zero point, without any float. The scores and the thresholds of the API are
+// probabilities x 256 (0 to 255), SetOutputQuantization() converts the
+// thresholds once to the quantized outputs of the model, in Q16, so a model
+// with another output scale takes the same decisions as the float outputs
+// would:
+//  - attack / release : a label is detected when its score reaches its
+//    threshold, and can't be detected again before its score went under its
+//    release level and its suppression time is over.
+//  - background adaptive threshold : while a background label ("silence",
+//    "unknown") is on top, the mean and mean deviation of the averaged score
+//    of every keyword are followed (1 / 2^adaptation_shift per result). The
+//    threshold of a keyword is then at least mean + margin x deviation, so a
+//    noise which the model confuses with a keyword raises its threshold, up
+//    to max_threshold.
+// A model without its softmax (KWS_model/strip_softmax.py, or the softmax
+// elided at load time) gives int8 logits. Their softmax is made again with a
+// table of exp(-scale x d) for the 256 differences d to the highest logit,
+// and gives the same scores as the int8 softmax of TFLM, so the decisions
+// don't change.
+// Everything can be changed at runtime. KWS_model/sweep_thresholds.py has the
+// same integer arithmetic, to tune the values on labelled recordings.
 class RecognizeCommands {
  public:
+  struct LabelConfig {
+    uint8_t threshold;       // Score to detect the label
+    uint8_t release;         // Score to go under before the next detection
+    int32_t suppression_ms;  // Shortest time between two detections
+    bool background;         // Never detected, its results adapt the thresholds
+  };
+
+  struct AdaptationConfig {
+    int shift;               // Weight of a new result 1 / 2^shift, 0 disables
+    int margin_q4;           // Deviations above the mean, Q4
+    uint8_t max_threshold;
+  };
+
   // labels should be a list of the strings associated with each one-hot score.
   // The window duration controls the smoothing. Longer durations will give a
   // higher confidence that the results are correct, but may miss some commands.
@@ -129,31 +171,86 @@ class RecognizeCommands {
   // average. This prevents erroneous results when the averaging window is
   // initially being populated for example. The suppression argument disables
   // further recognitions for a set time after one has been triggered, which can
-  // help reduce spurious recognitions.
+  // help reduce spurious recognitions. The threshold and the suppression are
+  // the defaults of every label.
   explicit RecognizeCommands(tflite::ErrorReporter* error_reporter,
                              int32_t average_window_duration_ms = 1000,
                              uint8_t detection_threshold = 200,
                              int32_t suppression_ms = 1500,
                              int32_t minimum_count = 3);
 
+  // The labels of the model, the results must have `count` scores. Every
+  // label gets the default config, "silence" and "unknown" (also with
+  // underscores around) are background labels. Clears the results and the
+  // adaptation.
+  TfLiteStatus SetLabels(const char* const* labels, int count);
+
+  TfLiteStatus SetLabelConfig(int label, const LabelConfig& config);
+  const LabelConfig& label_config(int label) const { return label_configs_[label]; }
+  void SetAdaptation(const AdaptationConfig& config);
+  const AdaptationConfig& adaptation() const { return adaptation_; }
+
+  // The scale and the zero point of the output tensor, the only float of the
+  // class. The default is the softmax output, 1/256 and -128. With logits,
+  // the outputs are the input of the softmax which was removed.
+  TfLiteStatus SetOutputQuantization(float scale, int32_t zero_point,
+                                     bool logits = false);
+  bool logits() const { return logits_; }
+
+  // Threshold of the label now, with the adaptation.
+  uint8_t EffectiveThreshold(int label) const;
+
   // Call this with the results of running a model on sample data.
   TfLiteStatus ProcessLatestResults(const TfLiteTensor* latest_results,
                                     const int32_t current_time_ms,
                                     const char** found_command, uint8_t* score,
                                     bool* is_new_command);
 
+  // Same with the int8 outputs of the model and the zero point given to
+  // SetOutputQuantization(). The index of the found label is in found_index.
+  TfLiteStatus ProcessLatestScores(const int8_t* scores, int32_t zero_point,
+                                   const int32_t current_time_ms,
+                                   int* found_index, uint8_t* score,
+                                   bool* is_new_command);
+
  private:
+  void AdaptThresholds(const int32_t* average_q16);
+  void SoftmaxOfLogits(const int8_t* logits, int8_t* scores) const;
+  void QuantizeThresholds();
+  int32_t ToQ16(uint8_t score) const;
+  uint8_t ToScore(int32_t value_q16) const;
+  int32_t EffectiveThresholdQ16(int label) const;
+
   // Configuration
   tflite::ErrorReporter* error_reporter_;
   int32_t average_window_duration_ms_;
   uint8_t detection_threshold_;
   int32_t suppression_ms_;
   int32_t minimum_count_;
+  const char* const* labels_;
+  int label_count_;
+  LabelConfig label_configs_[kMaxRecognizedCategories];
+  AdaptationConfig adaptation_;
+
+  // Quantized outputs, Q16 of the output minus its zero point
+  int32_t output_zero_point_;
+  bool logits_;
+  int32_t logits_zero_point_;
+  uint32_t exp_q20_[256];      // Logits only, exp(-scale x d), Q20
+  int64_t q16_per_score_q8_;   // 256 / scale, Q8
+  int64_t score_per_q16_q32_;  // scale / 256, Q32
+  int32_t threshold_q16_[kMaxRecognizedCategories];
+  int32_t release_q16_[kMaxRecognizedCategories];
+  int32_t max_threshold_q16_;
 
   // Working variables
   PreviousResultsQueue previous_results_;
-  const char* previous_top_label_;
-  int32_t previous_top_label_time_;
+  int previous_top_index_;
+  bool active_[kMaxRecognizedCategories];
+  int32_t last_detection_time_[kMaxRecognizedCategories];
+  int32_t background_mean_q16_[kMaxRecognizedCategories];
+  int32_t background_deviation_q16_[kMaxRecognizedCategories];
+  bool background_seen_;
 };
 
-#endif  // TENSORFLOW_LITE_MICRO_EXAMPLES_MICRO_SPEECH_RECOGNIZE_COMMANDS_H_
\ No newline at end of file
+#endif  // TENSORFLOW_LITE_MICRO_EXAMPLES_MICRO_SPEECH_RECOGNIZE_COMMANDS_H_
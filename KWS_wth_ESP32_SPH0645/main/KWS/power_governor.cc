@@ -0,0 +1,106 @@
+/*
+ *  power_governor.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "power_governor.h"
+
+#include <string.h>
+
+
+void power_governor_init(power_governor_t *governor, const uint16_t *freq_mhz, const uint32_t *active_ua,
+                         int levels, uint32_t idle_ua, uint32_t stride_us, int target_load_percent,
+                         int window_strides)
+{
+  memset( governor , 0 , sizeof(*governor) );
+  governor->levels = (levels > POWER_GOVERNOR_MAX_LEVELS) ? POWER_GOVERNOR_MAX_LEVELS : levels;
+  for( int i = 0 ; i < governor->levels ; i++ )
+  {
+    governor->freq_mhz[i] = freq_mhz[i];
+    governor->active_ua[i] = active_ua[i];
+  }
+  governor->idle_ua = idle_ua;
+  governor->stride_us = stride_us;
+  governor->target_us = (uint32_t)( (uint64_t)stride_us * target_load_percent / 100 );
+  governor->window_strides = (window_strides > 0) ? window_strides : 1;
+  governor->level = governor->levels - 1;
+}
+
+
+/* The lowest level which does the cycles in the target time, else the highest */
+static int power_governor_level_for(const power_governor_t *governor, uint64_t cycles)
+{
+  for( int i = 0 ; i < governor->levels ; i++ )
+  {
+    if( cycles <= (uint64_t)governor->freq_mhz[i] * governor->target_us )
+    {
+      return i;
+    }
+  }
+  return governor->levels - 1;
+}
+
+
+int power_governor_update(power_governor_t *governor, uint32_t busy_us, uint32_t idle_us)
+{
+  power_governor_stats_t *stats = &governor->stats;
+  stats->iterations++;
+  stats->busy_us[governor->level] += busy_us;
+  stats->idle_us += idle_us;
+  stats->charge_ua_us += (uint64_t)governor->active_ua[governor->level] * busy_us + (uint64_t)governor->idle_ua * idle_us;
+  if( busy_us > stats->max_busy_us )
+  {
+    stats->max_busy_us = busy_us;
+  }
+  if( busy_us > governor->stride_us )
+  {
+    stats->overruns++;
+  }
+
+  /* Cycles at 1 MHz per us, so they don't depend on the level */
+  const uint64_t cycles = (uint64_t)busy_us * governor->freq_mhz[governor->level];
+  if( cycles > governor->window_peak_cycles )
+  {
+    governor->window_peak_cycles = cycles;
+  }
+
+  int level = governor->level;
+  if( busy_us > governor->target_us )
+  {
+    const int up = power_governor_level_for( governor , cycles );
+    if( up > level )
+    {
+      level = up;
+    }
+  }
+  if( ++governor->window_count >= governor->window_strides )
+  {
+    const int down = power_governor_level_for( governor , governor->window_peak_cycles );
+    if( down < level )
+    {
+      level = down;
+    }
+    governor->window_count = 0;
+    governor->window_peak_cycles = 0;
+  }
+
+  if( level != governor->level )
+  {
+    stats->level_changes++;
+    governor->level = level;
+  }
+  return level;
+}
+
+
+uint32_t power_governor_average_ua(const power_governor_t *governor)
+{
+  uint64_t total_us = governor->stats.idle_us;
+  for( int i = 0 ; i < governor->levels ; i++ )
+  {
+    total_us += governor->stats.busy_us[i];
+  }
+  return (total_us > 0) ? (uint32_t)( governor->stats.charge_ua_us / total_us ) : 0;
+}
@@ -0,0 +1,71 @@
+/*
+ *  power_governor.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef POWER_GOVERNOR_H_
+#define POWER_GOVERNOR_H_
+
+#include <stdint.h>
+
+/* CPU frequency of the KWS work by its load. The KWS task sleeps until a
+   stride of audio is captured, then holds the CPU at the frequency of the
+   governor level for the features and the inference, and gives back the
+   time of both. The governor keeps the highest number of CPU cycles of the
+   last window_strides iterations, and chooses the lowest frequency which
+   does them in target_load_percent of the stride :
+
+   - up at once, when an iteration went over the target, so a burst of
+     inferences (the cascade stage 2) doesn't fill the capture ring;
+   - down only at the end of a window, with the peak of the whole window.
+
+   The average current is estimated from the time at every level and the
+   current given for it, and the idle current between the iterations.
+
+   There is nothing of the ESP-IDF in this file, so it runs on the host with
+   a simulated capture and workload. */
+
+#define  POWER_GOVERNOR_MAX_LEVELS      (4)
+
+typedef struct
+{
+  uint32_t iterations;                         /* Times power_governor_update() ran */
+  uint32_t overruns;                           /* Iterations which took longer than a stride */
+  uint32_t level_changes;
+  uint64_t busy_us[POWER_GOVERNOR_MAX_LEVELS]; /* Work at every level */
+  uint64_t idle_us;                            /* Waiting for the audio */
+  uint64_t charge_ua_us;                       /* Estimated charge, uA x us */
+  uint32_t max_busy_us;
+} power_governor_stats_t;
+
+typedef struct
+{
+  int levels;
+  int level;                                        /* Active level */
+  uint16_t freq_mhz[POWER_GOVERNOR_MAX_LEVELS];     /* From the lowest */
+  uint32_t active_ua[POWER_GOVERNOR_MAX_LEVELS];    /* Current when busy at every level */
+  uint32_t idle_ua;
+  uint32_t target_us;                               /* target_load_percent of the stride */
+  uint32_t stride_us;
+  uint32_t window_strides;
+  uint32_t window_count;
+  uint64_t window_peak_cycles;
+  power_governor_stats_t stats;
+} power_governor_t;
+
+/* freq_mhz and active_ua have `levels` values, from the lowest frequency.
+   It starts at the highest level */
+void power_governor_init(power_governor_t *governor, const uint16_t *freq_mhz, const uint32_t *active_ua,
+                         int levels, uint32_t idle_ua, uint32_t stride_us, int target_load_percent,
+                         int window_strides);
+
+/* One iteration of the KWS task : busy_us of work at the active level,
+   after idle_us of sleep. Returns the level of the next iteration */
+int power_governor_update(power_governor_t *governor, uint32_t busy_us, uint32_t idle_us);
+
+/* Mean current since the init, in uA */
+uint32_t power_governor_average_ua(const power_governor_t *governor);
+
+#endif /* POWER_GOVERNOR_H_ */
@@ -0,0 +1,148 @@
+/*
+ *  telemetry.cc
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#include "telemetry.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "keyword_spotting_config.h"
+
+#if defined(ESP_PLATFORM)
+#include "esp_attr.h"
+#else
+#define IRAM_ATTR
+#endif
+
+namespace {
+
+constexpr uint32_t kCapacity = KEYWORD_SPOTTING_TELEMETRY_RECORDS;
+static_assert( (kCapacity & (kCapacity - 1)) == 0 , "The telemetry ring must be a power of two" );
+
+typedef struct
+{
+  uint32_t sequence;       /* position : free for its producer, position + 1 : full */
+  telemetry_record_t record;
+} telemetry_slot_t;
+
+telemetry_slot_t g_slots[kCapacity];
+uint32_t g_head = 0;       /* Next position of the producers */
+uint32_t g_tail = 0;       /* Next position of the consumer */
+uint32_t g_reported_drops = 0;
+int64_t (*g_clock_us)(void) = nullptr;
+telemetry_stats_t g_stats;
+
+#define  TELEMETRY_EVENT_FORMAT(id, format)  format,
+const char *const kFormats[TELEMETRY_EVENT_COUNT] = { TELEMETRY_EVENTS( TELEMETRY_EVENT_FORMAT ) };
+#undef  TELEMETRY_EVENT_FORMAT
+
+}/* namespace */
+
+
+void telemetry_init(int64_t (*clock_us)(void))
+{
+  for( uint32_t i = 0 ; i < kCapacity ; i++ )
+  {
+    g_slots[i].sequence = i;
+  }
+  g_head = 0;
+  g_tail = 0;
+  g_reported_drops = 0;
+  g_clock_us = clock_us;
+  memset( &g_stats , 0 , sizeof(g_stats) );
+}
+
+
+IRAM_ATTR bool telemetry_log(telemetry_event_t id, int32_t arg0, int32_t arg1, int32_t arg2)
+{
+  uint32_t position = __atomic_load_n( &g_head , __ATOMIC_RELAXED );
+  telemetry_slot_t *slot;
+  for( ;; )
+  {
+    slot = &g_slots[position & (kCapacity - 1)];
+    const int32_t difference = (int32_t)( __atomic_load_n( &slot->sequence , __ATOMIC_ACQUIRE ) - position );
+    if( difference == 0 )
+    {
+      /* Free for this turn, take it if no other producer did */
+      if( __atomic_compare_exchange_n( &g_head , &position , position + 1 , true , __ATOMIC_RELAXED , __ATOMIC_RELAXED ) )
+      {
+        break;
+      }
+    }
+    else if( difference < 0 )
+    {
+      /* The consumer didn't take the record of the previous turn */
+      __atomic_fetch_add( &g_stats.dropped , 1 , __ATOMIC_RELAXED );
+      return false;
+    }
+    else
+    {
+      position = __atomic_load_n( &g_head , __ATOMIC_RELAXED );
+    }
+  }
+
+  slot->record.magic = TELEMETRY_MAGIC;
+  slot->record.id = (uint16_t) id;
+  slot->record.time_us = (g_clock_us != nullptr) ? (uint32_t) g_clock_us() : 0;
+  slot->record.args[0] = arg0;
+  slot->record.args[1] = arg1;
+  slot->record.args[2] = arg2;
+  __atomic_store_n( &slot->sequence , position + 1 , __ATOMIC_RELEASE );
+  __atomic_fetch_add( &g_stats.logged , 1 , __ATOMIC_RELAXED );
+  return true;
+}
+
+
+bool telemetry_pop(telemetry_record_t *record)
+{
+  const uint32_t dropped = __atomic_load_n( &g_stats.dropped , __ATOMIC_RELAXED );
+  if( dropped != g_reported_drops )
+  {
+    memset( record , 0 , sizeof(*record) );
+    record->magic = TELEMETRY_MAGIC;
+    record->id = TELEMETRY_DROPPED;
+    record->time_us = (g_clock_us != nullptr) ? (uint32_t) g_clock_us() : 0;
+    record->args[0] = (int32_t)( dropped - g_reported_drops );
+    g_reported_drops = dropped;
+    return true;
+  }
+
+  telemetry_slot_t *slot = &g_slots[g_tail & (kCapacity - 1)];
+  if( __atomic_load_n( &slot->sequence , __ATOMIC_ACQUIRE ) != g_tail + 1 )
+  {
+    return false;
+  }
+
+  const uint32_t fill = __atomic_load_n( &g_head , __ATOMIC_RELAXED ) - g_tail;
+  if( fill > g_stats.max_fill )
+  {
+    g_stats.max_fill = fill;
+  }
+  *record = slot->record;
+  /* Free for the producer of the next turn */
+  __atomic_store_n( &slot->sequence , g_tail + kCapacity , __ATOMIC_RELEASE );
+  g_tail++;
+  g_stats.popped++;
+  return true;
+}
+
+
+int telemetry_format(const telemetry_record_t *record, char *buffer, int size)
+{
+  if( record->id >= TELEMETRY_EVENT_COUNT )
+  {
+    return snprintf( buffer , size , "Unknown telemetry event %u" , (unsigned) record->id );
+  }
+  return snprintf( buffer , size , kFormats[record->id] ,
+                   (int) record->args[0] , (int) record->args[1] , (int) record->args[2] );
+}
+
+
+const telemetry_stats_t *telemetry_get_stats(void)
+{
+  return &g_stats;
+}
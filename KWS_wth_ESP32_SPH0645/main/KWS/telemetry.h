@@ -0,0 +1,93 @@
+/*
+ *  telemetry.h
+ *
+ *  Created on: October 18 , 2026
+ *  Author: mohammedhamdy32
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdint.h>
+
+/* Logs of the capture and inference paths, without formatting or UART
+   writes in them. An event is a fixed size record (id, time and three int32
+   args) put in a lock-free ring by telemetry_log(), which never blocks : it
+   can be called from any task and from the DMA callback, and the record is
+   dropped (and counted) when the ring is full. A low priority task takes the
+   records out with telemetry_pop() and formats them, or writes them as they
+   are, and KWS_model/decode_telemetry.py formats them on the host.
+
+   The ring is the bounded queue of D. Vyukov : every slot has a sequence
+   number which says if it is free for the producer of this turn or full for
+   the consumer, the producers take a slot with a compare and swap of the
+   head, so many producers (the other core, an interrupt) can log at the same
+   time. There is one consumer.
+
+   There is nothing of the ESP-IDF in this file, the clock is given to
+   telemetry_init(), so it runs on the host. */
+
+/* id, format of the three args (only %d like conversions of int32). This
+   list is also read by KWS_model/decode_telemetry.py, new events are added at
+   the end so the ids of the old ones don't change */
+#define  TELEMETRY_EVENTS(EVENT) \
+  EVENT( TELEMETRY_DETECTION ,            "Detected label %d of model %d, score %d/256" ) \
+  EVENT( TELEMETRY_CAPTURE_READ_ERROR ,   "Error in I2S read : %d" ) \
+  EVENT( TELEMETRY_CAPTURE_PARTIAL_READ , "Partial I2S read : %d bytes out of %d" ) \
+  EVENT( TELEMETRY_CAPTURE_RING_PARTIAL , "KWS : Could only write %d bytes out of %d, microphone %d" ) \
+  EVENT( TELEMETRY_CAPTURE_RING_FULL ,    "KWS : Could Not Write in Ring Buffer : %d, microphone %d" ) \
+  EVENT( TELEMETRY_CAPTURE_DMA_DROPPED ,  "DMA buffer of %d frames dropped, the capture ring is full (%d dropped)" ) \
+  EVENT( TELEMETRY_CAPTURE_NO_AUDIO ,     "No audio from the capture for %d ms" ) \
+  EVENT( TELEMETRY_MODEL_READ_ERROR ,     "Model Could not read data from Ring Buffer : %d" ) \
+  EVENT( TELEMETRY_NS_OVER_BUDGET ,       "Noise suppressor took %d us, budget %d us" ) \
+  EVENT( TELEMETRY_DROPPED ,              "%d telemetry records dropped" ) \
+  EVENT( TELEMETRY_COMMAND_BACKPRESSURE , "Commands : %d dropped, %d posted to a 3/4 full queue, slowest handlers %d us" ) \
+  EVENT( TELEMETRY_WEIGHT_STREAM_PREFETCH , "Streamed tensor %d : %d prefetch hits, %d misses" ) \
+  EVENT( TELEMETRY_WEIGHT_STREAM_LATENCY ,  "Streamed tensor %d : %d us stalled, worst invoke %d us" )
+
+#define  TELEMETRY_EVENT_ID(id, format)  id,
+typedef enum
+{
+  TELEMETRY_EVENTS( TELEMETRY_EVENT_ID )
+  TELEMETRY_EVENT_COUNT
+} telemetry_event_t;
+#undef  TELEMETRY_EVENT_ID
+
+/* Start of every record written out, so the decoder finds them among the
+   text of the console */
+#define  TELEMETRY_MAGIC          (0x4B57)
+#define  TELEMETRY_MAX_ARGS       (3)
+
+/* 16 bytes, little endian, what the binary output writes */
+typedef struct
+{
+  uint16_t magic;
+  uint16_t id;
+  uint32_t time_us;        /* Low 32 bits of the clock, wraps after 71 minutes */
+  int32_t args[TELEMETRY_MAX_ARGS];
+} telemetry_record_t;
+
+typedef struct
+{
+  uint32_t logged;         /* Records put in the ring */
+  uint32_t dropped;        /* Records lost because the ring was full */
+  uint32_t popped;
+  uint32_t max_fill;       /* Most records waiting, seen by the consumer */
+} telemetry_stats_t;
+
+/* Empties the ring, clock_us gives the time of the records */
+void telemetry_init(int64_t (*clock_us)(void));
+
+/* Never blocks, returns false when the record is dropped */
+bool telemetry_log(telemetry_event_t id, int32_t arg0, int32_t arg1, int32_t arg2);
+
+/* The oldest record, false when the ring is empty. One consumer only. The
+   drops since the last call come out first as a TELEMETRY_DROPPED record */
+bool telemetry_pop(telemetry_record_t *record);
+
+/* The text of a record, like snprintf */
+int telemetry_format(const telemetry_record_t *record, char *buffer, int size);
+
+const telemetry_stats_t *telemetry_get_stats(void);
+
+#endif /* TELEMETRY_H_ */